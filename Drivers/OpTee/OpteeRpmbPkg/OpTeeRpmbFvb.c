@@ -14,6 +14,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/MmServicesTableLib.h>
 #include <Library/PcdLib.h>
+#include <Library/TimerLib.h>
 
 #include <IndustryStandard/ArmFfaSvc.h>
 #include <IndustryStandard/ArmMmSvc.h>
@@ -36,6 +37,9 @@ STATIC CONST UINT16 mStorageId = 4U;
 
 STATIC MEM_INSTANCE mInstance;
 
+#define BLOCK_IS_LOADED(Instance, Lba) \
+  (((Instance)->LoadedBitmap[(Lba) / 8] & (1 << ((Lba) % 8))) != 0)
+
 /**
   Sends an SVC call to OP-TEE for reading/writing an RPMB partition
 
@@ -92,6 +96,275 @@ ReadWriteRpmb (
   return Status;
 }
 
+/**
+  Print how much of the store was read from the RPMB and how long it took,
+  per region.
+
+  @param[in] Instance    MEM_INSTANCE pointer describing the device
+**/
+STATIC
+VOID
+ReportLoadTimes (
+  IN MEM_INSTANCE *Instance
+  )
+{
+  UINTN        Index;
+
+  for (Index = 0; Index < RpmbRegionMax; Index++) {
+    DEBUG ((DEBUG_INFO, "%a: %a loaded 0x%x of 0x%x bytes in %ld us\n",
+      __func__, Instance->Region[Index].Name, Instance->Region[Index].LoadedBytes,
+      Instance->Region[Index].Size, DivU64x32 (Instance->Region[Index].LoadTime, 1000)));
+  }
+}
+
+/**
+  Mark blocks as present in memory.
+
+  @param[in] Instance    MEM_INSTANCE pointer describing the device
+  @param[in] StartLba    First block
+  @param[in] NumLba      Number of blocks
+**/
+STATIC
+VOID
+MarkBlocksLoaded (
+  IN MEM_INSTANCE *Instance,
+  IN UINTN        StartLba,
+  IN UINTN        NumLba
+  )
+{
+  UINTN        Lba;
+
+  for (Lba = StartLba; Lba < StartLba + NumLba; Lba++) {
+    if (!BLOCK_IS_LOADED (Instance, Lba)) {
+      Instance->LoadedBitmap[Lba / 8] |= (UINT8)(1 << (Lba % 8));
+      Instance->LoadedBlocks++;
+      if (Instance->LoadedBlocks == Instance->NBlocks) {
+        ReportLoadTimes (Instance);
+      }
+    }
+  }
+}
+
+/**
+  Read the blocks of a range which are not present in memory yet from the
+  RPMB. Consecutive missing blocks of the same region are read at once.
+
+  @param[in] Instance    MEM_INSTANCE pointer describing the device
+  @param[in] StartLba    First block
+  @param[in] NumLba      Number of blocks
+
+  @retval    EFI_SUCCESS All the blocks are present in memory
+  @retval    Others      The read from the RPMB failed
+**/
+STATIC
+EFI_STATUS
+LoadBlocks (
+  IN MEM_INSTANCE *Instance,
+  IN UINTN        StartLba,
+  IN UINTN        NumLba
+  )
+{
+  EFI_STATUS        Status;
+  RPMB_REGION_STATS *Region;
+  UINTN             Index;
+  UINTN             Lba;
+  UINTN             EndLba;
+  UINTN             RunEnd;
+  UINTN             ReadStart;
+  UINTN             ReadEnd;
+  UINT64            StartTime;
+
+  Lba = StartLba;
+  EndLba = MIN (StartLba + NumLba, Instance->NBlocks);
+  while (Lba < EndLba) {
+    if (BLOCK_IS_LOADED (Instance, Lba)) {
+      Lba++;
+      continue;
+    }
+
+    ReadStart = Lba * Instance->BlockSize;
+    Region = NULL;
+    for (Index = 0; Index < RpmbRegionMax; Index++) {
+      if ((ReadStart >= Instance->Region[Index].Start) &&
+          (ReadStart < Instance->Region[Index].Start + Instance->Region[Index].Size)) {
+        Region = &Instance->Region[Index];
+        break;
+      }
+    }
+    if (Region == NULL) {
+      // Padding after the store, there is nothing to read
+      MarkBlocksLoaded (Instance, Lba, 1);
+      Lba++;
+      continue;
+    }
+
+    RunEnd = Lba + 1;
+    while ((RunEnd < EndLba) && !BLOCK_IS_LOADED (Instance, RunEnd) &&
+           (RunEnd * Instance->BlockSize < Region->Start + Region->Size)) {
+      RunEnd++;
+    }
+    ReadEnd = MIN (RunEnd * Instance->BlockSize, Region->Start + Region->Size);
+
+    StartTime = GetPerformanceCounter ();
+    Status = ReadWriteRpmb (
+               SP_SVC_RPMB_READ,
+               (UINTN)Instance->MemBaseAddress + ReadStart,
+               ReadEnd - ReadStart,
+               ReadStart
+               );
+    Region->LoadTime += GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    Region->LoadedBytes += ReadEnd - ReadStart;
+
+    MarkBlocksLoaded (Instance, Lba, RunEnd - Lba);
+    Lba = RunEnd;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Write the range of the in-memory copy which has not reached the RPMB yet.
+
+  The range is only kept dirty if the write fails, so it is retried by the
+  next flush.
+
+  @param[in] Instance    MEM_INSTANCE pointer describing the device
+
+  @retval    EFI_SUCCESS Nothing to write or the range was written
+  @retval    Others      The write to the RPMB failed
+**/
+STATIC
+EFI_STATUS
+FlushDirtyRange (
+  IN MEM_INSTANCE *Instance
+  )
+{
+  EFI_STATUS   Status;
+
+  if (Instance->DirtyEnd == Instance->DirtyStart) {
+    return EFI_SUCCESS;
+  }
+
+  Status = ReadWriteRpmb (
+             SP_SVC_RPMB_WRITE,
+             (UINTN)Instance->MemBaseAddress + Instance->DirtyStart,
+             Instance->DirtyEnd - Instance->DirtyStart,
+             Instance->DirtyStart
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Instance->DirtyEnd = Instance->DirtyStart;
+  return EFI_SUCCESS;
+}
+
+/**
+  Check whether a range of the in-memory copy is still in the erased state.
+
+  Blocks which are not loaded yet are skipped: OpTeeRpmbFvbWrite() loads the
+  partially written blocks first, so those are entirely overwritten.
+
+  @param[in] Instance    MEM_INSTANCE pointer describing the device
+  @param[in] Offset      Offset of the range
+  @param[in] Length      Length of the range
+
+  @retval    TRUE        All the loaded bytes of the range are erased
+  @retval    FALSE       The range holds programmed bytes
+**/
+STATIC
+BOOLEAN
+IsRangeErased (
+  IN MEM_INSTANCE *Instance,
+  IN UINTN        Offset,
+  IN UINTN        Length
+  )
+{
+  UINT8        *Byte;
+  UINTN        Index;
+
+  Byte = (UINT8 *)(UINTN)Instance->MemBaseAddress + Offset;
+  for (Index = 0; Index < Length; Index++) {
+    if (!BLOCK_IS_LOADED (Instance, (Offset + Index) / Instance->BlockSize)) {
+      continue;
+    }
+    if (Byte[Index] != 0xFF) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Root MMI handler writing back the pending range at the end of each MMI.
+
+  It runs after the GUIDed handler of the MMI (e.g. SetVariable), so
+  coalesced writes which were not followed by a state update still reach the
+  RPMB before the MMI returns to the normal world. A failure leaves the range
+  pending; it is retried, and reported, by the next write or erase.
+
+  Root MMI handlers are not given the communicate buffer, and any status other
+  than the ones below trips the ASSERT of MmiManage(), so a failed write back
+  is reported as a source which is still pending.
+
+  @param[in]     DispatchHandle  The unique handle assigned to this handler.
+  @param[in]     Context         Not used.
+  @param[in,out] CommBuffer      Not used.
+  @param[in,out] CommBufferSize  Not used.
+
+  @retval EFI_SUCCESS                       Nothing was pending, or the
+                                            pending range was written back.
+  @retval EFI_WARN_INTERRUPT_SOURCE_PENDING The pending range could not be
+                                            written back.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+OpTeeRpmbFvbMmiHandler (
+  IN     EFI_HANDLE  DispatchHandle,
+  IN     CONST VOID  *Context         OPTIONAL,
+  IN OUT VOID        *CommBuffer      OPTIONAL,
+  IN OUT UINTN       *CommBufferSize  OPTIONAL
+  )
+{
+  EFI_STATUS   Status;
+  EFI_STATUS   FlushStatus;
+  UINTN        Lba;
+  UINT32       PrefetchBlocks;
+
+  FlushStatus = FlushDirtyRange (&mInstance);
+  if (EFI_ERROR (FlushStatus)) {
+    DEBUG ((DEBUG_ERROR,
+      "%a: Failed to write back 0x%x-0x%x, the data of this MMI is not in the RPMB: %r\n",
+      __func__, mInstance.DirtyStart, mInstance.DirtyEnd, FlushStatus));
+  }
+
+  // Complete the in-memory copy a few blocks at a time
+  PrefetchBlocks = FixedPcdGet32 (PcdRpmbFvbPrefetchBlocksPerMmi);
+  if ((PrefetchBlocks != 0) && mInstance.Initialized &&
+      (mInstance.LoadedBlocks < mInstance.NBlocks)) {
+    Lba = 0;
+    while (BLOCK_IS_LOADED (&mInstance, Lba)) {
+      Lba++;
+    }
+    Status = LoadBlocks (&mInstance, Lba, PrefetchBlocks);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: Failed to prefetch from block 0x%x: %r\n",
+        __func__, Lba, Status));
+    }
+  }
+
+  if (EFI_ERROR (FlushStatus)) {
+    return EFI_WARN_INTERRUPT_SOURCE_PENDING;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   The GetAttributes() function retrieves the attributes and
   current settings of the block.
@@ -287,10 +560,24 @@ OpTeeRpmbFvbRead (
     }
   }
 
+  if (*NumBytes == 0) {
+    return EFI_SUCCESS;
+  }
+
+  // Fetch the blocks which were not read from the RPMB yet
+  Status = LoadBlocks (
+             Instance,
+             (UINTN)Lba + Offset / Instance->BlockSize,
+             (Offset % Instance->BlockSize + *NumBytes + Instance->BlockSize - 1) /
+             Instance->BlockSize
+             );
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
+
   Base = (VOID *)(UINTN)Instance->MemBaseAddress + (Lba * Instance->BlockSize) +
          Offset;
-  // We could read the data from the RPMB instead of memory
-  // The 2 copies should already be identical
+  // The in-memory copy is identical to the RPMB for loaded blocks
   // Copy from memory image
   CopyMem (Buffer, Base, *NumBytes);
 
@@ -362,6 +649,9 @@ OpTeeRpmbFvbWrite (
   MEM_INSTANCE *Instance;
   EFI_STATUS   Status;
   VOID         *Base;
+  UINTN        WriteOffset;
+  UINTN        FirstLba;
+  UINTN        LastLba;
 
   Instance = INSTANCE_FROM_FVB_THIS (This);
   if (!Instance->Initialized) {
@@ -370,22 +660,74 @@ OpTeeRpmbFvbWrite (
       return Status;
     }
   }
-  Base = (VOID *)(UINTN)Instance->MemBaseAddress + (Lba * Instance->BlockSize) +
-         Offset;
-  Status = ReadWriteRpmb (
-             SP_SVC_RPMB_WRITE,
-             (UINTN)Buffer,
-             *NumBytes,
-             (Lba * Instance->BlockSize) + Offset
-             );
-  if (EFI_ERROR (Status)) {
-    return Status;
+  if (*NumBytes == 0) {
+    return EFI_SUCCESS;
+  }
+  WriteOffset = (Lba * Instance->BlockSize) + Offset;
+  Base = (VOID *)(UINTN)Instance->MemBaseAddress + WriteOffset;
+
+  // Blocks only partially overwritten must be read from the RPMB first
+  FirstLba = WriteOffset / Instance->BlockSize;
+  LastLba  = (WriteOffset + *NumBytes - 1) / Instance->BlockSize;
+  if ((WriteOffset % Instance->BlockSize) != 0) {
+    Status = LoadBlocks (Instance, FirstLba, 1);
+    if (EFI_ERROR (Status)) {
+      return EFI_DEVICE_ERROR;
+    }
+  }
+  if (((WriteOffset + *NumBytes) % Instance->BlockSize) != 0) {
+    Status = LoadBlocks (Instance, LastLba, 1);
+    if (EFI_ERROR (Status)) {
+      return EFI_DEVICE_ERROR;
+    }
+  }
+
+  // The variable and FTW drivers write a record in several consecutive
+  // pieces (header, name, data) into erased space, and then complete the
+  // update by changing state bytes of records already written. Only writes
+  // into erased space are deferred, and they are merged while each one
+  // directly follows the pending range; anything else writes the pending
+  // range back first. A write to programmed bytes completes an update: it
+  // goes to the RPMB before Write() returns, and any failure, including
+  // the one of the pending range, is returned to the caller. RPMB writes
+  // are thus never reordered and a state byte never lands in the same RPMB
+  // write as the data it validates, which keeps the fault tolerant write
+  // guarantees. A trailing range is written back at the end of the MMI.
+  if (!IsRangeErased (Instance, WriteOffset, *NumBytes)) {
+    Status = FlushDirtyRange (Instance);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    Status = ReadWriteRpmb (
+               SP_SVC_RPMB_WRITE,
+               (UINTN)Buffer,
+               *NumBytes,
+               WriteOffset
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    CopyMem (Base, Buffer, *NumBytes);
+    MarkBlocksLoaded (Instance, FirstLba, LastLba - FirstLba + 1);
+    return EFI_SUCCESS;
+  }
+
+  if ((Instance->DirtyEnd == Instance->DirtyStart) ||
+      (WriteOffset != Instance->DirtyEnd)) {
+    Status = FlushDirtyRange (Instance);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    Instance->DirtyStart = WriteOffset;
+    Instance->DirtyEnd   = WriteOffset;
   }
 
   // Update the memory copy
   CopyMem (Base, Buffer, *NumBytes);
+  Instance->DirtyEnd += *NumBytes;
+  MarkBlocksLoaded (Instance, FirstLba, LastLba - FirstLba + 1);
 
-  return Status;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -452,6 +794,12 @@ OpTeeRpmbFvbErase (
 
   Instance = INSTANCE_FROM_FVB_THIS (This);
 
+  // Keep the write order: pending writes reach the RPMB before the erase
+  Status = FlushDirtyRange (Instance);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   VA_START (Args, This);
   for (Start = VA_ARG (Args, EFI_LBA);
        Start != EFI_LBA_LIST_TERMINATOR;
@@ -481,6 +829,7 @@ OpTeeRpmbFvbErase (
     }
     // Update the in memory copy
     SetMem64 (Base, NumLba * Instance->BlockSize, ~0UL);
+    MarkBlocksLoaded (Instance, (UINTN)Start, NumLba);
     FreePool (Buf);
   }
 
@@ -491,34 +840,33 @@ OpTeeRpmbFvbErase (
 
 /**
   Since we use a memory backed storage we need to restore the RPMB contents
-  into memory before we register the Fvb protocol.
+  into memory before they are accessed.
+
+  The variable store is read at once: it holds the FV header and the
+  variable driver reads it straight from memory. The FTW working and spare
+  areas are only accessed through the FVB protocol, so their blocks are
+  read on first access or prefetched at the end of an MMI.
 
   @param Instance Address to copy flash contents to
 **/
 STATIC
 VOID
-ReadEntireFlash (
+ReadVariableStore (
   IN MEM_INSTANCE *Instance
  )
 {
-  UINTN ReadAddr;
-  UINTN StorageFtwWorkingSize;
-  UINTN StorageVariableSize;
-  UINTN StorageFtwSpareSize;
-
-  StorageFtwWorkingSize = PcdGet32 (PcdFlashNvStorageFtwWorkingSize);
-  StorageVariableSize   = PcdGet32 (PcdFlashNvStorageVariableSize);
-  StorageFtwSpareSize   = PcdGet32 (PcdFlashNvStorageFtwSpareSize);
+  RPMB_REGION_STATS *Region;
 
-  ReadAddr = Instance->MemBaseAddress;
+  Region = &Instance->Region[RpmbRegionVariable];
   // There's no need to check if the read failed here. The upper EDK2 layers
   // will initialize the flash correctly if the in-memory copy is wrong
-  ReadWriteRpmb (
-    SP_SVC_RPMB_READ,
-    ReadAddr,
-    StorageVariableSize + StorageFtwWorkingSize + StorageFtwSpareSize,
-    0
+  LoadBlocks (
+    Instance,
+    Region->Start / Instance->BlockSize,
+    (Region->Size + Instance->BlockSize - 1) / Instance->BlockSize
     );
+  DEBUG ((DEBUG_INFO, "%a: %a loaded in %ld us, FTW areas on demand\n",
+    __func__, Region->Name, DivU64x32 (Region->LoadTime, 1000)));
 }
 
 /**
@@ -729,8 +1077,8 @@ FvbInitialize (
   ASSERT ((PcdGet64 (PcdFlashNvStorageFtwWorkingBase64) % Instance->BlockSize) == 0);
   ASSERT ((PcdGet64 (PcdFlashNvStorageFtwSpareBase64) % Instance->BlockSize) == 0);
 
-  // Read the file from disk and copy it to memory
-  ReadEntireFlash (Instance);
+  // Read the variable store from disk and copy it to memory
+  ReadVariableStore (Instance);
 
   FwVolHeader = (EFI_FIRMWARE_VOLUME_HEADER *)(UINTN)Instance->MemBaseAddress;
   Status = ValidateFvHeader (FwVolHeader);
@@ -756,6 +1104,7 @@ FvbInitialize (
     if (EFI_ERROR (Status)) {
       return Status;
     }
+    MarkBlocksLoaded (Instance, 0, Instance->NBlocks);
     // Install all appropriate headers
     DEBUG ((DEBUG_INFO, "%a: Installing a correct one for this volume.\n",
       __func__));
@@ -822,6 +1171,23 @@ OpTeeRpmbFvbInit (
   mInstance.BlockSize      = EFI_PAGE_SIZE;
   mInstance.NBlocks        = NBlocks;
 
+  mInstance.LoadedBitmap = AllocateZeroPool ((NBlocks + 7) / 8);
+  if (mInstance.LoadedBitmap == NULL) {
+    FreePages (Addr, NBlocks);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  mInstance.Region[RpmbRegionVariable].Name   = "Variable store";
+  mInstance.Region[RpmbRegionVariable].Start  = 0;
+  mInstance.Region[RpmbRegionVariable].Size   = PcdGet32 (PcdFlashNvStorageVariableSize);
+  mInstance.Region[RpmbRegionFtwWorking].Name  = "FTW working area";
+  mInstance.Region[RpmbRegionFtwWorking].Start = PcdGet32 (PcdFlashNvStorageVariableSize);
+  mInstance.Region[RpmbRegionFtwWorking].Size  = PcdGet32 (PcdFlashNvStorageFtwWorkingSize);
+  mInstance.Region[RpmbRegionFtwSpare].Name   = "FTW spare area";
+  mInstance.Region[RpmbRegionFtwSpare].Start  = PcdGet32 (PcdFlashNvStorageVariableSize) +
+                                                PcdGet32 (PcdFlashNvStorageFtwWorkingSize);
+  mInstance.Region[RpmbRegionFtwSpare].Size   = PcdGet32 (PcdFlashNvStorageFtwSpareSize);
+
   // Update the defined PCDs related to Variable Storage
   PatchPcdSet64 (PcdFlashNvStorageVariableBase64, mInstance.MemBaseAddress);
   PatchPcdSet64 (
@@ -843,6 +1209,13 @@ OpTeeRpmbFvbInit (
                     );
   ASSERT_EFI_ERROR (Status);
 
+  Status = gMmst->MmiHandlerRegister (
+                    OpTeeRpmbFvbMmiHandler,
+                    NULL,
+                    &mInstance.MmiHandle
+                    );
+  ASSERT_EFI_ERROR (Status);
+
   DEBUG ((DEBUG_INFO, "%a: Register OP-TEE RPMB Fvb\n", __func__));
   DEBUG ((DEBUG_INFO, "%a: Using NV store FV in-memory copy at 0x%lx\n",
     __func__, PatchPcdGet64 (PcdFlashNvStorageVariableBase64)));
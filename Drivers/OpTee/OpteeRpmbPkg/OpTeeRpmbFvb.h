@@ -35,6 +35,29 @@
 typedef struct _MEM_INSTANCE         MEM_INSTANCE;
 typedef EFI_STATUS (*MEM_INITIALIZE) (MEM_INSTANCE* Instance);
 
+typedef enum {
+  RpmbRegionVariable,
+  RpmbRegionFtwWorking,
+  RpmbRegionFtwSpare,
+  RpmbRegionMax
+} RPMB_REGION;
+
+/**
+  Load statistics of one region of the RPMB variable store.
+**/
+typedef struct {
+    /// Name printed in the load report
+    CONST CHAR8                         *Name;
+    /// Offset of the region in the store
+    UINTN                               Start;
+    /// Size of the region
+    UINTN                               Size;
+    /// Bytes read from the RPMB so far
+    UINTN                               LoadedBytes;
+    /// Time spent reading them, in nanoseconds
+    UINT64                              LoadTime;
+} RPMB_REGION_STATS;
+
 /**
   This struct is used by the RPMB driver. Since the upper EDK2 layers
   expect byte addressable memory, we allocate a memory area of certain
@@ -58,6 +81,18 @@ struct _MEM_INSTANCE
     UINT16                              BlockSize;
     /// Number of allocated blocks
     UINT16                              NBlocks;
+    /// Start offset of the range updated in memory but not yet in the RPMB
+    UINTN                               DirtyStart;
+    /// End offset (exclusive) of that range, equal to DirtyStart when clean
+    UINTN                               DirtyEnd;
+    /// Root MMI handler used to write back at the end of every MMI
+    EFI_HANDLE                          MmiHandle;
+    /// One bit per block, set once the block is present in memory
+    UINT8                               *LoadedBitmap;
+    /// Number of blocks present in memory
+    UINTN                               LoadedBlocks;
+    /// Load statistics per region
+    RPMB_REGION_STATS                   Region[RpmbRegionMax];
 };
 
 #endif
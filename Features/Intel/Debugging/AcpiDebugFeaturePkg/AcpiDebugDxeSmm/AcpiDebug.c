@@ -50,8 +50,39 @@ typedef struct {
 
 #define MAX_BUFFER_SIZE     32
 
+//
+// Ring buffer mode. The Acpi Debug head is followed by a ring header and
+// fixed size records which ASL RDBG writes without mutex or SMI. The layout
+// is decoded by Tools/AcpiDebugDecode/AcpiDebugDecode.py.
+//
+#define ACPI_DEBUG_RING_SIGNATURE  SIGNATURE_32 ('A', 'D', 'R', 'B')
+#define ACPI_DEBUG_RING_REVISION   1
+
+#pragma pack(1)
+typedef struct {
+  UINT32 Signature;         // "ADRB"
+  UINT16 Revision;          // ACPI_DEBUG_RING_REVISION
+  UINT16 RecordSize;        // sizeof (ACPI_DEBUG_RING_RECORD)
+  UINT32 RecordCount;       // Number of records following the ring header
+  UINT32 Sequence;          // Sequence number of the next record, incremented by ASL
+  UINT32 TimerPeriod;       // Period of the record timestamps in ns, ASL Timer is 100ns
+  UINT8  Reserved[12];
+} ACPI_DEBUG_RING_HEAD;
+
+typedef struct {
+  UINT32 Sequence;          // Sequence number of the record + 1, 0 while ASL writes the record
+  UINT8  Truncate;          // If the input from ASL >= sizeof (Message)
+  UINT8  Reserved[3];
+  UINT64 Timestamp;         // ASL Timer value when the record was claimed
+  CHAR8  Message[48];       // NULL terminated string
+} ACPI_DEBUG_RING_RECORD;
+#pragma pack()
+
+#define AD_RING_SIZE        (AD_SIZE + sizeof (ACPI_DEBUG_RING_HEAD)) // This is 0x40
+
 UINT32                      mBufferEnd = 0;
 ACPI_DEBUG_HEAD             *mAcpiDebug = NULL;
+BOOLEAN                     mRingBuffer = FALSE;
 
 EFI_SMM_SYSTEM_TABLE2       *mSmst = NULL;
 
@@ -61,13 +92,15 @@ EFI_SMM_SYSTEM_TABLE2       *mSmst = NULL;
   @param[in] AcpiDebugAddress   Address of Acpi debug memory buffer.
   @param[in] BufferIndex        Index that starts after the Acpi Debug head.
   @param[in] BufferEnd          End of Acpi debug memory buffer.
+  @param[in] RingBuffer         TRUE if the buffer is set up in ring buffer mode.
 
 **/
 VOID
 PatchAndLoadAcpiTable (
   IN ACPI_DEBUG_HEAD            *AcpiDebugAddress,
   IN UINT32                     BufferIndex,
-  IN UINT32                     BufferEnd
+  IN UINT32                     BufferEnd,
+  IN BOOLEAN                    RingBuffer
   )
 {
   EFI_STATUS                    Status;
@@ -102,10 +135,10 @@ PatchAndLoadAcpiTable (
   //
 
   //
-  // Count pointer updates, so we can stop after all three pointers are patched.
+  // Count pointer updates, so we can stop after all three pointers and the mode are patched.
   //
   UpdateCounter = 1;
-  for (CurrPtr = (UINT8 *) TableHeader; CurrPtr <= ((UINT8 *) TableHeader + TableHeader->Length) && UpdateCounter < 4; CurrPtr++) {
+  for (CurrPtr = (UINT8 *) TableHeader; CurrPtr <= ((UINT8 *) TableHeader + TableHeader->Length) && UpdateCounter < 5; CurrPtr++) {
     Signature = (UINT32 *) (CurrPtr + 1);
     //
     // patch DPTR (address of Acpi debug memory buffer)
@@ -131,6 +164,14 @@ PatchAndLoadAcpiTable (
       NamePtr->Value  = BufferIndex;
       UpdateCounter++;
     }
+    //
+    // patch RMOD (ring buffer mode)
+    //
+    if ((*CurrPtr == AML_NAME_OP) && *Signature == SIGNATURE_32 ('R', 'M', 'O', 'D')) {
+      NamePtr = (NAME_LAYOUT *) CurrPtr;
+      NamePtr->Value  = RingBuffer ? 1 : 0;
+      UpdateCounter++;
+    }
   }
 
   //
@@ -224,11 +265,30 @@ AcpiDebugEndOfDxeNotification (
   IN VOID       *Context
   )
 {
-  UINT32        BufferSize;
-  UINT32        BufferIndex;
+  UINT32                BufferSize;
+  UINT32                BufferIndex;
+  ACPI_DEBUG_RING_HEAD  *RingHead;
 
   mAcpiDebug = (ACPI_DEBUG_HEAD *) (UINTN) AllocateAcpiDebugMemory (&BufferSize);
-  if (mAcpiDebug != NULL) {
+  if ((mAcpiDebug != NULL) && mRingBuffer && (BufferSize >= AD_RING_SIZE + sizeof (ACPI_DEBUG_RING_RECORD))) {
+    //
+    // Records with a zero sequence number are empty.
+    //
+    ZeroMem ((VOID *) mAcpiDebug, BufferSize);
+    CopyMem ((VOID *) mAcpiDebug, ACPI_DEBUG_STR, sizeof (ACPI_DEBUG_STR) - 1);
+    mAcpiDebug->BufferSize = BufferSize;
+
+    RingHead = (ACPI_DEBUG_RING_HEAD *) (mAcpiDebug + 1);
+    RingHead->Signature   = ACPI_DEBUG_RING_SIGNATURE;
+    RingHead->Revision    = ACPI_DEBUG_RING_REVISION;
+    RingHead->RecordSize  = sizeof (ACPI_DEBUG_RING_RECORD);
+    RingHead->RecordCount = (BufferSize - AD_RING_SIZE) / sizeof (ACPI_DEBUG_RING_RECORD);
+    RingHead->TimerPeriod = 100;
+
+    BufferIndex = (UINT32) (UINTN) mAcpiDebug;
+    mBufferEnd = BufferIndex + BufferSize;
+    PatchAndLoadAcpiTable (mAcpiDebug, BufferIndex + AD_RING_SIZE, mBufferEnd, TRUE);
+  } else if (mAcpiDebug != NULL) {
     //
     // Init ACPI DEBUG buffer to lower case 'x'.
     //
@@ -255,7 +315,7 @@ AcpiDebugEndOfDxeNotification (
     //
     // Patch and Load the SSDT ACPI Tables.
     //
-    PatchAndLoadAcpiTable (mAcpiDebug, BufferIndex, mBufferEnd);
+    PatchAndLoadAcpiTable (mAcpiDebug, BufferIndex, mBufferEnd, FALSE);
 
     mAcpiDebug->Head = BufferIndex;
     mAcpiDebug->Tail = BufferIndex;
@@ -293,6 +353,12 @@ InitializeAcpiDebugDxe (
     return EFI_SUCCESS;
   }
 
+  //
+  // Only the DXE version can use the ring buffer, AcpiDebugSmmCallback ()
+  // consumes the Head/Tail layout.
+  //
+  mRingBuffer = FeaturePcdGet (PcdAcpiDebugRingBuffer);
+
   //
   // Register EndOfDxe notification
   // that point could ensure the Acpi Debug related PCDs initialized.
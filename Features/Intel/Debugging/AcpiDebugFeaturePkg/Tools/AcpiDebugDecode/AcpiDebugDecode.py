@@ -0,0 +1,166 @@
+## @file
+# Decode the ACPI Debug buffer written by the AcpiDebugFeaturePkg SSDT
+#
+# The buffer is read either from a memory dump or, on a running Linux system,
+# from /dev/mem at the address the ACPI Debug SSDT exposes in its DPTR/EPTR
+# names. Both the ring buffer layout (PcdAcpiDebugRingBuffer) and the 32 byte
+# string layout are supported.
+#
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+import os
+import sys
+import struct
+import argparse
+
+# Version message
+__prog__ = 'AcpiDebugDecode'
+__description__ = 'Decode the ACPI Debug buffer from a memory dump or from the running OS. '
+__version__ = '%s Version %s' % (__prog__, '0.1 ')
+
+# Buffer layout, see AcpiDebugDxeSmm/AcpiDebug.c
+_DebugSignature = b'INTEL ACPI DEBUG'
+_DebugHead = struct.Struct('<16sIIIBBBB')
+_RingSignature = b'ADRB'
+_RingHead = struct.Struct('<4sHHIII12x')
+_RingRecord = struct.Struct('<IB3xQ48s')
+_LegacySlotSize = 32
+
+# ACPI Debug SSDT
+_SsdtOemTableId = b'ADebTabl'
+_AmlNameOp = 0x08
+_AmlDWordPrefix = 0x0C
+
+
+def _Error(Message):
+    sys.stderr.write('%s: error: %s\n' % (__prog__, Message))
+    sys.exit(1)
+
+
+def _String(Data):
+    return Data.split(b'\0', 1)[0].decode('ascii', 'replace')
+
+
+def _GetSsdtNames(AcpiTableDir):
+    """Return the patched DWord names of the ACPI Debug SSDT."""
+    for Name in sorted(os.listdir(AcpiTableDir)):
+        if not Name.startswith('SSDT'):
+            continue
+        with open(os.path.join(AcpiTableDir, Name), 'rb') as File:
+            Table = File.read()
+        if Table[16:24] != _SsdtOemTableId:
+            continue
+        Names = {}
+        for Key in (b'DPTR', b'EPTR', b'RMOD'):
+            Offset = Table.find(bytes([_AmlNameOp]) + Key + bytes([_AmlDWordPrefix]))
+            if Offset >= 0:
+                Names[Key.decode()] = struct.unpack_from('<I', Table, Offset + 6)[0]
+        return Names
+    return None
+
+
+def _ReadFromOs(AcpiTableDir, MemDevice):
+    Names = _GetSsdtNames(AcpiTableDir)
+    if Names is None or 'DPTR' not in Names or 'EPTR' not in Names:
+        _Error('ACPI Debug SSDT not found in %s' % AcpiTableDir)
+    Base = Names['DPTR']
+    with open(MemDevice, 'rb') as File:
+        File.seek(Base)
+        Buffer = File.read(Names['EPTR'] - Base)
+    return Buffer, Base
+
+
+def _ReadFromDump(DumpFile, Base):
+    with open(DumpFile, 'rb') as File:
+        Dump = File.read()
+    Offset = Dump.find(_DebugSignature)
+    if Offset < 0:
+        _Error('"%s" signature not found in %s' % (_DebugSignature.decode(), DumpFile))
+    BufferSize = _DebugHead.unpack_from(Dump, Offset)[1]
+    return Dump[Offset:Offset + BufferSize], Base
+
+
+def DecodeRing(Buffer):
+    """Return (Sequence, Timestamp in ns, Truncate, Message) of all valid records, oldest first."""
+    Signature, Revision, RecordSize, RecordCount, Sequence, TimerPeriod = _RingHead.unpack_from(Buffer, _DebugHead.size)
+    if RecordSize != _RingRecord.size or RecordCount == 0:
+        _Error('unsupported ring layout, revision %d record size %d' % (Revision, RecordSize))
+    RecordBase = _DebugHead.size + _RingHead.size
+    RecordCount = min(RecordCount, (len(Buffer) - RecordBase) // RecordSize)
+
+    Records = []
+    Skipped = 0
+    for Number in range(max(0, Sequence - RecordCount), Sequence):
+        Offset = RecordBase + (Number % RecordCount) * RecordSize
+        RecordSequence, Truncate, Timestamp, Message = _RingRecord.unpack_from(Buffer, Offset)
+        #
+        # A record still being written or already reused for a newer
+        # message does not carry the expected sequence number.
+        #
+        if RecordSequence != ((Number + 1) & 0xFFFFFFFF):
+            Skipped += 1
+            continue
+        Records.append((Number, Timestamp * TimerPeriod, Truncate != 0, _String(Message)))
+    return Records, max(0, Sequence - RecordCount), Skipped
+
+
+def DecodeLegacy(Buffer, Base):
+    """Return the messages of the 32 byte string layout, oldest first if Base is known."""
+    Signature, BufferSize, Head, Tail, SmiTrigger, Wrap, SmmVersion, Truncate = _DebugHead.unpack_from(Buffer, 0)
+    Slots = range(_DebugHead.size, len(Buffer) - _LegacySlotSize + 1, _LegacySlotSize)
+    if Base is not None and Base + _DebugHead.size <= Tail < Base + len(Buffer):
+        TailOffset = Tail - Base
+        Slots = [Offset for Offset in Slots if Offset >= TailOffset] + [Offset for Offset in Slots if Offset < TailOffset]
+    Messages = []
+    for Offset in Slots:
+        Slot = Buffer[Offset:Offset + _LegacySlotSize]
+        #
+        # Unused slots are filled with 'x' by AcpiDebugDxe.
+        #
+        if Slot == b'x' * _LegacySlotSize or Slot[0] == 0:
+            continue
+        Messages.append(_String(Slot))
+    return Messages
+
+
+def main():
+    Parser = argparse.ArgumentParser(prog=__prog__, description=__description__ + __version__)
+    Parser.add_argument('-i', '--input', dest='Input', help='Memory dump containing the ACPI Debug buffer. '
+                        'Without it the buffer is read from the running OS.')
+    Parser.add_argument('-b', '--base', dest='Base', type=lambda Value: int(Value, 0),
+                        help='Physical address of the buffer in the dump, orders messages of the 32 byte string layout')
+    Parser.add_argument('--acpi-tables', dest='AcpiTables', default='/sys/firmware/acpi/tables',
+                        help='Directory of the ACPI tables of the running OS')
+    Parser.add_argument('--mem', dest='Mem', default='/dev/mem', help='Physical memory device of the running OS')
+    Parser.add_argument('--version', action='version', version=__version__)
+    Args = Parser.parse_args()
+
+    if Args.Input:
+        Buffer, Base = _ReadFromDump(Args.Input, Args.Base)
+    else:
+        Buffer, Base = _ReadFromOs(Args.AcpiTables, Args.Mem)
+
+    if len(Buffer) < _DebugHead.size + _RingHead.size or not Buffer.startswith(_DebugSignature):
+        _Error('invalid ACPI Debug buffer')
+
+    if Buffer[_DebugHead.size:_DebugHead.size + 4] == _RingSignature:
+        Records, First, Skipped = DecodeRing(Buffer)
+        if First != 0:
+            print('# %d older records overwritten' % First)
+        if Skipped != 0:
+            print('# %d records skipped (being written or overwritten while reading)' % Skipped)
+        for Number, Nanoseconds, Truncate, Message in Records:
+            print('[%6d] %10d.%07d %s%s' % (Number, Nanoseconds // 1000000000, (Nanoseconds % 1000000000) // 100,
+                                           Message, '...' if Truncate else ''))
+    else:
+        for Message in DecodeLegacy(Buffer, Base):
+            print(Message)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
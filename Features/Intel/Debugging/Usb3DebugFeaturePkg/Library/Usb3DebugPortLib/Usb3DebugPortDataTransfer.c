@@ -178,6 +178,41 @@ XhcCheckNewEvent (
   return Status;
 }
 
+/**
+  Write the software event ring dequeue pointer back to XHC.
+
+  @param  Xhc         The XHCI Instance.
+
+**/
+VOID
+XhcUpdateEventRingDequeue (
+  IN  USB3_DEBUG_PORT_INSTANCE *Xhc
+  )
+{
+  UINT64                  XhcDequeue;
+  UINT32                  High;
+  UINT32                  Low;
+
+  //
+  // Advance event ring to last available entry
+  //
+  // Some 3rd party XHCI external cards don't support single 64-bytes width register access,
+  // So divide it to two 32-bytes width register access.
+  //
+  Low  = XhcReadDebugReg (Xhc, XHC_DC_DCERDP);
+  High = XhcReadDebugReg (Xhc, XHC_DC_DCERDP + 4);
+  XhcDequeue = (UINT64)(LShiftU64((UINT64)High, 32) | Low);
+
+  if ((XhcDequeue & (~0x0F)) != ((UINT64)(UINTN)Xhc->EventRing.EventRingDequeue & (~0x0F))) {
+    //
+    // Some 3rd party XHCI external cards don't support single 64-bytes width register access,
+    // So divide it to two 32-bytes width register access.
+    //
+    XhcWriteDebugReg (Xhc, XHC_DC_DCERDP, XHC_LOW_32BIT (Xhc->EventRing.EventRingDequeue));
+    XhcWriteDebugReg (Xhc, XHC_DC_DCERDP + 4, XHC_HIGH_32BIT (Xhc->EventRing.EventRingDequeue));
+  }
+}
+
 /**
   Check if the Trb is a transaction of the URB.
 
@@ -235,9 +270,6 @@ XhcCheckUrbResult (
   UINT8                   TRBType;
   EFI_STATUS              Status;
   URB                     *CheckedUrb;
-  UINT64                  XhcDequeue;
-  UINT32                  High;
-  UINT32                  Low;
 
   ASSERT ((Xhc != NULL) && (Urb != NULL));
 
@@ -342,24 +374,7 @@ XhcCheckUrbResult (
   }
 
 EXIT:
-  //
-  // Advance event ring to last available entry
-  //
-  // Some 3rd party XHCI external cards don't support single 64-bytes width register access,
-  // So divide it to two 32-bytes width register access.
-  //
-  Low  = XhcReadDebugReg (Xhc, XHC_DC_DCERDP);
-  High = XhcReadDebugReg (Xhc, XHC_DC_DCERDP + 4);
-  XhcDequeue = (UINT64)(LShiftU64((UINT64)High, 32) | Low);
-
-  if ((XhcDequeue & (~0x0F)) != ((UINT64)(UINTN)Xhc->EventRing.EventRingDequeue & (~0x0F))) {
-    //
-    // Some 3rd party XHCI external cards don't support single 64-bytes width register access,
-    // So divide it to two 32-bytes width register access.
-    //
-    XhcWriteDebugReg (Xhc, XHC_DC_DCERDP, XHC_LOW_32BIT (Xhc->EventRing.EventRingDequeue));
-    XhcWriteDebugReg (Xhc, XHC_DC_DCERDP + 4, XHC_HIGH_32BIT (Xhc->EventRing.EventRingDequeue));
-  }
+  XhcUpdateEventRingDequeue (Xhc);
 
   return Status;
 }
@@ -638,6 +653,14 @@ XhcDataTransfer (
   *TransferResult = EFI_USB_ERR_SYSTEM;
   Status          = EFI_DEVICE_ERROR;
 
+  //
+  // The synchronous transfer only handles the events of its own URB, so the
+  // buffered output has to be drained before the event ring is shared.
+  //
+  if (EFI_ERROR (XhcWaitOutTransfers (Xhc, 0, Timeout))) {
+    return EFI_TIMEOUT;
+  }
+
   //
   // Create a new URB, insert it into the asynchronous
   // schedule list, then poll the execution status.
@@ -663,6 +686,235 @@ ON_EXIT:
   return Status;
 }
 
+/**
+  Reap the completed buffered output transfers from the event ring.
+
+  Transfer events which do not belong to the output transfer ring are
+  dropped, the same as XhcCheckUrbResult() does for the other rings.
+
+  @param  Xhc             The XHCI Instance.
+
+**/
+VOID
+XhcReapOutTransfers (
+  IN  USB3_DEBUG_PORT_INSTANCE *Xhc
+  )
+{
+  EVT_TRB_TRANSFER        *EvtTrb;
+  EFI_PHYSICAL_ADDRESS    TrbAddress;
+  TRANSFER_RING           *Ring;
+  UINTN                   Index;
+
+  if (Xhc->OutPending == 0) {
+    return;
+  }
+
+  Ring = &Xhc->TransferRingOut;
+  XhcSyncEventRing (Xhc, &Xhc->EventRing);
+
+  for (Index = 0; Index < Xhc->EventRing.TrbNumber; Index++) {
+    if (XhcCheckNewEvent (Xhc, &Xhc->EventRing, ((TRB_TEMPLATE **)&EvtTrb)) == EFI_NOT_READY) {
+      break;
+    }
+    if (EvtTrb->Type != TRB_TYPE_TRANS_EVENT) {
+      continue;
+    }
+
+    TrbAddress = (EFI_PHYSICAL_ADDRESS)(EvtTrb->TRBPtrLo | LShiftU64 ((UINT64) EvtTrb->TRBPtrHi, 32));
+    if ((TrbAddress < Ring->RingSeg0) ||
+        (TrbAddress >= Ring->RingSeg0 + sizeof (TRB_TEMPLATE) * Ring->TrbNumber)) {
+      continue;
+    }
+
+    //
+    // Each output slot is one TRB with IOC set, and the XHC completes the TRBs
+    // of a ring in order, so every event releases the oldest pending slot.
+    //
+    switch (EvtTrb->Completecode) {
+      case TRB_COMPLETION_SUCCESS:
+      case TRB_COMPLETION_SHORT_PACKET:
+        break;
+
+      case TRB_COMPLETION_STALL_ERROR:
+        Xhc->OutResult |= EFI_USB_ERR_STALL;
+        break;
+
+      case TRB_COMPLETION_BABBLE_ERROR:
+        Xhc->OutResult |= EFI_USB_ERR_BABBLE;
+        break;
+
+      case TRB_COMPLETION_DATA_BUFFER_ERROR:
+        Xhc->OutResult |= EFI_USB_ERR_BUFFER;
+        break;
+
+      default:
+        Xhc->OutResult |= EFI_USB_ERR_TIMEOUT;
+        break;
+    }
+
+    if (Xhc->OutPending > 0) {
+      Xhc->OutPending--;
+    }
+  }
+
+  XhcUpdateEventRingDequeue (Xhc);
+}
+
+/**
+  Wait until no more than MaxPending buffered output transfers are owned by XHC.
+
+  @param  Xhc               The XHCI Instance.
+  @param  MaxPending        The number of transfers allowed to stay in flight.
+  @param  Timeout           The time to wait before abort, in millisecond.
+                            0 means infinite timeout.
+
+  @retval EFI_SUCCESS       The pending transfers are completed.
+  @retval EFI_TIMEOUT       The transfers are not completed in time.
+
+**/
+EFI_STATUS
+XhcWaitOutTransfers (
+  IN  USB3_DEBUG_PORT_INSTANCE *Xhc,
+  IN  UINT32                   MaxPending,
+  IN  UINTN                    Timeout
+  )
+{
+  UINTN                   Index;
+  UINTN                   Loop;
+
+  Loop   = (Timeout * XHC_1_MILLISECOND / XHC_POLL_DELAY) + 1;
+  if (Timeout == 0) {
+    Loop = 0xFFFFFFFF;
+  }
+
+  for (Index = 0; Index < Loop; Index++) {
+    XhcReapOutTransfers (Xhc);
+    if (Xhc->OutPending <= MaxPending) {
+      return EFI_SUCCESS;
+    }
+    MicroSecondDelay (XHC_POLL_DELAY);
+  }
+
+  return EFI_TIMEOUT;
+}
+
+/**
+  Copy data into the next output slot and queue a Normal TRB for it.
+  The TRB is picked up by XHC on the next door bell.
+
+  @param  Xhc             The XHCI Instance.
+  @param  Data            The data to send.
+  @param  DataLen         The length of the data, at most XHC_DEBUG_PORT_OUT_SLOT_LENGTH.
+
+**/
+VOID
+XhcQueueOutTransfer (
+  IN  USB3_DEBUG_PORT_INSTANCE *Xhc,
+  IN  UINT8                    *Data,
+  IN  UINTN                    DataLen
+  )
+{
+  TRANSFER_RING           *Ring;
+  TRB                     *Trb;
+  EFI_PHYSICAL_ADDRESS    Slot;
+
+  ASSERT (DataLen <= XHC_DEBUG_PORT_OUT_SLOT_LENGTH);
+  ASSERT (Xhc->OutPending < XHC_DEBUG_PORT_OUT_SLOT_NUMBER);
+
+  Slot = Xhc->OutData + Xhc->OutHead * XHC_DEBUG_PORT_OUT_SLOT_LENGTH;
+  CopyMem ((VOID *)(UINTN) Slot, Data, DataLen);
+
+  Ring = &Xhc->TransferRingOut;
+  XhcSyncTrsRing (Xhc, Ring);
+
+  Trb = (TRB *)(UINTN) Ring->RingEnqueue;
+  Trb->TrbNormal.TRBPtrLo  = XHC_LOW_32BIT (Slot);
+  Trb->TrbNormal.TRBPtrHi  = XHC_HIGH_32BIT (Slot);
+  Trb->TrbNormal.Length    = (UINT32) DataLen;
+  Trb->TrbNormal.TDSize    = 0;
+  Trb->TrbNormal.IntTarget = 0;
+  Trb->TrbNormal.ISP       = 1;
+  Trb->TrbNormal.IOC       = 1;
+  Trb->TrbNormal.Type      = TRB_TYPE_NORMAL;
+
+  //
+  // XHC may still be processing earlier TRBs of the ring, hand the TRB over
+  // by the cycle bit only after the rest of it is written.
+  //
+  MemoryFence ();
+  Trb->TrbNormal.CycleBit = Ring->RingPCS & BIT0;
+
+  XhcSyncTrsRing (Xhc, Ring);
+
+  Xhc->OutHead = (Xhc->OutHead + 1) % XHC_DEBUG_PORT_OUT_SLOT_NUMBER;
+  Xhc->OutPending++;
+}
+
+/**
+  Send data through the buffered output pipeline.
+
+  The data is copied into output slots and sent without waiting for the
+  transfers to complete. It only blocks when all slots are in flight.
+
+  @param  Xhc             The XHCI Instance.
+  @param  Data            The data to send.
+  @param  Length          On input, the length of the data. On output, the
+                          length of the data which is not queued.
+
+**/
+VOID
+XhcBufferedDataOut (
+  IN     USB3_DEBUG_PORT_INSTANCE *Xhc,
+  IN     UINT8                    *Data,
+  IN OUT UINTN                    *Length
+  )
+{
+  UINTN                   BytesToSend;
+  BOOLEAN                 Queued;
+
+  //
+  // Reap the transfers completed since the previous write
+  //
+  XhcReapOutTransfers (Xhc);
+
+  Queued = FALSE;
+  while (*Length > 0) {
+    if (Xhc->OutPending == XHC_DEBUG_PORT_OUT_SLOT_NUMBER) {
+      //
+      // All slots are in flight, kick the queued ones and wait for the oldest
+      //
+      if (Queued) {
+        XhcWriteDebugReg (Xhc, XHC_DC_DCDB, 0);
+        Queued = FALSE;
+      }
+      if (EFI_ERROR (XhcWaitOutTransfers (Xhc, XHC_DEBUG_PORT_OUT_SLOT_NUMBER - 1, DATA_TRANSFER_TIME_OUT))) {
+        break;
+      }
+    }
+    if (Xhc->OutResult != EFI_USB_NOERROR) {
+      //
+      // Report the failure by leaving the rest of the data unsent, as the
+      // synchronous path does.
+      //
+      Xhc->OutResult = EFI_USB_NOERROR;
+      break;
+    }
+
+    BytesToSend = ((*Length) > XHC_DEBUG_PORT_OUT_SLOT_LENGTH) ? XHC_DEBUG_PORT_OUT_SLOT_LENGTH : *Length;
+    XhcQueueOutTransfer (Xhc, Data, BytesToSend);
+    Queued = TRUE;
+    *Length -= BytesToSend;
+    Data += BytesToSend;
+  }
+
+  if (Queued) {
+    //
+    // 7.6.8.2 DCDB Register, target 0 for the OUT endpoint
+    //
+    XhcWriteDebugReg (Xhc, XHC_DC_DCDB, 0);
+  }
+}
+
 /**
   Check whether the MMIO Bar is within any of the SMRAM ranges.
 
@@ -832,6 +1084,13 @@ Usb3DebugPortDataTransfer (
     }
   }
 
+  if ((Direction == EfiUsbDataOut) &&
+      FeaturePcdGet (PcdUsb3DebugBufferedOutput) &&
+      (Instance->OutData != 0)) {
+    XhcBufferedDataOut (Instance, Data, Length);
+    goto Done;
+  }
+
   BytesToSend = 0;
   while (*Length > 0) {
     BytesToSend = ((*Length) > XHC_DEBUG_PORT_DATA_LENGTH) ? XHC_DEBUG_PORT_DATA_LENGTH : *Length;
@@ -851,6 +1110,17 @@ Usb3DebugPortDataTransfer (
   }
 
 Done:
+  //
+  // The buffered output leaves TRBs in flight when it returns. If memory space
+  // or bus master was enabled above only for this transfer, drain them before
+  // the Command Register is restored, or XHC would lose access to the rings
+  // and the output slots.
+  //
+  if ((Instance != NULL) && (Instance->OutPending != 0) &&
+      (((Command & EFI_PCI_COMMAND_MEMORY_SPACE) == 0) || ((Command & EFI_PCI_COMMAND_BUS_MASTER) == 0))) {
+    XhcWaitOutTransfers (Instance, 0, DATA_TRANSFER_TIME_OUT);
+  }
+
   //
   // Restore Command Register
   //
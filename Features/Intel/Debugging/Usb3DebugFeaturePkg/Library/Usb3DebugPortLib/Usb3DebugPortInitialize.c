@@ -593,6 +593,16 @@ InitializeUsb3DebugPort (
   //
   Instance->Urb.Data = (EFI_PHYSICAL_ADDRESS) (UINTN) AllocateAlignBuffer (XHC_DEBUG_PORT_DATA_LENGTH);
 
+  //
+  // Init buffered output, the synchronous path is used if it is not available
+  //
+  if (FeaturePcdGet (PcdUsb3DebugBufferedOutput)) {
+    Instance->OutData = (EFI_PHYSICAL_ADDRESS) (UINTN) AllocateAlignBuffer (XHC_DEBUG_PORT_OUT_BUFFER_LENGTH);
+  }
+  Instance->OutHead    = 0;
+  Instance->OutPending = 0;
+  Instance->OutResult  = EFI_USB_NOERROR;
+
   //
   // Init DCDDI1 and DCDDI2
   //
@@ -146,6 +146,14 @@ Usb3MapDmaBuffers (
     XHC_DEBUG_PORT_DATA_LENGTH
     );
 
+  if (Instance->OutData != 0) {
+    Usb3MapOneDmaBuffer (
+      PciIo,
+      Instance->OutData,
+      XHC_DEBUG_PORT_OUT_BUFFER_LENGTH
+      );
+  }
+
   Usb3MapOneDmaBuffer (
     PciIo,
     Instance->TransferRingIn.RingSeg0,
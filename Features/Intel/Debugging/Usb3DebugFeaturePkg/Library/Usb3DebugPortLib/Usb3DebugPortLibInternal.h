@@ -61,6 +61,15 @@
 //
 #define XHC_DEBUG_PORT_DATA_LENGTH   8
 
+//
+// Buffered output: a write is copied into slots of the output buffer, each
+// slot is sent by one Normal TRB. Up to XHC_DEBUG_PORT_OUT_SLOT_NUMBER TRBs
+// are in flight, completions are reaped on the next write.
+//
+#define XHC_DEBUG_PORT_OUT_SLOT_LENGTH   0x200
+#define XHC_DEBUG_PORT_OUT_SLOT_NUMBER   16
+#define XHC_DEBUG_PORT_OUT_BUFFER_LENGTH (XHC_DEBUG_PORT_OUT_SLOT_LENGTH * XHC_DEBUG_PORT_OUT_SLOT_NUMBER)
+
 //
 // Indicate the timeout when data is transferred. 0 means infinite timeout.
 //
@@ -509,6 +518,26 @@ typedef struct _USB3_DEBUG_PORT_INSTANCE {
   // URB
   //
   URB                                     Urb;
+
+  //
+  // Buffered output data, XHC_DEBUG_PORT_OUT_BUFFER_LENGTH bytes
+  //
+  EFI_PHYSICAL_ADDRESS                    OutData;
+
+  //
+  // Next output slot to fill
+  //
+  UINT32                                  OutHead;
+
+  //
+  // Number of output slots owned by XHC
+  //
+  UINT32                                  OutPending;
+
+  //
+  // Accumulated result of the reaped output transfers
+  //
+  UINT32                                  OutResult;
 } USB3_DEBUG_PORT_INSTANCE;
 
 #pragma pack()
@@ -884,4 +913,23 @@ XhcDataTransfer (
   OUT    UINT32                              *TransferResult
   );
 
+/**
+  Wait until no more than MaxPending buffered output transfers are owned by XHC.
+
+  @param  Xhc               The XHCI Instance.
+  @param  MaxPending        The number of transfers allowed to stay in flight.
+  @param  Timeout           The time to wait before abort, in millisecond.
+                            0 means infinite timeout.
+
+  @retval EFI_SUCCESS       The pending transfers are completed.
+  @retval EFI_TIMEOUT       The transfers are not completed in time.
+
+**/
+EFI_STATUS
+XhcWaitOutTransfers (
+  IN  USB3_DEBUG_PORT_INSTANCE *Xhc,
+  IN  UINT32                   MaxPending,
+  IN  UINTN                    Timeout
+  );
+
 #endif //__SERIAL_PORT_LIB_USB__
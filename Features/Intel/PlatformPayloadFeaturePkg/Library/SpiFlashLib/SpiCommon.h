@@ -20,6 +20,7 @@
 #include <Library/BaseLib.h>
 #include <Library/HobLib.h>
 #include <Library/TimerLib.h>
+#include <Library/CacheMaintenanceLib.h>
 #include <Guid/SpiFlashInfoGuid.h>
 #include "RegsSpi.h"
 
@@ -31,6 +32,28 @@
 #define WAIT_TIME    6000000    ///< Wait Time = 6 seconds = 6000000 microseconds
 #define WAIT_PERIOD  10         ///< Wait Period = 10 microseconds
 
+///
+/// Maximum number of data bytes transferred by one hardware sequencing cycle (FDATA0 - FDATA15)
+///
+#define SPI_MAX_CYCLE_DATA_SIZE  64
+
+///
+/// Flash page program size. A write cycle must not cross a page boundary,
+/// otherwise the flash part wraps around to the start of the page.
+///
+#define SPI_PAGE_PROGRAM_SIZE  0x100
+
+///
+/// The PCH never lets a hardware sequencing cycle cross a 4KB boundary.
+///
+#define SPI_CYCLE_BOUNDARY_SIZE  SIZE_4KB
+
+///
+/// Size of the BIOS region window decoded by the PCH right below 4GB.
+/// The last SPI_BIOS_MMIO_WINDOW_SIZE bytes of the BIOS region are visible there.
+///
+#define SPI_BIOS_MMIO_WINDOW_SIZE  SIZE_16MB
+
 ///
 /// Flash cycle Type
 ///
@@ -59,18 +82,32 @@ typedef enum {
 ///
 #define SC_SPI_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('P', 'S', 'P', 'I')
 
+///
+/// Accumulated cost of one kind of flash access, reported at DEBUG_VERBOSE level
+///
+typedef struct {
+  UINT64    Operations;     ///< Number of library calls
+  UINT64    Cycles;         ///< Number of hardware sequencing cycles, 0 for memory-mapped reads
+  UINT64    Bytes;          ///< Number of bytes transferred
+  UINT64    Ticks;          ///< Performance counter ticks spent
+} SPI_FLASH_STATISTICS;
+
 typedef struct {
-  UINTN         Signature;
-  EFI_HANDLE    Handle;
-  UINT32        AcpiTmrReg;
-  UINTN         PchSpiBase;
-  UINT16        RegionPermission;
-  UINT32        SfdpVscc0Value;
-  UINT32        SfdpVscc1Value;
-  UINT32        StrapBaseAddress;
-  UINT8         NumberOfComponents;
-  UINT16        Flags;
-  UINT32        Component1StartAddr;
+  UINTN                   Signature;
+  EFI_HANDLE              Handle;
+  UINT32                  AcpiTmrReg;
+  UINTN                   PchSpiBase;
+  UINT16                  RegionPermission;
+  UINT32                  SfdpVscc0Value;
+  UINT32                  SfdpVscc1Value;
+  UINT32                  StrapBaseAddress;
+  UINT8                   NumberOfComponents;
+  UINT16                  Flags;
+  UINT32                  Component1StartAddr;
+  UINT32                  BiosRegionSize;
+  UINT32                  BiosMmioStartAddr;
+  SPI_FLASH_STATISTICS    MappedReadStatistics;
+  SPI_FLASH_STATISTICS    CycleStatistics[FlashCycleMax];
 } SPI_INSTANCE;
 
 /**
@@ -184,6 +221,41 @@ SendSpiCmd (
   IN OUT UINT8              *Buffer
   );
 
+/**
+  Account one flash operation and report the running totals.
+
+  @param[in] Name                 Name of the operation, used in the debug output
+  @param[in,out] Statistics       Statistics to be updated
+  @param[in] Cycles               Number of hardware sequencing cycles issued
+  @param[in] Bytes                Number of bytes transferred
+  @param[in] StartTicks           Performance counter value when the operation started
+**/
+VOID
+SpiRecordStatistics (
+  IN     CONST CHAR8           *Name,
+  IN OUT SPI_FLASH_STATISTICS  *Statistics,
+  IN     UINT32                Cycles,
+  IN     UINT32                Bytes,
+  IN     UINT64                StartTicks
+  );
+
+/**
+  Get the memory-mapped address of a BIOS region range.
+
+  @param[in] SpiInstance          SPI instance
+  @param[in] Address              Offset inside the BIOS region
+  @param[in] ByteCount            Number of bytes in the range
+
+  @retval NULL                    The range is not (completely) decoded in the memory-mapped window.
+  @retval Others                  Host address of the first byte of the range.
+**/
+VOID *
+SpiGetBiosMmioAddress (
+  IN     SPI_INSTANCE  *SpiInstance,
+  IN     UINT32        Address,
+  IN     UINT32        ByteCount
+  );
+
 /**
   Wait execution cycle to complete on the SPI interface.
 
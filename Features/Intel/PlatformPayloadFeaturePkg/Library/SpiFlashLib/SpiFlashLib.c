@@ -9,6 +9,16 @@
 
 SPI_INSTANCE  *mSpiInstance = NULL;
 
+GLOBAL_REMOVE_IF_UNREFERENCED CONST CHAR8  *mSpiCycleName[FlashCycleMax] = {
+  "read",
+  "write",
+  "erase",
+  "SFDP read",
+  "JEDEC ID read",
+  "status write",
+  "status read"
+};
+
 /**
   Get SPI Instance from library global data..
 
@@ -147,9 +157,89 @@ SpiConstructor (
   //
   SpiInstance->StrapBaseAddress &= B_SPI_FDBAR_FPSBA;
 
+  //
+  // Cache the part of the BIOS region which is decoded right below 4GB,
+  // reads falling into it are served from the memory-mapped window.
+  //
+  if (EFI_ERROR (SpiGetRegionAddress (FlashRegionBios, NULL, &SpiInstance->BiosRegionSize))) {
+    SpiInstance->BiosRegionSize = 0;
+  }
+
+  SpiInstance->BiosMmioStartAddr = 0;
+  if (SpiInstance->BiosRegionSize > SPI_BIOS_MMIO_WINDOW_SIZE) {
+    SpiInstance->BiosMmioStartAddr = SpiInstance->BiosRegionSize - SPI_BIOS_MMIO_WINDOW_SIZE;
+  }
+
+  DEBUG ((DEBUG_INFO, "BIOS region size 0x%x, mapped from offset 0x%x\n", SpiInstance->BiosRegionSize, SpiInstance->BiosMmioStartAddr));
+
   return EFI_SUCCESS;
 }
 
+/**
+  Account one flash operation and report the running totals.
+
+  @param[in] Name                 Name of the operation, used in the debug output
+  @param[in,out] Statistics       Statistics to be updated
+  @param[in] Cycles               Number of hardware sequencing cycles issued
+  @param[in] Bytes                Number of bytes transferred
+  @param[in] StartTicks           Performance counter value when the operation started
+**/
+VOID
+SpiRecordStatistics (
+  IN     CONST CHAR8           *Name,
+  IN OUT SPI_FLASH_STATISTICS  *Statistics,
+  IN     UINT32                Cycles,
+  IN     UINT32                Bytes,
+  IN     UINT64                StartTicks
+  )
+{
+  UINT64  Nanoseconds;
+
+  Statistics->Operations++;
+  Statistics->Cycles += Cycles;
+  Statistics->Bytes  += Bytes;
+  Statistics->Ticks  += GetPerformanceCounter () - StartTicks;
+
+  Nanoseconds = GetTimeInNanoSecond (Statistics->Ticks);
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "SpiFlash %a: %ld ops, %ld cycles, %ld bytes, %ld bytes/s\n",
+    Name,
+    Statistics->Operations,
+    Statistics->Cycles,
+    Statistics->Bytes,
+    (Nanoseconds == 0) ? 0 : DivU64x64Remainder (MultU64x32 (Statistics->Bytes, 1000000000), Nanoseconds, NULL)
+    ));
+}
+
+/**
+  Get the memory-mapped address of a BIOS region range.
+
+  @param[in] SpiInstance          SPI instance
+  @param[in] Address              Offset inside the BIOS region
+  @param[in] ByteCount            Number of bytes in the range
+
+  @retval NULL                    The range is not (completely) decoded in the memory-mapped window.
+  @retval Others                  Host address of the first byte of the range.
+**/
+VOID *
+SpiGetBiosMmioAddress (
+  IN     SPI_INSTANCE  *SpiInstance,
+  IN     UINT32        Address,
+  IN     UINT32        ByteCount
+  )
+{
+  if ((SpiInstance->BiosRegionSize == 0) ||
+      (Address < SpiInstance->BiosMmioStartAddr) ||
+      (Address >= SpiInstance->BiosRegionSize) ||
+      (ByteCount > SpiInstance->BiosRegionSize - Address))
+  {
+    return NULL;
+  }
+
+  return (VOID *)(UINTN)(BASE_4GB - SpiInstance->BiosRegionSize + Address);
+}
+
 /**
   Read data from the flash part.
 
@@ -172,7 +262,32 @@ SpiFlashRead (
   OUT    UINT8              *Buffer
   )
 {
-  EFI_STATUS  Status;
+  EFI_STATUS    Status;
+  SPI_INSTANCE  *SpiInstance;
+  VOID          *MappedAddress;
+  UINT64        StartTicks;
+
+  SpiInstance = GetSpiInstance ();
+  if (SpiInstance == NULL) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  //
+  // The BIOS region is decoded below 4GB, so a read is a plain memory copy
+  // instead of a series of 64 byte hardware sequencing cycles. The SPI prefetch
+  // buffer and CPU caches serve it in cache line sized chunks.
+  //
+  if ((FlashRegionType == FlashRegionBios) &&
+      ((SpiInstance->RegionPermission & B_SPI_FRAP_BRRA_BIOS) != 0))
+  {
+    MappedAddress = SpiGetBiosMmioAddress (SpiInstance, Address, ByteCount);
+    if (MappedAddress != NULL) {
+      StartTicks = GetPerformanceCounter ();
+      CopyMem (Buffer, MappedAddress, ByteCount);
+      SpiRecordStatistics ("mapped read", &SpiInstance->MappedReadStatistics, 0, ByteCount, StartTicks);
+      return EFI_SUCCESS;
+    }
+  }
 
   Status = SendSpiCmd (FlashRegionType, FlashCycleRead, Address, ByteCount, Buffer);
   return Status;
@@ -436,12 +551,20 @@ SendSpiCmd (
   UINT8         BiosCtlSave;
   SPI_INSTANCE  *SpiInstance;
   UINT32        Data32;
+  UINT32        Boundary;
+  UINT32        Cycles;
+  UINT32        TotalByteCount;
+  UINT64        StartTicks;
+  VOID          *MappedAddress;
 
   SpiInstance = GetSpiInstance ();
   if (SpiInstance == NULL) {
     return EFI_DEVICE_ERROR;
   }
 
+  StartTicks                    = GetPerformanceCounter ();
+  Cycles                        = 0;
+  TotalByteCount                = ByteCount;
   Status                        = EFI_SUCCESS;
   SpiBaseAddress                = SpiInstance->PchSpiBase;
   ScSpiBar0                     = AcquireSpiBar0 (SpiBaseAddress);
@@ -616,14 +739,19 @@ SendSpiCmd (
     SpiDataCount = ByteCount;
     if ((FlashCycleType == FlashCycleRead) || (FlashCycleType == FlashCycleWrite)) {
       //
-      // Trim at 256 byte boundary per operation,
-      // - SC SPI controller requires trimming at 4KB boundary
-      // - Some SPI chips require trimming at 256 byte boundary for write operation
-      // - Trimming has limited performance impact as we can read / write at most 64 byte
-      //   per operation
+      // Trim at a boundary per operation,
+      // - SC SPI controller requires trimming at 4KB boundary, which is all a read needs
+      // - SPI chips require trimming at the 256 byte page boundary for write operation,
+      //   so every write cycle after the first one starts page aligned
       //
-      if (HardwareSpiAddr + ByteCount > ((HardwareSpiAddr + BIT8) &~(BIT8 - 1))) {
-        SpiDataCount = (((UINT32)(HardwareSpiAddr) + BIT8) &~(BIT8 - 1)) - (UINT32)(HardwareSpiAddr);
+      if (FlashCycleType == FlashCycleWrite) {
+        Boundary = SPI_PAGE_PROGRAM_SIZE;
+      } else {
+        Boundary = SPI_CYCLE_BOUNDARY_SIZE;
+      }
+
+      if (HardwareSpiAddr + ByteCount > ((HardwareSpiAddr + Boundary) &~(Boundary - 1))) {
+        SpiDataCount = (((UINT32)(HardwareSpiAddr) + Boundary) &~(Boundary - 1)) - (UINT32)(HardwareSpiAddr);
       }
 
       //
@@ -631,8 +759,8 @@ SendSpiCmd (
       // Valid settings for the number of bytes during each data portion of the
       // SC SPI cycles are: 0, 1, 2, 3, 4, 5, 6, 7, 8, 16, 24, 32, 40, 48, 56, 64
       //
-      if (SpiDataCount >= 64) {
-        SpiDataCount = 64;
+      if (SpiDataCount >= SPI_MAX_CYCLE_DATA_SIZE) {
+        SpiDataCount = SPI_MAX_CYCLE_DATA_SIZE;
       } else if ((SpiDataCount &~0x07) != 0) {
         SpiDataCount = SpiDataCount &~0x07;
       }
@@ -711,6 +839,7 @@ SendSpiCmd (
     //
     // Wait for command execution complete.
     //
+    Cycles++;
     if (!WaitForSpiCycleComplete (ScSpiBar0, TRUE)) {
       Status = EFI_DEVICE_ERROR;
       goto SendSpiCmdEnd;
@@ -753,10 +882,31 @@ SendSpiCmdEnd:
   if ((FlashCycleType == FlashCycleWrite) || (FlashCycleType == FlashCycleErase)) {
     EnableBiosWriteProtect (SpiBaseAddress, mSpiInstance->Flags & FLAGS_SPI_DISABLE_SMM_WRITE_PROTECT);
     SetSpiBiosControlRegister (SpiBaseAddress, BiosCtlSave);
+
+    //
+    // Drop stale copies of the modified range from the CPU caches so that
+    // the next memory-mapped read sees the new flash content.
+    //
+    if (FlashRegionType == FlashRegionBios) {
+      MappedAddress = SpiGetBiosMmioAddress (SpiInstance, Address, TotalByteCount);
+      if (MappedAddress != NULL) {
+        InvalidateDataCacheRange (MappedAddress, TotalByteCount);
+      }
+    }
   }
 
   ReleaseSpiBar0 (SpiBaseAddress);
 
+  if (FlashCycleType < FlashCycleMax) {
+    SpiRecordStatistics (
+      mSpiCycleName[FlashCycleType],
+      &SpiInstance->CycleStatistics[FlashCycleType],
+      Cycles,
+      TotalByteCount - ByteCount,
+      StartTicks
+      );
+  }
+
   return Status;
 }
 
@@ -102,6 +102,10 @@ SmmSwDispatcher (
   EFI_SMM_SW_REGISTER_CONTEXT   DispatchContext;
   UINTN                         Size;
   EFI_SMM_SAVE_STATE_IO_INFO    IoInfo;
+  UINT64                        RootEntryTsc;
+  UINT64                        EntryTsc;
+
+  RootEntryTsc = SmiLatencyProfileBegin ();
 
   //
   // Construct new context
@@ -159,7 +163,9 @@ SmmSwDispatcher (
   DispatchContext.SwSmiInputValue = SwContext.CommandPort;
   Size                            = sizeof (SwContext);
   DispatchFunction                = (EFI_SMM_HANDLER_ENTRY_POINT2)Context->DispatchFunction;
+  EntryTsc                        = SmiLatencyProfileBegin ();
   Status                          = DispatchFunction (DispatchHandle, &DispatchContext, &SwContext, &Size);
+  SmiLatencyProfileEnd (PCH_SMI_DISPATCH_SOURCE_SW, (UINT64)(UINTN)DispatchFunction, EntryTsc);
 
 End:
   //
@@ -172,6 +178,8 @@ End:
   //
   IoOr32 (mSmiPchReg.SmiEosAddr, 1 << mSmiPchReg.EosBitOffset);
 
+  SmiLatencyProfileEnd (SMI_LATENCY_PROFILE_SOURCE_ROOT, (UINT64)(UINTN)SmmSwDispatcher, RootEntryTsc);
+
   return Status;
 }
 
@@ -19,6 +19,7 @@
 #include <Library/DebugLib.h>
 #include <Guid/SmmRegisterInfoGuid.h>
 #include <Library/HobLib.h>
+#include <Library/SmiLatencyProfileLib.h>
 
 #define SMI_SW_HANDLER_SIGNATURE  SIGNATURE_32('s','s','w','h')
 #define MAXIMUM_SWI_VALUE         0xFF
@@ -57,7 +57,10 @@ AmlBuffer (
   AML_OBJECT_INSTANCE  *Object;
   AML_OBJECT_INSTANCE  *ChildObject;
   UINTN                ChildCount;
+  UINTN                ChildDataSize;
   UINTN                InternalBufferSize;
+  UINT8                *EncodedData;
+  UINTN                EncodedDataSize;
 
   Status      = EFI_DEVICE_ERROR;
   Object      = NULL;
@@ -78,7 +81,7 @@ AmlBuffer (
   switch (Phase) {
     case AmlStart:
       // Start the Buffer Object
-      Status = InternalAppendNewAmlObject (&Object, "BUFFER", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "BUFFER", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BUFFER object\n", __func__));
         goto Done;
@@ -92,7 +95,12 @@ AmlBuffer (
       }
 
       // Start BufferSize
-      Status = InternalAppendNewAmlObject (&Object, "BUFFERSIZE", ListHead);
+      Status = InternalAppendNewAmlObject (
+                 &Object,
+                 "BUFFERSIZE",
+                 MAX_AML_DATA_INTEGER_ENCODING_SIZE,
+                 ListHead
+                 );
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BUFFERSIZE object\n", __func__));
         goto Done;
@@ -115,24 +123,11 @@ AmlBuffer (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
-                 &ChildCount,
-                 &Object->Link,
-                 ListHead
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect BufferSize children\n", __func__));
-        goto Done;
-      }
-
       // Set BufferSize Object to correct value and size.
       // BufferSize should be from zero (no Child Data) to MAX of requested
-      // BufferSize or size required for ChildObject->Data.
-      InternalBufferSize = MAX (BufferSize, ChildObject->DataSize);
+      // BufferSize or size required for the ByteList.
+      ChildDataSize      = InternalAmlChildrenDataSize (NULL, &Object->Link, ListHead);
+      InternalBufferSize = MAX (BufferSize, ChildDataSize);
       // iASL compiler 20200110 only keeps lower 32 bits of size.  We'll error if
       // someone requests something >= 4GB size.
       if (InternalBufferSize >= SIZE_4GB) {
@@ -148,38 +143,31 @@ AmlBuffer (
 
       Status = InternalAmlDataIntegerBuffer (
                  InternalBufferSize,
-                 (VOID **)&Object->Data,
-                 &Object->DataSize
+                 (VOID **)&EncodedData,
+                 &EncodedDataSize
                  );
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: calc BufferSize\n", __func__));
         goto Done;
       }
 
-      if ((ChildObject->DataSize != 0) && (ChildObject->Data != NULL)) {
-        // Make room for ChildObject->Data
-        Object->Data = ReallocatePool (
-                         Object->DataSize,
-                         Object->DataSize +
-                         ChildObject->DataSize,
-                         Object->Data
-                         );
-        if (Object->Data == NULL) {
-          DEBUG ((DEBUG_ERROR, "%a: ERROR: to reallocate BufferSize\n", __func__));
-          Status = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
+      // Collect child data behind the encoded BufferSize and delete children
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 EncodedDataSize,
+                 &ChildCount,
+                 ListHead
+                 );
+      if (!EFI_ERROR (Status)) {
+        CopyMem (Object->Data, EncodedData, EncodedDataSize);
+      }
 
-        CopyMem (
-          &Object->Data[Object->DataSize],
-          ChildObject->Data,
-          ChildObject->DataSize
-          );
-        Object->DataSize += ChildObject->DataSize;
+      FreePool (EncodedData);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect BufferSize children\n", __func__));
+        goto Done;
       }
 
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       // Close required PkgLength before finishing Object
@@ -196,42 +184,19 @@ AmlBuffer (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      //  BufferOp is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-
-      // Buffer must have at least PkgLength BufferSize
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: No Buffer Data\n", __func__));
         goto Done;
       }
 
-      //  BufferOp is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Buffer allocate failed\n", __func__));
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Done;
-      }
-
       Object->Data[0] = AML_BUFFER_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -290,7 +255,7 @@ AmlLEqual (
   switch (Phase) {
     case AmlStart:
       // Start the LEqual Object
-      Status = InternalAppendNewAmlObject (&Object, "LEQUAL", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "LEQUAL", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start LEQUAL object\n", __func__));
         goto Done;
@@ -312,42 +277,19 @@ AmlLEqual (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      //  LequalOp is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-
-      // LEqual must have at least two operands
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: No LEqual Args\n", __func__));
         goto Done;
       }
 
-      //  LequalOp is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Buffer allocate failed\n", __func__));
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Done;
-      }
-
       Object->Data[0] = AML_LEQUAL_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -399,6 +341,8 @@ InternalAmlNumElements (
   AML_OBJECT_INSTANCE  *Object;
   AML_OBJECT_INSTANCE  *ChildObject;
   UINTN                ChildCount;
+  UINT8                *EncodedData;
+  UINTN                EncodedDataSize;
 
   Status      = EFI_DEVICE_ERROR;
   Object      = NULL;
@@ -412,7 +356,9 @@ InternalAmlNumElements (
   switch (Phase) {
     case AmlStart:
       // Start Number of Elements Object
-      Status = InternalAppendNewAmlObject (&Object, "NUM_ELEMENTS", ListHead);
+      // Room for the ByteData NumElements of a Package, a VarPackage with
+      // more elements makes room when it closes
+      Status = InternalAppendNewAmlObject (&Object, "NUM_ELEMENTS", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start NUM_ELEMENTS object\n", __func__));
         goto Done;
@@ -435,19 +381,7 @@ InternalAmlNumElements (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
-                 &ChildCount,
-                 &Object->Link,
-                 ListHead
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect NUM_ELEMENTS children\n", __func__));
-        goto Done;
-      }
+      InternalAmlChildrenDataSize (&ChildCount, &Object->Link, ListHead);
 
       // We do not have to change anything for NumElements >= Child Count
       if (*NumElements == 0) {
@@ -459,20 +393,20 @@ InternalAmlNumElements (
       }
 
       if (*NumElements <= MAX_UINT8) {
-        Object->DataSize = 1;
-        Object->Data     = AllocateZeroPool (Object->DataSize);
-        if (Object->Data == NULL) {
+        EncodedDataSize = 1;
+        EncodedData     = AllocateZeroPool (EncodedDataSize);
+        if (EncodedData == NULL) {
           DEBUG ((DEBUG_ERROR, "%a: ERROR: NumElements allocate failed\n", __func__));
           Status = EFI_OUT_OF_RESOURCES;
           goto Done;
         }
 
-        Object->Data[0] = (UINT8)*NumElements;
+        EncodedData[0] = (UINT8)*NumElements;
       } else {
         Status = InternalAmlDataIntegerBuffer (
                    *NumElements,
-                   (VOID **)&Object->Data,
-                   &Object->DataSize
+                   (VOID **)&EncodedData,
+                   &EncodedDataSize
                    );
         if (EFI_ERROR (Status)) {
           DEBUG ((DEBUG_ERROR, "%a: ERROR: calc NumElements\n", __func__));
@@ -480,30 +414,23 @@ InternalAmlNumElements (
         }
       }
 
-      if ((ChildObject->DataSize != 0) && (ChildObject->Data != NULL)) {
-        // Make room for ChildObject->Data
-        Object->Data = ReallocatePool (
-                         Object->DataSize,
-                         Object->DataSize +
-                         ChildObject->DataSize,
-                         Object->Data
-                         );
-        if (Object->Data == NULL) {
-          DEBUG ((DEBUG_ERROR, "%a: ERROR: to reallocate NumElements\n", __func__));
-          Status = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
+      // Collect child data behind the encoded NumElements and delete children
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 EncodedDataSize,
+                 &ChildCount,
+                 ListHead
+                 );
+      if (!EFI_ERROR (Status)) {
+        CopyMem (Object->Data, EncodedData, EncodedDataSize);
+      }
 
-        CopyMem (
-          &Object->Data[Object->DataSize],
-          ChildObject->Data,
-          ChildObject->DataSize
-          );
-        Object->DataSize += ChildObject->DataSize;
+      FreePool (EncodedData);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect NUM_ELEMENTS children\n", __func__));
+        goto Done;
       }
 
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -571,7 +498,7 @@ AmlPackage (
   switch (Phase) {
     case AmlStart:
       // Start the Package Object
-      Status = InternalAppendNewAmlObject (&Object, "PACKAGE", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "PACKAGE", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start PACKAGE object\n", __func__));
         goto Done;
@@ -624,41 +551,19 @@ AmlPackage (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      //  PackageOp and VarPackageOp are both one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      // Package must have at least PkgLength NumElements
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: No Package Data\n", __func__));
         goto Done;
       }
 
-      //  PackageOp and VarPackageOp are both one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Package allocate failed\n", __func__));
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Done;
-      }
-
       Object->Data[0] = OpCode;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -719,7 +624,7 @@ AmlStore (
   switch (Phase) {
     case AmlStart:
       // Start Store expression
-      Status = InternalAppendNewAmlObject (&Object, "STORE", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "STORE", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append STORE object\n", __func__));
         goto Done;
@@ -738,42 +643,23 @@ AmlStore (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Store Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __func__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
         goto Done;
       }
 
-      // Store Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Store object
       Object->Data[0] = AML_STORE_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -844,7 +730,7 @@ InternalAmlShift (
   switch (Phase) {
     case AmlStart:
       // Start Store expression
-      Status = InternalAppendNewAmlObject (&Object, "SHIFT", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "SHIFT", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append SHIFT object\n", __func__));
         goto Done;
@@ -864,42 +750,23 @@ InternalAmlShift (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Shift Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __func__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
         goto Done;
       }
 
-      // Store Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Store object
       Object->Data[0] = ShiftOp;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1037,7 +904,7 @@ InternalAmlFindSetBit (
   switch (Phase) {
     case AmlStart:
       // Start Store expression
-      Status = InternalAppendNewAmlObject (&Object, "FINDSET", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "FINDSET", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append FIND_SET object\n", __func__));
         goto Done;
@@ -1057,42 +924,23 @@ InternalAmlFindSetBit (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // FindSetBit Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __func__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
         goto Done;
       }
 
-      // Store Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Store object
       Object->Data[0] = FindSetOp;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1218,7 +1066,7 @@ AmlDecrement (
   switch (Phase) {
     case AmlStart:
       // Start decrement expression
-      Status = InternalAppendNewAmlObject (&Object, "DECREMENT", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "DECREMENT", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append DECREMENT object\n", __func__));
         goto Done;
@@ -1238,42 +1086,23 @@ AmlDecrement (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Decrement Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __func__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __func__));
         goto Done;
       }
 
-      // Decrement Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Decrement object
       Object->Data[0] = AML_DECREMENT_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -280,6 +280,7 @@ AmlOPNameString (
   UINTN                NameStringBufferSize;
   UINTN                NameStringSize;
   UINTN                NameStringPrefixSize;
+  UINTN                SegPrefixSize;
   UINTN                NameSegCount;
   UINTN                StringIndex;
   UINTN                StringLength;
@@ -296,6 +297,7 @@ AmlOPNameString (
   Status                    = EFI_DEVICE_ERROR;
   Object                    = NULL;
   NameString                = NULL;
+  NameStringPrefix          = NULL;
   FoundRootChar             = FALSE;
   FoundParentPrefixChar     = FALSE;
   NameStringBufferSize      = 0;
@@ -504,23 +506,6 @@ AmlOPNameString (
     }
   }
 
-  // Create AML Record with NameString contents from above
-  // Copy in RootChar or ParentPrefixChar(s)
-  if (NameStringPrefixSize != 0) {
-    Object->Data = ReallocatePool (
-                     Object->DataSize,
-                     NameStringPrefixSize,
-                     Object->Data
-                     );
-    CopyMem (
-      &Object->Data[Object->DataSize],
-      NameStringPrefix,
-      NameStringPrefixSize
-      );
-    Object->DataSize += NameStringPrefixSize;
-    FreePool (NameStringPrefix);
-  }
-
   // Set up for Dual/MultiName Prefix
   if (NameSegCount > MAX_NAME_SEG_COUNT) {
     Status = EFI_INVALID_PARAMETER;
@@ -532,34 +517,41 @@ AmlOPNameString (
     goto Done;
   } else if (NameSegCount == 1) {
     // Single NameSeg
-    Object->Data = ReallocatePool (
-                     Object->DataSize,
-                     Object->DataSize + NameStringSize,
-                     Object->Data
-                     );
+    SegPrefixSize = 0;
   } else if (NameSegCount == 2) {
-    Object->Data = ReallocatePool (
-                     Object->DataSize,
-                     Object->DataSize + NameStringSize + 1,
-                     Object->Data
-                     );
-    Object->Data[Object->DataSize] = AML_DUAL_NAME_PREFIX;
-    Object->DataSize              += 1;
+    SegPrefixSize = 1;
   } else {
-    Object->Data = ReallocatePool (
-                     Object->DataSize,
-                     Object->DataSize + NameStringSize + 2,
-                     Object->Data
-                     );
+    SegPrefixSize = 2;
+  }
+
+  // Create AML Record with NameString contents from above, sized once for
+  // RootChar or ParentPrefixChar(s), Dual/MultiName Prefix and NameSegs
+  Object->DataSize = 0;
+  Object->Data     = AllocatePool (NameStringPrefixSize + SegPrefixSize + NameStringSize);
+  if (Object->Data == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate NameString=%a\n", __func__, String));
+    goto Done;
+  }
+
+  // Copy in RootChar or ParentPrefixChar(s)
+  if (NameStringPrefixSize != 0) {
+    CopyMem (Object->Data, NameStringPrefix, NameStringPrefixSize);
+    Object->DataSize += NameStringPrefixSize;
+  }
+
+  if (NameSegCount == 2) {
+    Object->Data[Object->DataSize] = AML_DUAL_NAME_PREFIX;
+  } else if (NameSegCount > 2) {
     Object->Data[Object->DataSize]     = AML_MULTI_NAME_PREFIX;
     Object->Data[Object->DataSize + 1] = NameSegCount & 0xFF;
-    Object->DataSize                  += 2;
   }
 
+  Object->DataSize += SegPrefixSize;
+
   // Copy NameString data over. From above must be at least one NameSeg
   CopyMem (&Object->Data[Object->DataSize], NameString, NameStringSize);
   Object->DataSize += NameStringSize;
-  FreePool (NameString);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -567,9 +559,14 @@ AmlOPNameString (
 Done:
   if (EFI_ERROR (Status)) {
     InternalFreeAmlObject (&Object, ListHead);
-    if (NameString != NULL) {
-      FreePool (NameString);
-    }
+  }
+
+  if (NameString != NULL) {
+    FreePool (NameString);
+  }
+
+  if (NameStringPrefix != NULL) {
+    FreePool (NameStringPrefix);
   }
 
   return Status;
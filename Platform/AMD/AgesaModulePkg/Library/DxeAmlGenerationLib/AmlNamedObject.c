@@ -55,7 +55,7 @@ AmlDevice (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, String, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, String, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Device for %a object\n", __func__, String));
         goto Done;
@@ -94,40 +94,20 @@ AmlDevice (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Device Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, String));
         goto Done;
       }
 
-      // Device Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, String));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_DEVICE_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -405,7 +385,7 @@ AmlOPExternal (
   ChildObject = NULL;
 
   // Start EXTERNAL object
-  Status = InternalAppendNewAmlObject (&Object, "EXTERNAL", ListHead);
+  Status = InternalAppendNewAmlObject (&Object, "EXTERNAL", 1, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: Start %a object\n", __func__, Name));
     goto Done;
@@ -424,46 +404,43 @@ AmlOPExternal (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // ObjectType + ArgumentCount go after Name
+  Status = InternalAppendNewAmlObjectNoData (&ChildObject, ListHead);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: append ObjectType for %a\n", __func__, Name));
+    goto Done;
+  }
+
+  ChildObject->Data = AllocatePool (2);
+  if (ChildObject->Data == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate ObjectType for %a\n", __func__, Name));
+    goto Done;
+  }
+
+  ChildObject->Data[0]   = ObjectType;
+  ChildObject->Data[1]   = NumArgs;
+  ChildObject->DataSize  = 2;
+  ChildObject->Completed = TRUE;
+  ChildObject            = NULL;
+
+  // AML_EXTERNAL_OP + Name + ObjectType + ArgumentCount
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             1,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __func__, Name));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount < 2)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  Object->Data = AllocateZeroPool (ChildObject->DataSize + 3);
-  // AML_EXTERNAL_OP + Name + ObjectType + ArgumentCount
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, Name));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __func__, Name));
     goto Done;
   }
 
-  Object->DataSize = 0;
-  Object->Data[0]  = AML_EXTERNAL_OP;
-  Object->DataSize++;
-  CopyMem (
-    &Object->Data[Object->DataSize],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  Object->DataSize              += ChildObject->DataSize;
-  Object->Data[Object->DataSize] = ObjectType;
-  Object->DataSize++;
-  Object->Data[Object->DataSize] = NumArgs;
-  Object->DataSize++;
-
-  InternalFreeAmlObject (&ChildObject, ListHead);
+  Object->Data[0] = AML_EXTERNAL_OP;
   Object->Completed = TRUE;
   Status            = EFI_SUCCESS;
 
@@ -795,7 +772,7 @@ AmlField (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Field for %a object\n", __func__, Name));
         goto Done;
@@ -808,9 +785,9 @@ AmlField (
         goto Done;
       }
 
-      Object->DataSize  = sizeof (UINT64);
-      Object->Data      = AllocateZeroPool (Object->DataSize);
-      Object->Completed = TRUE;
+      // Never completed, so it is not collected into the Field data
+      Object->DataSize = sizeof (UINT64);
+      Object->Data     = AllocateZeroPool (Object->DataSize);
       if (EFI_ERROR (Status) || (Object->Data == NULL)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Field internal offset %a object\n", __func__, Name));
         goto Done;
@@ -885,41 +862,20 @@ AmlField (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Field Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, Name));
         goto Done;
       }
 
-      // Field Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, Name));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_FIELD_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -997,17 +953,17 @@ AmlBankField (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BankField for %a object\n", __func__, BankName));
         goto Done;
       }
 
       // Insert internal offset counter
-      Status            = InternalAppendNewAmlObjectNoData (&Object, ListHead);
-      Object->DataSize  = sizeof (UINT64);
-      Object->Data      = AllocateZeroPool (Object->DataSize);
-      Object->Completed = TRUE;
+      Status = InternalAppendNewAmlObjectNoData (&Object, ListHead);
+      // Never completed, so it is not collected into the Field data
+      Object->DataSize = sizeof (UINT64);
+      Object->Data     = AllocateZeroPool (Object->DataSize);
       if (EFI_ERROR (Status) || (Object->Data == NULL)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BankField internal offset %a object\n", __func__, BankName));
         goto Done;
@@ -1096,41 +1052,20 @@ AmlBankField (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Field Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, BankName));
         goto Done;
       }
 
-      // Field Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, BankName));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_BANK_FIELD_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1206,17 +1141,17 @@ AmlIndexField (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start IndexField for %a object\n", __func__, IndexName));
         goto Done;
       }
 
       // Insert internal offset counter
-      Status            = InternalAppendNewAmlObjectNoData (&Object, ListHead);
-      Object->DataSize  = sizeof (UINT64);
-      Object->Data      = AllocateZeroPool (Object->DataSize);
-      Object->Completed = TRUE;
+      Status = InternalAppendNewAmlObjectNoData (&Object, ListHead);
+      // Never completed, so it is not collected into the Field data
+      Object->DataSize = sizeof (UINT64);
+      Object->Data     = AllocateZeroPool (Object->DataSize);
       if (EFI_ERROR (Status) || (Object->Data == NULL)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start IndexField internal offset %a object\n", __func__, IndexName));
         goto Done;
@@ -1298,41 +1233,20 @@ AmlIndexField (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Field Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, IndexName));
         goto Done;
       }
 
-      // Field Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, IndexName));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_INDEX_FIELD_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1409,7 +1323,7 @@ AmlOPOperationRegion (
   ChildObject = NULL;
   Status      = EFI_DEVICE_ERROR;
 
-  Status = InternalAppendNewAmlObject (&Object, "OPREGION", ListHead);
+  Status = InternalAppendNewAmlObject (&Object, "OPREGION", 2, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: Start OpRegion for %a object\n", __func__, RegionName));
     goto Done;
@@ -1445,41 +1359,24 @@ AmlOPOperationRegion (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // OpRegion Opcode is two bytes
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             2,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, RegionName));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  // OpRegion Opcode is two bytes
-  Object->DataSize = ChildObject->DataSize + 2;
-  Object->Data     = AllocatePool (Object->DataSize);
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, RegionName));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, RegionName));
     goto Done;
   }
 
   Object->Data[0] = AML_EXT_OP;
   Object->Data[1] = AML_EXT_REGION_OP;
-  CopyMem (
-    &Object->Data[2],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -1540,7 +1437,7 @@ AmlOPCreateField (
   }
 
   ChildObject = NULL;
-  Status      = InternalAppendNewAmlObject (&Object, "CreateField", ListHead);
+  Status      = InternalAppendNewAmlObject (&Object, "CreateField", 2, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: CreateField for %a object\n", __func__, FieldName));
     goto Done;
@@ -1576,40 +1473,24 @@ AmlOPCreateField (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // CreateFieldOp is two bytes
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             2,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, FieldName));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  // CreateFieldOp is two bytes
-  Object->DataSize = ChildObject->DataSize + 2;
-  Object->Data     = AllocatePool (Object->DataSize);
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, FieldName));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, FieldName));
     goto Done;
   }
 
   Object->Data[0] = AML_EXT_OP;
   Object->Data[1] = AML_EXT_CREATE_FIELD_OP;
-  CopyMem (
-    &Object->Data[2],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -1659,7 +1540,7 @@ InternalAmlCreateFixedField (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = InternalAppendNewAmlObject (&Object, "CreateFixedField", ListHead);
+  Status = InternalAppendNewAmlObject (&Object, "CreateFixedField", 1, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: CreateField for %a object\n", __func__, FixedFieldName));
     goto Done;
@@ -1710,39 +1591,23 @@ InternalAmlCreateFixedField (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // CreateXFieldOp is one byte
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             1,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, FixedFieldName));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  // CreateWordFieldOp is one byte
-  Object->DataSize = ChildObject->DataSize + 1;
-  Object->Data     = AllocatePool (Object->DataSize);
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, FixedFieldName));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, FixedFieldName));
     goto Done;
   }
 
   Object->Data[0] = OpCode;
-  CopyMem (
-    &Object->Data[1],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -1991,7 +1856,7 @@ AmlMethod (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, "Method", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "Method", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Method for %a object\n", __func__, Name));
         goto Done;
@@ -2012,7 +1877,7 @@ AmlMethod (
       }
 
       // Add Method Flags
-      Status = InternalAppendNewAmlObject (&Object, "METHOD_FLAGS", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "METHOD_FLAGS", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start METHOD_FLAGS for %a object\n", __func__, Name));
         goto Done;
@@ -2030,30 +1895,18 @@ AmlMethod (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Method Flags is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a METHOD_FLAGS child data collection.\n", __func__, Name));
         goto Done;
       }
 
-      // Method Flags is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, Name));
-        goto Done;
-      }
-
       MethodFlags = NumArgs & 0x07;
       if (SerializeRule) {
         MethodFlags |= BIT3;
@@ -2061,12 +1914,6 @@ AmlMethod (
 
       MethodFlags    |= (SyncLevel & 0x0F) << 4;
       Object->Data[0] = MethodFlags;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       // Required NameString completed in one phase call
@@ -2084,40 +1931,19 @@ AmlMethod (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Method Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __func__, Name));
         goto Done;
       }
 
-      // Method Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __func__, Name));
-        goto Done;
-      }
-
       Object->Data[0] = AML_METHOD_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -98,7 +98,10 @@ AmlDebugPrintObject (
   IN      AML_OBJECT_INSTANCE  *Object
   )
 {
-  if ((Object == NULL) || (Object->Signature != AML_OBJECT_INSTANCE_SIGNATURE)) {
+  if ((Object == NULL) ||
+      ((Object->Signature != AML_OBJECT_INSTANCE_SIGNATURE) &&
+       (Object->Signature != AML_SCOPE_INSTANCE_SIGNATURE)))
+  {
     return EFI_INVALID_PARAMETER;
   }
 
@@ -75,7 +75,7 @@ AmlElse (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, "Else", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "Else", 1, ListHead);
 
       // Start required PkgLength
       Status = AmlPkgLength (AmlStart, ListHead);
@@ -101,14 +101,11 @@ AmlElse (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Else Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
       if (EFI_ERROR (Status)) {
@@ -116,30 +113,13 @@ AmlElse (
         goto Done;
       }
 
-      // Handle Return with no arguments
-      if ((ChildObject->Data == NULL) || (ChildObject->DataSize == 0)) {
+      if (ChildCount == 0) {
         Status = EFI_DEVICE_ERROR;
         DEBUG ((DEBUG_ERROR, "%a: ERROR: If must have at least a Predicate\n", __func__));
         goto Done;
       }
 
-      // Allocate buffer for Return object
-      Object->Data     = AllocatePool (ChildObject->DataSize + 1);
-      Object->DataSize = ChildObject->DataSize + 1;
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object=Return\n", __func__));
-        goto Done;
-      }
-
-      // Fill out Return object
       Object->Data[0] = AML_ELSE_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
       Status            = EFI_SUCCESS;
       break;
@@ -223,7 +203,7 @@ AmlIf (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, "If", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "If", 1, ListHead);
 
       // Start required PkgLength
       Status = AmlPkgLength (AmlStart, ListHead);
@@ -249,14 +229,11 @@ AmlIf (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // If Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
       if (EFI_ERROR (Status)) {
@@ -264,30 +241,13 @@ AmlIf (
         goto Done;
       }
 
-      // Handle Return with no arguments
-      if ((ChildObject->Data == NULL) || (ChildObject->DataSize == 0)) {
+      if (ChildCount == 0) {
         Status = EFI_DEVICE_ERROR;
         DEBUG ((DEBUG_ERROR, "%a: ERROR: If must have at least a Predicate\n", __func__));
         goto Done;
       }
 
-      // Allocate buffer for Return object
-      Object->Data     = AllocatePool (ChildObject->DataSize + 1);
-      Object->DataSize = ChildObject->DataSize + 1;
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object=Return\n", __func__));
-        goto Done;
-      }
-
-      // Fill out Return object
       Object->Data[0] = AML_IF_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
       Status            = EFI_SUCCESS;
       break;
@@ -338,7 +298,7 @@ AmlOPNotify (
   Object      = NULL;
   ChildObject = NULL;
 
-  Status = InternalAppendNewAmlObject (&Object, NotifyObject, ListHead);
+  Status = InternalAppendNewAmlObject (&Object, NotifyObject, 1, ListHead);
   Status = AmlOPNameString (NotifyObject, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: Failed creating NotifyObject NameString\n", __func__));
@@ -357,14 +317,11 @@ AmlOPNotify (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // Notify Op is one byte
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             1,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
   if (EFI_ERROR (Status)) {
@@ -372,23 +329,7 @@ AmlOPNotify (
     goto Done;
   }
 
-  // Allocate buffer for Return object
-  Object->Data     = AllocatePool (ChildObject->DataSize + 1);
-  Object->DataSize = ChildObject->DataSize + 1;
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object=Return\n", __func__));
-    goto Done;
-  }
-
-  // Fill out Return object
   Object->Data[0] = AML_NOTIFY_OP;
-  CopyMem (
-    &Object->Data[1],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
   Status            = EFI_SUCCESS;
 
@@ -439,7 +380,7 @@ AmlReturn (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, "Return", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "Return", 1, ListHead);
       // DataRefObject is outside the scope of this object
       break;
     case AmlClose:
@@ -450,25 +391,16 @@ AmlReturn (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
-                 &ChildCount,
-                 &Object->Link,
-                 ListHead
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: collecting Child data\n", __func__));
-        goto Done;
-      }
-
       // Handle Return with no arguments
-      if ((ChildObject->Data == NULL) || (ChildObject->DataSize == 0)) {
+      if (InternalAmlChildrenDataSize (NULL, &Object->Link, ListHead) == 0) {
         // Return without arguments is treated like Return(0)
         // Zeroed byte = ZeroOp
+        Status = InternalAppendNewAmlObjectNoData (&ChildObject, ListHead);
+        if (EFI_ERROR (Status)) {
+          DEBUG ((DEBUG_ERROR, "%a: ERROR: append Zero Child for Return\n", __func__));
+          goto Done;
+        }
+
         ChildObject->Data = AllocateZeroPool (sizeof (UINT8));
         if (ChildObject->Data == NULL) {
           Status = EFI_OUT_OF_RESOURCES;
@@ -476,26 +408,24 @@ AmlReturn (
           goto Done;
         }
 
-        ChildObject->DataSize = 1;
+        ChildObject->DataSize  = 1;
+        ChildObject->Completed = TRUE;
+        ChildObject            = NULL;
       }
 
-      // Allocate buffer for Return object
-      Object->Data     = AllocatePool (ChildObject->DataSize + 1);
-      Object->DataSize = ChildObject->DataSize + 1;
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object=Return\n", __func__));
+      // Return Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
+                 &ChildCount,
+                 ListHead
+                 );
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: collecting Child data\n", __func__));
         goto Done;
       }
 
-      // Fill out Return object
       Object->Data[0] = AML_RETURN_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
       Status            = EFI_SUCCESS;
       break;
@@ -11,6 +11,260 @@
 
 #define FILECODE  LIBRARY_DXEAMLGENERATIONLIB_LOCALAMLOBJECTS_FILECODE
 
+/**
+  Frees a stream and its buffer
+
+  @param [in]     Stream      - Stream to be freed
+**/
+STATIC
+VOID
+InternalAmlFreeStream (
+  IN      AML_STREAM  *Stream
+  )
+{
+  if (Stream->Buffer != NULL) {
+    FreePool (Stream->Buffer);
+  }
+
+  if (Stream->Gaps != NULL) {
+    FreePool (Stream->Gaps);
+  }
+
+  FreePool (Stream);
+}
+
+/**
+  Makes room for Size more bytes at the end of the stream
+
+  @param [in,out] Stream      - Stream to grow
+  @param [in]     Size        - Bytes to be appended
+
+  @return         EFI_SUCCESS - Stream->Buffer can hold Size more bytes
+  @return         <all others> - Stream could not be grown
+**/
+STATIC
+EFI_STATUS
+InternalAmlStreamGrow (
+  IN OUT  AML_STREAM  *Stream,
+  IN      UINTN       Size
+  )
+{
+  UINTN  Capacity;
+  UINT8  *Buffer;
+
+  if (Size > (MAX_UINTN - Stream->Size)) {
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  if ((Stream->Size + Size) <= Stream->Capacity) {
+    return EFI_SUCCESS;
+  }
+
+  Capacity = MAX (Stream->Capacity, AML_STREAM_INITIAL_SIZE);
+  while (Capacity < (Stream->Size + Size)) {
+    if (Capacity > (MAX_UINTN / 2)) {
+      Capacity = Stream->Size + Size;
+      break;
+    }
+
+    Capacity *= 2;
+  }
+
+  Buffer = ReallocatePool (Stream->Capacity, Capacity, Stream->Buffer);
+  if (Buffer == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: growing stream to 0x%lx bytes\n", __func__, (UINT64)Capacity));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Stream->Buffer   = Buffer;
+  Stream->Capacity = Capacity;
+  return EFI_SUCCESS;
+}
+
+/**
+  Records Size unused bytes at Offset as a gap
+
+  Gaps are kept in stream order. A scope records its gap when it closes,
+  after the gaps of the scopes nested in it, so it is inserted at the
+  position the gap list had when the scope was started.
+
+  @param [in,out] Stream      - Stream to record the gap in
+  @param [in]     GapIndex    - Position of the gap in the gap list
+  @param [in]     Offset      - Stream offset of the gap
+  @param [in]     Size        - Size of the gap
+
+  @return         EFI_SUCCESS - Gap recorded
+  @return         <all others> - Gap list could not be grown
+**/
+STATIC
+EFI_STATUS
+InternalAmlStreamInsertGap (
+  IN OUT  AML_STREAM  *Stream,
+  IN      UINTN       GapIndex,
+  IN      UINTN       Offset,
+  IN      UINTN       Size
+  )
+{
+  UINTN           GapCapacity;
+  AML_STREAM_GAP  *Gaps;
+
+  if (Stream->GapCount == Stream->GapCapacity) {
+    GapCapacity = MAX (Stream->GapCapacity * 2, AML_STREAM_INITIAL_GAPS);
+    Gaps        = ReallocatePool (
+                    Stream->GapCapacity * sizeof (AML_STREAM_GAP),
+                    GapCapacity * sizeof (AML_STREAM_GAP),
+                    Stream->Gaps
+                    );
+    if (Gaps == NULL) {
+      DEBUG ((DEBUG_ERROR, "%a: ERROR: growing stream gap list\n", __func__));
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Stream->Gaps        = Gaps;
+    Stream->GapCapacity = GapCapacity;
+  }
+
+  if (GapIndex < Stream->GapCount) {
+    CopyMem (
+      &Stream->Gaps[GapIndex + 1],
+      &Stream->Gaps[GapIndex],
+      (Stream->GapCount - GapIndex) * sizeof (AML_STREAM_GAP)
+      );
+  }
+
+  Stream->Gaps[GapIndex].Offset = Offset;
+  Stream->Gaps[GapIndex].Size   = Size;
+  Stream->GapCount++;
+  return EFI_SUCCESS;
+}
+
+/**
+  Squeezes all gaps out of the stream, moving each byte at most once
+
+  @param [in,out] Stream      - Stream to compact
+**/
+STATIC
+VOID
+InternalAmlStreamCompact (
+  IN OUT  AML_STREAM  *Stream
+  )
+{
+  UINTN  Index;
+  UINTN  Read;
+  UINTN  Write;
+  UINTN  End;
+
+  if (Stream->GapCount == 0) {
+    return;
+  }
+
+  // Gaps are recorded in stream order and never overlap
+  Write = Stream->Gaps[0].Offset;
+  for (Index = 0; Index < Stream->GapCount; Index++) {
+    Read = Stream->Gaps[Index].Offset + Stream->Gaps[Index].Size;
+    End  = (Index + 1 < Stream->GapCount) ? Stream->Gaps[Index + 1].Offset : Stream->Size;
+    if ((Write != Read) && (End != Read)) {
+      CopyMem (&Stream->Buffer[Write], &Stream->Buffer[Read], End - Read);
+    }
+
+    Write += End - Read;
+  }
+
+  Stream->Size     = Write;
+  Stream->GapSize  = 0;
+  Stream->GapCount = 0;
+}
+
+/**
+  Finds the innermost scope that has been started but not closed
+
+  @param [in]     ListHead      - Head of AML Object linked list
+
+  @return         Innermost open scope, or NULL if there is none
+**/
+STATIC
+AML_SCOPE_INSTANCE *
+InternalAmlLocateOpenScope (
+  IN      LIST_ENTRY  *ListHead
+  )
+{
+  LIST_ENTRY           *Node;
+  AML_OBJECT_INSTANCE  *Object;
+
+  for (Node = GetPreviousNode (ListHead, ListHead);
+       Node != ListHead;
+       Node = GetPreviousNode (ListHead, Node))
+  {
+    Object = AML_OBJECT_INSTANCE_FROM_LINK (Node);
+    if (!Object->Completed && IS_AML_SCOPE_INSTANCE (Object)) {
+      return AML_SCOPE_INSTANCE_FROM_OBJECT (Object);
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Moves the data of the completed Objects following Scope into its stream and
+  frees them
+
+  Completed scopes already hold their data in the stream and are only freed.
+  Objects that are not completed are left in place.
+
+  @param [in,out] Scope         - Open scope to collect children of
+  @param [in,out] ListHead      - Head of AML Object linked list
+
+  @return         EFI_SUCCESS   - Children moved into the stream
+  @return         <all others>  - Stream could not be grown
+**/
+STATIC
+EFI_STATUS
+InternalAmlAbsorbChildren (
+  IN OUT  AML_SCOPE_INSTANCE  *Scope,
+  IN OUT  LIST_ENTRY          *ListHead
+  )
+{
+  EFI_STATUS           Status;
+  AML_STREAM           *Stream;
+  LIST_ENTRY           *Node;
+  AML_OBJECT_INSTANCE  *ChildObject;
+  AML_SCOPE_INSTANCE   *ChildScope;
+
+  Stream = Scope->Stream;
+  Node   = GetNextNode (ListHead, &Scope->Object.Link);
+  while (Node != ListHead) {
+    ChildObject = AML_OBJECT_INSTANCE_FROM_LINK (Node);
+    Node        = GetNextNode (ListHead, Node);
+    if (!ChildObject->Completed) {
+      continue;
+    }
+
+    ChildScope = NULL;
+    if (IS_AML_SCOPE_INSTANCE (ChildObject)) {
+      ChildScope = AML_SCOPE_INSTANCE_FROM_OBJECT (ChildObject);
+    }
+
+    if ((ChildScope != NULL) && ChildScope->DataInStream) {
+      ChildScope->DataInStream = FALSE;
+      ChildObject->Data        = NULL;
+      ChildObject->DataSize    = 0;
+    } else if (ChildObject->DataSize != 0) {
+      Status = InternalAmlStreamGrow (Stream, ChildObject->DataSize);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      CopyMem (&Stream->Buffer[Stream->Size], ChildObject->Data, ChildObject->DataSize);
+      Stream->Size += ChildObject->DataSize;
+    }
+
+    Scope->ChildCount++;
+    InternalFreeAmlObject (&ChildObject, ListHead);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Free Object->Data
 
@@ -28,12 +282,25 @@ InternalFreeAmlObjectData (
   IN      AML_OBJECT_INSTANCE  *Object
   )
 {
+  AML_SCOPE_INSTANCE  *Scope;
+
   if (Object == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
   if (Object->Data != NULL) {
-    FreePool (Object->Data);
+    // Data of a closed nested scope belongs to the stream
+    Scope = NULL;
+    if (IS_AML_SCOPE_INSTANCE (Object)) {
+      Scope = AML_SCOPE_INSTANCE_FROM_OBJECT (Object);
+    }
+
+    if ((Scope != NULL) && Scope->DataInStream) {
+      Scope->DataInStream = FALSE;
+    } else {
+      FreePool (Object->Data);
+    }
+
     Object->Data      = NULL;
     Object->DataSize  = 0;
     Object->Completed = FALSE;
@@ -63,6 +330,10 @@ InternalFreeAmlObject (
   )
 {
   AML_OBJECT_INSTANCE  *Object;
+  AML_SCOPE_INSTANCE   *Scope;
+  AML_SCOPE_INSTANCE   *ChildScope;
+  LIST_ENTRY           *Node;
+  BOOLEAN              InList;
 
   if ((FreeObject == NULL) || (ListHead == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -71,7 +342,37 @@ InternalFreeAmlObject (
   Object = *FreeObject;
   if (Object != NULL) {
     InternalFreeAmlObjectData (Object);
-    if (IsNodeInList (ListHead, &Object->Link)) {
+    InList = IsNodeInList (ListHead, &Object->Link);
+    if (IS_AML_SCOPE_INSTANCE (Object)) {
+      Scope = AML_SCOPE_INSTANCE_FROM_OBJECT (Object);
+      if (Scope->StreamOwner && (Scope->Stream != NULL)) {
+        // Scopes nested in an outermost scope freed early must not use its stream
+        for (Node = InList ? GetNextNode (ListHead, &Object->Link) : ListHead;
+             Node != ListHead;
+             Node = GetNextNode (ListHead, Node))
+        {
+          if (!IS_AML_SCOPE_INSTANCE (AML_OBJECT_INSTANCE_FROM_LINK (Node))) {
+            continue;
+          }
+
+          ChildScope = AML_SCOPE_INSTANCE_FROM_OBJECT (AML_OBJECT_INSTANCE_FROM_LINK (Node));
+          if (ChildScope->Stream == Scope->Stream) {
+            if (ChildScope->DataInStream) {
+              ChildScope->DataInStream    = FALSE;
+              ChildScope->Object.Data     = NULL;
+              ChildScope->Object.DataSize = 0;
+            }
+
+            ChildScope->Stream = NULL;
+          }
+        }
+
+        InternalAmlFreeStream (Scope->Stream);
+        Scope->Stream = NULL;
+      }
+    }
+
+    if (InList) {
       RemoveEntryList (&Object->Link);
     }
 
@@ -161,10 +462,16 @@ InternalAppendNewAmlObjectNoData (
   Inserts a new AML_OBJECT_INSTANCE at the end of the linked list.  Using a
   string Identifier for comparison purposes
 
+  The object is the Start phase of an object that is completed by a Close
+  phase. PrefixSize bytes are reserved for it in the stream of the enclosing
+  open object, or in a new stream if there is none.
+
   Allocates AML_OBJECT_INSTANCE which must be freed by caller
 
   @param [out]    ReturnObject  - Pointer to an Object
   @param [in]     Identifier    - String Identifier to create object with
+  @param [in]     PrefixSize    - Bytes the Close phase writes ahead of the
+                                  children, more can be made room for later
   @param [in,out] ListHead      - Head of AML Object linked list
 
   @return         EFI_SUCCESS   - Object created and appended to linked list
@@ -175,23 +482,56 @@ EFIAPI
 InternalAppendNewAmlObject (
   OUT  AML_OBJECT_INSTANCE  **ReturnObject,
   IN      CHAR8             *Identifier,
+  IN      UINTN             PrefixSize,
   IN OUT  LIST_ENTRY        *ListHead
   )
 {
   EFI_STATUS           Status;
   AML_OBJECT_INSTANCE  *Object;
+  AML_SCOPE_INSTANCE   *Scope;
+  AML_SCOPE_INSTANCE   *Parent;
 
   if ((Identifier == NULL) || (ListHead == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
-  Object = NULL;
+  // Everything completed in the parent so far goes ahead of this object
+  Parent = InternalAmlLocateOpenScope (ListHead);
+  if (Parent != NULL) {
+    if (Parent->Stream == NULL) {
+      DEBUG ((DEBUG_ERROR, "%a: ERROR: Enclosing object of %a was freed\n", __func__, Identifier));
+      return EFI_DEVICE_ERROR;
+    }
+
+    Status = InternalAmlAbsorbChildren (Parent, ListHead);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
 
-  Status = InternalAppendNewAmlObjectNoData (&Object, ListHead);
-  if (EFI_ERROR (Status)) {
+  Scope = AllocateZeroPool (sizeof (AML_SCOPE_INSTANCE));
+  if (Scope == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: Allocate Object Failed\n", __func__));
     return EFI_OUT_OF_RESOURCES;
   }
 
+  Object            = &Scope->Object;
+  Object->Signature = AML_SCOPE_INSTANCE_SIGNATURE;
+  InsertTailList (ListHead, &Object->Link);
+
+  if (Parent != NULL) {
+    Scope->Stream = Parent->Stream;
+  } else {
+    Scope->Stream = AllocateZeroPool (sizeof (AML_STREAM));
+    if (Scope->Stream == NULL) {
+      DEBUG ((DEBUG_ERROR, "%a: ERROR: Allocate stream Identifier=%a\n", __func__, Identifier));
+      InternalFreeAmlObject (&Object, ListHead);
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Scope->StreamOwner = TRUE;
+  }
+
   // Allocate Identifier Data + NULL termination
   Object->DataSize = AsciiStrLen (Identifier) + 1;
   Object->Data     = AllocatePool (Object->DataSize);
@@ -203,6 +543,23 @@ InternalAppendNewAmlObject (
 
   CopyMem (Object->Data, Identifier, Object->DataSize);
 
+  // Reserve the most bytes the Close phase can write ahead of the children
+  Status = InternalAmlStreamGrow (Scope->Stream, PrefixSize);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: Reserve stream Identifier=%a\n", __func__, Identifier));
+    InternalFreeAmlObject (&Object, ListHead);
+    return Status;
+  }
+
+  Scope->StreamOffset = Scope->Stream->Size;
+  Scope->ReservedSize = PrefixSize;
+  Scope->GapIndex     = Scope->Stream->GapCount;
+
+  // Counted as a gap until the Close phase knows how much of it is used
+  Scope->Stream->Size    += PrefixSize;
+  Scope->Stream->GapSize += PrefixSize;
+  Scope->GapSizeAtStart   = Scope->Stream->GapSize;
+
   *ReturnObject = Object;
   return EFI_SUCCESS;
 }
@@ -276,89 +633,192 @@ InternalAmlLocateObjectByIdentifier (
 }
 
 /**
-  Finds all children of the Link and appends them into a single ObjectData
-  buffer of ObjectDataSize
+  Returns the total size of the data of all children of the Object at Link,
+  both those already moved into its stream and those still in the linked
+  list, without modifying the list
+
+  @param [out]    ChildCount    - Optional count of Child Objects found
+  @param [in]     Link          - Linked List Object entry to size children of
+  @param [in]     ListHead      - Head of Object Linked List
+
+  @return         Sum of the DataSize of all Child Objects
+**/
+UINTN
+EFIAPI
+InternalAmlChildrenDataSize (
+  OUT     UINTN       *ChildCount  OPTIONAL,
+  IN      LIST_ENTRY  *Link,
+  IN      LIST_ENTRY  *ListHead
+  )
+{
+  LIST_ENTRY           *Node;
+  AML_OBJECT_INSTANCE  *Object;
+  AML_SCOPE_INSTANCE   *Scope;
+  AML_STREAM           *Stream;
+  UINTN                DataSize;
+  UINTN                Count;
+
+  DataSize = 0;
+  Count    = 0;
+  Object   = AML_OBJECT_INSTANCE_FROM_LINK (Link);
+  if (IS_AML_SCOPE_INSTANCE (Object) && (AML_SCOPE_INSTANCE_FROM_OBJECT (Object)->Stream != NULL)) {
+    // Stream bytes after the reservation, less gaps of scopes nested in it
+    Scope    = AML_SCOPE_INSTANCE_FROM_OBJECT (Object);
+    Stream   = Scope->Stream;
+    DataSize = (Stream->Size - (Scope->StreamOffset + Scope->ReservedSize)) -
+               (Stream->GapSize - Scope->GapSizeAtStart);
+    Count = Scope->ChildCount;
+  }
+
+  Node = GetNextNode (ListHead, Link);
+  while (Node != ListHead) {
+    Object = AML_OBJECT_INSTANCE_FROM_LINK (Node);
+    if (Object->Completed) {
+      if (!IS_AML_SCOPE_INSTANCE (Object) ||
+          !AML_SCOPE_INSTANCE_FROM_OBJECT (Object)->DataInStream)
+      {
+        DataSize += Object->DataSize;
+      }
 
-  Allocates AML_OBJECT_INSTANCE and Data which must be freed by caller
+      Count++;
+    }
 
-  @param [out]    ReturnObject  - Pointer to an Object pointer
+    Node = GetNextNode (ListHead, Node);
+  }
+
+  if (ChildCount != NULL) {
+    *ChildCount = Count;
+  }
+
+  return DataSize;
+}
+
+/**
+  Completes the stream data of Object: moves the children still in the linked
+  list into the stream and frees them, then points Object->Data at PrefixSize
+  uninitialized bytes followed by the data of all children
+
+  The prefix bytes were reserved when Object was started, so callers fill in
+  their opcode or PkgLength at the start of Object->Data without copying the
+  children again. If PrefixSize is more than was reserved, the children are
+  moved once to make room. Object->Data stays valid until the next object is started
+  or closed. When Object is the outermost open object, the stream is
+  compacted and handed over to Object->Data.
+
+  @param [in,out] Object        - Object to receive the children's data
+  @param [in]     PrefixSize    - Bytes ahead of the child data
   @param [out]    ChildCount    - Count of Child Objects collapsed
-  @param [in]     Link          - Linked List Object entry to collect children
   @param [in,out] ListHead      - Head of Object Linked List
 
-  @return         EFI_SUCCESS   - ChildObject created and returned
-  @return         <all others>  - Object creation failed, Object = NULL
+  @return         EFI_SUCCESS   - Object->Data holds prefix and child data
+  @return         <all others>  - Collection failed
 **/
 EFI_STATUS
 EFIAPI
-InternalAmlCollapseAndReleaseChildren (
-  OUT  AML_OBJECT_INSTANCE  **ReturnObject,
-  OUT  UINTN                *ChildCount,
-  IN      LIST_ENTRY        *Link,
-  IN OUT  LIST_ENTRY        *ListHead
+InternalAmlCollapseChildrenWithPrefix (
+  IN OUT  AML_OBJECT_INSTANCE  *Object,
+  IN      UINTN                PrefixSize,
+  OUT     UINTN                *ChildCount,
+  IN OUT  LIST_ENTRY           *ListHead
   )
 {
-  EFI_STATUS           Status;
-  LIST_ENTRY           *Node;
-  AML_OBJECT_INSTANCE  *Object;
-  AML_OBJECT_INSTANCE  *ChildObject;
-  UINT8                *TempBuffer;
-
-  Status = EFI_SUCCESS;
-  if ((ReturnObject == NULL) ||
-      (ChildCount == NULL) ||
-      (Link == NULL) ||
-      (ListHead == NULL))
+  EFI_STATUS          Status;
+  AML_SCOPE_INSTANCE  *Scope;
+  AML_STREAM          *Stream;
+  UINTN               BodyStart;
+  UINTN               BodySize;
+  UINTN               Extra;
+  UINTN               Unused;
+  UINTN               Index;
+
+  if ((Object == NULL) || (ChildCount == NULL) || (ListHead == NULL) ||
+      !IS_AML_SCOPE_INSTANCE (Object) || Object->Completed)
   {
     return EFI_INVALID_PARAMETER;
   }
 
   *ChildCount = 0;
+  Scope       = AML_SCOPE_INSTANCE_FROM_OBJECT (Object);
+  Stream      = Scope->Stream;
+  if (Stream == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: Enclosing object was freed\n", __func__));
+    return EFI_DEVICE_ERROR;
+  }
 
-  Status = InternalNewAmlObjectNoData (&Object);
+  Status = InternalAmlAbsorbChildren (Scope, ListHead);
   if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocating Object Data\n", __func__));
-    goto Done;
+    return Status;
   }
 
-  // Get first Child Node
-  Node = GetNextNode (ListHead, Link);
-  while (Node != ListHead) {
-    ChildObject = AML_OBJECT_INSTANCE_FROM_LINK (Node);
-    // Expand data buffer to fit existing data + new data
-    TempBuffer = ReallocatePool (
-                   Object->DataSize,
-                   Object->DataSize + ChildObject->DataSize,
-                   Object->Data
-                   );
-    if (TempBuffer == NULL) {
-      Status = EFI_OUT_OF_RESOURCES;
-      FreePool (Object->Data);
-      Object->Data = NULL;
-      DEBUG ((DEBUG_ERROR, "%a: ERROR: reallocating Object Data\n", __func__));
-      goto Done;
+  if (PrefixSize > Scope->ReservedSize) {
+    // Not enough was reserved, move the children once to make room
+    Extra  = PrefixSize - Scope->ReservedSize;
+    Status = InternalAmlStreamGrow (Stream, Extra);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
 
-    Object->Data = TempBuffer;
-    // Copy new data at end of buffer
+    BodyStart = Scope->StreamOffset + Scope->ReservedSize;
     CopyMem (
-      &Object->Data[Object->DataSize],
-      ChildObject->Data,
-      ChildObject->DataSize
+      &Stream->Buffer[BodyStart + Extra],
+      &Stream->Buffer[BodyStart],
+      Stream->Size - BodyStart
       );
-    Object->DataSize += ChildObject->DataSize;
-    // Get Next ChildObject Node, then free ChildObject from list
-    Node = GetNextNode (ListHead, Node);
-    InternalFreeAmlObject (&ChildObject, ListHead);
-    *ChildCount = *ChildCount + 1;
+    for (Index = Scope->GapIndex; Index < Stream->GapCount; Index++) {
+      Stream->Gaps[Index].Offset += Extra;
+    }
+
+    Stream->Size          += Extra;
+    Stream->GapSize       += Extra;
+    Scope->GapSizeAtStart += Extra;
+    Scope->ReservedSize    = PrefixSize;
   }
 
-Done:
-  if (EFI_ERROR (Status)) {
-    InternalFreeAmlObject (&Object, ListHead);
-    Object = NULL;
+  BodyStart = Scope->StreamOffset + Scope->ReservedSize;
+  BodySize  = (Stream->Size - BodyStart) - (Stream->GapSize - Scope->GapSizeAtStart);
+
+  // Back-patched bytes sit right before the children, the rest is a gap
+  Unused = Scope->ReservedSize - PrefixSize;
+  if ((Unused != 0) && ((Stream->Size - BodyStart) <= AML_STREAM_SHORT_BODY_SIZE)) {
+    // Cheaper to move a short body now than to record the gap
+    CopyMem (
+      &Stream->Buffer[BodyStart - Unused],
+      &Stream->Buffer[BodyStart],
+      Stream->Size - BodyStart
+      );
+    for (Index = Scope->GapIndex; Index < Stream->GapCount; Index++) {
+      Stream->Gaps[Index].Offset -= Unused;
+    }
+
+    Stream->Size    -= Unused;
+    Stream->GapSize -= Unused;
+    BodyStart       -= Unused;
+  } else if (Unused != 0) {
+    Status = InternalAmlStreamInsertGap (Stream, Scope->GapIndex, Scope->StreamOffset, Unused);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
-  *ReturnObject = Object;
-  return Status;
+  Stream->GapSize -= PrefixSize;
+
+  InternalFreeAmlObjectData (Object);
+  *ChildCount = Scope->ChildCount;
+
+  if (!Scope->StreamOwner) {
+    Object->Data        = &Stream->Buffer[BodyStart - PrefixSize];
+    Object->DataSize    = PrefixSize + BodySize;
+    Scope->DataInStream = TRUE;
+    return EFI_SUCCESS;
+  }
+
+  // Outermost object, squeeze out the unused reservations once
+  InternalAmlStreamCompact (Stream);
+  Object->Data     = Stream->Buffer;
+  Object->DataSize = Stream->Size;
+  Stream->Buffer   = NULL;
+  InternalAmlFreeStream (Stream);
+  Scope->Stream = NULL;
+
+  return EFI_SUCCESS;
 }
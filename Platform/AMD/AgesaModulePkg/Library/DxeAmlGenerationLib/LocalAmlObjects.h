@@ -11,6 +11,56 @@
 
 // #include "LocalAmlLib.h"
 
+#define AML_SCOPE_INSTANCE_SIGNATURE  SIGNATURE_32 ('a', 'm', 'l', 's')
+#define AML_STREAM_INITIAL_SIZE       SIZE_4KB
+#define AML_STREAM_INITIAL_GAPS       32
+#define AML_STREAM_SHORT_BODY_SIZE    64
+
+//
+// Bytes reserved when an object was started that its Close phase did not use
+//
+typedef struct {
+  UINTN    Offset;
+  UINTN    Size;
+} AML_STREAM_GAP;
+
+//
+// Growing buffer shared by an outermost open object and everything nested in
+// it. Each nested object reserves room for its opcode or PkgLength when it
+// starts and back-patches it when it closes. The unused part of each
+// reservation is recorded as a gap and squeezed out once, when the outermost
+// object closes. Objects with a short body move it over the gap instead.
+//
+typedef struct {
+  UINT8             *Buffer;
+  UINTN             Size;
+  UINTN             Capacity;
+  UINTN             GapSize;      // Gaps plus reservations of open objects
+  AML_STREAM_GAP    *Gaps;        // Non-empty gaps of closed objects, in stream order
+  UINTN             GapCount;
+  UINTN             GapCapacity;
+} AML_STREAM;
+
+//
+// An object with a Start and Close phase. Object must be the first member so
+// the scope is freed with the object.
+//
+typedef struct {
+  AML_OBJECT_INSTANCE    Object;
+  AML_STREAM             *Stream;
+  BOOLEAN                StreamOwner;   // Outermost object, frees the stream
+  BOOLEAN                DataInStream;  // Object.Data points into Stream
+  UINTN                  StreamOffset;  // Start of the reserved prefix bytes
+  UINTN                  ReservedSize;
+  UINTN                  GapIndex;      // Gap list position for the Close phase
+  UINTN                  GapSizeAtStart;
+  UINTN                  ChildCount;
+} AML_SCOPE_INSTANCE;
+
+#define IS_AML_SCOPE_INSTANCE(a)  ((a)->Signature == AML_SCOPE_INSTANCE_SIGNATURE)
+#define AML_SCOPE_INSTANCE_FROM_OBJECT(a) \
+  BASE_CR (a, AML_SCOPE_INSTANCE, Object)
+
 /**
   Free Object->Data
 
@@ -88,10 +138,16 @@ InternalAppendNewAmlObjectNoData (
   Inserts a new AML_OBJECT_INSTANCE at the end of the linked list.  Using a
   string Identifier for comparison purposes
 
+  The object is the Start phase of an object that is completed by a Close
+  phase. PrefixSize bytes are reserved for it in the stream of the enclosing
+  open object, or in a new stream if there is none.
+
   Allocates AML_OBJECT_INSTANCE which must be freed by caller
 
   @param [out]    ReturnObject  - Pointer to an Object
   @param [in]     Identifier    - String Identifier to create object with
+  @param [in]     PrefixSize    - Bytes the Close phase writes ahead of the
+                                  children, more can be made room for later
   @param [in,out] ListHead      - Head of AML Object linked list
 
   @return         EFI_SUCCESS   - Object created and appended to linked list
@@ -102,6 +158,7 @@ EFIAPI
 InternalAppendNewAmlObject (
   OUT  AML_OBJECT_INSTANCE  **ReturnObject,
   IN      CHAR8             *Identifier,
+  IN      UINTN             PrefixSize,
   IN OUT  LIST_ENTRY        *ListHead
   );
 
@@ -125,26 +182,51 @@ InternalAmlLocateObjectByIdentifier (
   );
 
 /**
-  Finds all children of the Link and appends them into a single ObjectData
-  buffer of ObjectDataSize
+  Returns the total size of the data of all children of the Object at Link,
+  both those already moved into its stream and those still in the linked
+  list, without modifying the list
+
+  @param [out]    ChildCount    - Optional count of Child Objects found
+  @param [in]     Link          - Linked List Object entry to size children of
+  @param [in]     ListHead      - Head of Object Linked List
 
-  Allocates AML_OBJECT_INSTANCE and Data which must be freed by caller
+  @return         Sum of the DataSize of all Child Objects
+**/
+UINTN
+EFIAPI
+InternalAmlChildrenDataSize (
+  OUT     UINTN       *ChildCount  OPTIONAL,
+  IN      LIST_ENTRY  *Link,
+  IN      LIST_ENTRY  *ListHead
+  );
 
-  @param [out]    ReturnObject  - Pointer to an Object pointer
+/**
+  Completes the stream data of Object: moves the children still in the linked
+  list into the stream and frees them, then points Object->Data at PrefixSize
+  uninitialized bytes followed by the data of all children
+
+  The prefix bytes were reserved when Object was started, so callers fill in
+  their opcode or PkgLength at the start of Object->Data without copying the
+  children again. If PrefixSize is more than was reserved, the children are
+  moved once to make room. Object->Data stays valid until the next object is started
+  or closed. When Object is the outermost open object, the stream is
+  compacted and handed over to Object->Data.
+
+  @param [in,out] Object        - Object to receive the children's data
+  @param [in]     PrefixSize    - Bytes ahead of the child data
   @param [out]    ChildCount    - Count of Child Objects collapsed
-  @param [in]     Link          - Linked List Object entry to collect children
   @param [in,out] ListHead      - Head of Object Linked List
 
-  @return         EFI_SUCCESS   - ChildObject created and returned
-  @return         <all others>  - Object creation failed, Object = NULL
+  @return         EFI_SUCCESS   - Object->Data holds prefix and child data
+  @return         <all others>  - Collection failed
 **/
 EFI_STATUS
 EFIAPI
-InternalAmlCollapseAndReleaseChildren (
-  OUT  AML_OBJECT_INSTANCE  **ReturnObject,
-  OUT  UINTN                *ChildCount,
-  IN      LIST_ENTRY        *Link,
-  IN OUT  LIST_ENTRY        *ListHead
+InternalAmlCollapseChildrenWithPrefix (
+  IN OUT  AML_OBJECT_INSTANCE  *Object,
+  IN      UINTN                PrefixSize,
+  OUT     UINTN                *ChildCount,
+  IN OUT  LIST_ENTRY           *ListHead
   );
 
 #endif // INTERNAL_AML_OBJECTS_H_
@@ -0,0 +1,1313 @@
+/** @file
+  Host based unit tests and generation benchmark for AmlGenerationLib.
+
+  Tables are built with the library and then walked by a small AML parser that
+  understands every opcode the library emits. The parser checks that each
+  PkgLength ends exactly where its scope does, that NameStrings and data
+  objects are well formed and that resource templates end with an End Tag,
+  which is what a disassembler would trip over first.
+
+  The benchmark builds a PCI root bridge SSDT and a processor SSDT sized like
+  a four socket server and reports bytes emitted, pool allocations, peak pool
+  use and time per table.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <time.h>
+
+#include <Uefi.h>
+#include <IndustryStandard/Acpi.h>
+#include <Library/AmlGenerationLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "CountingMemoryAllocationLib/AllocationCounters.h"
+
+#define UNIT_TEST_NAME     "AmlGenerationLib Unit Tests"
+#define UNIT_TEST_VERSION  "1.0"
+
+//
+// AML encodings the parser needs that the library keeps internal.
+//
+#define TEST_AML_ZERO_OP            0x00
+#define TEST_AML_ONE_OP             0x01
+#define TEST_AML_NAME_OP            0x08
+#define TEST_AML_BYTE_PREFIX        0x0A
+#define TEST_AML_WORD_PREFIX        0x0B
+#define TEST_AML_DWORD_PREFIX       0x0C
+#define TEST_AML_STRING_PREFIX      0x0D
+#define TEST_AML_QWORD_PREFIX       0x0E
+#define TEST_AML_SCOPE_OP           0x10
+#define TEST_AML_BUFFER_OP          0x11
+#define TEST_AML_PACKAGE_OP         0x12
+#define TEST_AML_VAR_PACKAGE_OP     0x13
+#define TEST_AML_METHOD_OP          0x14
+#define TEST_AML_DUAL_NAME_PREFIX   0x2E
+#define TEST_AML_MULTI_NAME_PREFIX  0x2F
+#define TEST_AML_EXT_OP             0x5B
+#define TEST_AML_ROOT_CHAR          0x5C
+#define TEST_AML_PARENT_PREFIX      0x5E
+#define TEST_AML_LOCAL0             0x60
+#define TEST_AML_LOCAL7             0x67
+#define TEST_AML_ARG0               0x68
+#define TEST_AML_ARG6               0x6E
+#define TEST_AML_STORE_OP           0x70
+#define TEST_AML_LEQUAL_OP          0x93
+#define TEST_AML_IF_OP              0xA0
+#define TEST_AML_ELSE_OP            0xA1
+#define TEST_AML_RETURN_OP          0xA4
+#define TEST_AML_ONES_OP            0xFF
+#define TEST_AML_EXT_REGION_OP      0x80
+#define TEST_AML_EXT_FIELD_OP       0x81
+#define TEST_AML_EXT_DEVICE_OP      0x82
+
+#define TEST_AML_END_TAG          0x79
+#define TEST_AML_LARGE_ITEM       BIT7
+#define TEST_AML_MAX_PARSE_DEPTH  64
+
+//
+// Topology used for the benchmark: four sockets, eight root bridges and 192
+// two-thread cores per socket.
+//
+#define BENCH_SOCKETS                  4
+#define BENCH_ROOT_BRIDGES_PER_SOCKET  8
+#define BENCH_PORTS_PER_ROOT_BRIDGE    8
+#define BENCH_THREADS_PER_SOCKET       384
+
+typedef struct {
+  UINTN    Scopes;
+  UINTN    Devices;
+  UINTN    Methods;
+  UINTN    Names;
+  UINTN    Packages;
+  UINTN    ResourceTemplates;
+  UINTN    MaxDepth;
+} AML_PARSE_STATS;
+
+typedef struct {
+  CONST UINT8        *Aml;
+  UINTN              Size;
+  AML_PARSE_STATS    Stats;
+} AML_PARSER;
+
+STATIC
+EFI_STATUS
+ParseTermArg (
+  IN OUT AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End,
+  IN     UINTN       Depth
+  );
+
+STATIC
+EFI_STATUS
+ParseTermList (
+  IN OUT AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End,
+  IN     UINTN       Depth
+  );
+
+/**
+  Decodes a PkgLength.
+
+  @param[in]      Parser  Parser state.
+  @param[in,out]  Offset  Offset of the PkgLength; advanced past it.
+  @param[in]      End     End of the enclosing scope.
+  @param[out]     PkgEnd  Offset just past the package.
+
+  @retval EFI_SUCCESS            PkgLength decoded and lies within End.
+  @retval EFI_VOLUME_CORRUPTED   Encoding is malformed or overruns End.
+**/
+STATIC
+EFI_STATUS
+ParsePkgLength (
+  IN     AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End,
+  OUT    UINTN       *PkgEnd
+  )
+{
+  UINTN  Start;
+  UINT8  LeadByte;
+  UINTN  FollowBytes;
+  UINTN  Length;
+  UINTN  Index;
+
+  Start = *Offset;
+  if (Start >= End) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  LeadByte    = Parser->Aml[Start];
+  FollowBytes = LeadByte >> 6;
+  if ((Start + 1 + FollowBytes) > End) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  if (FollowBytes == 0) {
+    Length = LeadByte & 0x3F;
+  } else {
+    if ((LeadByte & (BIT5 | BIT4)) != 0) {
+      DEBUG ((DEBUG_ERROR, "PkgLength at 0x%x has reserved bits set\n", Start));
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    Length = LeadByte & 0x0F;
+    for (Index = 0; Index < FollowBytes; Index++) {
+      Length |= (UINTN)Parser->Aml[Start + 1 + Index] << (4 + 8 * Index);
+    }
+  }
+
+  //
+  // PkgLength counts its own encoding.
+  //
+  if ((Length < (1 + FollowBytes)) || ((Start + Length) > End)) {
+    DEBUG ((DEBUG_ERROR, "PkgLength 0x%x at 0x%x overruns scope end 0x%x\n", Length, Start, End));
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  *Offset = Start + 1 + FollowBytes;
+  *PkgEnd = Start + Length;
+  return EFI_SUCCESS;
+}
+
+/**
+  Checks one NameSeg.
+
+  @param[in]  Seg  Four bytes of NameSeg.
+
+  @retval TRUE   Seg is a LeadNameChar followed by three NameChars.
+**/
+STATIC
+BOOLEAN
+IsNameSeg (
+  IN CONST UINT8  *Seg
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < 4; Index++) {
+    if ((Seg[Index] == '_') || ((Seg[Index] >= 'A') && (Seg[Index] <= 'Z'))) {
+      continue;
+    }
+
+    if ((Index != 0) && (Seg[Index] >= '0') && (Seg[Index] <= '9')) {
+      continue;
+    }
+
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Returns whether Byte can start a NameString.
+**/
+STATIC
+BOOLEAN
+IsNameStringStart (
+  IN UINT8  Byte
+  )
+{
+  return (BOOLEAN)((Byte == TEST_AML_ROOT_CHAR) ||
+                   (Byte == TEST_AML_PARENT_PREFIX) ||
+                   (Byte == TEST_AML_DUAL_NAME_PREFIX) ||
+                   (Byte == TEST_AML_MULTI_NAME_PREFIX) ||
+                   (Byte == '_') ||
+                   ((Byte >= 'A') && (Byte <= 'Z')));
+}
+
+/**
+  Decodes a NameString.
+
+  @param[in]      Parser  Parser state.
+  @param[in,out]  Offset  Offset of the NameString; advanced past it.
+  @param[in]      End     End of the enclosing scope.
+
+  @retval EFI_SUCCESS            NameString is well formed.
+  @retval EFI_VOLUME_CORRUPTED   NameString is malformed or overruns End.
+**/
+STATIC
+EFI_STATUS
+ParseNameString (
+  IN     AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End
+  )
+{
+  UINTN  Cursor;
+  UINTN  SegCount;
+
+  Cursor = *Offset;
+  if ((Cursor < End) && (Parser->Aml[Cursor] == TEST_AML_ROOT_CHAR)) {
+    Cursor++;
+  } else {
+    while ((Cursor < End) && (Parser->Aml[Cursor] == TEST_AML_PARENT_PREFIX)) {
+      Cursor++;
+    }
+  }
+
+  if (Cursor >= End) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  if (Parser->Aml[Cursor] == TEST_AML_ZERO_OP) {
+    *Offset = Cursor + 1;
+    return EFI_SUCCESS;
+  } else if (Parser->Aml[Cursor] == TEST_AML_DUAL_NAME_PREFIX) {
+    SegCount = 2;
+    Cursor++;
+  } else if (Parser->Aml[Cursor] == TEST_AML_MULTI_NAME_PREFIX) {
+    if ((Cursor + 1) >= End) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    SegCount = Parser->Aml[Cursor + 1];
+    Cursor  += 2;
+    if (SegCount < 3) {
+      DEBUG ((DEBUG_ERROR, "MultiNamePrefix at 0x%x with only %d segments\n", Cursor - 2, SegCount));
+      return EFI_VOLUME_CORRUPTED;
+    }
+  } else {
+    SegCount = 1;
+  }
+
+  for ( ; SegCount > 0; SegCount--) {
+    if (((Cursor + 4) > End) || !IsNameSeg (&Parser->Aml[Cursor])) {
+      DEBUG ((DEBUG_ERROR, "Bad NameSeg at 0x%x\n", Cursor));
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    Cursor += 4;
+  }
+
+  *Offset = Cursor;
+  return EFI_SUCCESS;
+}
+
+/**
+  Walks resource descriptors and checks they end with an End Tag that is the
+  last descriptor in the buffer.
+
+  @param[in]  Parser  Parser state.
+  @param[in]  Offset  First descriptor.
+  @param[in]  End     End of the buffer.
+
+  @retval EFI_SUCCESS            Descriptor list is well formed.
+  @retval EFI_VOLUME_CORRUPTED   A descriptor overruns End or no End Tag.
+**/
+STATIC
+EFI_STATUS
+ParseResourceTemplate (
+  IN AML_PARSER  *Parser,
+  IN UINTN       Offset,
+  IN UINTN       End
+  )
+{
+  UINT8  Tag;
+  UINTN  Length;
+
+  while (Offset < End) {
+    Tag = Parser->Aml[Offset];
+    if ((Tag & TEST_AML_LARGE_ITEM) != 0) {
+      if ((Offset + 3) > End) {
+        return EFI_VOLUME_CORRUPTED;
+      }
+
+      Length  = Parser->Aml[Offset + 1] | ((UINTN)Parser->Aml[Offset + 2] << 8);
+      Offset += 3 + Length;
+    } else {
+      Length  = Tag & 0x07;
+      Offset += 1 + Length;
+      if (Tag == TEST_AML_END_TAG) {
+        return (Offset == End) ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+      }
+    }
+  }
+
+  DEBUG ((DEBUG_ERROR, "Resource template ending at 0x%x has no End Tag\n", End));
+  return EFI_VOLUME_CORRUPTED;
+}
+
+/**
+  Decodes a Buffer, and if its ByteList looks like a resource template,
+  checks the descriptors as well.
+**/
+STATIC
+EFI_STATUS
+ParseBuffer (
+  IN OUT AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End,
+  IN     UINTN       Depth
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       PkgEnd;
+
+  Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  // BufferSize
+  Status = ParseTermArg (Parser, Offset, PkgEnd, Depth + 1);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (((PkgEnd - *Offset) >= 2) &&
+      (Parser->Aml[PkgEnd - 2] == TEST_AML_END_TAG))
+  {
+    Status = ParseResourceTemplate (Parser, *Offset, PkgEnd);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Parser->Stats.ResourceTemplates++;
+  }
+
+  *Offset = PkgEnd;
+  return EFI_SUCCESS;
+}
+
+/**
+  Decodes a Package or VarPackage and its elements.
+**/
+STATIC
+EFI_STATUS
+ParsePackage (
+  IN OUT AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End,
+  IN     UINTN       Depth,
+  IN     BOOLEAN     IsVarPackage
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       PkgEnd;
+  UINTN       NumElements;
+  UINTN       Elements;
+
+  Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  NumElements = MAX_UINTN;
+  if (IsVarPackage) {
+    Status = ParseTermArg (Parser, Offset, PkgEnd, Depth + 1);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  } else {
+    if (*Offset >= PkgEnd) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    NumElements = Parser->Aml[*Offset];
+    (*Offset)++;
+  }
+
+  for (Elements = 0; *Offset < PkgEnd; Elements++) {
+    Status = ParseTermArg (Parser, Offset, PkgEnd, Depth + 1);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  if (Elements > NumElements) {
+    DEBUG ((DEBUG_ERROR, "Package ending at 0x%x holds %d of %d elements\n", PkgEnd, Elements, NumElements));
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Parser->Stats.Packages++;
+  return EFI_SUCCESS;
+}
+
+/**
+  Decodes one term: a statement, an expression, a data object or a NameString.
+
+  @param[in,out]  Parser  Parser state.
+  @param[in,out]  Offset  Offset of the term; advanced past it.
+  @param[in]      End     End of the enclosing scope.
+  @param[in]      Depth   Nesting depth of the enclosing scope.
+
+  @retval EFI_SUCCESS            Term decoded.
+  @retval EFI_VOLUME_CORRUPTED   Term is malformed.
+  @retval EFI_UNSUPPORTED        Opcode is not one AmlGenerationLib emits.
+**/
+STATIC
+EFI_STATUS
+ParseTermArg (
+  IN OUT AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End,
+  IN     UINTN       Depth
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       OpOffset;
+  UINT8       Op;
+  UINTN       PkgEnd;
+
+  if (Depth > TEST_AML_MAX_PARSE_DEPTH) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Parser->Stats.MaxDepth = MAX (Parser->Stats.MaxDepth, Depth);
+
+  OpOffset = *Offset;
+  if (OpOffset >= End) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Op = Parser->Aml[OpOffset];
+  if (IsNameStringStart (Op)) {
+    return ParseNameString (Parser, Offset, End);
+  }
+
+  *Offset = OpOffset + 1;
+  switch (Op) {
+    case TEST_AML_ZERO_OP:
+    case TEST_AML_ONE_OP:
+    case TEST_AML_ONES_OP:
+      return EFI_SUCCESS;
+
+    case TEST_AML_BYTE_PREFIX:
+      *Offset += 1;
+      break;
+
+    case TEST_AML_WORD_PREFIX:
+      *Offset += 2;
+      break;
+
+    case TEST_AML_DWORD_PREFIX:
+      *Offset += 4;
+      break;
+
+    case TEST_AML_QWORD_PREFIX:
+      *Offset += 8;
+      break;
+
+    case TEST_AML_STRING_PREFIX:
+      while ((*Offset < End) && (Parser->Aml[*Offset] != '\0')) {
+        (*Offset)++;
+      }
+
+      // NullChar
+      *Offset += 1;
+      break;
+
+    case TEST_AML_NAME_OP:
+      Status = ParseNameString (Parser, Offset, End);
+      if (!EFI_ERROR (Status)) {
+        Status = ParseTermArg (Parser, Offset, End, Depth);
+      }
+
+      Parser->Stats.Names++;
+      return Status;
+
+    case TEST_AML_SCOPE_OP:
+      Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+      if (!EFI_ERROR (Status)) {
+        Status = ParseNameString (Parser, Offset, PkgEnd);
+      }
+
+      if (!EFI_ERROR (Status)) {
+        Status = ParseTermList (Parser, Offset, PkgEnd, Depth + 1);
+      }
+
+      Parser->Stats.Scopes++;
+      return Status;
+
+    case TEST_AML_METHOD_OP:
+      Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+      if (!EFI_ERROR (Status)) {
+        Status = ParseNameString (Parser, Offset, PkgEnd);
+      }
+
+      if (!EFI_ERROR (Status)) {
+        // MethodFlags
+        *Offset += 1;
+        Status   = ParseTermList (Parser, Offset, PkgEnd, Depth + 1);
+      }
+
+      Parser->Stats.Methods++;
+      return Status;
+
+    case TEST_AML_BUFFER_OP:
+      return ParseBuffer (Parser, Offset, End, Depth);
+
+    case TEST_AML_PACKAGE_OP:
+    case TEST_AML_VAR_PACKAGE_OP:
+      return ParsePackage (Parser, Offset, End, Depth, (BOOLEAN)(Op == TEST_AML_VAR_PACKAGE_OP));
+
+    case TEST_AML_STORE_OP:
+    case TEST_AML_LEQUAL_OP:
+      Status = ParseTermArg (Parser, Offset, End, Depth + 1);
+      if (!EFI_ERROR (Status)) {
+        Status = ParseTermArg (Parser, Offset, End, Depth + 1);
+      }
+
+      return Status;
+
+    case TEST_AML_RETURN_OP:
+      return ParseTermArg (Parser, Offset, End, Depth + 1);
+
+    case TEST_AML_IF_OP:
+      Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+      if (!EFI_ERROR (Status)) {
+        // Predicate
+        Status = ParseTermArg (Parser, Offset, PkgEnd, Depth + 1);
+      }
+
+      if (!EFI_ERROR (Status)) {
+        Status = ParseTermList (Parser, Offset, PkgEnd, Depth + 1);
+      }
+
+      return Status;
+
+    case TEST_AML_ELSE_OP:
+      Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+      if (!EFI_ERROR (Status)) {
+        Status = ParseTermList (Parser, Offset, PkgEnd, Depth + 1);
+      }
+
+      return Status;
+
+    case TEST_AML_EXT_OP:
+      if (*Offset >= End) {
+        return EFI_VOLUME_CORRUPTED;
+      }
+
+      Op = Parser->Aml[*Offset];
+      *Offset += 1;
+      switch (Op) {
+        case TEST_AML_EXT_DEVICE_OP:
+          Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+          if (!EFI_ERROR (Status)) {
+            Status = ParseNameString (Parser, Offset, PkgEnd);
+          }
+
+          if (!EFI_ERROR (Status)) {
+            Status = ParseTermList (Parser, Offset, PkgEnd, Depth + 1);
+          }
+
+          Parser->Stats.Devices++;
+          return Status;
+
+        case TEST_AML_EXT_REGION_OP:
+          Status = ParseNameString (Parser, Offset, End);
+          if (!EFI_ERROR (Status)) {
+            // RegionSpace
+            *Offset += 1;
+            Status   = ParseTermArg (Parser, Offset, End, Depth + 1);
+          }
+
+          if (!EFI_ERROR (Status)) {
+            Status = ParseTermArg (Parser, Offset, End, Depth + 1);
+          }
+
+          return Status;
+
+        case TEST_AML_EXT_FIELD_OP:
+          //
+          // The FieldList is only checked for staying inside its PkgLength.
+          //
+          Status = ParsePkgLength (Parser, Offset, End, &PkgEnd);
+          if (!EFI_ERROR (Status)) {
+            Status = ParseNameString (Parser, Offset, PkgEnd);
+          }
+
+          *Offset = PkgEnd;
+          return Status;
+
+        default:
+          break;
+      }
+
+      DEBUG ((DEBUG_ERROR, "Unsupported ExtOp 0x%02x at 0x%x\n", Op, OpOffset));
+      return EFI_UNSUPPORTED;
+
+    default:
+      if ((Op >= TEST_AML_LOCAL0) && (Op <= TEST_AML_ARG6)) {
+        return EFI_SUCCESS;
+      }
+
+      DEBUG ((DEBUG_ERROR, "Unsupported opcode 0x%02x at 0x%x\n", Op, OpOffset));
+      return EFI_UNSUPPORTED;
+  }
+
+  return (*Offset <= End) ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+}
+
+/**
+  Decodes terms until End, which must be reached exactly.
+**/
+STATIC
+EFI_STATUS
+ParseTermList (
+  IN OUT AML_PARSER  *Parser,
+  IN OUT UINTN       *Offset,
+  IN     UINTN       End,
+  IN     UINTN       Depth
+  )
+{
+  EFI_STATUS  Status;
+
+  while (*Offset < End) {
+    Status = ParseTermArg (Parser, Offset, End, Depth);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  return (*Offset == End) ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+}
+
+/**
+  Parses a complete definition block.
+
+  @param[in]   Table      Table returned by AmlGetCompletedTable.
+  @param[in]   TableSize  Size returned by AmlGetCompletedTable.
+  @param[out]  Stats      Objects found in the table.
+
+  @retval EFI_SUCCESS  Header length matches and the body parses cleanly.
+**/
+STATIC
+EFI_STATUS
+ParseDefinitionBlock (
+  IN  CONST VOID       *Table,
+  IN  UINTN            TableSize,
+  OUT AML_PARSE_STATS  *Stats
+  )
+{
+  AML_PARSER                         Parser;
+  CONST EFI_ACPI_DESCRIPTION_HEADER  *Header;
+  UINTN                              Offset;
+  EFI_STATUS                         Status;
+
+  if (TableSize < sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Header = Table;
+  if (Header->Length != TableSize) {
+    DEBUG ((DEBUG_ERROR, "Header length 0x%x, table size 0x%x\n", Header->Length, TableSize));
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  ZeroMem (&Parser, sizeof (Parser));
+  Parser.Aml  = Table;
+  Parser.Size = TableSize;
+  Offset      = sizeof (EFI_ACPI_DESCRIPTION_HEADER);
+  Status      = ParseTermList (&Parser, &Offset, TableSize, 0);
+  CopyMem (Stats, &Parser.Stats, sizeof (*Stats));
+  return Status;
+}
+
+/**
+  Builds a root bridge the way PciSsdt does for one host bridge: identity,
+  bus range, _CRS windows, a legacy-style _PRT and a Device per root port.
+
+  @param[in]      Index     Root bridge index.
+  @param[in]      Ports     Root ports below the bridge.
+  @param[in,out]  ListHead  Table being built.
+**/
+STATIC
+EFI_STATUS
+BuildRootBridge (
+  IN     UINTN       Index,
+  IN     UINTN       Ports,
+  IN OUT LIST_ENTRY  *ListHead
+  )
+{
+  EFI_STATUS  Status;
+  CHAR8       Name[5];
+  CHAR8       PortName[5];
+  UINT16      Bus;
+  UINT32      Mmio32;
+  UINT64      Mmio64;
+  UINTN       Port;
+  UINTN       Pin;
+
+  Bus    = (UINT16)((Index * 0x20) & 0xFF);
+  Mmio32 = 0xC0000000 + (UINT32)(Index * SIZE_16MB);
+  Mmio64 = 0x10000000000ULL + MultU64x32 (SIZE_64GB, (UINT32)Index);
+
+  AsciiSPrint (Name, sizeof (Name), "S%03X", Index);
+  Status  = AmlDevice (AmlStart, Name, ListHead);
+  Status |= AmlName (AmlStart, "_HID", ListHead);
+  Status |= AmlOPEisaId ("PNP0A08", ListHead);
+  Status |= AmlName (AmlClose, "_HID", ListHead);
+  Status |= AmlName (AmlStart, "_CID", ListHead);
+  Status |= AmlOPEisaId ("PNP0A03", ListHead);
+  Status |= AmlName (AmlClose, "_CID", ListHead);
+  Status |= AmlName (AmlStart, "_UID", ListHead);
+  Status |= AmlOPDataInteger (Index, ListHead);
+  Status |= AmlName (AmlClose, "_UID", ListHead);
+  Status |= AmlName (AmlStart, "_BBN", ListHead);
+  Status |= AmlOPDataInteger (Bus, ListHead);
+  Status |= AmlName (AmlClose, "_BBN", ListHead);
+  Status |= AmlName (AmlStart, "_SEG", ListHead);
+  Status |= AmlOPDataInteger (Index / 16, ListHead);
+  Status |= AmlName (AmlClose, "_SEG", ListHead);
+
+  Status |= AmlMethod (AmlStart, "_STA", 0, NotSerialized, 0, ListHead);
+  Status |= AmlReturn (AmlStart, ListHead);
+  Status |= AmlOPDataInteger (0x0F, ListHead);
+  Status |= AmlReturn (AmlClose, ListHead);
+  Status |= AmlMethod (AmlClose, "_STA", 0, NotSerialized, 0, ListHead);
+
+  Status |= AmlName (AmlStart, "_CRS", ListHead);
+  Status |= AmlResourceTemplate (AmlStart, ListHead);
+  Status |= AmlOPWordBusNumber (
+              EFI_ACPI_GENERAL_FLAG_RESOURCE_PRODUCER,
+              EFI_ACPI_GENERAL_FLAG_MIN_IS_FIXED,
+              EFI_ACPI_GENERAL_FLAG_MAX_IS_FIXED,
+              EFI_ACPI_GENERAL_FLAG_DECODE_POSITIVE,
+              0,
+              Bus,
+              Bus + 0x1F,
+              0,
+              0x20,
+              ListHead
+              );
+  Status |= AmlOPWordIO (
+              EFI_ACPI_GENERAL_FLAG_RESOURCE_PRODUCER,
+              EFI_ACPI_GENERAL_FLAG_MIN_IS_FIXED,
+              EFI_ACPI_GENERAL_FLAG_MAX_IS_FIXED,
+              EFI_ACPI_GENERAL_FLAG_DECODE_POSITIVE,
+              EFI_ACPI_IO_RESOURCE_SPECIFIC_FLAG_TYPE_RANGE_ENTIRE,
+              0,
+              0x1000,
+              0x1FFF,
+              0,
+              0x1000,
+              ListHead
+              );
+  Status |= AmlOPDWordMemory (
+              EFI_ACPI_GENERAL_FLAG_RESOURCE_PRODUCER,
+              EFI_ACPI_GENERAL_FLAG_DECODE_POSITIVE,
+              EFI_ACPI_GENERAL_FLAG_MIN_IS_FIXED,
+              EFI_ACPI_GENERAL_FLAG_MAX_IS_FIXED,
+              EFI_ACPI_MEMORY_RESOURCE_SPECIFIC_FLAG_NON_CACHEABLE,
+              EFI_ACPI_MEMORY_RESOURCE_SPECIFIC_FLAG_READ_WRITE,
+              0,
+              Mmio32,
+              Mmio32 + SIZE_16MB - 1,
+              0,
+              SIZE_16MB,
+              ListHead
+              );
+  Status |= AmlOPQWordMemory (
+              EFI_ACPI_GENERAL_FLAG_RESOURCE_PRODUCER,
+              EFI_ACPI_GENERAL_FLAG_DECODE_POSITIVE,
+              EFI_ACPI_GENERAL_FLAG_MIN_IS_FIXED,
+              EFI_ACPI_GENERAL_FLAG_MAX_IS_FIXED,
+              EFI_ACPI_MEMORY_RESOURCE_SPECIFIC_FLAG_NON_CACHEABLE,
+              EFI_ACPI_MEMORY_RESOURCE_SPECIFIC_FLAG_READ_WRITE,
+              0,
+              Mmio64,
+              Mmio64 + SIZE_64GB - 1,
+              0,
+              SIZE_64GB,
+              ListHead
+              );
+  Status |= AmlResourceTemplate (AmlClose, ListHead);
+  Status |= AmlName (AmlClose, "_CRS", ListHead);
+
+  Status |= AmlName (AmlStart, "_PRT", ListHead);
+  Status |= AmlPackage (AmlStart, 0, ListHead);
+  for (Port = 0; Port < Ports; Port++) {
+    for (Pin = 0; Pin < 4; Pin++) {
+      Status |= AmlPackage (AmlStart, 0, ListHead);
+      Status |= AmlOPDataInteger ((Port << 16) | 0xFFFF, ListHead);
+      Status |= AmlOPDataInteger (Pin, ListHead);
+      Status |= AmlOPDataInteger (0, ListHead);
+      Status |= AmlOPDataInteger (32 + Index * 32 + ((Port + Pin) % 4), ListHead);
+      Status |= AmlPackage (AmlClose, 0, ListHead);
+    }
+  }
+
+  Status |= AmlPackage (AmlClose, 0, ListHead);
+  Status |= AmlName (AmlClose, "_PRT", ListHead);
+
+  for (Port = 0; Port < Ports; Port++) {
+    AsciiSPrint (PortName, sizeof (PortName), "RP%02X", Port);
+    Status |= AmlDevice (AmlStart, PortName, ListHead);
+    Status |= AmlName (AmlStart, "_ADR", ListHead);
+    Status |= AmlOPDataInteger ((Port + 1) << 16, ListHead);
+    Status |= AmlName (AmlClose, "_ADR", ListHead);
+    Status |= AmlMethod (AmlStart, "_PRW", 0, NotSerialized, 0, ListHead);
+    Status |= AmlReturn (AmlStart, ListHead);
+    Status |= AmlPackage (AmlStart, 0, ListHead);
+    Status |= AmlOPDataInteger (0x08, ListHead);
+    Status |= AmlOPDataInteger (0x04, ListHead);
+    Status |= AmlPackage (AmlClose, 0, ListHead);
+    Status |= AmlReturn (AmlClose, ListHead);
+    Status |= AmlMethod (AmlClose, "_PRW", 0, NotSerialized, 0, ListHead);
+    Status |= AmlDevice (AmlClose, PortName, ListHead);
+  }
+
+  Status |= AmlDevice (AmlClose, Name, ListHead);
+  return (Status == EFI_SUCCESS) ? EFI_SUCCESS : EFI_DEVICE_ERROR;
+}
+
+/**
+  Builds a PciSsdt style table with RootBridges host bridges under \_SB.
+**/
+STATIC
+EFI_STATUS
+BuildPciSsdt (
+  IN     UINTN       RootBridges,
+  IN     UINTN       Ports,
+  IN OUT LIST_ENTRY  *ListHead
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  Status  = AmlDefinitionBlock (AmlStart, "SSDT", 2, "AMD", "PCISSDT", 1, "AMD ", 1, ListHead);
+  Status |= AmlScope (AmlStart, "\\_SB", ListHead);
+  for (Index = 0; (Index < RootBridges) && (Status == EFI_SUCCESS); Index++) {
+    Status |= BuildRootBridge (Index, Ports, ListHead);
+  }
+
+  Status |= AmlScope (AmlClose, "\\_SB", ListHead);
+  Status |= AmlDefinitionBlock (AmlClose, "SSDT", 2, "AMD", "PCISSDT", 1, "AMD ", 1, ListHead);
+  return (Status == EFI_SUCCESS) ? EFI_SUCCESS : EFI_DEVICE_ERROR;
+}
+
+/**
+  Builds a processor SSDT with one ACPI0007 Device per logical processor.
+**/
+STATIC
+EFI_STATUS
+BuildCpuSsdt (
+  IN     UINTN       Threads,
+  IN OUT LIST_ENTRY  *ListHead
+  )
+{
+  EFI_STATUS  Status;
+  CHAR8       Name[5];
+  UINTN       Index;
+
+  Status  = AmlDefinitionBlock (AmlStart, "SSDT", 2, "AMD", "CPUSSDT", 1, "AMD ", 1, ListHead);
+  Status |= AmlScope (AmlStart, "\\_SB", ListHead);
+  for (Index = 0; (Index < Threads) && (Status == EFI_SUCCESS); Index++) {
+    AsciiSPrint (Name, sizeof (Name), "C%03X", Index);
+    Status |= AmlDevice (AmlStart, Name, ListHead);
+    Status |= AmlName (AmlStart, "_HID", ListHead);
+    Status |= AmlOPDataString ("ACPI0007", ListHead);
+    Status |= AmlName (AmlClose, "_HID", ListHead);
+    Status |= AmlName (AmlStart, "_UID", ListHead);
+    Status |= AmlOPDataInteger (Index, ListHead);
+    Status |= AmlName (AmlClose, "_UID", ListHead);
+    Status |= AmlMethod (AmlStart, "_STA", 0, NotSerialized, 0, ListHead);
+    Status |= AmlIf (AmlStart, ListHead);
+    Status |= AmlLEqual (AmlStart, ListHead);
+    Status |= AmlOPLocalN (0, ListHead);
+    Status |= AmlOPDataInteger (0, ListHead);
+    Status |= AmlLEqual (AmlClose, ListHead);
+    Status |= AmlReturn (AmlStart, ListHead);
+    Status |= AmlOPDataInteger (0, ListHead);
+    Status |= AmlReturn (AmlClose, ListHead);
+    Status |= AmlIf (AmlClose, ListHead);
+    Status |= AmlReturn (AmlStart, ListHead);
+    Status |= AmlOPDataInteger (0x0F, ListHead);
+    Status |= AmlReturn (AmlClose, ListHead);
+    Status |= AmlMethod (AmlClose, "_STA", 0, NotSerialized, 0, ListHead);
+    Status |= AmlDevice (AmlClose, Name, ListHead);
+  }
+
+  Status |= AmlScope (AmlClose, "\\_SB", ListHead);
+  Status |= AmlDefinitionBlock (AmlClose, "SSDT", 2, "AMD", "CPUSSDT", 1, "AMD ", 1, ListHead);
+  return (Status == EFI_SUCCESS) ? EFI_SUCCESS : EFI_DEVICE_ERROR;
+}
+
+/**
+  Checks PkgLength encodings on both sides of the one, two, three and four
+  byte boundaries by wrapping Buffers of growing size in a Scope.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+PkgLengthBoundaries (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  STATIC CONST UINTN  BufferSizes[] = { 1, 55, 56, 57, 62, 63, 64, 4085, 4086, 4095, 4096, 70000, SIZE_1MB };
+  LIST_ENTRY          *ListHead;
+  UINT8               *Bytes;
+  VOID                *Table;
+  UINTN               TableSize;
+  UINTN               Index;
+  AML_PARSE_STATS     Stats;
+
+  Bytes = AllocateZeroPool (SIZE_1MB);
+  UT_ASSERT_NOT_NULL (Bytes);
+
+  for (Index = 0; Index < ARRAY_SIZE (BufferSizes); Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlDefinitionBlock (AmlStart, "SSDT", 2, "AMD", "PKGLEN", 1, "AMD ", 1, ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlScope (AmlStart, "\\_SB", ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlName (AmlStart, "BUF0", ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlBuffer (AmlStart, 0, ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlOPDataBufferFromArray (Bytes, BufferSizes[Index], ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlBuffer (AmlClose, 0, ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlName (AmlClose, "BUF0", ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlScope (AmlClose, "\\_SB", ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlDefinitionBlock (AmlClose, "SSDT", 2, "AMD", "PKGLEN", 1, "AMD ", 1, ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlGetCompletedTable (ListHead, &Table, &TableSize));
+
+    UT_LOG_INFO ("Buffer of %d bytes -> table of %d bytes\n", BufferSizes[Index], TableSize);
+    UT_ASSERT_NOT_EFI_ERROR (ParseDefinitionBlock (Table, TableSize, &Stats));
+    UT_ASSERT_EQUAL (Stats.Scopes, 1);
+    UT_ASSERT_EQUAL (Stats.Names, 1);
+    UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+  }
+
+  FreePool (Bytes);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Checks the NameString prefixes: RootChar, ParentPrefixChar, DualNamePrefix
+  and MultiNamePrefix, and padding of short NameSegs.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+NameStringEncoding (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  STATIC CONST struct {
+    CHAR8    *String;
+    UINT8    Encoding[16];
+    UINTN    EncodingSize;
+  } Cases[] = {
+    { "_SB",          { '_', 'S', 'B', '_' }, 4 },
+    { "\\_SB",        { '\\', '_', 'S', 'B', '_' }, 5 },
+    { "^^PC0",        { '^', '^', 'P', 'C', '0', '_' }, 6 },
+    { "\\_SB.PCI0",   { '\\', 0x2E, '_', 'S', 'B', '_', 'P', 'C', 'I', '0' }, 10 },
+    { "_SB.PCI0.RP0", { 0x2F, 3, '_', 'S', 'B', '_', 'P', 'C', 'I', '0', 'R', 'P', '0', '_' }, 14 },
+  };
+  LIST_ENTRY           *ListHead;
+  LIST_ENTRY           *Node;
+  AML_OBJECT_INSTANCE  *Object;
+  UINTN                Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (Cases); Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+    UT_ASSERT_NOT_EFI_ERROR (AmlOPNameString (Cases[Index].String, ListHead));
+
+    Node   = GetFirstNode (ListHead);
+    Object = AML_OBJECT_INSTANCE_FROM_LINK (Node);
+    UT_ASSERT_TRUE (Object->Completed);
+    UT_ASSERT_EQUAL (Object->DataSize, Cases[Index].EncodingSize);
+    UT_ASSERT_MEM_EQUAL (Object->Data, Cases[Index].Encoding, Cases[Index].EncodingSize);
+    UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+  }
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+  UT_ASSERT_STATUS_EQUAL (AmlOPNameString ("1ABC", ListHead), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (AmlOPNameString ("ABCDE", ListHead), EFI_INVALID_PARAMETER);
+  UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Builds a small PciSsdt style table and checks its shape object by object.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+PciSsdtRoundTrip (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  LIST_ENTRY       *ListHead;
+  VOID             *Table;
+  UINTN            TableSize;
+  AML_PARSE_STATS  Stats;
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (BuildPciSsdt (2, 4, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlGetCompletedTable (ListHead, &Table, &TableSize));
+  UT_ASSERT_NOT_EFI_ERROR (ParseDefinitionBlock (Table, TableSize, &Stats));
+
+  UT_ASSERT_EQUAL (Stats.Scopes, 1);
+  // Two root bridges with four root ports each
+  UT_ASSERT_EQUAL (Stats.Devices, 2 + 2 * 4);
+  // _STA per root bridge, _PRW per root port
+  UT_ASSERT_EQUAL (Stats.Methods, 2 + 2 * 4);
+  // _HID _CID _UID _BBN _SEG _CRS _PRT per root bridge, _ADR per root port
+  UT_ASSERT_EQUAL (Stats.Names, 2 * 7 + 2 * 4);
+  UT_ASSERT_EQUAL (Stats.ResourceTemplates, 2);
+  // _PRT and its entries per root bridge, _PRW return value per root port
+  UT_ASSERT_EQUAL (Stats.Packages, 2 * (1 + 4 * 4) + 2 * 4);
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Builds a small processor SSDT and checks its shape.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+CpuSsdtRoundTrip (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  LIST_ENTRY       *ListHead;
+  VOID             *Table;
+  UINTN            TableSize;
+  AML_PARSE_STATS  Stats;
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (BuildCpuSsdt (16, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlGetCompletedTable (ListHead, &Table, &TableSize));
+  UT_ASSERT_NOT_EFI_ERROR (ParseDefinitionBlock (Table, TableSize, &Stats));
+
+  UT_ASSERT_EQUAL (Stats.Devices, 16);
+  UT_ASSERT_EQUAL (Stats.Methods, 16);
+  UT_ASSERT_EQUAL (Stats.Names, 16 * 2);
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A Package with more than 255 elements is emitted as a VarPackage, and the
+  scopes around it still close to the right lengths.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+LargePackageRoundTrip (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  LIST_ENTRY       *ListHead;
+  VOID             *Table;
+  UINTN            TableSize;
+  UINT8            *Aml;
+  UINTN            Offset;
+  UINTN            Index;
+  AML_PARSE_STATS  Stats;
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlDefinitionBlock (AmlStart, "SSDT", 2, "AMD", "VARPKG", 1, "AMD ", 1, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlScope (AmlStart, "\\_SB", ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlName (AmlStart, "PKG0", ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlPackage (AmlStart, 300, ListHead));
+  for (Index = 0; Index < 300; Index++) {
+    UT_ASSERT_NOT_EFI_ERROR (AmlOPDataInteger (Index, ListHead));
+  }
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlPackage (AmlClose, 300, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlName (AmlClose, "PKG0", ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlName (AmlStart, "PKG1", ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlPackage (AmlStart, 2, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlOPDataInteger (0, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlOPDataInteger (1, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlPackage (AmlClose, 2, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlName (AmlClose, "PKG1", ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlScope (AmlClose, "\\_SB", ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlDefinitionBlock (AmlClose, "SSDT", 2, "AMD", "VARPKG", 1, "AMD ", 1, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlGetCompletedTable (ListHead, &Table, &TableSize));
+  UT_ASSERT_NOT_EFI_ERROR (ParseDefinitionBlock (Table, TableSize, &Stats));
+
+  UT_ASSERT_EQUAL (Stats.Names, 2);
+  UT_ASSERT_EQUAL (Stats.Packages, 2);
+
+  Aml = Table;
+  for (Offset = 0; Offset + 5 <= TableSize; Offset++) {
+    if (CompareMem (&Aml[Offset], "PKG0", 4) == 0) {
+      break;
+    }
+  }
+
+  UT_ASSERT_TRUE (Offset + 5 <= TableSize);
+  UT_ASSERT_EQUAL (Aml[Offset + 4], TEST_AML_VAR_PACKAGE_OP);
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Closing a scope that was never opened must fail rather than emit a table.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnbalancedClose (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  LIST_ENTRY  *ListHead;
+  VOID        *Table;
+  UINTN       TableSize;
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlDefinitionBlock (AmlStart, "SSDT", 2, "AMD", "UNBAL", 1, "AMD ", 1, ListHead));
+  UT_ASSERT_NOT_EFI_ERROR (AmlDevice (AmlStart, "DEV0", ListHead));
+  UT_ASSERT_TRUE (EFI_ERROR (AmlDevice (AmlClose, "DEV1", ListHead)));
+  UT_ASSERT_TRUE (EFI_ERROR (AmlGetCompletedTable (ListHead, &Table, &TableSize)));
+  UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Generates the benchmark topology, parses it and logs bytes emitted, pool
+  allocations, peak pool use and generation time.
+
+  @param[in]  Context  Points to the UINTN selecting the table: 0 for the
+                       PciSsdt style table, 1 for the processor SSDT.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+GenerationBenchmark (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  LIST_ENTRY           *ListHead;
+  VOID                 *Table;
+  UINTN                TableSize;
+  AML_PARSE_STATS      Stats;
+  ALLOCATION_COUNTERS  Counters;
+  clock_t              Start;
+  clock_t              Elapsed;
+  BOOLEAN              IsCpuSsdt;
+
+  IsCpuSsdt = (BOOLEAN)(*(CONST UINTN *)Context != 0);
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlInitializeTableList (&ListHead));
+  ResetAllocationCounters ();
+  Start = clock ();
+  if (IsCpuSsdt) {
+    UT_ASSERT_NOT_EFI_ERROR (BuildCpuSsdt (BENCH_SOCKETS * BENCH_THREADS_PER_SOCKET, ListHead));
+  } else {
+    UT_ASSERT_NOT_EFI_ERROR (
+      BuildPciSsdt (
+        BENCH_SOCKETS * BENCH_ROOT_BRIDGES_PER_SOCKET,
+        BENCH_PORTS_PER_ROOT_BRIDGE,
+        ListHead
+        )
+      );
+  }
+
+  Elapsed = clock () - Start;
+  GetAllocationCounters (&Counters);
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlGetCompletedTable (ListHead, &Table, &TableSize));
+  UT_ASSERT_NOT_EFI_ERROR (ParseDefinitionBlock (Table, TableSize, &Stats));
+  if (IsCpuSsdt) {
+    UT_ASSERT_EQUAL (Stats.Devices, BENCH_SOCKETS * BENCH_THREADS_PER_SOCKET);
+  } else {
+    UT_ASSERT_EQUAL (
+      Stats.Devices,
+      BENCH_SOCKETS * BENCH_ROOT_BRIDGES_PER_SOCKET * (1 + BENCH_PORTS_PER_ROOT_BRIDGE)
+      );
+  }
+
+  UT_LOG_INFO (
+    "%a: %d bytes emitted, %d allocations (%d bytes), peak %d bytes in use, %d us\n",
+    IsCpuSsdt ? "CPU SSDT" : "PCI SSDT",
+    TableSize,
+    Counters.Allocations,
+    Counters.BytesAllocated,
+    Counters.PeakBytesInUse,
+    (UINTN)(((UINT64)Elapsed * 1000000) / CLOCKS_PER_SEC)
+    );
+
+  UT_ASSERT_NOT_EFI_ERROR (AmlReleaseTableList (&ListHead));
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  AmlGenerationLib and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  STATIC UINTN                PciSsdtContext = 0;
+  STATIC UINTN                CpuSsdtContext = 1;
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      EncodingSuite;
+  UNIT_TEST_SUITE_HANDLE      BenchmarkSuite;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&EncodingSuite, Framework, "AML Encoding Tests", "AmlGenerationLib.Encoding", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for AML Encoding Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (EncodingSuite, "PkgLength encodes one to four bytes", "PkgLengthBoundaries", PkgLengthBoundaries, NULL, NULL, NULL);
+  AddTestCase (EncodingSuite, "NameString prefixes and padding", "NameStringEncoding", NameStringEncoding, NULL, NULL, NULL);
+  AddTestCase (EncodingSuite, "PciSsdt style table parses back", "PciSsdtRoundTrip", PciSsdtRoundTrip, NULL, NULL, NULL);
+  AddTestCase (EncodingSuite, "CPU SSDT parses back", "CpuSsdtRoundTrip", CpuSsdtRoundTrip, NULL, NULL, NULL);
+  AddTestCase (EncodingSuite, "Package over 255 elements parses back", "LargePackageRoundTrip", LargePackageRoundTrip, NULL, NULL, NULL);
+  AddTestCase (EncodingSuite, "Mismatched close is rejected", "UnbalancedClose", UnbalancedClose, NULL, NULL, NULL);
+
+  Status = CreateUnitTestSuite (&BenchmarkSuite, Framework, "AML Generation Benchmark", "AmlGenerationLib.Benchmark", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for AML Generation Benchmark\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (BenchmarkSuite, "Four socket PciSsdt style table", "PciSsdt", GenerationBenchmark, NULL, NULL, &PciSsdtContext);
+  AddTestCase (BenchmarkSuite, "Four socket CPU SSDT", "CpuSsdt", GenerationBenchmark, NULL, NULL, &CpuSsdtContext);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
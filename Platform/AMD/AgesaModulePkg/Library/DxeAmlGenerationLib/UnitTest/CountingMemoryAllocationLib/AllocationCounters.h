@@ -0,0 +1,42 @@
+/** @file
+  Allocation counters exposed by CountingMemoryAllocationLib so host based
+  tests can report how much pool a library consumed.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef ALLOCATION_COUNTERS_H_
+#define ALLOCATION_COUNTERS_H_
+
+typedef struct {
+  UINTN    Allocations;     // Pool allocations, including reallocations
+  UINTN    Frees;           // Pool frees
+  UINTN    BytesAllocated;  // Total bytes handed out since the last reset
+  UINTN    BytesInUse;      // Bytes currently allocated and not yet freed
+  UINTN    PeakBytesInUse;  // High-water mark of BytesInUse since the last reset
+} ALLOCATION_COUNTERS;
+
+/**
+  Returns a snapshot of the pool allocation counters.
+
+  @param[out]  Counters  Receives the current counter values.
+**/
+VOID
+EFIAPI
+GetAllocationCounters (
+  OUT ALLOCATION_COUNTERS  *Counters
+  );
+
+/**
+  Zeroes the allocation counters. BytesInUse is kept so that pool allocated
+  before the reset and freed afterwards does not underflow it; the peak restarts
+  from the bytes currently in use.
+**/
+VOID
+EFIAPI
+ResetAllocationCounters (
+  VOID
+  );
+
+#endif // ALLOCATION_COUNTERS_H_
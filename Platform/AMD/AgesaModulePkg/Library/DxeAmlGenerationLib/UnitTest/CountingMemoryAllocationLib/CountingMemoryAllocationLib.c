@@ -0,0 +1,391 @@
+/** @file
+  Host based MemoryAllocationLib instance that counts pool allocations.
+
+  Pool buffers carry a small header recording their size so FreePool and
+  ReallocatePool can keep BytesInUse exact. Page allocations are served from
+  the C heap as well but are not counted; the code this instance is meant to
+  measure only uses pool.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdlib.h>
+
+#include <Uefi.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#include "AllocationCounters.h"
+
+#define POOL_HEAD_SIGNATURE  SIGNATURE_32 ('c', 'p', 'h', 'd')
+#define PAGE_HEAD_SIGNATURE  SIGNATURE_32 ('c', 'p', 'g', 'h')
+
+//
+// Sixteen bytes so the buffer handed out keeps malloc's alignment.
+//
+typedef struct {
+  UINT32    Signature;
+  UINT32    Reserved;
+  UINT64    Size;
+} POOL_HEAD;
+
+typedef struct {
+  UINT32    Signature;
+  UINT32    Reserved;
+  VOID      *Allocation;
+  UINTN     Pages;
+} PAGE_HEAD;
+
+STATIC ALLOCATION_COUNTERS  mCounters;
+
+/**
+  Returns a snapshot of the pool allocation counters.
+
+  @param[out]  Counters  Receives the current counter values.
+**/
+VOID
+EFIAPI
+GetAllocationCounters (
+  OUT ALLOCATION_COUNTERS  *Counters
+  )
+{
+  CopyMem (Counters, &mCounters, sizeof (mCounters));
+}
+
+/**
+  Zeroes the allocation counters. BytesInUse is kept so that pool allocated
+  before the reset and freed afterwards does not underflow it; the peak restarts
+  from the bytes currently in use.
+**/
+VOID
+EFIAPI
+ResetAllocationCounters (
+  VOID
+  )
+{
+  mCounters.Allocations    = 0;
+  mCounters.Frees          = 0;
+  mCounters.BytesAllocated = 0;
+  mCounters.PeakBytesInUse = mCounters.BytesInUse;
+}
+
+/**
+  Allocates a counted pool buffer.
+
+  @param[in]  AllocationSize  Bytes to allocate.
+
+  @return  Buffer, or NULL if the C heap is exhausted.
+**/
+STATIC
+VOID *
+InternalAllocateCountedPool (
+  IN UINTN  AllocationSize
+  )
+{
+  POOL_HEAD  *Head;
+
+  Head = malloc (sizeof (POOL_HEAD) + AllocationSize);
+  if (Head == NULL) {
+    return NULL;
+  }
+
+  Head->Signature = POOL_HEAD_SIGNATURE;
+  Head->Reserved  = 0;
+  Head->Size      = AllocationSize;
+
+  mCounters.Allocations++;
+  mCounters.BytesAllocated += AllocationSize;
+  mCounters.BytesInUse     += AllocationSize;
+  if (mCounters.BytesInUse > mCounters.PeakBytesInUse) {
+    mCounters.PeakBytesInUse = mCounters.BytesInUse;
+  }
+
+  return Head + 1;
+}
+
+/**
+  Returns the header of a buffer handed out by InternalAllocateCountedPool.
+
+  @param[in]  Buffer  Pool buffer.
+
+  @return  Header preceding Buffer.
+**/
+STATIC
+POOL_HEAD *
+InternalPoolHead (
+  IN VOID  *Buffer
+  )
+{
+  POOL_HEAD  *Head;
+
+  Head = (POOL_HEAD *)Buffer - 1;
+  ASSERT (Head->Signature == POOL_HEAD_SIGNATURE);
+  return Head;
+}
+
+VOID *
+EFIAPI
+AllocatePool (
+  IN UINTN  AllocationSize
+  )
+{
+  return InternalAllocateCountedPool (AllocationSize);
+}
+
+VOID *
+EFIAPI
+AllocateRuntimePool (
+  IN UINTN  AllocationSize
+  )
+{
+  return InternalAllocateCountedPool (AllocationSize);
+}
+
+VOID *
+EFIAPI
+AllocateReservedPool (
+  IN UINTN  AllocationSize
+  )
+{
+  return InternalAllocateCountedPool (AllocationSize);
+}
+
+VOID *
+EFIAPI
+AllocateZeroPool (
+  IN UINTN  AllocationSize
+  )
+{
+  VOID  *Buffer;
+
+  Buffer = InternalAllocateCountedPool (AllocationSize);
+  if (Buffer != NULL) {
+    ZeroMem (Buffer, AllocationSize);
+  }
+
+  return Buffer;
+}
+
+VOID *
+EFIAPI
+AllocateRuntimeZeroPool (
+  IN UINTN  AllocationSize
+  )
+{
+  return AllocateZeroPool (AllocationSize);
+}
+
+VOID *
+EFIAPI
+AllocateReservedZeroPool (
+  IN UINTN  AllocationSize
+  )
+{
+  return AllocateZeroPool (AllocationSize);
+}
+
+VOID *
+EFIAPI
+AllocateCopyPool (
+  IN UINTN       AllocationSize,
+  IN CONST VOID  *Buffer
+  )
+{
+  VOID  *Memory;
+
+  ASSERT (Buffer != NULL);
+
+  Memory = InternalAllocateCountedPool (AllocationSize);
+  if (Memory != NULL) {
+    CopyMem (Memory, Buffer, AllocationSize);
+  }
+
+  return Memory;
+}
+
+VOID *
+EFIAPI
+AllocateRuntimeCopyPool (
+  IN UINTN       AllocationSize,
+  IN CONST VOID  *Buffer
+  )
+{
+  return AllocateCopyPool (AllocationSize, Buffer);
+}
+
+VOID *
+EFIAPI
+AllocateReservedCopyPool (
+  IN UINTN       AllocationSize,
+  IN CONST VOID  *Buffer
+  )
+{
+  return AllocateCopyPool (AllocationSize, Buffer);
+}
+
+VOID
+EFIAPI
+FreePool (
+  IN VOID  *Buffer
+  )
+{
+  POOL_HEAD  *Head;
+
+  ASSERT (Buffer != NULL);
+
+  Head = InternalPoolHead (Buffer);
+  mCounters.Frees++;
+  mCounters.BytesInUse -= (UINTN)Head->Size;
+  Head->Signature       = 0;
+  free (Head);
+}
+
+VOID *
+EFIAPI
+ReallocatePool (
+  IN UINTN  OldSize,
+  IN UINTN  NewSize,
+  IN VOID   *OldBuffer  OPTIONAL
+  )
+{
+  VOID  *NewBuffer;
+
+  NewBuffer = AllocateZeroPool (NewSize);
+  if ((NewBuffer != NULL) && (OldBuffer != NULL)) {
+    CopyMem (NewBuffer, OldBuffer, MIN (OldSize, NewSize));
+    FreePool (OldBuffer);
+  }
+
+  return NewBuffer;
+}
+
+VOID *
+EFIAPI
+ReallocateRuntimePool (
+  IN UINTN  OldSize,
+  IN UINTN  NewSize,
+  IN VOID   *OldBuffer  OPTIONAL
+  )
+{
+  return ReallocatePool (OldSize, NewSize, OldBuffer);
+}
+
+VOID *
+EFIAPI
+ReallocateReservedPool (
+  IN UINTN  OldSize,
+  IN UINTN  NewSize,
+  IN VOID   *OldBuffer  OPTIONAL
+  )
+{
+  return ReallocatePool (OldSize, NewSize, OldBuffer);
+}
+
+VOID *
+EFIAPI
+AllocateAlignedPages (
+  IN UINTN  Pages,
+  IN UINTN  Alignment
+  )
+{
+  UINT8      *Allocation;
+  UINTN      Aligned;
+  PAGE_HEAD  *Head;
+
+  if (Pages == 0) {
+    return NULL;
+  }
+
+  if (Alignment < EFI_PAGE_SIZE) {
+    Alignment = EFI_PAGE_SIZE;
+  }
+
+  Allocation = malloc (EFI_PAGES_TO_SIZE (Pages) + Alignment + sizeof (PAGE_HEAD));
+  if (Allocation == NULL) {
+    return NULL;
+  }
+
+  Aligned          = ALIGN_VALUE ((UINTN)Allocation + sizeof (PAGE_HEAD), Alignment);
+  Head             = (PAGE_HEAD *)Aligned - 1;
+  Head->Signature  = PAGE_HEAD_SIGNATURE;
+  Head->Allocation = Allocation;
+  Head->Pages      = Pages;
+  return (VOID *)Aligned;
+}
+
+VOID *
+EFIAPI
+AllocateAlignedRuntimePages (
+  IN UINTN  Pages,
+  IN UINTN  Alignment
+  )
+{
+  return AllocateAlignedPages (Pages, Alignment);
+}
+
+VOID *
+EFIAPI
+AllocateAlignedReservedPages (
+  IN UINTN  Pages,
+  IN UINTN  Alignment
+  )
+{
+  return AllocateAlignedPages (Pages, Alignment);
+}
+
+VOID
+EFIAPI
+FreeAlignedPages (
+  IN VOID   *Buffer,
+  IN UINTN  Pages
+  )
+{
+  PAGE_HEAD  *Head;
+
+  ASSERT (Buffer != NULL);
+
+  Head = (PAGE_HEAD *)Buffer - 1;
+  ASSERT (Head->Signature == PAGE_HEAD_SIGNATURE);
+  ASSERT (Head->Pages == Pages);
+  Head->Signature = 0;
+  free (Head->Allocation);
+}
+
+VOID *
+EFIAPI
+AllocatePages (
+  IN UINTN  Pages
+  )
+{
+  return AllocateAlignedPages (Pages, EFI_PAGE_SIZE);
+}
+
+VOID *
+EFIAPI
+AllocateRuntimePages (
+  IN UINTN  Pages
+  )
+{
+  return AllocateAlignedPages (Pages, EFI_PAGE_SIZE);
+}
+
+VOID *
+EFIAPI
+AllocateReservedPages (
+  IN UINTN  Pages
+  )
+{
+  return AllocateAlignedPages (Pages, EFI_PAGE_SIZE);
+}
+
+VOID
+EFIAPI
+FreePages (
+  IN VOID   *Buffer,
+  IN UINTN  Pages
+  )
+{
+  FreeAlignedPages (Buffer, Pages);
+}
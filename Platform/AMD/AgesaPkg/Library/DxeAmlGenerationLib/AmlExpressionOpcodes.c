@@ -54,7 +54,10 @@ AmlBuffer (
   AML_OBJECT_INSTANCE  *Object;
   AML_OBJECT_INSTANCE  *ChildObject;
   UINTN                ChildCount;
+  UINTN                ChildDataSize;
   UINTN                InternalBufferSize;
+  UINT8                *EncodedData;
+  UINTN                EncodedDataSize;
 
   Status      = EFI_DEVICE_ERROR;
   Object      = NULL;
@@ -75,7 +78,7 @@ AmlBuffer (
   switch (Phase) {
     case AmlStart:
       // Start the Buffer Object
-      Status = InternalAppendNewAmlObject (&Object, "BUFFER", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "BUFFER", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BUFFER object\n", __FUNCTION__));
         goto Done;
@@ -89,7 +92,12 @@ AmlBuffer (
       }
 
       // Start BufferSize
-      Status = InternalAppendNewAmlObject (&Object, "BUFFERSIZE", ListHead);
+      Status = InternalAppendNewAmlObject (
+                 &Object,
+                 "BUFFERSIZE",
+                 MAX_AML_DATA_INTEGER_ENCODING_SIZE,
+                 ListHead
+                 );
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BUFFERSIZE object\n", __FUNCTION__));
         goto Done;
@@ -112,24 +120,11 @@ AmlBuffer (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
-                 &ChildCount,
-                 &Object->Link,
-                 ListHead
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect BufferSize children\n", __FUNCTION__));
-        goto Done;
-      }
-
       // Set BufferSize Object to correct value and size.
       // BufferSize should be from zero (no Child Data) to MAX of requested
-      // BufferSize or size required for ChildObject->Data.
-      InternalBufferSize = MAX (BufferSize, ChildObject->DataSize);
+      // BufferSize or size required for the ByteList.
+      ChildDataSize      = InternalAmlChildrenDataSize (NULL, &Object->Link, ListHead);
+      InternalBufferSize = MAX (BufferSize, ChildDataSize);
       // iASL compiler 20200110 only keeps lower 32 bits of size.  We'll error if
       // someone requests something >= 4GB size.
       if (InternalBufferSize >= SIZE_4GB) {
@@ -145,38 +140,31 @@ AmlBuffer (
 
       Status = InternalAmlDataIntegerBuffer (
                  InternalBufferSize,
-                 (VOID **)&Object->Data,
-                 &Object->DataSize
+                 (VOID **)&EncodedData,
+                 &EncodedDataSize
                  );
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: calc BufferSize\n", __FUNCTION__));
         goto Done;
       }
 
-      if ((ChildObject->DataSize != 0) && (ChildObject->Data != NULL)) {
-        // Make room for ChildObject->Data
-        Object->Data = ReallocatePool (
-                         Object->DataSize,
-                         Object->DataSize +
-                         ChildObject->DataSize,
-                         Object->Data
-                         );
-        if (Object->Data == NULL) {
-          DEBUG ((DEBUG_ERROR, "%a: ERROR: to reallocate BufferSize\n", __FUNCTION__));
-          Status = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
+      // Collect child data behind the encoded BufferSize and delete children
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 EncodedDataSize,
+                 &ChildCount,
+                 ListHead
+                 );
+      if (!EFI_ERROR (Status)) {
+        CopyMem (Object->Data, EncodedData, EncodedDataSize);
+      }
 
-        CopyMem (
-          &Object->Data[Object->DataSize],
-          ChildObject->Data,
-          ChildObject->DataSize
-          );
-        Object->DataSize += ChildObject->DataSize;
+      FreePool (EncodedData);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect BufferSize children\n", __FUNCTION__));
+        goto Done;
       }
 
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       // Close required PkgLength before finishing Object
@@ -193,42 +181,19 @@ AmlBuffer (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      //  BufferOp is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-
-      // Buffer must have at least PkgLength BufferSize
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: No Buffer Data\n", __FUNCTION__));
         goto Done;
       }
 
-      //  BufferOp is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Buffer allocate failed\n", __FUNCTION__));
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Done;
-      }
-
       Object->Data[0] = AML_BUFFER_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -287,7 +252,7 @@ AmlLEqual (
   switch (Phase) {
     case AmlStart:
       // Start the LEqual Object
-      Status = InternalAppendNewAmlObject (&Object, "LEQUAL", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "LEQUAL", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start LEQUAL object\n", __FUNCTION__));
         goto Done;
@@ -309,42 +274,19 @@ AmlLEqual (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      //  LequalOp is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-
-      // LEqual must have at least two operands
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: No LEqual Args\n", __FUNCTION__));
         goto Done;
       }
 
-      //  LequalOp is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Buffer allocate failed\n", __FUNCTION__));
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Done;
-      }
-
       Object->Data[0] = AML_LEQUAL_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -396,6 +338,8 @@ InternalAmlNumElements (
   AML_OBJECT_INSTANCE  *Object;
   AML_OBJECT_INSTANCE  *ChildObject;
   UINTN                ChildCount;
+  UINT8                *EncodedData;
+  UINTN                EncodedDataSize;
 
   Status      = EFI_DEVICE_ERROR;
   Object      = NULL;
@@ -409,7 +353,9 @@ InternalAmlNumElements (
   switch (Phase) {
     case AmlStart:
       // Start Number of Elements Object
-      Status = InternalAppendNewAmlObject (&Object, "NUM_ELEMENTS", ListHead);
+      // Room for the ByteData NumElements of a Package, a VarPackage with
+      // more elements makes room when it closes
+      Status = InternalAppendNewAmlObject (&Object, "NUM_ELEMENTS", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start NUM_ELEMENTS object\n", __FUNCTION__));
         goto Done;
@@ -432,19 +378,7 @@ InternalAmlNumElements (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
-                 &ChildCount,
-                 &Object->Link,
-                 ListHead
-                 );
-      if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect NUM_ELEMENTS children\n", __FUNCTION__));
-        goto Done;
-      }
+      InternalAmlChildrenDataSize (&ChildCount, &Object->Link, ListHead);
 
       // We do not have to change anything for NumElements >= Child Count
       if (*NumElements == 0) {
@@ -456,20 +390,20 @@ InternalAmlNumElements (
       }
 
       if (*NumElements <= MAX_UINT8) {
-        Object->DataSize = 1;
-        Object->Data     = AllocateZeroPool (Object->DataSize);
-        if (Object->Data == NULL) {
+        EncodedDataSize = 1;
+        EncodedData     = AllocateZeroPool (EncodedDataSize);
+        if (EncodedData == NULL) {
           DEBUG ((DEBUG_ERROR, "%a: ERROR: NumElements allocate failed\n", __FUNCTION__));
           Status = EFI_OUT_OF_RESOURCES;
           goto Done;
         }
 
-        Object->Data[0] = (UINT8)*NumElements;
+        EncodedData[0] = (UINT8)*NumElements;
       } else {
         Status = InternalAmlDataIntegerBuffer (
                    *NumElements,
-                   (VOID **)&Object->Data,
-                   &Object->DataSize
+                   (VOID **)&EncodedData,
+                   &EncodedDataSize
                    );
         if (EFI_ERROR (Status)) {
           DEBUG ((DEBUG_ERROR, "%a: ERROR: calc NumElements\n", __FUNCTION__));
@@ -477,30 +411,23 @@ InternalAmlNumElements (
         }
       }
 
-      if ((ChildObject->DataSize != 0) && (ChildObject->Data != NULL)) {
-        // Make room for ChildObject->Data
-        Object->Data = ReallocatePool (
-                         Object->DataSize,
-                         Object->DataSize +
-                         ChildObject->DataSize,
-                         Object->Data
-                         );
-        if (Object->Data == NULL) {
-          DEBUG ((DEBUG_ERROR, "%a: ERROR: to reallocate NumElements\n", __FUNCTION__));
-          Status = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
+      // Collect child data behind the encoded NumElements and delete children
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 EncodedDataSize,
+                 &ChildCount,
+                 ListHead
+                 );
+      if (!EFI_ERROR (Status)) {
+        CopyMem (Object->Data, EncodedData, EncodedDataSize);
+      }
 
-        CopyMem (
-          &Object->Data[Object->DataSize],
-          ChildObject->Data,
-          ChildObject->DataSize
-          );
-        Object->DataSize += ChildObject->DataSize;
+      FreePool (EncodedData);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: collect NUM_ELEMENTS children\n", __FUNCTION__));
+        goto Done;
       }
 
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -568,7 +495,7 @@ AmlPackage (
   switch (Phase) {
     case AmlStart:
       // Start the Package Object
-      Status = InternalAppendNewAmlObject (&Object, "PACKAGE", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "PACKAGE", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start PACKAGE object\n", __FUNCTION__));
         goto Done;
@@ -621,41 +548,19 @@ AmlPackage (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      //  PackageOp and VarPackageOp are both one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      // Package must have at least PkgLength NumElements
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: No Package Data\n", __FUNCTION__));
         goto Done;
       }
 
-      //  PackageOp and VarPackageOp are both one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Package allocate failed\n", __FUNCTION__));
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Done;
-      }
-
       Object->Data[0] = OpCode;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      // Free Child Object since it has been consumed
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -716,7 +621,7 @@ AmlStore (
   switch (Phase) {
     case AmlStart:
       // Start Store expression
-      Status = InternalAppendNewAmlObject (&Object, "STORE", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "STORE", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append STORE object\n", __FUNCTION__));
         goto Done;
@@ -735,42 +640,23 @@ AmlStore (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Store Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __FUNCTION__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
         goto Done;
       }
 
-      // Store Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Store object
       Object->Data[0] = AML_STORE_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -841,7 +727,7 @@ InternalAmlShift (
   switch (Phase) {
     case AmlStart:
       // Start Store expression
-      Status = InternalAppendNewAmlObject (&Object, "SHIFT", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "SHIFT", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append SHIFT object\n", __FUNCTION__));
         goto Done;
@@ -861,42 +747,23 @@ InternalAmlShift (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Shift Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __FUNCTION__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
         goto Done;
       }
 
-      // Store Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Store object
       Object->Data[0] = ShiftOp;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1034,7 +901,7 @@ InternalAmlFindSetBit (
   switch (Phase) {
     case AmlStart:
       // Start Store expression
-      Status = InternalAppendNewAmlObject (&Object, "FINDSET", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "FINDSET", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append FIND_SET object\n", __FUNCTION__));
         goto Done;
@@ -1054,42 +921,23 @@ InternalAmlFindSetBit (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // FindSetBit Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __FUNCTION__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
         goto Done;
       }
 
-      // Store Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Store object
       Object->Data[0] = FindSetOp;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1215,7 +1063,7 @@ AmlDecrement (
   switch (Phase) {
     case AmlStart:
       // Start decrement expression
-      Status = InternalAppendNewAmlObject (&Object, "DECREMENT", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "DECREMENT", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append DECREMENT object\n", __FUNCTION__));
         goto Done;
@@ -1235,42 +1083,23 @@ AmlDecrement (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Decrement Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for Store()\n", __FUNCTION__));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: Store() has no child data.\n", __FUNCTION__));
         goto Done;
       }
 
-      // Decrement Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-
-      // Fill out Decrement object
       Object->Data[0] = AML_DECREMENT_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -52,7 +52,7 @@ AmlDevice (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, String, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, String, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Device for %a object\n", __FUNCTION__, String));
         goto Done;
@@ -91,40 +91,20 @@ AmlDevice (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Device Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, String));
         goto Done;
       }
 
-      // Device Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, String));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_DEVICE_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -402,7 +382,7 @@ AmlOPExternal (
   ChildObject = NULL;
 
   // Start EXTERNAL object
-  Status = InternalAppendNewAmlObject (&Object, "EXTERNAL", ListHead);
+  Status = InternalAppendNewAmlObject (&Object, "EXTERNAL", 1, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: Start %a object\n", __FUNCTION__, Name));
     goto Done;
@@ -421,46 +401,43 @@ AmlOPExternal (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // ObjectType + ArgumentCount go after Name
+  Status = InternalAppendNewAmlObjectNoData (&ChildObject, ListHead);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: append ObjectType for %a\n", __FUNCTION__, Name));
+    goto Done;
+  }
+
+  ChildObject->Data = AllocatePool (2);
+  if (ChildObject->Data == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate ObjectType for %a\n", __FUNCTION__, Name));
+    goto Done;
+  }
+
+  ChildObject->Data[0]   = ObjectType;
+  ChildObject->Data[1]   = NumArgs;
+  ChildObject->DataSize  = 2;
+  ChildObject->Completed = TRUE;
+  ChildObject            = NULL;
+
+  // AML_EXTERNAL_OP + Name + ObjectType + ArgumentCount
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             1,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, Name));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount < 2)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  Object->Data = AllocateZeroPool (ChildObject->DataSize + 3);
-  // AML_EXTERNAL_OP + Name + ObjectType + ArgumentCount
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, Name));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, Name));
     goto Done;
   }
 
-  Object->DataSize = 0;
-  Object->Data[0]  = AML_EXTERNAL_OP;
-  Object->DataSize++;
-  CopyMem (
-    &Object->Data[Object->DataSize],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  Object->DataSize              += ChildObject->DataSize;
-  Object->Data[Object->DataSize] = ObjectType;
-  Object->DataSize++;
-  Object->Data[Object->DataSize] = NumArgs;
-  Object->DataSize++;
-
-  InternalFreeAmlObject (&ChildObject, ListHead);
+  Object->Data[0] = AML_EXTERNAL_OP;
   Object->Completed = TRUE;
   Status            = EFI_SUCCESS;
 
@@ -792,7 +769,7 @@ AmlField (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Field for %a object\n", __FUNCTION__, Name));
         goto Done;
@@ -805,9 +782,9 @@ AmlField (
         goto Done;
       }
 
-      Object->DataSize  = sizeof (UINT64);
-      Object->Data      = AllocateZeroPool (Object->DataSize);
-      Object->Completed = TRUE;
+      // Never completed, so it is not collected into the Field data
+      Object->DataSize = sizeof (UINT64);
+      Object->Data     = AllocateZeroPool (Object->DataSize);
       if (EFI_ERROR (Status) || (Object->Data == NULL)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Field internal offset %a object\n", __FUNCTION__, Name));
         goto Done;
@@ -882,41 +859,20 @@ AmlField (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Field Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, Name));
         goto Done;
       }
 
-      // Field Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, Name));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_FIELD_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -994,17 +950,17 @@ AmlBankField (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BankField for %a object\n", __FUNCTION__, BankName));
         goto Done;
       }
 
       // Insert internal offset counter
-      Status            = InternalAppendNewAmlObjectNoData (&Object, ListHead);
-      Object->DataSize  = sizeof (UINT64);
-      Object->Data      = AllocateZeroPool (Object->DataSize);
-      Object->Completed = TRUE;
+      Status = InternalAppendNewAmlObjectNoData (&Object, ListHead);
+      // Never completed, so it is not collected into the Field data
+      Object->DataSize = sizeof (UINT64);
+      Object->Data     = AllocateZeroPool (Object->DataSize);
       if (EFI_ERROR (Status) || (Object->Data == NULL)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start BankField internal offset %a object\n", __FUNCTION__, BankName));
         goto Done;
@@ -1093,41 +1049,20 @@ AmlBankField (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Field Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, BankName));
         goto Done;
       }
 
-      // Field Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, BankName));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_BANK_FIELD_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1203,17 +1138,17 @@ AmlIndexField (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, GENERIC_FIELD_IDENTIFIER, 2, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start IndexField for %a object\n", __FUNCTION__, IndexName));
         goto Done;
       }
 
       // Insert internal offset counter
-      Status            = InternalAppendNewAmlObjectNoData (&Object, ListHead);
-      Object->DataSize  = sizeof (UINT64);
-      Object->Data      = AllocateZeroPool (Object->DataSize);
-      Object->Completed = TRUE;
+      Status = InternalAppendNewAmlObjectNoData (&Object, ListHead);
+      // Never completed, so it is not collected into the Field data
+      Object->DataSize = sizeof (UINT64);
+      Object->Data     = AllocateZeroPool (Object->DataSize);
       if (EFI_ERROR (Status) || (Object->Data == NULL)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start IndexField internal offset %a object\n", __FUNCTION__, IndexName));
         goto Done;
@@ -1295,41 +1230,20 @@ AmlIndexField (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Field Op is two bytes
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 2,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, IndexName));
         goto Done;
       }
 
-      // Field Op is two bytes
-      Object->DataSize = ChildObject->DataSize + 2;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, IndexName));
-        goto Done;
-      }
-
       Object->Data[0] = AML_EXT_OP;
       Object->Data[1] = AML_EXT_INDEX_FIELD_OP;
-      CopyMem (
-        &Object->Data[2],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -1406,7 +1320,7 @@ AmlOPOperationRegion (
   ChildObject = NULL;
   Status      = EFI_DEVICE_ERROR;
 
-  Status = InternalAppendNewAmlObject (&Object, "OPREGION", ListHead);
+  Status = InternalAppendNewAmlObject (&Object, "OPREGION", 2, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: Start OpRegion for %a object\n", __FUNCTION__, RegionName));
     goto Done;
@@ -1442,41 +1356,24 @@ AmlOPOperationRegion (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // OpRegion Opcode is two bytes
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             2,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, RegionName));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  // OpRegion Opcode is two bytes
-  Object->DataSize = ChildObject->DataSize + 2;
-  Object->Data     = AllocatePool (Object->DataSize);
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, RegionName));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, RegionName));
     goto Done;
   }
 
   Object->Data[0] = AML_EXT_OP;
   Object->Data[1] = AML_EXT_REGION_OP;
-  CopyMem (
-    &Object->Data[2],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -1537,7 +1434,7 @@ AmlOPCreateField (
   }
 
   ChildObject = NULL;
-  Status      = InternalAppendNewAmlObject (&Object, "CreateField", ListHead);
+  Status      = InternalAppendNewAmlObject (&Object, "CreateField", 2, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: CreateField for %a object\n", __FUNCTION__, FieldName));
     goto Done;
@@ -1573,40 +1470,24 @@ AmlOPCreateField (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // CreateFieldOp is two bytes
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             2,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, FieldName));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  // CreateFieldOp is two bytes
-  Object->DataSize = ChildObject->DataSize + 2;
-  Object->Data     = AllocatePool (Object->DataSize);
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, FieldName));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, FieldName));
     goto Done;
   }
 
   Object->Data[0] = AML_EXT_OP;
   Object->Data[1] = AML_EXT_CREATE_FIELD_OP;
-  CopyMem (
-    &Object->Data[2],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -1656,7 +1537,7 @@ InternalAmlCreateFixedField (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = InternalAppendNewAmlObject (&Object, "CreateFixedField", ListHead);
+  Status = InternalAppendNewAmlObject (&Object, "CreateFixedField", 1, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: CreateField for %a object\n", __FUNCTION__, FixedFieldName));
     goto Done;
@@ -1707,39 +1588,23 @@ InternalAmlCreateFixedField (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // CreateXFieldOp is one byte
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             1,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, FixedFieldName));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  // CreateWordFieldOp is one byte
-  Object->DataSize = ChildObject->DataSize + 1;
-  Object->Data     = AllocatePool (Object->DataSize);
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, FixedFieldName));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, FixedFieldName));
     goto Done;
   }
 
   Object->Data[0] = OpCode;
-  CopyMem (
-    &Object->Data[1],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -1988,7 +1853,7 @@ AmlMethod (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, "Method", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "Method", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Method for %a object\n", __FUNCTION__, Name));
         goto Done;
@@ -2009,7 +1874,7 @@ AmlMethod (
       }
 
       // Add Method Flags
-      Status = InternalAppendNewAmlObject (&Object, "METHOD_FLAGS", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "METHOD_FLAGS", 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start METHOD_FLAGS for %a object\n", __FUNCTION__, Name));
         goto Done;
@@ -2027,30 +1892,18 @@ AmlMethod (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Method Flags is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a METHOD_FLAGS child data collection.\n", __FUNCTION__, Name));
         goto Done;
       }
 
-      // Method Flags is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, Name));
-        goto Done;
-      }
-
       MethodFlags = NumArgs & 0x07;
       if (SerializeRule) {
         MethodFlags |= BIT3;
@@ -2058,12 +1911,6 @@ AmlMethod (
 
       MethodFlags    |= (SyncLevel & 0x0F) << 4;
       Object->Data[0] = MethodFlags;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       // Required NameString completed in one phase call
@@ -2081,40 +1928,19 @@ AmlMethod (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Method Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a child data collection.\n", __FUNCTION__, Name));
         goto Done;
       }
 
-      // Method Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, Name));
-        goto Done;
-      }
-
       Object->Data[0] = AML_METHOD_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -47,7 +47,7 @@ AmlScope (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, String, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, String, 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start %a object\n", __FUNCTION__, String));
         goto Done;
@@ -86,35 +86,19 @@ AmlScope (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Scope Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, String));
         goto Done;
       }
 
-      // Scope Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, String));
-        goto Done;
-      }
-
       Object->Data[0] = AML_SCOPE_OP;
-      CopyMem (&Object->Data[1], ChildObject->Data, ChildObject->DataSize);
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -173,7 +157,7 @@ AmlName (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, String, ListHead);
+      Status = InternalAppendNewAmlObject (&Object, String, 1, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start %a object\n", __FUNCTION__, String));
         goto Done;
@@ -196,39 +180,23 @@ AmlName (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Name Op is one byte
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 1,
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, String));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->Data = AllocatePool (ChildObject->DataSize + 1);
-      // Name Op is one byte
-      Object->DataSize = ChildObject->DataSize + 1;
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, String));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, String));
         goto Done;
       }
 
       Object->Data[0] = AML_NAME_OP;
-      CopyMem (
-        &Object->Data[1],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = EFI_SUCCESS;
@@ -283,7 +251,7 @@ AmlOPAlias (
   ChildObject = NULL;
 
   // Start ALIAS object
-  Status = InternalAppendNewAmlObject (&Object, "ALIAS", ListHead);
+  Status = InternalAppendNewAmlObject (&Object, "ALIAS", 1, ListHead);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: ERROR: Cannot append ALIAS object\n", __FUNCTION__));
     goto Done;
@@ -309,40 +277,23 @@ AmlOPAlias (
     goto Done;
   }
 
-  // Get rid of original Identifier data
-  InternalFreeAmlObjectData (Object);
-  // Collect child data and delete children
-  Status = InternalAmlCollapseAndReleaseChildren (
-             &ChildObject,
+  // Alias Op is one byte
+  Status = InternalAmlCollapseChildrenWithPrefix (
+             Object,
+             1,
              &ChildCount,
-             &Object->Link,
              ListHead
              );
-  if (EFI_ERROR (Status) ||
-      (ChildObject->Data == NULL) ||
-      (ChildObject->DataSize == 0))
-  {
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, SourceName));
-    goto Done;
+  if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+    Status = EFI_DEVICE_ERROR;
   }
 
-  Object->Data = AllocateZeroPool (ChildObject->DataSize + 1);
-  // Alias Op is one byte
-  Object->DataSize = ChildObject->DataSize + 1;
-  if (Object->Data == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, SourceName));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, SourceName));
     goto Done;
   }
 
   Object->Data[0] = AML_ALIAS_OP;
-  CopyMem (
-    &Object->Data[1],
-    ChildObject->Data,
-    ChildObject->DataSize
-    );
-
-  InternalFreeAmlObject (&ChildObject, ListHead);
   Object->Completed = TRUE;
 
   Status = EFI_SUCCESS;
@@ -22,6 +22,8 @@
 #define MAX_FOUR_BYTE_PKG_LENGTH       268435455
 #define FOUR_BYTE_PKG_LENGTH_ENCODING  0xC0
 
+#define MAX_PKG_LENGTH_ENCODING_SIZE  4
+
 /**
   Creates a Package Length encoding and places it in the return buffer,
   PkgLengthEncoding. Similar to AmlPkgLength but the PkgLength does not
@@ -143,6 +145,7 @@ AmlPkgLength (
   AML_OBJECT_INSTANCE  *Object;
   AML_OBJECT_INSTANCE  *ChildObject;
   UINTN                ChildCount;
+  UINTN                ChildDataSize;
   UINTN                DataLength;
   UINT8                PkgLeadByte;
   UINTN                PkgLengthRemainder;
@@ -157,7 +160,12 @@ AmlPkgLength (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, "LENGTH", ListHead);
+      Status = InternalAppendNewAmlObject (
+                 &Object,
+                 "LENGTH",
+                 MAX_PKG_LENGTH_ENCODING_SIZE,
+                 ListHead
+                 );
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start Length object\n", __FUNCTION__));
         goto Done;
@@ -171,20 +179,11 @@ AmlPkgLength (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
-                 &ChildCount,
-                 &Object->Link,
-                 ListHead
-                 );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
+      // Size the children first, the encoding is written into the bytes
+      // reserved in front of them at AmlStart
+      ChildDataSize = InternalAmlChildrenDataSize (NULL, &Object->Link, ListHead);
+      if (ChildDataSize == 0) {
+        Status = EFI_DEVICE_ERROR;
         DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, "Length"));
         goto Done;
       }
@@ -192,18 +191,18 @@ AmlPkgLength (
       DataLength = 0;
       // Calculate Length of PkgLength Data and fill out least
       // significant nibble
-      if ((ChildObject->DataSize + 1) <= MAX_ONE_BYTE_PKG_LENGTH) {
+      if ((ChildDataSize + 1) <= MAX_ONE_BYTE_PKG_LENGTH) {
         DataLength   = 1;
         PkgLeadByte  = ONE_BYTE_PKG_LENGTH_ENCODING;
-        PkgLeadByte |= ((ChildObject->DataSize + DataLength) & ONE_BYTE_NIBBLE_MASK);
+        PkgLeadByte |= ((ChildDataSize + DataLength) & ONE_BYTE_NIBBLE_MASK);
       } else {
-        if ((ChildObject->DataSize + 2) <= MAX_TWO_BYTE_PKG_LENGTH) {
+        if ((ChildDataSize + 2) <= MAX_TWO_BYTE_PKG_LENGTH) {
           DataLength  = 2;
           PkgLeadByte = TWO_BYTE_PKG_LENGTH_ENCODING;
-        } else if ((ChildObject->DataSize + 3) <= MAX_THREE_BYTE_PKG_LENGTH) {
+        } else if ((ChildDataSize + 3) <= MAX_THREE_BYTE_PKG_LENGTH) {
           DataLength  = 3;
           PkgLeadByte = THREE_BYTE_PKG_LENGTH_ENCODING;
-        } else if ((ChildObject->DataSize + 4) <= MAX_FOUR_BYTE_PKG_LENGTH) {
+        } else if ((ChildDataSize + 4) <= MAX_FOUR_BYTE_PKG_LENGTH) {
           DataLength  = 4;
           PkgLeadByte = FOUR_BYTE_PKG_LENGTH_ENCODING;
         } else {
@@ -217,14 +216,17 @@ AmlPkgLength (
           goto Done;
         }
 
-        PkgLeadByte |= ((ChildObject->DataSize + DataLength) & PKG_LENGTH_NIBBLE_MASK);
+        PkgLeadByte |= ((ChildDataSize + DataLength) & PKG_LENGTH_NIBBLE_MASK);
       }
 
-      // Allocate new data buffer
-      Object->DataSize = DataLength + ChildObject->DataSize;
-      Object->Data     = AllocatePool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
+      // Collect child data behind the reserved encoding and delete children
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 DataLength,
+                 &ChildCount,
+                 ListHead
+                 );
+      if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: allocation failed Object=PkgLength\n", __FUNCTION__));
         goto Done;
       }
@@ -233,18 +235,11 @@ AmlPkgLength (
       Object->Data[0] = PkgLeadByte;
 
       // Populate remainder of PkgLength bytes
-      PkgLengthRemainder = (ChildObject->DataSize + DataLength) >> 4;
+      PkgLengthRemainder = (ChildDataSize + DataLength) >> 4;
       if (PkgLengthRemainder != 0) {
         CopyMem (&Object->Data[1], &PkgLengthRemainder, DataLength - 1);
       }
 
-      CopyMem (
-        &Object->Data[DataLength],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
       Status            = EFI_SUCCESS;
       break;
@@ -53,7 +53,7 @@ AmlResourceTemplate (
       // Start EndTag object to be completed in Close
       // ACPI 6.3: 6.4.2.9 End Tag: ...The End Tag is automatically generated by
       // the ASL compiler at the end of the ResourceTemplate statement.
-      Status = InternalAppendNewAmlObject (&Object, "END_TAG", ListHead);
+      Status = InternalAppendNewAmlObject (&Object, "END_TAG", 0, ListHead);
       if (EFI_ERROR (Status)) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: Start %a object\n", __FUNCTION__, "END_TAG"));
         goto Done;
@@ -71,41 +71,41 @@ AmlResourceTemplate (
         goto Done;
       }
 
-      // Release Object->Data Identifier
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
-                 &ChildCount,
-                 &Object->Link,
-                 ListHead
-                 );
+      // End Tag goes after the ResourceMacroList
+      Status = InternalAppendNewAmlObjectNoData (&ChildObject, ListHead);
       if (EFI_ERROR (Status)) {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: collecting Child data\n", __FUNCTION__));
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: EndTag Append Failed\n", __FUNCTION__));
         goto Done;
       }
 
-      Object->DataSize = ChildObject->DataSize + sizeof (EFI_ACPI_END_TAG_DESCRIPTOR);
-      Object->Data     = AllocateZeroPool (Object->DataSize);
-      if (Object->Data == NULL) {
+      ChildObject->DataSize = sizeof (EFI_ACPI_END_TAG_DESCRIPTOR);
+      ChildObject->Data     = AllocateZeroPool (ChildObject->DataSize);
+      if (ChildObject->Data == NULL) {
         DEBUG ((DEBUG_ERROR, "%a: ERROR: EndTag Alloc Failed\n", __FUNCTION__));
         Status = EFI_OUT_OF_RESOURCES;
         goto Done;
       }
 
-      // ChildObject Data goes before End Tag
-      if ((ChildObject->Data != NULL) && (ChildObject->DataSize > 0)) {
-        CopyMem (Object->Data, ChildObject->Data, ChildObject->DataSize);
-      }
-
-      EndTag       = (EFI_ACPI_END_TAG_DESCRIPTOR *)&Object->Data[ChildObject->DataSize];
+      EndTag       = (EFI_ACPI_END_TAG_DESCRIPTOR *)ChildObject->Data;
       EndTag->Desc = ACPI_END_TAG_DESCRIPTOR;
       // Spec says the byte is a checksum, but I have never seen a value other
       // than zero in the field compiled from ASL.
       // EndTag->Checksum already = 0;
+      ChildObject->Completed = TRUE;
+      ChildObject            = NULL;
+
+      // Collect child data and delete children
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 0,
+                 &ChildCount,
+                 ListHead
+                 );
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: collecting Child data\n", __FUNCTION__));
+        goto Done;
+      }
 
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
 
       Status = AmlBuffer (AmlClose, 0, ListHead);
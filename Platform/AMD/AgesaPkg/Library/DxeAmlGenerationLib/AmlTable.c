@@ -91,7 +91,12 @@ AmlDefinitionBlock (
 
   switch (Phase) {
     case AmlStart:
-      Status = InternalAppendNewAmlObject (&Object, TableNameString, ListHead);
+      Status = InternalAppendNewAmlObject (
+                 &Object,
+                 TableNameString,
+                 sizeof (EFI_ACPI_DESCRIPTION_HEADER),
+                 ListHead
+                 );
       // TermList is too complicated and must be added outside
       break;
 
@@ -103,32 +108,24 @@ AmlDefinitionBlock (
         goto Done;
       }
 
-      // Get rid of original Identifier data
-      InternalFreeAmlObjectData (Object);
-
-      // Collect child data and delete children
-      Status = InternalAmlCollapseAndReleaseChildren (
-                 &ChildObject,
+      // Table header was reserved ahead of the TermList
+      Status = InternalAmlCollapseChildrenWithPrefix (
+                 Object,
+                 sizeof (EFI_ACPI_DESCRIPTION_HEADER),
                  &ChildCount,
-                 &Object->Link,
                  ListHead
                  );
-      if (EFI_ERROR (Status) ||
-          (ChildObject->Data == NULL) ||
-          (ChildObject->DataSize == 0))
-      {
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, TableNameString));
-        goto Done;
+      if (!EFI_ERROR (Status) && (ChildCount == 0)) {
+        Status = EFI_DEVICE_ERROR;
       }
 
-      Object->DataSize = ChildObject->DataSize + sizeof (EFI_ACPI_DESCRIPTION_HEADER);
-      Object->Data     = AllocateZeroPool (Object->DataSize);
-      if (Object->Data == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        DEBUG ((DEBUG_ERROR, "%a: ERROR: allocate Object->Data for %a\n", __FUNCTION__, TableNameString));
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: ERROR: %a has no child data.\n", __FUNCTION__, TableNameString));
         goto Done;
       }
 
+      ZeroMem (Object->Data, sizeof (EFI_ACPI_DESCRIPTION_HEADER));
+
       // Fill table header with data
       // Signature
       CopyMem (
@@ -182,15 +179,7 @@ AmlDefinitionBlock (
         sizeof (UINT32)
         );
 
-      // Copy rest of data into Object
-      CopyMem (
-        &Object->Data[sizeof (EFI_ACPI_DESCRIPTION_HEADER)],
-        ChildObject->Data,
-        ChildObject->DataSize
-        );
-
       // Checksum Set on Table Install
-      InternalFreeAmlObject (&ChildObject, ListHead);
       Object->Completed = TRUE;
       Status            = EFI_SUCCESS;
       break;
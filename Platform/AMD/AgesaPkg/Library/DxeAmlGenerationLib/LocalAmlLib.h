@@ -27,6 +27,9 @@
 // The max string size for a QWord is 8 bytes = 16 characters plus NULL Terminator
 #define MAX_AML_DATA_INTEGER_SIZE  17
 
+// The max encoded size of a DataInteger is a QWordPrefix plus 8 bytes
+#define MAX_AML_DATA_INTEGER_ENCODING_SIZE  (1 + sizeof (UINT64))
+
 // Defines similar to ctype.h functions isalpha() and isdigit()
 #define IS_ASCII_UPPER_ALPHA(c)  ( ((c) >= AML_NAME_CHAR_A) && ((c) <= AML_NAME_CHAR_Z) )
 #define IS_ASCII_HEX_DIGIT(c)    ( (((c) >= AML_DIGIT_CHAR_0) && ((c) <= AML_DIGIT_CHAR_9)) ||\
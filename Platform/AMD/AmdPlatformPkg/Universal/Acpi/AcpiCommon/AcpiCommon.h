@@ -11,6 +11,7 @@
 #define ACPI_COMMON_H_
 
 #include <IndustryStandard/Acpi.h>
+#include <Library/AmdPlatformSocLib.h>
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
@@ -111,6 +112,75 @@ InstallPciAcpi (
   IN      EFI_SYSTEM_TABLE  *SystemTable
   );
 
+/**
+  Arrange for the PCI SSDT cache variable to be locked at EndOfDxe.
+
+  The cache must not be used unless this succeeds.
+
+  @retval         EFI_SUCCESS   - The variable is locked at EndOfDxe.
+  @retval         Others        - Variable Policy is not available, or the
+                                  EndOfDxe event could not be created.
+**/
+EFI_STATUS
+EFIAPI
+PciSsdtCacheRegisterLock (
+  VOID
+  );
+
+/**
+  Build the cache key describing everything the PCI SSDT is generated from.
+
+  @param[in]      RootBridge      - Sorted root bridge instances
+  @param[in]      RootBridgeCount - Number of root bridges
+  @param[out]     Key             - Allocated key, caller frees
+  @param[out]     KeySize         - Size of Key in bytes
+
+  @retval         EFI_SUCCESS, various EFI FAILUREs.
+**/
+EFI_STATUS
+EFIAPI
+PciSsdtCacheCreateKey (
+  IN      AMD_PCI_ROOT_BRIDGE_OBJECT_INSTANCE  *RootBridge,
+  IN      UINTN                                RootBridgeCount,
+     OUT  VOID                                 **Key,
+     OUT  UINTN                                *KeySize
+  );
+
+/**
+  Look up a cached PCI SSDT generated for the given key.
+
+  @param[in]      Key           - Key from PciSsdtCacheCreateKey ()
+  @param[in]      KeySize       - Size of Key in bytes
+  @param[out]     Table         - Allocated copy of the cached table, caller frees
+
+  @retval         EFI_SUCCESS   - Table holds the cached SSDT.
+  @retval         EFI_NOT_FOUND - No usable cache entry for this key.
+**/
+EFI_STATUS
+EFIAPI
+PciSsdtCacheLoad (
+  IN      VOID                         *Key,
+  IN      UINTN                        KeySize,
+     OUT  EFI_ACPI_DESCRIPTION_HEADER  **Table
+  );
+
+/**
+  Store a freshly generated PCI SSDT for use on the next boots.
+
+  Failures are not fatal; the table is simply generated again next boot.
+
+  @param[in]      Key           - Key from PciSsdtCacheCreateKey ()
+  @param[in]      KeySize       - Size of Key in bytes
+  @param[in]      Table         - Serialized SSDT
+**/
+VOID
+EFIAPI
+PciSsdtCacheSave (
+  IN      VOID                         *Key,
+  IN      UINTN                        KeySize,
+  IN      EFI_ACPI_DESCRIPTION_HEADER  *Table
+  );
+
 VOID
 EFIAPI
 InstallAcpiSpmiTable (
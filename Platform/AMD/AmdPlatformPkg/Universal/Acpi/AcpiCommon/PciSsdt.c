@@ -11,6 +11,7 @@
 #include <Library/DebugLib.h>
 #include <Library/IoLib.h>
 #include <Library/PcdLib.h>
+#include <Library/PerformanceLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Protocol/PciRootBridgeIo.h>
 #include <Register/AmdIoApic.h>
@@ -1036,18 +1037,11 @@ InstallPciAcpi (
   AML_METHOD_PARAM                     MethodParam[7];
   AML_OBJECT_NODE_HANDLE               OscMethod;
   AML_OBJECT_NODE_HANDLE               CdsmMethod;
+  VOID                                 *CacheKey;
+  UINTN                                CacheKeySize;
 
   DEBUG ((DEBUG_INFO, "%a: Entry\n", __func__));
 
-  Status = AmlCodeGenDefinitionBlock (
-             "SSDT",
-             "AMD   ",
-             "AmdTable",
-             0x00,
-             &RootNode
-             );
-  ASSERT_EFI_ERROR (Status);
-
   ZeroMem ((VOID *)&PciAddr, sizeof (PciAddr));
   mDriverHandle       = ImageHandle;
   GlobalInterruptBase = 0;
@@ -1058,6 +1052,48 @@ InstallPciAcpi (
     return Status;
   }
 
+  //
+  // Server topology rarely changes between boots. If the SSDT generated on a
+  // previous boot was built from the same topology, install it as is.
+  //
+  CacheKey = NULL;
+  if (FeaturePcdGet (PcdAmdPciSsdtCacheEnable) && !EFI_ERROR (PciSsdtCacheRegisterLock ())) {
+    PERF_INMODULE_BEGIN ("PciSsdtCacheLookup");
+    Status = PciSsdtCacheCreateKey (RootBridgeHead, RootBridgeCount, &CacheKey, &CacheKeySize);
+    if (!EFI_ERROR (Status)) {
+      Status = PciSsdtCacheLoad (CacheKey, CacheKeySize, &Table);
+    } else {
+      CacheKey = NULL;
+    }
+
+    PERF_INMODULE_END ("PciSsdtCacheLookup");
+
+    if (!EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "%a: Installing cached PCI SSDT\n", __func__));
+      FreePool (CacheKey);
+      FreePool (RootBridgeHead);
+
+      Status = AppendExistingAcpiTable (
+                 EFI_ACPI_6_5_DIFFERENTIATED_SYSTEM_DESCRIPTION_TABLE_SIGNATURE,
+                 AMD_DSDT_OEMID,
+                 Table
+                 );
+      FreePool (Table);
+      return Status;
+    }
+  }
+
+  PERF_INMODULE_BEGIN ("PciSsdtGenerate");
+
+  Status = AmlCodeGenDefinitionBlock (
+             "SSDT",
+             "AMD   ",
+             "AmdTable",
+             0x00,
+             &RootNode
+             );
+  ASSERT_EFI_ERROR (Status);
+
   Status = AmlCodeGenScope ("\\_SB_", RootNode, &ScopeNode);  // START: Scope (\_SB)
   if (EFI_ERROR (Status)) {
     ASSERT_EFI_ERROR (Status);
@@ -1457,6 +1493,13 @@ InstallPciAcpi (
 
   FreePool (RootBridgeHead);
 
+  PERF_INMODULE_END ("PciSsdtGenerate");
+
+  if (CacheKey != NULL) {
+    PciSsdtCacheSave (CacheKey, CacheKeySize, Table);
+    FreePool (CacheKey);
+  }
+
   Status = AppendExistingAcpiTable (
              EFI_ACPI_6_5_DIFFERENTIATED_SYSTEM_DESCRIPTION_TABLE_SIGNATURE,
              AMD_DSDT_OEMID,
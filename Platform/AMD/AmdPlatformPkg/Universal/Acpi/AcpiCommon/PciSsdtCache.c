@@ -0,0 +1,498 @@
+/** @file
+  Caches the generated PCI SSDT across boots.
+
+  The PCI SSDT only depends on the root bridge, root port and CXL topology
+  reported by the SoC library, the root bridge resources, the firmware version
+  and a few PCDs. All of that is serialized into a key. The key and the
+  serialized table are kept in a non-volatile, boot services only variable.
+  When the key of the current boot matches the stored one, the stored table is
+  installed instead of generating it again.
+
+  The variable is locked through Variable Policy at EndOfDxe, so neither the OS
+  nor third party code running before it can supply AML through the cache. The
+  cache is not used when Variable Policy is not available.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include "AcpiCommon.h"
+
+#include <Guid/EventGroup.h>
+#include <Protocol/PciRootBridgeIo.h>
+#include <Protocol/VariablePolicy.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+#include <Library/VariablePolicyHelperLib.h>
+
+#define PCI_SSDT_CACHE_VARIABLE_NAME  L"AmdPciSsdtCache"
+#define PCI_SSDT_CACHE_SIGNATURE      SIGNATURE_32 ('P', 'S', 'S', 'C')
+
+#define PCI_SSDT_CACHE_ATTRIBUTES     (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS)
+
+//
+// Bump whenever the layout of the key or of the generated AML changes. A
+// firmware update is caught by the firmware revision and version string.
+//
+#define PCI_SSDT_CACHE_VERSION  2
+
+#pragma pack (1)
+
+typedef struct {
+  UINT32    Signature;
+  UINT32    KeyCrc32;
+  UINT32    KeySize;
+  UINT32    TableCrc32;
+  UINT32    TableSize;
+} PCI_SSDT_CACHE_HEADER;
+
+typedef struct {
+  UINT32    Version;
+  UINT32    FirmwareRevision;
+  UINT32    FirmwareVersionCrc32;
+  UINT64    PciExpressBaseAddress;
+  UINT64    PciExpressBaseSize;
+  UINT32    IoApicAddressBase;
+  UINT8     CedtPresent;
+  UINT64    RootBridgeCount;
+  UINT64    RootBridgeIoCount;
+} PCI_SSDT_CACHE_KEY_HEADER;
+
+typedef struct {
+  UINT64    Uid;
+  UINT64    GlobalInterruptStart;
+  UINT64    Segment;
+  UINT64    BaseBusNumber;
+  UINT8     SocketId;
+  UINT64    PxmDomain;
+  UINT64    RootPortCount;
+  UINT64    CxlCount;
+  UINT32    CxlEndPointBdf;
+  UINT8     CxlIsCxl2;
+} PCI_SSDT_CACHE_KEY_ROOT_BRIDGE;
+
+typedef struct {
+  UINT8     Enabled;
+  UINT8     PortPresent;
+  UINT64    Device;
+  UINT64    Function;
+  UINT64    SlotNum;
+  UINT64    BridgeInterrupt;
+  UINT64    EndpointInterruptArray[4];
+} PCI_SSDT_CACHE_KEY_ROOT_PORT;
+
+#pragma pack ()
+
+STATIC EDKII_VARIABLE_POLICY_PROTOCOL  *mPciSsdtCacheVariablePolicy;
+
+/**
+  Lock the PCI SSDT cache variable at EndOfDxe.
+
+  @param[in]      Event         - The EndOfDxe event
+  @param[in]      Context       - Unused
+**/
+STATIC
+VOID
+EFIAPI
+PciSsdtCacheEndOfDxe (
+  IN      EFI_EVENT  Event,
+  IN      VOID       *Context
+  )
+{
+  EFI_STATUS  Status;
+
+  gBS->CloseEvent (Event);
+
+  Status = RegisterBasicVariablePolicy (
+             mPciSsdtCacheVariablePolicy,
+             &gAmdPciSsdtCacheVariableGuid,
+             PCI_SSDT_CACHE_VARIABLE_NAME,
+             VARIABLE_POLICY_NO_MIN_SIZE,
+             VARIABLE_POLICY_NO_MAX_SIZE,
+             VARIABLE_POLICY_NO_MUST_ATTR,
+             VARIABLE_POLICY_NO_CANT_ATTR,
+             VARIABLE_POLICY_TYPE_LOCK_NOW
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Unable to lock the PCI SSDT cache: %r\n", __func__, Status));
+    ASSERT_EFI_ERROR (Status);
+    //
+    // An unlocked cache must not survive into the next boot.
+    //
+    gRT->SetVariable (
+           PCI_SSDT_CACHE_VARIABLE_NAME,
+           &gAmdPciSsdtCacheVariableGuid,
+           0,
+           0,
+           NULL
+           );
+  }
+}
+
+/**
+  Arrange for the PCI SSDT cache variable to be locked at EndOfDxe.
+
+  The cache must not be used unless this succeeds.
+
+  @retval         EFI_SUCCESS   - The variable is locked at EndOfDxe.
+  @retval         Others        - Variable Policy is not available, or the
+                                  EndOfDxe event could not be created.
+**/
+EFI_STATUS
+EFIAPI
+PciSsdtCacheRegisterLock (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  EFI_EVENT   EndOfDxeEvent;
+
+  Status = gBS->LocateProtocol (
+                  &gEdkiiVariablePolicyProtocolGuid,
+                  NULL,
+                  (VOID **)&mPciSsdtCacheVariablePolicy
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: No Variable Policy, PCI SSDT cache disabled\n", __func__));
+    return Status;
+  }
+
+  return gBS->CreateEventEx (
+                EVT_NOTIFY_SIGNAL,
+                TPL_CALLBACK,
+                PciSsdtCacheEndOfDxe,
+                NULL,
+                &gEfiEndOfDxeEventGroupGuid,
+                &EndOfDxeEvent
+                );
+}
+
+/**
+  Return the size of a root bridge resource descriptor list, end tag included.
+
+  @param[in]      Configuration - Descriptor list from EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL
+
+  @retval         Size in bytes.
+**/
+STATIC
+UINTN
+InternalConfigurationSize (
+  IN      VOID  *Configuration
+  )
+{
+  EFI_ACPI_QWORD_ADDRESS_SPACE_DESCRIPTOR  *Descriptor;
+
+  Descriptor = Configuration;
+  while (Descriptor->Header.Header.Byte == ACPI_QWORD_ADDRESS_SPACE_DESCRIPTOR) {
+    Descriptor++;
+  }
+
+  return (UINTN)Descriptor - (UINTN)Configuration + sizeof (EFI_ACPI_END_TAG_DESCRIPTOR);
+}
+
+/**
+  Build the cache key describing everything the PCI SSDT is generated from.
+
+  @param[in]      RootBridge      - Sorted root bridge instances
+  @param[in]      RootBridgeCount - Number of root bridges
+  @param[out]     Key             - Allocated key, caller frees
+  @param[out]     KeySize         - Size of Key in bytes
+
+  @retval         EFI_SUCCESS, various EFI FAILUREs.
+**/
+EFI_STATUS
+EFIAPI
+PciSsdtCacheCreateKey (
+  IN      AMD_PCI_ROOT_BRIDGE_OBJECT_INSTANCE  *RootBridge,
+  IN      UINTN                                RootBridgeCount,
+     OUT  VOID                                 **Key,
+     OUT  UINTN                                *KeySize
+  )
+{
+  EFI_ACPI_SDT_HEADER              *SdtTable;
+  EFI_HANDLE                       *HandleBuffer;
+  EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL  *Io;
+  EFI_STATUS                       Status;
+  CHAR16                           *FirmwareVersion;
+  PCI_SSDT_CACHE_KEY_HEADER        *KeyHeader;
+  PCI_SSDT_CACHE_KEY_ROOT_BRIDGE   *RbKey;
+  PCI_SSDT_CACHE_KEY_ROOT_PORT     *RpKey;
+  AMD_PCI_ROOT_PORT_OBJECT         *RootPort;
+  VOID                             **Configurations;
+  UINT8                            *Cursor;
+  UINTN                            NumHandles;
+  UINTN                            Size;
+  UINTN                            RbIndex;
+  UINTN                            RpIndex;
+  UINTN                            Index;
+
+  if ((RootBridge == NULL) || (Key == NULL) || (KeySize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiPciRootBridgeIoProtocolGuid,
+                  NULL,
+                  &NumHandles,
+                  &HandleBuffer
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Configurations = AllocateZeroPool (NumHandles * sizeof (VOID *));
+  if (Configurations == NULL) {
+    FreePool (HandleBuffer);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // First pass: size the key.
+  //
+  Size = sizeof (PCI_SSDT_CACHE_KEY_HEADER);
+  for (Index = 0; Index < NumHandles; Index++) {
+    Status = gBS->HandleProtocol (
+                    HandleBuffer[Index],
+                    &gEfiPciRootBridgeIoProtocolGuid,
+                    (VOID **)&Io
+                    );
+    if (!EFI_ERROR (Status)) {
+      Status = Io->Configuration (Io, &Configurations[Index]);
+    }
+
+    if (EFI_ERROR (Status)) {
+      FreePool (Configurations);
+      FreePool (HandleBuffer);
+      return Status;
+    }
+
+    Size += sizeof (UINT64) + InternalConfigurationSize (Configurations[Index]);
+  }
+
+  for (RbIndex = 0; RbIndex < RootBridgeCount; RbIndex++) {
+    Size += sizeof (PCI_SSDT_CACHE_KEY_ROOT_BRIDGE) +
+            RootBridge[RbIndex].RootPortCount * sizeof (PCI_SSDT_CACHE_KEY_ROOT_PORT);
+  }
+
+  KeyHeader = AllocateZeroPool (Size);
+  if (KeyHeader == NULL) {
+    FreePool (Configurations);
+    FreePool (HandleBuffer);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Second pass: fill it in.
+  //
+  FirmwareVersion = (CHAR16 *)PcdGetPtr (PcdFirmwareVersionString);
+  KeyHeader->Version          = PCI_SSDT_CACHE_VERSION;
+  KeyHeader->FirmwareRevision = gST->FirmwareRevision;
+  gBS->CalculateCrc32 (FirmwareVersion, StrSize (FirmwareVersion), &KeyHeader->FirmwareVersionCrc32);
+  KeyHeader->PciExpressBaseAddress = PcdGet64 (PcdPciExpressBaseAddress);
+  KeyHeader->PciExpressBaseSize    = PcdGet64 (PcdPciExpressBaseSize);
+  KeyHeader->IoApicAddressBase     = PcdGet32 (PcdPcIoApicAddressBase);
+  KeyHeader->CedtPresent           = !EFI_ERROR (GetExistingAcpiTable (CXL_EARLY_DISCOVERY_TABLE_SIGNATURE, 0, &SdtTable));
+  KeyHeader->RootBridgeCount       = RootBridgeCount;
+  KeyHeader->RootBridgeIoCount     = NumHandles;
+
+  Cursor = (UINT8 *)(KeyHeader + 1);
+  for (RbIndex = 0; RbIndex < RootBridgeCount; RbIndex++) {
+    RbKey                       = (PCI_SSDT_CACHE_KEY_ROOT_BRIDGE *)Cursor;
+    RbKey->Uid                  = RootBridge[RbIndex].Uid;
+    RbKey->GlobalInterruptStart = RootBridge[RbIndex].GlobalInterruptStart;
+    RbKey->Segment              = RootBridge[RbIndex].Object->Segment;
+    RbKey->BaseBusNumber        = RootBridge[RbIndex].Object->BaseBusNumber;
+    RbKey->SocketId             = RootBridge[RbIndex].Object->SocketId;
+    RbKey->PxmDomain            = RootBridge[RbIndex].PxmDomain;
+    RbKey->RootPortCount        = RootBridge[RbIndex].RootPortCount;
+    RbKey->CxlCount             = RootBridge[RbIndex].CxlCount;
+    RbKey->CxlEndPointBdf       = RootBridge[RbIndex].CxlPortInfo.EndPointBDF.AddressValue;
+    RbKey->CxlIsCxl2            = RootBridge[RbIndex].CxlPortInfo.IsCxl2;
+    Cursor                     += sizeof (PCI_SSDT_CACHE_KEY_ROOT_BRIDGE);
+
+    // Root ports are 1-based, as in InternalInsertRootPorts ()
+    for (RpIndex = 1; RpIndex <= RootBridge[RbIndex].RootPortCount; RpIndex++) {
+      RootPort               = RootBridge[RbIndex].RootPort[RpIndex];
+      RpKey                  = (PCI_SSDT_CACHE_KEY_ROOT_PORT *)Cursor;
+      RpKey->Enabled         = RootPort->Enabled;
+      RpKey->PortPresent     = RootPort->PortPresent;
+      RpKey->Device          = RootPort->Device;
+      RpKey->Function        = RootPort->Function;
+      RpKey->SlotNum         = RootPort->SlotNum;
+      RpKey->BridgeInterrupt = RootPort->BridgeInterrupt;
+      CopyMem (RpKey->EndpointInterruptArray, RootPort->EndpointInterruptArray, sizeof (RpKey->EndpointInterruptArray));
+      Cursor += sizeof (PCI_SSDT_CACHE_KEY_ROOT_PORT);
+    }
+  }
+
+  for (Index = 0; Index < NumHandles; Index++) {
+    WriteUnaligned64 ((UINT64 *)Cursor, InternalConfigurationSize (Configurations[Index]));
+    Cursor += sizeof (UINT64);
+    CopyMem (Cursor, Configurations[Index], InternalConfigurationSize (Configurations[Index]));
+    Cursor += InternalConfigurationSize (Configurations[Index]);
+  }
+
+  ASSERT ((UINTN)(Cursor - (UINT8 *)KeyHeader) == Size);
+
+  FreePool (Configurations);
+  FreePool (HandleBuffer);
+
+  *Key     = KeyHeader;
+  *KeySize = Size;
+  return EFI_SUCCESS;
+}
+
+/**
+  Look up a cached PCI SSDT generated for the given key.
+
+  @param[in]      Key           - Key from PciSsdtCacheCreateKey ()
+  @param[in]      KeySize       - Size of Key in bytes
+  @param[out]     Table         - Allocated copy of the cached table, caller frees
+
+  @retval         EFI_SUCCESS   - Table holds the cached SSDT.
+  @retval         EFI_NOT_FOUND - No usable cache entry for this key.
+**/
+EFI_STATUS
+EFIAPI
+PciSsdtCacheLoad (
+  IN      VOID                         *Key,
+  IN      UINTN                        KeySize,
+     OUT  EFI_ACPI_DESCRIPTION_HEADER  **Table
+  )
+{
+  PCI_SSDT_CACHE_HEADER  *Header;
+  EFI_STATUS             Status;
+  UINT8                  *Data;
+  UINTN                  DataSize;
+  UINT32                 Crc32;
+  UINT32                 Attributes;
+
+  *Table = NULL;
+
+  DataSize = 0;
+  Status   = gRT->GetVariable (
+                    PCI_SSDT_CACHE_VARIABLE_NAME,
+                    &gAmdPciSsdtCacheVariableGuid,
+                    NULL,
+                    &DataSize,
+                    NULL
+                    );
+  if ((Status != EFI_BUFFER_TOO_SMALL) || (DataSize < sizeof (PCI_SSDT_CACHE_HEADER))) {
+    return EFI_NOT_FOUND;
+  }
+
+  Data = AllocatePool (DataSize);
+  if (Data == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = gRT->GetVariable (
+                  PCI_SSDT_CACHE_VARIABLE_NAME,
+                  &gAmdPciSsdtCacheVariableGuid,
+                  &Attributes,
+                  &DataSize,
+                  Data
+                  );
+  if (EFI_ERROR (Status) || (Attributes != PCI_SSDT_CACHE_ATTRIBUTES)) {
+    FreePool (Data);
+    return EFI_NOT_FOUND;
+  }
+
+  Header = (PCI_SSDT_CACHE_HEADER *)Data;
+  Status = EFI_NOT_FOUND;
+  if (  (Header->Signature != PCI_SSDT_CACHE_SIGNATURE)
+     || (Header->KeySize != KeySize)
+     || ((UINT64)sizeof (*Header) + Header->KeySize + Header->TableSize != DataSize)
+     || (Header->TableSize < sizeof (EFI_ACPI_DESCRIPTION_HEADER)))
+  {
+    goto Done;
+  }
+
+  gBS->CalculateCrc32 (Key, KeySize, &Crc32);
+  if ((Crc32 != Header->KeyCrc32) || (CompareMem (Header + 1, Key, KeySize) != 0)) {
+    DEBUG ((DEBUG_INFO, "%a: PCI topology changed, cached SSDT is stale\n", __func__));
+    goto Done;
+  }
+
+  gBS->CalculateCrc32 (Data + sizeof (*Header) + KeySize, Header->TableSize, &Crc32);
+  if (Crc32 != Header->TableCrc32) {
+    DEBUG ((DEBUG_WARN, "%a: Cached SSDT is corrupted\n", __func__));
+    goto Done;
+  }
+
+  *Table = AllocateCopyPool (Header->TableSize, Data + sizeof (*Header) + KeySize);
+  if (*Table == NULL) {
+    goto Done;
+  }
+
+  if ((*Table)->Length != Header->TableSize) {
+    FreePool (*Table);
+    *Table = NULL;
+    goto Done;
+  }
+
+  Status = EFI_SUCCESS;
+
+Done:
+  FreePool (Data);
+  return Status;
+}
+
+/**
+  Store a freshly generated PCI SSDT for use on the next boots.
+
+  Failures are not fatal; the table is simply generated again next boot.
+
+  @param[in]      Key           - Key from PciSsdtCacheCreateKey ()
+  @param[in]      KeySize       - Size of Key in bytes
+  @param[in]      Table         - Serialized SSDT
+**/
+VOID
+EFIAPI
+PciSsdtCacheSave (
+  IN      VOID                         *Key,
+  IN      UINTN                        KeySize,
+  IN      EFI_ACPI_DESCRIPTION_HEADER  *Table
+  )
+{
+  PCI_SSDT_CACHE_HEADER  *Header;
+  EFI_STATUS             Status;
+  UINTN                  DataSize;
+
+  DataSize = sizeof (*Header) + KeySize + Table->Length;
+  Header   = AllocatePool (DataSize);
+  if (Header == NULL) {
+    return;
+  }
+
+  Header->Signature = PCI_SSDT_CACHE_SIGNATURE;
+  Header->KeySize   = (UINT32)KeySize;
+  Header->TableSize = Table->Length;
+  gBS->CalculateCrc32 (Key, KeySize, &Header->KeyCrc32);
+  gBS->CalculateCrc32 (Table, Table->Length, &Header->TableCrc32);
+  CopyMem (Header + 1, Key, KeySize);
+  CopyMem ((UINT8 *)(Header + 1) + KeySize, Table, Table->Length);
+
+  Status = gRT->SetVariable (
+                  PCI_SSDT_CACHE_VARIABLE_NAME,
+                  &gAmdPciSsdtCacheVariableGuid,
+                  PCI_SSDT_CACHE_ATTRIBUTES,
+                  DataSize,
+                  Header
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: Unable to cache PCI SSDT (0x%lx bytes): %r\n", __func__, DataSize, Status));
+    //
+    // Do not leave an entry for an older topology behind to be checked on
+    // every boot.
+    //
+    gRT->SetVariable (
+           PCI_SSDT_CACHE_VARIABLE_NAME,
+           &gAmdPciSsdtCacheVariableGuid,
+           0,
+           0,
+           NULL
+           );
+  }
+
+  FreePool (Header);
+}
@@ -9,6 +9,11 @@
 #ifndef _EFI_COMPRESS_LIB_H_
 #define _EFI_COMPRESS_LIB_H_
 
+///
+/// Opaque compressor state, see CreateCompressContext().
+///
+typedef struct _COMPRESS_CONTEXT COMPRESS_CONTEXT;
+
 /**
   The compression routine.
 
@@ -30,5 +35,61 @@ Compress (
   IN OUT  UINT64  *DstSize
   );
 
+/**
+  Allocate a compression context.
+
+  The context holds the work buffers and all state of the compressor. It can
+  be passed to any number of CompressWithContext() calls, which then do not
+  allocate memory. Callers compressing concurrently need one context each.
+
+  @param[out]  Context       Returned compression context.
+
+  @retval EFI_SUCCESS           The context was allocated.
+  @retval EFI_INVALID_PARAMETER Context is NULL.
+  @retval EFI_OUT_OF_RESOURCES  Not enough memory for the work buffers.
+**/
+EFI_STATUS
+EFIAPI
+CreateCompressContext (
+  OUT COMPRESS_CONTEXT  **Context
+  );
+
+/**
+  Free a compression context allocated by CreateCompressContext().
+
+  @param[in]  Context       The compression context. May be NULL.
+**/
+VOID
+EFIAPI
+FreeCompressContext (
+  IN COMPRESS_CONTEXT  *Context
+  );
+
+/**
+  The compression routine, using the work buffers of a compression context.
+
+  The output is identical to that of Compress() for the same input.
+
+  @param[in]       Context       The compression context.
+  @param[in]       SrcBuffer     The buffer containing the source data.
+  @param[in]       SrcSize       Number of bytes in SrcBuffer.
+  @param[in]       DstBuffer     The buffer to put the compressed image in.
+  @param[in, out]  DstSize       On input the size (in bytes) of DstBuffer, on
+                                 return the number of bytes placed in DstBuffer.
+
+  @retval EFI_SUCCESS           The compression was sucessful.
+  @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+  @retval EFI_INVALID_PARAMETER Context or DstSize is NULL.
+**/
+EFI_STATUS
+EFIAPI
+CompressWithContext (
+  IN      COMPRESS_CONTEXT  *Context,
+  IN      VOID              *SrcBuffer,
+  IN      UINT64            SrcSize,
+  IN      VOID              *DstBuffer,
+  IN OUT  UINT64            *DstSize
+  );
+
 #endif
 
@@ -27,9 +27,22 @@
 
 #include <Uefi/UefiBaseType.h>
 
+///
+/// Size and layout of a large variable, as returned by GetLargeVariableInfo ().
+///
+typedef struct {
+  UINTN    TotalSize;       ///< Size in bytes of the whole data set.
+  UINTN    VariableCount;   ///< Number of UEFI variables the data is split across,
+                            ///< 0 if it is stored in a single variable under its own name.
+} LARGE_VARIABLE_INFO;
+
 /**
   Returns the value of a large variable.
 
+  The variables of a multi-variable set are read straight into Data in a
+  single pass. If Data turns out to be too small, its contents are undefined
+  on return.
+
   @param[in]       VariableName  A Null-terminated string that is the name of the vendor's
                                  variable.
   @param[in]       VendorGuid    A unique identifier for the vendor.
@@ -58,4 +71,63 @@ GetLargeVariable (
   OUT    VOID                        *Data           OPTIONAL
   );
 
+/**
+  Returns the size of a large variable and the number of UEFI variables it is
+  stored in.
+
+  The result can be passed to GetLargeVariableWithInfo () to read the data
+  without probing the variables again.
+
+  @param[in]   VariableName  A Null-terminated string that is the name of the vendor's
+                             variable.
+  @param[in]   VendorGuid    A unique identifier for the vendor.
+  @param[out]  Info          The size and variable count of the large variable.
+
+  @retval EFI_SUCCESS            The function completed successfully.
+  @retval EFI_NOT_FOUND          The variable was not found.
+  @retval EFI_INVALID_PARAMETER  VariableName, VendorGuid or Info is NULL.
+  @retval EFI_OUT_OF_RESOURCES   VariableName is too long.
+  @retval EFI_DEVICE_ERROR       The variable could not be retrieved due to a hardware error.
+  @retval EFI_SECURITY_VIOLATION The variable could not be retrieved due to an authentication failure.
+
+**/
+EFI_STATUS
+EFIAPI
+GetLargeVariableInfo (
+  IN     CHAR16                      *VariableName,
+  IN     EFI_GUID                    *VendorGuid,
+  OUT    LARGE_VARIABLE_INFO         *Info
+  );
+
+/**
+  Returns the value of a large variable described by GetLargeVariableInfo ().
+
+  Exactly Info->VariableCount variables are read straight into Data, so the
+  variable must not have been changed since Info was retrieved.
+
+  @param[in]   VariableName  A Null-terminated string that is the name of the vendor's
+                             variable.
+  @param[in]   VendorGuid    A unique identifier for the vendor.
+  @param[in]   Info          The result of GetLargeVariableInfo () for this variable.
+  @param[out]  Data          The buffer to return the contents of the variable. It must
+                             be at least Info->TotalSize bytes large.
+
+  @retval EFI_SUCCESS            The function completed successfully.
+  @retval EFI_NOT_FOUND          The variable was not found, or no longer matches Info.
+  @retval EFI_BUFFER_TOO_SMALL   The variable no longer matches Info.
+  @retval EFI_INVALID_PARAMETER  VariableName, VendorGuid, Info or Data is NULL.
+  @retval EFI_OUT_OF_RESOURCES   VariableName is too long.
+  @retval EFI_DEVICE_ERROR       The variable could not be retrieved due to a hardware error.
+  @retval EFI_SECURITY_VIOLATION The variable could not be retrieved due to an authentication failure.
+
+**/
+EFI_STATUS
+EFIAPI
+GetLargeVariableWithInfo (
+  IN     CHAR16                      *VariableName,
+  IN     EFI_GUID                    *VendorGuid,
+  IN     CONST LARGE_VARIABLE_INFO   *Info,
+  OUT    VOID                        *Data
+  );
+
 #endif  // _LARGE_VARIABLE_READ_LIB_H_
@@ -179,6 +179,23 @@ TestPointEndOfPeiPciBusMasterDisabled (
   VOID
   );
 
+/**
+  This service verifies boot performance against the platform budget at the end of PEI.
+
+  Test subject: PEI performance records.
+  Test overview: Verify the time from reset to the end of PEI and the time spent in each PEIM are within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the longest running modules to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointEndOfPeiPerformanceBudget (
+  VOID
+  );
+
 /**
   This service verifies bus master enable (BME) is disabled after PCI enumeration.
 
@@ -264,6 +281,23 @@ TestPointEndOfDxeDmaProtectionEnabled (
   VOID
   );
 
+/**
+  This service verifies boot performance against the platform budget at the end of DXE.
+
+  Test subject: Boot time.
+  Test overview: Verify the time from reset to the end of DXE is within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps results to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointEndOfDxePerformanceBudget (
+  VOID
+  );
+
 /**
   This service verifies the validity of System Management RAM (SMRAM) alignment at SMM Ready To Lock.
 
@@ -454,6 +488,23 @@ TestPointReadyToBootEsrtTableFunctional (
   VOID
   );
 
+/**
+  This service verifies boot performance against the platform budget at Ready To Boot.
+
+  Test subject: FPDT boot performance records.
+  Test overview: Verify the time from reset to Ready To Boot and the time spent in each module are within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the longest running modules to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootPerformanceBudget (
+  VOID
+  );
+
 /**
   This service verifies UEFI Secure Boot is enabled.
 
@@ -770,6 +821,17 @@ TestPointSmmExitBootServices (
 #define   TEST_POINT_BYTE8_READY_TO_BOOT_HSTI_TABLE_FUNCTIONAL_ERROR_CODE                        L"0x08010000"
 #define   TEST_POINT_BYTE8_READY_TO_BOOT_HSTI_TABLE_FUNCTIONAL_ERROR_STRING                      L"No HSTI\r\n"
 
+// Byte 9 - Performance
+#define TEST_POINT_BYTE9_END_OF_PEI_PERFORMANCE_BUDGET                                      BIT0
+#define TEST_POINT_BYTE9_END_OF_DXE_PERFORMANCE_BUDGET                                      BIT1
+#define TEST_POINT_BYTE9_READY_TO_BOOT_PERFORMANCE_BUDGET                                   BIT2
+#define   TEST_POINT_BYTE9_END_OF_PEI_PERFORMANCE_BUDGET_ERROR_CODE                              L"0x09000000"
+#define   TEST_POINT_BYTE9_END_OF_PEI_PERFORMANCE_BUDGET_ERROR_STRING                            L"PEI performance over budget\r\n"
+#define   TEST_POINT_BYTE9_END_OF_DXE_PERFORMANCE_BUDGET_ERROR_CODE                              L"0x09010000"
+#define   TEST_POINT_BYTE9_END_OF_DXE_PERFORMANCE_BUDGET_ERROR_STRING                            L"DXE performance over budget\r\n"
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_PERFORMANCE_BUDGET_ERROR_CODE                           L"0x09020000"
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_PERFORMANCE_BUDGET_ERROR_STRING                         L"Boot performance over budget\r\n"
+
 #pragma pack (1)
 
 typedef struct {
@@ -19,14 +19,274 @@
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/LargeVariableReadLib.h>
 #include <Library/PrintLib.h>
 #include <Library/VariableReadLib.h>
 
 #include "LargeVariableCommon.h"
 
+/**
+  Prepares the name buffer used to access the variables of a multi-variable set.
+
+  The base name is copied once, the index of each variable is then written
+  behind it by LargeVariableSetNameIndex ().
+
+  @param[in]   VariableName    A Null-terminated string that is the name of the vendor's
+                               variable.
+  @param[out]  ChunkName       Buffer of MAX_VARIABLE_NAME_SIZE characters.
+  @param[out]  BaseNameLength  Length of VariableName in characters.
+
+  @retval EFI_SUCCESS            The name buffer is ready.
+  @retval EFI_OUT_OF_RESOURCES   VariableName is too long to append an index.
+
+**/
+STATIC
+EFI_STATUS
+LargeVariableInitName (
+  IN  CHAR16                      *VariableName,
+  OUT CHAR16                      *ChunkName,
+  OUT UINTN                       *BaseNameLength
+  )
+{
+  *BaseNameLength = StrnLenS (VariableName, MAX_VARIABLE_NAME_SIZE);
+  if (*BaseNameLength >= (MAX_VARIABLE_NAME_SIZE - MAX_VARIABLE_SPLIT_DIGITS)) {
+    DEBUG ((DEBUG_ERROR, "GetLargeVariable: Variable name too long\n"));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (ChunkName, VariableName, *BaseNameLength * sizeof (CHAR16));
+  return EFI_SUCCESS;
+}
+
+/**
+  Writes the index of one variable of a multi-variable set behind the base name.
+
+  @param[in, out]  ChunkName       Name buffer prepared by LargeVariableInitName ().
+  @param[in]       BaseNameLength  Length of the base name in characters.
+  @param[in]       Index           Index of the variable.
+
+**/
+STATIC
+VOID
+LargeVariableSetNameIndex (
+  IN OUT CHAR16                      *ChunkName,
+  IN     UINTN                       BaseNameLength,
+  IN     UINTN                       Index
+  )
+{
+  UnicodeValueToStringS (
+    &ChunkName[BaseNameLength],
+    (MAX_VARIABLE_NAME_SIZE - BaseNameLength) * sizeof (CHAR16),
+    0,
+    Index,
+    0
+    );
+}
+
+/**
+  Adds up the sizes of the variables of a multi-variable set, starting at the
+  given index.
+
+  @param[in, out]  ChunkName       Name buffer prepared by LargeVariableInitName ().
+  @param[in]       BaseNameLength  Length of the base name in characters.
+  @param[in]       VendorGuid      A unique identifier for the vendor.
+  @param[in]       FirstIndex      Index of the first variable to size.
+  @param[in, out]  TotalSize       Incremented by the size of each variable found.
+  @param[out]      VariableCount   Index one past the last variable found.
+
+  @retval EFI_SUCCESS            The end of the set has been reached.
+  @retval Others                 The variable services returned an error.
+
+**/
+STATIC
+EFI_STATUS
+LargeVariableSumSizes (
+  IN OUT CHAR16                      *ChunkName,
+  IN     UINTN                       BaseNameLength,
+  IN     EFI_GUID                    *VendorGuid,
+  IN     UINTN                       FirstIndex,
+  IN OUT UINTN                       *TotalSize,
+  OUT    UINTN                       *VariableCount
+  )
+{
+  EFI_STATUS    Status;
+  UINTN         VarDataSize;
+  UINTN         Index;
+
+  for (Index = FirstIndex; Index < MAX_VARIABLE_SPLIT; Index++) {
+    VarDataSize = 0;
+    LargeVariableSetNameIndex (ChunkName, BaseNameLength, Index);
+    Status = VarLibGetVariable (ChunkName, VendorGuid, NULL, &VarDataSize, NULL);
+    if (Status == EFI_NOT_FOUND) {
+      break;
+    }
+    if (Status != EFI_BUFFER_TOO_SMALL) {
+      return Status;
+    }
+    *TotalSize += VarDataSize;
+  }
+
+  *VariableCount = Index;
+  return EFI_SUCCESS;
+}
+
+/**
+  Returns the size of a large variable and the number of UEFI variables it is
+  stored in.
+
+  The result can be passed to GetLargeVariableWithInfo () to read the data
+  without probing the variables again.
+
+  @param[in]   VariableName  A Null-terminated string that is the name of the vendor's
+                             variable.
+  @param[in]   VendorGuid    A unique identifier for the vendor.
+  @param[out]  Info          The size and variable count of the large variable.
+
+  @retval EFI_SUCCESS            The function completed successfully.
+  @retval EFI_NOT_FOUND          The variable was not found.
+  @retval EFI_INVALID_PARAMETER  VariableName, VendorGuid or Info is NULL.
+  @retval EFI_OUT_OF_RESOURCES   VariableName is too long.
+  @retval EFI_DEVICE_ERROR       The variable could not be retrieved due to a hardware error.
+  @retval EFI_SECURITY_VIOLATION The variable could not be retrieved due to an authentication failure.
+
+**/
+EFI_STATUS
+EFIAPI
+GetLargeVariableInfo (
+  IN     CHAR16                      *VariableName,
+  IN     EFI_GUID                    *VendorGuid,
+  OUT    LARGE_VARIABLE_INFO         *Info
+  )
+{
+  CHAR16        TempVariableName[MAX_VARIABLE_NAME_SIZE];
+  EFI_STATUS    Status;
+  UINTN         BaseNameLength;
+
+  if ((VariableName == NULL) || (VendorGuid == NULL) || (Info == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // First check if a variable with the given name exists
+  //
+  Info->VariableCount = 0;
+  Info->TotalSize     = 0;
+  Status = VarLibGetVariable (VariableName, VendorGuid, NULL, &Info->TotalSize, NULL);
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    return EFI_SUCCESS;
+  } else if (Status != EFI_NOT_FOUND) {
+    return Status;
+  }
+
+  //
+  // Sum up the sizes of the variables of a multi-variable set
+  //
+  Status = LargeVariableInitName (VariableName, TempVariableName, &BaseNameLength);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = LargeVariableSumSizes (
+             TempVariableName,
+             BaseNameLength,
+             VendorGuid,
+             0,
+             &Info->TotalSize,
+             &Info->VariableCount
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (Info->VariableCount == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  DEBUG ((DEBUG_VERBOSE, "TotalSize = %d, NumVariables = %d\n", Info->TotalSize, Info->VariableCount));
+  return EFI_SUCCESS;
+}
+
+/**
+  Returns the value of a large variable described by GetLargeVariableInfo ().
+
+  Exactly Info->VariableCount variables are read straight into Data, so the
+  variable must not have been changed since Info was retrieved.
+
+  @param[in]   VariableName  A Null-terminated string that is the name of the vendor's
+                             variable.
+  @param[in]   VendorGuid    A unique identifier for the vendor.
+  @param[in]   Info          The result of GetLargeVariableInfo () for this variable.
+  @param[out]  Data          The buffer to return the contents of the variable. It must
+                             be at least Info->TotalSize bytes large.
+
+  @retval EFI_SUCCESS            The function completed successfully.
+  @retval EFI_NOT_FOUND          The variable was not found, or no longer matches Info.
+  @retval EFI_BUFFER_TOO_SMALL   The variable no longer matches Info.
+  @retval EFI_INVALID_PARAMETER  VariableName, VendorGuid, Info or Data is NULL.
+  @retval EFI_OUT_OF_RESOURCES   VariableName is too long.
+  @retval EFI_DEVICE_ERROR       The variable could not be retrieved due to a hardware error.
+  @retval EFI_SECURITY_VIOLATION The variable could not be retrieved due to an authentication failure.
+
+**/
+EFI_STATUS
+EFIAPI
+GetLargeVariableWithInfo (
+  IN     CHAR16                      *VariableName,
+  IN     EFI_GUID                    *VendorGuid,
+  IN     CONST LARGE_VARIABLE_INFO   *Info,
+  OUT    VOID                        *Data
+  )
+{
+  CHAR16        TempVariableName[MAX_VARIABLE_NAME_SIZE];
+  EFI_STATUS    Status;
+  UINTN         BaseNameLength;
+  UINTN         VarDataSize;
+  UINTN         Index;
+  UINTN         Offset;
+
+  if ((VariableName == NULL) || (VendorGuid == NULL) || (Info == NULL) || (Data == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (Info->VariableCount == 0) {
+    VarDataSize = Info->TotalSize;
+    Status = VarLibGetVariable (VariableName, VendorGuid, NULL, &VarDataSize, Data);
+    if (!EFI_ERROR (Status) && (VarDataSize != Info->TotalSize)) {
+      Status = EFI_NOT_FOUND;
+    }
+    return Status;
+  }
+
+  Status = LargeVariableInitName (VariableName, TempVariableName, &BaseNameLength);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Offset = 0;
+  for (Index = 0; Index < Info->VariableCount; Index++) {
+    LargeVariableSetNameIndex (TempVariableName, BaseNameLength, Index);
+    VarDataSize = Info->TotalSize - Offset;
+    Status = VarLibGetVariable (TempVariableName, VendorGuid, NULL, &VarDataSize, (UINT8 *) Data + Offset);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    Offset += VarDataSize;
+  }
+
+  if (Offset != Info->TotalSize) {
+    return EFI_NOT_FOUND;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Returns the value of a large variable.
 
+  The variables of a multi-variable set are read straight into Data in a
+  single pass. If Data turns out to be too small, its contents are undefined
+  on return.
+
   @param[in]       VariableName  A Null-terminated string that is the name of the vendor's
                                  variable.
   @param[in]       VendorGuid    A unique identifier for the vendor.
@@ -55,122 +315,100 @@ GetLargeVariable (
   OUT    VOID                        *Data           OPTIONAL
   )
 {
-  CHAR16        TempVariableName[MAX_VARIABLE_NAME_SIZE];
-  EFI_STATUS    Status;
-  UINTN         TotalSize;
-  UINTN         VarDataSize;
-  UINTN         Index;
-  UINTN         VariableSize;
-  UINTN         BytesRemaining;
-  UINT8         *OffsetPtr;
+  CHAR16               TempVariableName[MAX_VARIABLE_NAME_SIZE];
+  EFI_STATUS           Status;
+  LARGE_VARIABLE_INFO  Info;
+  UINTN                BaseNameLength;
+  UINTN                VarDataSize;
+  UINTN                Index;
+  UINTN                Offset;
+
+  if ((VariableName == NULL) || (VendorGuid == NULL) || (DataSize == NULL)) {
+    Status = EFI_INVALID_PARAMETER;
+    goto Done;
+  }
 
-  VarDataSize = 0;
+  if ((Data == NULL) || (*DataSize == 0)) {
+    //
+    // Size query
+    //
+    Status = GetLargeVariableInfo (VariableName, VendorGuid, &Info);
+    if (EFI_ERROR (Status)) {
+      goto Done;
+    }
+
+    if (*DataSize < Info.TotalSize) {
+      *DataSize = Info.TotalSize;
+      Status    = EFI_BUFFER_TOO_SMALL;
+    } else if (Data == NULL) {
+      Status = EFI_INVALID_PARAMETER;
+    } else {
+      *DataSize = Info.TotalSize;
+    }
+    goto Done;
+  }
 
   //
   // First check if a variable with the given name exists
   //
-  Status = VarLibGetVariable (VariableName, VendorGuid, NULL, &VarDataSize, NULL);
-  if (Status == EFI_BUFFER_TOO_SMALL) {
-    if (*DataSize >= VarDataSize) {
-      if (Data == NULL) {
-        Status = EFI_INVALID_PARAMETER;
-        goto Done;
-      }
+  VarDataSize = *DataSize;
+  Status = VarLibGetVariable (VariableName, VendorGuid, NULL, &VarDataSize, Data);
+  if (Status != EFI_NOT_FOUND) {
+    if (!EFI_ERROR (Status) || (Status == EFI_BUFFER_TOO_SMALL)) {
       DEBUG ((DEBUG_VERBOSE, "GetLargeVariable: Single Variable Found\n"));
-      Status = VarLibGetVariable (VariableName, VendorGuid, NULL, DataSize, Data);
-      goto Done;
-    } else {
       *DataSize = VarDataSize;
-      Status = EFI_BUFFER_TOO_SMALL;
-      goto Done;
     }
+    goto Done;
+  }
 
-  } else if (Status == EFI_NOT_FOUND) {
-    //
-    // Check if the first variable of a multi-variable set exists
-    //
-    if (StrLen (VariableName) >= (MAX_VARIABLE_NAME_SIZE - MAX_VARIABLE_SPLIT_DIGITS)) {
-      DEBUG ((DEBUG_ERROR, "GetLargeVariable: Variable name too long\n"));
-      Status = EFI_OUT_OF_RESOURCES;
-      goto Done;
-    }
+  //
+  // Read the variables of a multi-variable set straight into Data until the
+  // next one is not found
+  //
+  Status = LargeVariableInitName (VariableName, TempVariableName, &BaseNameLength);
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
 
-    VarDataSize = 0;
-    Index       = 0;
-    ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
-    UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, L"%s%d", VariableName, Index);
-    Status = VarLibGetVariable (TempVariableName, VendorGuid, NULL, &VarDataSize, NULL);
+  Offset = 0;
+  for (Index = 0; Index < MAX_VARIABLE_SPLIT; Index++) {
+    LargeVariableSetNameIndex (TempVariableName, BaseNameLength, Index);
+    VarDataSize = *DataSize - Offset;
+    Status = VarLibGetVariable (TempVariableName, VendorGuid, NULL, &VarDataSize, (UINT8 *) Data + Offset);
+    if (Status == EFI_NOT_FOUND) {
+      break;
+    }
 
     if (Status == EFI_BUFFER_TOO_SMALL) {
       //
-      // The first variable exists. Calculate the total size of all the variables.
+      // The rest does not fit, only add up the sizes from here on
       //
-      DEBUG ((DEBUG_VERBOSE, "GetLargeVariable: Multiple Variables Found\n"));
-      TotalSize = 0;
-      for (Index = 0; Index < MAX_VARIABLE_SPLIT; Index++) {
-        VarDataSize = 0;
-        ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
-        UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, L"%s%d", VariableName, Index);
-        Status = VarLibGetVariable (TempVariableName, VendorGuid, NULL, &VarDataSize, NULL);
-        if (Status != EFI_BUFFER_TOO_SMALL) {
-          break;
-        }
-        TotalSize += VarDataSize;
+      Offset += VarDataSize;
+      Status = LargeVariableSumSizes (TempVariableName, BaseNameLength, VendorGuid, Index + 1, &Offset, &Index);
+      if (!EFI_ERROR (Status)) {
+        *DataSize = Offset;
+        Status    = EFI_BUFFER_TOO_SMALL;
       }
-      DEBUG ((DEBUG_VERBOSE, "TotalSize = %d, NumVariables = %d\n", TotalSize, Index));
+      goto Done;
+    }
 
-      //
-      // Check if the user provided a large enough buffer
-      //
-      if (*DataSize >= TotalSize) {
-        if (Data == NULL) {
-          Status = EFI_INVALID_PARAMETER;
-          goto Done;
-        }
-
-        //
-        // Read the data from all variables
-        //
-        OffsetPtr       = (UINT8 *) Data;
-        BytesRemaining  = *DataSize;
-        for (Index = 0; Index < MAX_VARIABLE_SPLIT; Index++) {
-          VarDataSize = 0;
-          ZeroMem (TempVariableName, MAX_VARIABLE_NAME_SIZE);
-          UnicodeSPrint (TempVariableName, MAX_VARIABLE_NAME_SIZE, L"%s%d", VariableName, Index);
-          VariableSize = BytesRemaining;
-          DEBUG ((DEBUG_INFO, "Reading %s, Guid = %g,", TempVariableName, VendorGuid));
-          Status = VarLibGetVariable (TempVariableName, VendorGuid, NULL, &VariableSize, (VOID *) OffsetPtr);
-          DEBUG ((DEBUG_INFO, " Size %d\n", VariableSize));
-          if (EFI_ERROR (Status)) {
-            if (Status == EFI_NOT_FOUND) {
-              DEBUG ((DEBUG_VERBOSE, "No more variables found\n"));
-              Status = EFI_SUCCESS;   // The end has been reached
-            }
-            goto Done;
-          }
-
-          if (VariableSize < BytesRemaining) {
-            BytesRemaining -= VariableSize;
-            OffsetPtr += VariableSize;
-          } else {
-            DEBUG ((DEBUG_VERBOSE, "All data has been read\n"));
-            BytesRemaining = 0;
-            break;
-          }
-        }   //End of for loop
-
-        goto Done;
-      } else {
-        *DataSize = TotalSize;
-        Status = EFI_BUFFER_TOO_SMALL;
-        goto Done;
-      }
-    } else {
-      Status = EFI_NOT_FOUND;
+    if (EFI_ERROR (Status)) {
+      goto Done;
     }
+    Offset += VarDataSize;
   }
 
+  if (Index == 0) {
+    goto Done;
+  }
+
+  DEBUG ((DEBUG_VERBOSE, "TotalSize = %d, NumVariables = %d\n", Offset, Index));
+  *DataSize = Offset;
+  Status    = EFI_SUCCESS;
+
 Done:
-  DEBUG ((DEBUG_ERROR, "GetLargeVariable: Status = %r\n", Status));
+  if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND) && (Status != EFI_BUFFER_TOO_SMALL)) {
+    DEBUG ((DEBUG_ERROR, "GetLargeVariable: Status = %r\n", Status));
+  }
   return Status;
 }
@@ -7,15 +7,21 @@
   This sequence is further divided into Blocks and Huffman codings
   are applied to each Block.
 
+  All state of the compressor lives in a COMPRESS_CONTEXT, so the
+  routines are reentrant and the work buffers can be reused across
+  calls through CompressWithContext().
+
   Copyright (c) 2007 - 2020, Intel Corporation. All rights reserved.<BR>
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
 
+#include <Uefi/UefiBaseType.h>
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
-#include <Uefi/UefiBaseType.h>
+#include <Library/CompressLib.h>
 
 #define SHELL_FREE_NON_NULL(Pointer)  \
   do {                                \
@@ -33,7 +39,6 @@
 typedef INT16             NODE;
 #define UINT8_BIT         8
 #define THRESHOLD         3
-#define INIT_CRC          0
 #define WNDBIT            13
 #define WNDSIZ            (1U << WNDBIT)
 #define MAXMATCH          256
@@ -43,8 +48,6 @@ typedef INT16             NODE;
 #define NIL               0
 #define MAX_HASH_VAL      (3 * WNDSIZ + (WNDSIZ / 512 + 1) * MAX_UINT8)
 #define HASH(LoopVar7, LoopVar5)        ((LoopVar7) + ((LoopVar5) << (WNDBIT - 9)) + WNDSIZ * 2)
-#define CRCPOLY           0xA001
-#define UPDATE_CRC(LoopVar5)     mCrc = mCrcTable[(mCrc ^ (LoopVar5)) & 0xFF] ^ (mCrc >> UINT8_BIT)
 
 //
 // C: the Char&Len Set; P: the Position Set; T: the exTra Set
@@ -60,131 +63,96 @@ typedef INT16             NODE;
 #else
   #define                 NPT NP
 #endif
-//
-// Function Prototypes
-//
-
-/**
-  Put a dword to output stream.
-
-  @param[in] Data    The dword to put.
-**/
-VOID
-EFIAPI
-PutDword (
-  IN UINT32 Data
-  );
 
 //
-//  Global Variables
+// State of one compressor instance.
 //
-STATIC UINT8  *mSrc;
-STATIC UINT8  *mDst;
-STATIC UINT8  *mSrcUpperLimit;
-STATIC UINT8  *mDstUpperLimit;
-
-STATIC UINT8  *mLevel;
-STATIC UINT8  *mText;
-STATIC UINT8  *mChildCount;
-STATIC UINT8  *mBuf;
-STATIC UINT8  mCLen[NC];
-STATIC UINT8  mPTLen[NPT];
-STATIC UINT8  *mLen;
-STATIC INT16  mHeap[NC + 1];
-STATIC INT32  mRemainder;
-STATIC INT32  mMatchLen;
-STATIC INT32  mBitCount;
-STATIC INT32  mHeapSize;
-STATIC INT32  mTempInt32;
-STATIC UINT32 mBufSiz = 0;
-STATIC UINT32 mOutputPos;
-STATIC UINT32 mOutputMask;
-STATIC UINT32 mSubBitBuf;
-STATIC UINT32 mCrc;
-STATIC UINT32 mCompSize;
-STATIC UINT32 mOrigSize;
-
-STATIC UINT16 *mFreq;
-STATIC UINT16 *mSortPtr;
-STATIC UINT16 mLenCnt[17];
-STATIC UINT16 mLeft[2 * NC - 1];
-STATIC UINT16 mRight[2 * NC - 1];
-STATIC UINT16 mCrcTable[MAX_UINT8 + 1];
-STATIC UINT16 mCFreq[2 * NC - 1];
-STATIC UINT16 mCCode[NC];
-STATIC UINT16 mPFreq[2 * NP - 1];
-STATIC UINT16 mPTCode[NPT];
-STATIC UINT16 mTFreq[2 * NT - 1];
-
-STATIC NODE   mPos;
-STATIC NODE   mMatchPos;
-STATIC NODE   mAvail;
-STATIC NODE   *mPosition;
-STATIC NODE   *mParent;
-STATIC NODE   *mPrev;
-STATIC NODE   *mNext = NULL;
-INT32         mHuffmanDepth = 0;
-
-/**
-  Make a CRC table.
-
-**/
-VOID
-EFIAPI
-MakeCrcTable (
-  VOID
-  )
-{
-  UINT32  LoopVar1;
-
-  UINT32  LoopVar2;
-
-  UINT32  LoopVar4;
-
-  for (LoopVar1 = 0; LoopVar1 <= MAX_UINT8; LoopVar1++) {
-    LoopVar4 = LoopVar1;
-    for (LoopVar2 = 0; LoopVar2 < UINT8_BIT; LoopVar2++) {
-      if ((LoopVar4 & 1) != 0) {
-        LoopVar4 = (LoopVar4 >> 1) ^ CRCPOLY;
-      } else {
-        LoopVar4 >>= 1;
-      }
-    }
+struct _COMPRESS_CONTEXT {
+  UINT8     *mSrc;
+  UINT8     *mDst;
+  UINT8     *mSrcUpperLimit;
+  UINT8     *mDstUpperLimit;
 
-    mCrcTable[LoopVar1] = (UINT16) LoopVar4;
-  }
-}
+  //
+  // Work buffers, allocated once by CreateCompressContext()
+  //
+  UINT8     *mLevel;
+  UINT8     *mText;
+  UINT8     *mChildCount;
+  UINT8     *mBuf;
+  NODE      *mPosition;
+  NODE      *mParent;
+  NODE      *mPrev;
+  NODE      *mNext;
+  UINT32    mBufSiz;
+
+  UINT8     mCLen[NC];
+  UINT8     mPTLen[NPT];
+  UINT8     *mLen;
+  INT16     mHeap[NC + 1];
+  INT32     mRemainder;
+  INT32     mMatchLen;
+  INT32     mBitCount;
+  INT32     mHeapSize;
+  INT32     mTempInt32;
+  INT32     mHuffmanDepth;
+  UINT32    mOutputPos;
+  UINT32    mOutputMask;
+  UINT32    mCPos;
+  UINT32    mSubBitBuf;
+  UINT32    mCompSize;
+  UINT32    mOrigSize;
+
+  UINT16    *mFreq;
+  UINT16    *mSortPtr;
+  UINT16    mLenCnt[17];
+  UINT16    mLeft[2 * NC - 1];
+  UINT16    mRight[2 * NC - 1];
+  UINT16    mCFreq[2 * NC - 1];
+  UINT16    mCCode[NC];
+  UINT16    mPFreq[2 * NP - 1];
+  UINT16    mPTCode[NPT];
+  UINT16    mTFreq[2 * NT - 1];
+
+  NODE      mPos;
+  NODE      mMatchPos;
+  NODE      mAvail;
+};
 
 /**
   Put a dword to output stream
 
+  @param[in, out] Sd   The compression context.
   @param[in] Data    The dword to put.
 **/
 VOID
 EFIAPI
 PutDword (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN UINT32 Data
   )
 {
-  if (mDst < mDstUpperLimit) {
-    *mDst++ = (UINT8) (((UINT8) (Data)) & 0xff);
+  if (Sd->mDst < Sd->mDstUpperLimit) {
+    *Sd->mDst++ = (UINT8) (((UINT8) (Data)) & 0xff);
   }
 
-  if (mDst < mDstUpperLimit) {
-    *mDst++ = (UINT8) (((UINT8) (Data >> 0x08)) & 0xff);
+  if (Sd->mDst < Sd->mDstUpperLimit) {
+    *Sd->mDst++ = (UINT8) (((UINT8) (Data >> 0x08)) & 0xff);
   }
 
-  if (mDst < mDstUpperLimit) {
-    *mDst++ = (UINT8) (((UINT8) (Data >> 0x10)) & 0xff);
+  if (Sd->mDst < Sd->mDstUpperLimit) {
+    *Sd->mDst++ = (UINT8) (((UINT8) (Data >> 0x10)) & 0xff);
   }
 
-  if (mDst < mDstUpperLimit) {
-    *mDst++ = (UINT8) (((UINT8) (Data >> 0x18)) & 0xff);
+  if (Sd->mDst < Sd->mDstUpperLimit) {
+    *Sd->mDst++ = (UINT8) (((UINT8) (Data >> 0x18)) & 0xff);
   }
 }
 
 /**
-  Allocate memory spaces for data structures used in compression process.
+  Allocate the work buffers of a compression context.
+
+  @param[in, out] Sd   The compression context.
 
   @retval EFI_SUCCESS           Memory was allocated successfully.
   @retval EFI_OUT_OF_RESOURCES  A memory allocation failed.
@@ -192,81 +160,98 @@ PutDword (
 EFI_STATUS
 EFIAPI
 AllocateMemory (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
-  mText       = AllocateZeroPool (WNDSIZ * 2 + MAXMATCH);
-  mLevel      = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mLevel));
-  mChildCount = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mChildCount));
-  mPosition   = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mPosition));
-  mParent     = AllocateZeroPool (WNDSIZ * 2 * sizeof (*mParent));
-  mPrev       = AllocateZeroPool (WNDSIZ * 2 * sizeof (*mPrev));
-  mNext       = AllocateZeroPool ((MAX_HASH_VAL + 1) * sizeof (*mNext));
-
-  mBufSiz     = BLKSIZ;
-  mBuf        = AllocateZeroPool (mBufSiz);
-  while (mBuf == NULL) {
-    mBufSiz = (mBufSiz / 10U) * 9U;
-    if (mBufSiz < 4 * 1024U) {
+  Sd->mText       = AllocateZeroPool (WNDSIZ * 2 + MAXMATCH);
+  Sd->mLevel      = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*Sd->mLevel));
+  Sd->mChildCount = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*Sd->mChildCount));
+  Sd->mPosition   = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*Sd->mPosition));
+  Sd->mParent     = AllocateZeroPool (WNDSIZ * 2 * sizeof (*Sd->mParent));
+  Sd->mPrev       = AllocateZeroPool (WNDSIZ * 2 * sizeof (*Sd->mPrev));
+  Sd->mNext       = AllocateZeroPool ((MAX_HASH_VAL + 1) * sizeof (*Sd->mNext));
+
+  Sd->mBufSiz = BLKSIZ;
+  Sd->mBuf    = AllocateZeroPool (Sd->mBufSiz);
+  while (Sd->mBuf == NULL) {
+    Sd->mBufSiz = (Sd->mBufSiz / 10U) * 9U;
+    if (Sd->mBufSiz < 4 * 1024U) {
       return EFI_OUT_OF_RESOURCES;
     }
 
-    mBuf = AllocateZeroPool (mBufSiz);
+    Sd->mBuf = AllocateZeroPool (Sd->mBufSiz);
   }
 
-  mBuf[0] = 0;
-
   return EFI_SUCCESS;
 }
 
 /**
-  Called when compression is completed to free memory previously allocated.
+  Free the work buffers of a compression context.
+
+  @param[in, out] Sd   The compression context.
 
 **/
 VOID
 EFIAPI
 FreeMemory (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
-  SHELL_FREE_NON_NULL (mText);
-  SHELL_FREE_NON_NULL (mLevel);
-  SHELL_FREE_NON_NULL (mChildCount);
-  SHELL_FREE_NON_NULL (mPosition);
-  SHELL_FREE_NON_NULL (mParent);
-  SHELL_FREE_NON_NULL (mPrev);
-  SHELL_FREE_NON_NULL (mNext);
-  SHELL_FREE_NON_NULL (mBuf);
+  SHELL_FREE_NON_NULL (Sd->mText);
+  SHELL_FREE_NON_NULL (Sd->mLevel);
+  SHELL_FREE_NON_NULL (Sd->mChildCount);
+  SHELL_FREE_NON_NULL (Sd->mPosition);
+  SHELL_FREE_NON_NULL (Sd->mParent);
+  SHELL_FREE_NON_NULL (Sd->mPrev);
+  SHELL_FREE_NON_NULL (Sd->mNext);
+  SHELL_FREE_NON_NULL (Sd->mBuf);
 }
 
 /**
   Initialize String Info Log data structures.
+
+  The work buffers are cleared first. Match selection can look at text
+  beyond the end of the input, so a reused context has to start from the
+  same zeroed state as a freshly allocated one to produce identical output.
+
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 InitSlide (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
   NODE  LoopVar1;
 
-  SetMem (mLevel + WNDSIZ, (MAX_UINT8 + 1) * sizeof (UINT8), 1);
-  SetMem (mPosition + WNDSIZ, (MAX_UINT8 + 1) * sizeof (NODE), 0);
+  ZeroMem (Sd->mText, WNDSIZ * 2 + MAXMATCH);
+  ZeroMem (Sd->mLevel, (WNDSIZ + MAX_UINT8 + 1) * sizeof (*Sd->mLevel));
+  ZeroMem (Sd->mChildCount, (WNDSIZ + MAX_UINT8 + 1) * sizeof (*Sd->mChildCount));
+  ZeroMem (Sd->mPosition, (WNDSIZ + MAX_UINT8 + 1) * sizeof (*Sd->mPosition));
+  ZeroMem (Sd->mParent, WNDSIZ * 2 * sizeof (*Sd->mParent));
+  ZeroMem (Sd->mPrev, WNDSIZ * 2 * sizeof (*Sd->mPrev));
+  ZeroMem (Sd->mNext, (MAX_HASH_VAL + 1) * sizeof (*Sd->mNext));
+  ZeroMem (Sd->mBuf, Sd->mBufSiz);
+
+  SetMem (Sd->mLevel + WNDSIZ, (MAX_UINT8 + 1) * sizeof (UINT8), 1);
+  SetMem (Sd->mPosition + WNDSIZ, (MAX_UINT8 + 1) * sizeof (NODE), 0);
 
-  SetMem (mParent + WNDSIZ, WNDSIZ * sizeof (NODE), 0);
+  SetMem (Sd->mParent + WNDSIZ, WNDSIZ * sizeof (NODE), 0);
 
-  mAvail = 1;
+  Sd->mAvail = 1;
   for (LoopVar1 = 1; LoopVar1 < WNDSIZ - 1; LoopVar1++) {
-    mNext[LoopVar1] = (NODE) (LoopVar1 + 1);
+    Sd->mNext[LoopVar1] = (NODE) (LoopVar1 + 1);
   }
 
-  mNext[WNDSIZ - 1] = NIL;
-  SetMem (mNext + WNDSIZ * 2, (MAX_HASH_VAL - WNDSIZ * 2 + 1) * sizeof (NODE), 0);
+  Sd->mNext[WNDSIZ - 1] = NIL;
+  SetMem (Sd->mNext + WNDSIZ * 2, (MAX_HASH_VAL - WNDSIZ * 2 + 1) * sizeof (NODE), 0);
 }
 
 /**
   Find child node given the parent node and the edge character
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar6       The parent node.
   @param[in] LoopVar5       The edge character.
 
@@ -277,16 +262,17 @@ InitSlide (
 NODE
 EFIAPI
 Child (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN NODE   LoopVar6,
   IN UINT8  LoopVar5
   )
 {
   NODE  LoopVar4;
 
-  LoopVar4      = mNext[HASH (LoopVar6, LoopVar5)];
-  mParent[NIL]  = LoopVar6;  /* sentinel */
-  while (mParent[LoopVar4] != LoopVar6) {
-    LoopVar4 = mNext[LoopVar4];
+  LoopVar4      = Sd->mNext[HASH (LoopVar6, LoopVar5)];
+  Sd->mParent[NIL]  = LoopVar6;  /* sentinel */
+  while (Sd->mParent[LoopVar4] != LoopVar6) {
+    LoopVar4 = Sd->mNext[LoopVar4];
   }
 
   return LoopVar4;
@@ -295,6 +281,7 @@ Child (
 /**
   Create a new child for a given parent node.
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar6       The parent node.
   @param[in] LoopVar5       The edge character.
   @param[in] LoopVar4       The child node.
@@ -303,6 +290,7 @@ Child (
 VOID
 EFIAPI
 MakeChild (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN NODE   LoopVar6,
   IN UINT8  LoopVar5,
   IN NODE   LoopVar4
@@ -312,25 +300,27 @@ MakeChild (
 
   NODE  LoopVar10;
 
-  LoopVar12          = (NODE) HASH (LoopVar6, LoopVar5);
-  LoopVar10          = mNext[LoopVar12];
-  mNext[LoopVar12]   = LoopVar4;
-  mNext[LoopVar4]    = LoopVar10;
-  mPrev[LoopVar10]   = LoopVar4;
-  mPrev[LoopVar4]    = LoopVar12;
-  mParent[LoopVar4]  = LoopVar6;
-  mChildCount[LoopVar6]++;
+  LoopVar12             = (NODE) HASH (LoopVar6, LoopVar5);
+  LoopVar10             = Sd->mNext[LoopVar12];
+  Sd->mNext[LoopVar12]  = LoopVar4;
+  Sd->mNext[LoopVar4]   = LoopVar10;
+  Sd->mPrev[LoopVar10]  = LoopVar4;
+  Sd->mPrev[LoopVar4]   = LoopVar12;
+  Sd->mParent[LoopVar4] = LoopVar6;
+  Sd->mChildCount[LoopVar6]++;
 }
 
 /**
   Split a node.
 
+  @param[in, out] Sd   The compression context.
   @param[in] Old     The node to split.
 
 **/
 VOID
 EFIAPI
 Split (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN NODE Old
   )
 {
@@ -338,30 +328,32 @@ Split (
 
   NODE  LoopVar10;
 
-  New               = mAvail;
-  mAvail            = mNext[New];
-  mChildCount[New]  = 0;
-  LoopVar10         = mPrev[Old];
-  mPrev[New]        = LoopVar10;
-  mNext[LoopVar10]  = New;
-  LoopVar10         = mNext[Old];
-  mNext[New]        = LoopVar10;
-  mPrev[LoopVar10]  = New;
-  mParent[New]      = mParent[Old];
-  mLevel[New]       = (UINT8) mMatchLen;
-  mPosition[New]    = mPos;
-  MakeChild (New, mText[mMatchPos + mMatchLen], Old);
-  MakeChild (New, mText[mPos + mMatchLen], mPos);
+  New                  = Sd->mAvail;
+  Sd->mAvail           = Sd->mNext[New];
+  Sd->mChildCount[New] = 0;
+  LoopVar10            = Sd->mPrev[Old];
+  Sd->mPrev[New]       = LoopVar10;
+  Sd->mNext[LoopVar10] = New;
+  LoopVar10            = Sd->mNext[Old];
+  Sd->mNext[New]       = LoopVar10;
+  Sd->mPrev[LoopVar10] = New;
+  Sd->mParent[New]     = Sd->mParent[Old];
+  Sd->mLevel[New]      = (UINT8) Sd->mMatchLen;
+  Sd->mPosition[New]   = Sd->mPos;
+  MakeChild (Sd, New, Sd->mText[Sd->mMatchPos + Sd->mMatchLen], Old);
+  MakeChild (Sd, New, Sd->mText[Sd->mPos + Sd->mMatchLen], Sd->mPos);
 }
 
 /**
   Insert string info for current position into the String Info Log.
 
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 InsertNode (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
   NODE  LoopVar6;
@@ -375,7 +367,7 @@ InsertNode (
   UINT8 *TempString3;
   UINT8 *TempString2;
 
-  if (mMatchLen >= 4) {
+  if (Sd->mMatchLen >= 4) {
     //
     // We have just got a long match, the target tree
     // can be located by MatchPos + 1. Travese the tree
@@ -383,42 +375,42 @@ InsertNode (
     // The usage of PERC_FLAG ensures proper node deletion
     // in DeleteNode() later.
     //
-    mMatchLen--;
-    LoopVar4 = (NODE) ((mMatchPos + 1) | WNDSIZ);
-    LoopVar6 = mParent[LoopVar4];
+    Sd->mMatchLen--;
+    LoopVar4 = (NODE) ((Sd->mMatchPos + 1) | WNDSIZ);
+    LoopVar6 = Sd->mParent[LoopVar4];
     while (LoopVar6 == NIL) {
-      LoopVar4 = mNext[LoopVar4];
-      LoopVar6 = mParent[LoopVar4];
+      LoopVar4 = Sd->mNext[LoopVar4];
+      LoopVar6 = Sd->mParent[LoopVar4];
     }
 
-    while (mLevel[LoopVar6] >= mMatchLen) {
+    while (Sd->mLevel[LoopVar6] >= Sd->mMatchLen) {
       LoopVar4 = LoopVar6;
-      LoopVar6 = mParent[LoopVar6];
+      LoopVar6 = Sd->mParent[LoopVar6];
     }
 
     LoopVar10 = LoopVar6;
-    while (mPosition[LoopVar10] < 0) {
-      mPosition[LoopVar10]  = mPos;
-      LoopVar10             = mParent[LoopVar10];
+    while (Sd->mPosition[LoopVar10] < 0) {
+      Sd->mPosition[LoopVar10] = Sd->mPos;
+      LoopVar10                = Sd->mParent[LoopVar10];
     }
 
     if (LoopVar10 < WNDSIZ) {
-      mPosition[LoopVar10] = (NODE) (mPos | PERC_FLAG);
+      Sd->mPosition[LoopVar10] = (NODE) (Sd->mPos | PERC_FLAG);
     }
   } else {
     //
     // Locate the target tree
     //
-    LoopVar6 = (NODE) (mText[mPos] + WNDSIZ);
-    LoopVar5 = mText[mPos + 1];
-    LoopVar4 = Child (LoopVar6, LoopVar5);
+    LoopVar6 = (NODE) (Sd->mText[Sd->mPos] + WNDSIZ);
+    LoopVar5 = Sd->mText[Sd->mPos + 1];
+    LoopVar4 = Child (Sd, LoopVar6, LoopVar5);
     if (LoopVar4 == NIL) {
-      MakeChild (LoopVar6, LoopVar5, mPos);
-      mMatchLen = 1;
+      MakeChild (Sd, LoopVar6, LoopVar5, Sd->mPos);
+      Sd->mMatchLen = 1;
       return;
     }
 
-    mMatchLen = 2;
+    Sd->mMatchLen = 2;
   }
   //
   // Traverse down the tree to find a match.
@@ -427,58 +419,70 @@ InsertNode (
   //
   for (;;) {
     if (LoopVar4 >= WNDSIZ) {
-      LoopVar2  = MAXMATCH;
-      mMatchPos = LoopVar4;
+      LoopVar2      = MAXMATCH;
+      Sd->mMatchPos = LoopVar4;
     } else {
-      LoopVar2  = mLevel[LoopVar4];
-      mMatchPos = (NODE) (mPosition[LoopVar4] & ~PERC_FLAG);
+      LoopVar2      = Sd->mLevel[LoopVar4];
+      Sd->mMatchPos = (NODE) (Sd->mPosition[LoopVar4] & ~PERC_FLAG);
+    }
+
+    if (Sd->mMatchPos >= Sd->mPos) {
+      Sd->mMatchPos -= WNDSIZ;
     }
 
-    if (mMatchPos >= mPos) {
-      mMatchPos -= WNDSIZ;
+    TempString3 = &Sd->mText[Sd->mPos + Sd->mMatchLen];
+    TempString2 = &Sd->mText[Sd->mMatchPos + Sd->mMatchLen];
+    //
+    // Skip over equal bytes eight at a time, the byte loop below
+    // then finds the exact mismatch.
+    //
+    while ((Sd->mMatchLen + (INT32)sizeof (UINT64) <= LoopVar2) &&
+           (ReadUnaligned64 ((UINT64 *) TempString3) == ReadUnaligned64 ((UINT64 *) TempString2)))
+    {
+      Sd->mMatchLen += sizeof (UINT64);
+      TempString3   += sizeof (UINT64);
+      TempString2   += sizeof (UINT64);
     }
 
-    TempString3 = &mText[mPos + mMatchLen];
-    TempString2 = &mText[mMatchPos + mMatchLen];
-    while (mMatchLen < LoopVar2) {
+    while (Sd->mMatchLen < LoopVar2) {
       if (*TempString3 != *TempString2) {
-        Split (LoopVar4);
+        Split (Sd, LoopVar4);
         return;
       }
 
-      mMatchLen++;
+      Sd->mMatchLen++;
       TempString3++;
       TempString2++;
     }
 
-    if (mMatchLen >= MAXMATCH) {
+    if (Sd->mMatchLen >= MAXMATCH) {
       break;
     }
 
-    mPosition[LoopVar4]  = mPos;
-    LoopVar6             = LoopVar4;
-    LoopVar4             = Child (LoopVar6, *TempString3);
+    Sd->mPosition[LoopVar4] = Sd->mPos;
+    LoopVar6                = LoopVar4;
+    LoopVar4                = Child (Sd, LoopVar6, *TempString3);
     if (LoopVar4 == NIL) {
-      MakeChild (LoopVar6, *TempString3, mPos);
+      MakeChild (Sd, LoopVar6, *TempString3, Sd->mPos);
       return;
     }
 
-    mMatchLen++;
+    Sd->mMatchLen++;
   }
 
-  LoopVar10             = mPrev[LoopVar4];
-  mPrev[mPos]           = LoopVar10;
-  mNext[LoopVar10]      = mPos;
-  LoopVar10             = mNext[LoopVar4];
-  mNext[mPos]           = LoopVar10;
-  mPrev[LoopVar10]      = mPos;
-  mParent[mPos]         = LoopVar6;
-  mParent[LoopVar4]     = NIL;
+  LoopVar10             = Sd->mPrev[LoopVar4];
+  Sd->mPrev[Sd->mPos]   = LoopVar10;
+  Sd->mNext[LoopVar10]  = Sd->mPos;
+  LoopVar10             = Sd->mNext[LoopVar4];
+  Sd->mNext[Sd->mPos]   = LoopVar10;
+  Sd->mPrev[LoopVar10]  = Sd->mPos;
+  Sd->mParent[Sd->mPos] = LoopVar6;
+  Sd->mParent[LoopVar4] = NIL;
 
   //
   // Special usage of 'next'
   //
-  mNext[LoopVar4] = mPos;
+  Sd->mNext[LoopVar4] = Sd->mPos;
 
 }
 
@@ -486,11 +490,13 @@ InsertNode (
   Delete outdated string info. (The Usage of PERC_FLAG
   ensures a clean deletion).
 
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 DeleteNode (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
   NODE  LoopVar6;
@@ -503,36 +509,36 @@ DeleteNode (
 
   NODE  LoopVar9;
 
-  if (mParent[mPos] == NIL) {
+  if (Sd->mParent[Sd->mPos] == NIL) {
     return;
   }
 
-  LoopVar4             = mPrev[mPos];
-  LoopVar11            = mNext[mPos];
-  mNext[LoopVar4]      = LoopVar11;
-  mPrev[LoopVar11]     = LoopVar4;
-  LoopVar4             = mParent[mPos];
-  mParent[mPos]        = NIL;
+  LoopVar4              = Sd->mPrev[Sd->mPos];
+  LoopVar11             = Sd->mNext[Sd->mPos];
+  Sd->mNext[LoopVar4]   = LoopVar11;
+  Sd->mPrev[LoopVar11]  = LoopVar4;
+  LoopVar4              = Sd->mParent[Sd->mPos];
+  Sd->mParent[Sd->mPos] = NIL;
   if (LoopVar4 >= WNDSIZ) {
     return;
   }
 
-  mChildCount[LoopVar4]--;
-  if (mChildCount[LoopVar4] > 1) {
+  Sd->mChildCount[LoopVar4]--;
+  if (Sd->mChildCount[LoopVar4] > 1) {
     return;
   }
 
-  LoopVar10 = (NODE) (mPosition[LoopVar4] & ~PERC_FLAG);
-  if (LoopVar10 >= mPos) {
+  LoopVar10 = (NODE) (Sd->mPosition[LoopVar4] & ~PERC_FLAG);
+  if (LoopVar10 >= Sd->mPos) {
     LoopVar10 -= WNDSIZ;
   }
 
   LoopVar11 = LoopVar10;
-  LoopVar6 = mParent[LoopVar4];
-  LoopVar9 = mPosition[LoopVar6];
+  LoopVar6 = Sd->mParent[LoopVar4];
+  LoopVar9 = Sd->mPosition[LoopVar6];
   while ((LoopVar9 & PERC_FLAG) != 0) {
     LoopVar9 &= ~PERC_FLAG;
-    if (LoopVar9 >= mPos) {
+    if (LoopVar9 >= Sd->mPos) {
       LoopVar9 -= WNDSIZ;
     }
 
@@ -540,13 +546,13 @@ DeleteNode (
       LoopVar11 = LoopVar9;
     }
 
-    mPosition[LoopVar6]  = (NODE) (LoopVar11 | WNDSIZ);
-    LoopVar6             = mParent[LoopVar6];
-    LoopVar9             = mPosition[LoopVar6];
+    Sd->mPosition[LoopVar6] = (NODE) (LoopVar11 | WNDSIZ);
+    LoopVar6                = Sd->mParent[LoopVar6];
+    LoopVar9                = Sd->mPosition[LoopVar6];
   }
 
   if (LoopVar6 < WNDSIZ) {
-    if (LoopVar9 >= mPos) {
+    if (LoopVar9 >= Sd->mPos) {
       LoopVar9 -= WNDSIZ;
     }
 
@@ -554,29 +560,30 @@ DeleteNode (
       LoopVar11 = LoopVar9;
     }
 
-    mPosition[LoopVar6] = (NODE) (LoopVar11 | WNDSIZ | PERC_FLAG);
+    Sd->mPosition[LoopVar6] = (NODE) (LoopVar11 | WNDSIZ | PERC_FLAG);
   }
 
-  LoopVar11           = Child (LoopVar4, mText[LoopVar10 + mLevel[LoopVar4]]);
-  LoopVar10           = mPrev[LoopVar11];
-  LoopVar9            = mNext[LoopVar11];
-  mNext[LoopVar10]    = LoopVar9;
-  mPrev[LoopVar9]     = LoopVar10;
-  LoopVar10           = mPrev[LoopVar4];
-  mNext[LoopVar10]    = LoopVar11;
-  mPrev[LoopVar11]    = LoopVar10;
-  LoopVar10           = mNext[LoopVar4];
-  mPrev[LoopVar10]    = LoopVar11;
-  mNext[LoopVar11]    = LoopVar10;
-  mParent[LoopVar11]  = mParent[LoopVar4];
-  mParent[LoopVar4]   = NIL;
-  mNext[LoopVar4]     = mAvail;
-  mAvail              = LoopVar4;
+  LoopVar11              = Child (Sd, LoopVar4, Sd->mText[LoopVar10 + Sd->mLevel[LoopVar4]]);
+  LoopVar10              = Sd->mPrev[LoopVar11];
+  LoopVar9               = Sd->mNext[LoopVar11];
+  Sd->mNext[LoopVar10]   = LoopVar9;
+  Sd->mPrev[LoopVar9]    = LoopVar10;
+  LoopVar10              = Sd->mPrev[LoopVar4];
+  Sd->mNext[LoopVar10]   = LoopVar11;
+  Sd->mPrev[LoopVar11]   = LoopVar10;
+  LoopVar10              = Sd->mNext[LoopVar4];
+  Sd->mPrev[LoopVar10]   = LoopVar11;
+  Sd->mNext[LoopVar11]   = LoopVar10;
+  Sd->mParent[LoopVar11] = Sd->mParent[LoopVar4];
+  Sd->mParent[LoopVar4]  = NIL;
+  Sd->mNext[LoopVar4]    = Sd->mAvail;
+  Sd->mAvail             = LoopVar4;
 }
 
 /**
   Read in source data
 
+  @param[in, out] Sd   The compression context.
   @param[out] LoopVar7   The buffer to hold the data.
   @param[in] LoopVar8    The number of bytes to read.
 
@@ -585,26 +592,19 @@ DeleteNode (
 **/
 INT32
 EFIAPI
-FreadCrc (
+Fread (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   OUT UINT8 *LoopVar7,
   IN  INT32 LoopVar8
   )
 {
-  INT32 LoopVar1;
-
-  for (LoopVar1 = 0; mSrc < mSrcUpperLimit && LoopVar1 < LoopVar8; LoopVar1++) {
-    *LoopVar7++ = *mSrc++;
+  if (LoopVar8 > Sd->mSrcUpperLimit - Sd->mSrc) {
+    LoopVar8 = (INT32) (Sd->mSrcUpperLimit - Sd->mSrc);
   }
 
-  LoopVar8 = LoopVar1;
-
-  LoopVar7 -= LoopVar8;
-  mOrigSize += LoopVar8;
-  LoopVar1--;
-  while (LoopVar1 >= 0) {
-    UPDATE_CRC (*LoopVar7++);
-    LoopVar1--;
-  }
+  CopyMem (LoopVar7, Sd->mSrc, LoopVar8);
+  Sd->mSrc      += LoopVar8;
+  Sd->mOrigSize += LoopVar8;
 
   return LoopVar8;
 }
@@ -613,49 +613,44 @@ FreadCrc (
   Advance the current position (read in new data if needed).
   Delete outdated string info. Find a match string for current position.
 
-  @retval TRUE      The operation was successful.
-  @retval FALSE     The operation failed due to insufficient memory.
+  @param[in, out] Sd   The compression context.
 
 **/
-BOOLEAN
+VOID
 EFIAPI
 GetNextMatch (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
   INT32 LoopVar8;
-  VOID  *Temp;
-
-  mRemainder--;
-  mPos++;
-  if (mPos == WNDSIZ * 2) {
-    Temp = AllocateZeroPool (WNDSIZ + MAXMATCH);
-    if (Temp == NULL) {
-      return (FALSE);
-    }
-    CopyMem (Temp, &mText[WNDSIZ], WNDSIZ + MAXMATCH);
-    CopyMem (&mText[0], Temp, WNDSIZ + MAXMATCH);
-    FreePool (Temp);
-    LoopVar8 = FreadCrc (&mText[WNDSIZ + MAXMATCH], WNDSIZ);
-    mRemainder += LoopVar8;
-    mPos = WNDSIZ;
-  }
 
-  DeleteNode ();
-  InsertNode ();
+  Sd->mRemainder--;
+  Sd->mPos++;
+  if (Sd->mPos == WNDSIZ * 2) {
+    //
+    // CopyMem() handles the overlap of the two ranges.
+    //
+    CopyMem (&Sd->mText[0], &Sd->mText[WNDSIZ], WNDSIZ + MAXMATCH);
+    LoopVar8 = Fread (Sd, &Sd->mText[WNDSIZ + MAXMATCH], WNDSIZ);
+    Sd->mRemainder += LoopVar8;
+    Sd->mPos = WNDSIZ;
+  }
 
-  return (TRUE);
+  DeleteNode (Sd);
+  InsertNode (Sd);
 }
 
 /**
   Send entry LoopVar1 down the queue.
 
+  @param[in, out] Sd   The compression context.
   @param[in] Index    The index of the item to move.
 
 **/
 VOID
 EFIAPI
 DownHeap (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN INT32 Index
   )
 {
@@ -666,55 +661,59 @@ DownHeap (
   //
   // priority queue: send Index-th entry down heap
   //
-  LoopVar2 = mHeap[Index];
+  LoopVar2 = Sd->mHeap[Index];
   LoopVar1 = 2 * Index;
-  while (LoopVar1 <= mHeapSize) {
-    if (LoopVar1 < mHeapSize && mFreq[mHeap[LoopVar1]] > mFreq[mHeap[LoopVar1 + 1]]) {
+  while (LoopVar1 <= Sd->mHeapSize) {
+    if (LoopVar1 < Sd->mHeapSize && Sd->mFreq[Sd->mHeap[LoopVar1]] > Sd->mFreq[Sd->mHeap[LoopVar1 + 1]]) {
       LoopVar1++;
     }
 
-    if (mFreq[LoopVar2] <= mFreq[mHeap[LoopVar1]]) {
+    if (Sd->mFreq[LoopVar2] <= Sd->mFreq[Sd->mHeap[LoopVar1]]) {
       break;
     }
 
-    mHeap[Index]  = mHeap[LoopVar1];
-    Index         = LoopVar1;
-    LoopVar1  = 2 * Index;
+    Sd->mHeap[Index] = Sd->mHeap[LoopVar1];
+    Index            = LoopVar1;
+    LoopVar1         = 2 * Index;
   }
 
-  mHeap[Index] = (INT16) LoopVar2;
+  Sd->mHeap[Index] = (INT16) LoopVar2;
 }
 
 /**
   Count the number of each code length for a Huffman tree.
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar1      The top node.
 
 **/
 VOID
 EFIAPI
 CountLen (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN INT32 LoopVar1
   )
 {
-  if (LoopVar1 < mTempInt32) {
-    mLenCnt[(mHuffmanDepth < 16) ? mHuffmanDepth : 16]++;
+  if (LoopVar1 < Sd->mTempInt32) {
+    Sd->mLenCnt[(Sd->mHuffmanDepth < 16) ? Sd->mHuffmanDepth : 16]++;
   } else {
-    mHuffmanDepth++;
-    CountLen (mLeft[LoopVar1]);
-    CountLen (mRight[LoopVar1]);
-    mHuffmanDepth--;
+    Sd->mHuffmanDepth++;
+    CountLen (Sd, Sd->mLeft[LoopVar1]);
+    CountLen (Sd, Sd->mRight[LoopVar1]);
+    Sd->mHuffmanDepth--;
   }
 }
 
 /**
   Create code length array for a Huffman tree.
 
+  @param[in, out] Sd   The compression context.
   @param[in] Root   The root of the tree.
 **/
 VOID
 EFIAPI
 MakeLen (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN INT32 Root
   )
 {
@@ -724,10 +723,10 @@ MakeLen (
   UINT32  Cum;
 
   for (LoopVar1 = 0; LoopVar1 <= 16; LoopVar1++) {
-    mLenCnt[LoopVar1] = 0;
+    Sd->mLenCnt[LoopVar1] = 0;
   }
 
-  CountLen (Root);
+  CountLen (Sd, Root);
 
   //
   // Adjust the length count array so that
@@ -735,15 +734,15 @@ MakeLen (
   //
   Cum = 0;
   for (LoopVar1 = 16; LoopVar1 > 0; LoopVar1--) {
-    Cum += mLenCnt[LoopVar1] << (16 - LoopVar1);
+    Cum += Sd->mLenCnt[LoopVar1] << (16 - LoopVar1);
   }
 
   while (Cum != (1U << 16)) {
-    mLenCnt[16]--;
+    Sd->mLenCnt[16]--;
     for (LoopVar1 = 15; LoopVar1 > 0; LoopVar1--) {
-      if (mLenCnt[LoopVar1] != 0) {
-        mLenCnt[LoopVar1]--;
-        mLenCnt[LoopVar1 + 1] += 2;
+      if (Sd->mLenCnt[LoopVar1] != 0) {
+        Sd->mLenCnt[LoopVar1]--;
+        Sd->mLenCnt[LoopVar1 + 1] += 2;
         break;
       }
     }
@@ -752,10 +751,10 @@ MakeLen (
   }
 
   for (LoopVar1 = 16; LoopVar1 > 0; LoopVar1--) {
-    LoopVar2 = mLenCnt[LoopVar1];
+    LoopVar2 = Sd->mLenCnt[LoopVar1];
     LoopVar2--;
     while (LoopVar2 >= 0) {
-      mLen[*mSortPtr++] = (UINT8) LoopVar1;
+      Sd->mLen[*Sd->mSortPtr++] = (UINT8) LoopVar1;
       LoopVar2--;
     }
   }
@@ -764,6 +763,7 @@ MakeLen (
 /**
   Assign code to each symbol based on the code length array.
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar8      The number of symbols.
   @param[in] Len    The code length array.
   @param[out] Code  The stores codes for each symbol.
@@ -772,6 +772,7 @@ MakeLen (
 VOID
 EFIAPI
 MakeCode (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN  INT32         LoopVar8,
   IN  UINT8         Len[],
   OUT UINT16        Code[]
@@ -782,7 +783,7 @@ MakeCode (
 
   Start[1] = 0;
   for (LoopVar1 = 1; LoopVar1 <= 16; LoopVar1++) {
-    Start[LoopVar1 + 1] = (UINT16) ((Start[LoopVar1] + mLenCnt[LoopVar1]) << 1);
+    Start[LoopVar1 + 1] = (UINT16) ((Start[LoopVar1] + Sd->mLenCnt[LoopVar1]) << 1);
   }
 
   for (LoopVar1 = 0; LoopVar1 < LoopVar8; LoopVar1++) {
@@ -793,6 +794,7 @@ MakeCode (
 /**
   Generates Huffman codes given a frequency distribution of symbols.
 
+  @param[in, out] Sd   The compression context.
   @param[in] NParm      The number of symbols.
   @param[in] FreqParm   The frequency of each symbol.
   @param[out] LenParm   The code length for each symbol.
@@ -804,6 +806,7 @@ MakeCode (
 INT32
 EFIAPI
 MakeTree (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN  INT32             NParm,
   IN  UINT16            FreqParm[],
   OUT UINT8             LenParm[],
@@ -821,57 +824,57 @@ MakeTree (
   //
   // make tree, calculate len[], return root
   //
-  mTempInt32        = NParm;
-  mFreq             = FreqParm;
-  mLen              = LenParm;
-  Avail             = mTempInt32;
-  mHeapSize         = 0;
-  mHeap[1]          = 0;
-  for (LoopVar1 = 0; LoopVar1 < mTempInt32; LoopVar1++) {
-    mLen[LoopVar1] = 0;
-    if ((mFreq[LoopVar1]) != 0) {
-      mHeapSize++;
-      mHeap[mHeapSize] = (INT16) LoopVar1;
+  Sd->mTempInt32 = NParm;
+  Sd->mFreq      = FreqParm;
+  Sd->mLen       = LenParm;
+  Avail          = Sd->mTempInt32;
+  Sd->mHeapSize  = 0;
+  Sd->mHeap[1]   = 0;
+  for (LoopVar1 = 0; LoopVar1 < Sd->mTempInt32; LoopVar1++) {
+    Sd->mLen[LoopVar1] = 0;
+    if ((Sd->mFreq[LoopVar1]) != 0) {
+      Sd->mHeapSize++;
+      Sd->mHeap[Sd->mHeapSize] = (INT16) LoopVar1;
     }
   }
 
-  if (mHeapSize < 2) {
-    CodeParm[mHeap[1]] = 0;
-    return mHeap[1];
+  if (Sd->mHeapSize < 2) {
+    CodeParm[Sd->mHeap[1]] = 0;
+    return Sd->mHeap[1];
   }
 
-  for (LoopVar1 = mHeapSize / 2; LoopVar1 >= 1; LoopVar1--) {
+  for (LoopVar1 = Sd->mHeapSize / 2; LoopVar1 >= 1; LoopVar1--) {
     //
     // make priority queue
     //
-    DownHeap (LoopVar1);
+    DownHeap (Sd, LoopVar1);
   }
 
-  mSortPtr = CodeParm;
+  Sd->mSortPtr = CodeParm;
   do {
-    LoopVar1 = mHeap[1];
-    if (LoopVar1 < mTempInt32) {
-      *mSortPtr++ = (UINT16) LoopVar1;
+    LoopVar1 = Sd->mHeap[1];
+    if (LoopVar1 < Sd->mTempInt32) {
+      *Sd->mSortPtr++ = (UINT16) LoopVar1;
     }
 
-    mHeap[1] = mHeap[mHeapSize--];
-    DownHeap (1);
-    LoopVar2 = mHeap[1];
-    if (LoopVar2 < mTempInt32) {
-      *mSortPtr++ = (UINT16) LoopVar2;
+    Sd->mHeap[1] = Sd->mHeap[Sd->mHeapSize--];
+    DownHeap (Sd, 1);
+    LoopVar2 = Sd->mHeap[1];
+    if (LoopVar2 < Sd->mTempInt32) {
+      *Sd->mSortPtr++ = (UINT16) LoopVar2;
     }
 
-    LoopVar3         = Avail++;
-    mFreq[LoopVar3]  = (UINT16) (mFreq[LoopVar1] + mFreq[LoopVar2]);
-    mHeap[1]         = (INT16) LoopVar3;
-    DownHeap (1);
-    mLeft[LoopVar3]  = (UINT16) LoopVar1;
-    mRight[LoopVar3] = (UINT16) LoopVar2;
-  } while (mHeapSize > 1);
+    LoopVar3            = Avail++;
+    Sd->mFreq[LoopVar3] = (UINT16) (Sd->mFreq[LoopVar1] + Sd->mFreq[LoopVar2]);
+    Sd->mHeap[1]        = (INT16) LoopVar3;
+    DownHeap (Sd, 1);
+    Sd->mLeft[LoopVar3]  = (UINT16) LoopVar1;
+    Sd->mRight[LoopVar3] = (UINT16) LoopVar2;
+  } while (Sd->mHeapSize > 1);
 
-  mSortPtr = CodeParm;
-  MakeLen (LoopVar3);
-  MakeCode (NParm, LenParm, CodeParm);
+  Sd->mSortPtr = CodeParm;
+  MakeLen (Sd, LoopVar3);
+  MakeCode (Sd, NParm, LenParm, CodeParm);
 
   //
   // return root
@@ -882,6 +885,7 @@ MakeTree (
 /**
   Outputs rightmost LoopVar8 bits of x
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar8   The rightmost LoopVar8 bits of the data is used.
   @param[in] x   The data.
 
@@ -889,33 +893,34 @@ MakeTree (
 VOID
 EFIAPI
 PutBits (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN INT32    LoopVar8,
   IN UINT32   x
   )
 {
   UINT8 Temp;
 
-  if (LoopVar8 < mBitCount) {
-    mSubBitBuf |= x << (mBitCount -= LoopVar8);
+  if (LoopVar8 < Sd->mBitCount) {
+    Sd->mSubBitBuf |= x << (Sd->mBitCount -= LoopVar8);
   } else {
 
-    Temp = (UINT8) (mSubBitBuf | (x >> (LoopVar8 -= mBitCount)));
-    if (mDst < mDstUpperLimit) {
-      *mDst++ = Temp;
+    Temp = (UINT8) (Sd->mSubBitBuf | (x >> (LoopVar8 -= Sd->mBitCount)));
+    if (Sd->mDst < Sd->mDstUpperLimit) {
+      *Sd->mDst++ = Temp;
     }
-    mCompSize++;
+    Sd->mCompSize++;
 
     if (LoopVar8 < UINT8_BIT) {
-      mSubBitBuf = x << (mBitCount = UINT8_BIT - LoopVar8);
+      Sd->mSubBitBuf = x << (Sd->mBitCount = UINT8_BIT - LoopVar8);
     } else {
 
       Temp = (UINT8) (x >> (LoopVar8 - UINT8_BIT));
-      if (mDst < mDstUpperLimit) {
-        *mDst++ = Temp;
+      if (Sd->mDst < Sd->mDstUpperLimit) {
+        *Sd->mDst++ = Temp;
       }
-      mCompSize++;
+      Sd->mCompSize++;
 
-      mSubBitBuf = x << (mBitCount = 2 * UINT8_BIT - LoopVar8);
+      Sd->mSubBitBuf = x << (Sd->mBitCount = 2 * UINT8_BIT - LoopVar8);
     }
   }
 }
@@ -923,25 +928,29 @@ PutBits (
 /**
   Encode a signed 32 bit number.
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar5     The number to encode.
 **/
 VOID
 EFIAPI
 EncodeC (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN INT32 LoopVar5
   )
 {
-  PutBits (mCLen[LoopVar5], mCCode[LoopVar5]);
+  PutBits (Sd, Sd->mCLen[LoopVar5], Sd->mCCode[LoopVar5]);
 }
 
 /**
   Encode a unsigned 32 bit number.
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar7     The number to encode.
 **/
 VOID
 EFIAPI
 EncodeP (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN UINT32 LoopVar7
   )
 {
@@ -956,20 +965,22 @@ EncodeP (
     LoopVar5++;
   }
 
-  PutBits (mPTLen[LoopVar5], mPTCode[LoopVar5]);
+  PutBits (Sd, Sd->mPTLen[LoopVar5], Sd->mPTCode[LoopVar5]);
   if (LoopVar5 > 1) {
-    PutBits (LoopVar5 - 1, LoopVar7 & (0xFFFFU >> (17 - LoopVar5)));
+    PutBits (Sd, LoopVar5 - 1, LoopVar7 & (0xFFFFU >> (17 - LoopVar5)));
   }
 }
 
 /**
   Count the frequencies for the Extra Set.
 
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 CountTFreq (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
   INT32 LoopVar1;
@@ -981,40 +992,40 @@ CountTFreq (
   INT32 Count;
 
   for (LoopVar1 = 0; LoopVar1 < NT; LoopVar1++) {
-    mTFreq[LoopVar1] = 0;
+    Sd->mTFreq[LoopVar1] = 0;
   }
 
   LoopVar8 = NC;
-  while (LoopVar8 > 0 && mCLen[LoopVar8 - 1] == 0) {
+  while (LoopVar8 > 0 && Sd->mCLen[LoopVar8 - 1] == 0) {
     LoopVar8--;
   }
 
   LoopVar1 = 0;
   while (LoopVar1 < LoopVar8) {
-    LoopVar3 = mCLen[LoopVar1++];
+    LoopVar3 = Sd->mCLen[LoopVar1++];
     if (LoopVar3 == 0) {
       Count = 1;
-      while (LoopVar1 < LoopVar8 && mCLen[LoopVar1] == 0) {
+      while (LoopVar1 < LoopVar8 && Sd->mCLen[LoopVar1] == 0) {
         LoopVar1++;
         Count++;
       }
 
       if (Count <= 2) {
-        mTFreq[0] = (UINT16) (mTFreq[0] + Count);
+        Sd->mTFreq[0] = (UINT16) (Sd->mTFreq[0] + Count);
       } else if (Count <= 18) {
-        mTFreq[1]++;
+        Sd->mTFreq[1]++;
       } else if (Count == 19) {
-        mTFreq[0]++;
-        mTFreq[1]++;
+        Sd->mTFreq[0]++;
+        Sd->mTFreq[1]++;
       } else {
-        mTFreq[2]++;
+        Sd->mTFreq[2]++;
       }
     } else {
       ASSERT ((LoopVar3 + 2) < (2 * NT - 1));
       if ((LoopVar3 + 2) >= (2 * NT - 1)) {
         return;
       }
-      mTFreq[LoopVar3 + 2]++;
+      Sd->mTFreq[LoopVar3 + 2]++;
     }
   }
 }
@@ -1022,6 +1033,7 @@ CountTFreq (
 /**
   Outputs the code length array for the Extra Set or the Position Set.
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar8       The number of symbols.
   @param[in] nbit           The number of bits needed to represent 'LoopVar8'.
   @param[in] Special        The special symbol that needs to be take care of.
@@ -1030,6 +1042,7 @@ CountTFreq (
 VOID
 EFIAPI
 WritePTLen (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN INT32 LoopVar8,
   IN INT32 nbit,
   IN INT32 Special
@@ -1039,26 +1052,26 @@ WritePTLen (
 
   INT32 LoopVar3;
 
-  while (LoopVar8 > 0 && mPTLen[LoopVar8 - 1] == 0) {
+  while (LoopVar8 > 0 && Sd->mPTLen[LoopVar8 - 1] == 0) {
     LoopVar8--;
   }
 
-  PutBits (nbit, LoopVar8);
+  PutBits (Sd, nbit, LoopVar8);
   LoopVar1 = 0;
   while (LoopVar1 < LoopVar8) {
-    LoopVar3 = mPTLen[LoopVar1++];
+    LoopVar3 = Sd->mPTLen[LoopVar1++];
     if (LoopVar3 <= 6) {
-      PutBits (3, LoopVar3);
+      PutBits (Sd, 3, LoopVar3);
     } else {
-      PutBits (LoopVar3 - 3, (1U << (LoopVar3 - 3)) - 2);
+      PutBits (Sd, LoopVar3 - 3, (1U << (LoopVar3 - 3)) - 2);
     }
 
     if (LoopVar1 == Special) {
-      while (LoopVar1 < 6 && mPTLen[LoopVar1] == 0) {
+      while (LoopVar1 < 6 && Sd->mPTLen[LoopVar1] == 0) {
         LoopVar1++;
       }
 
-      PutBits (2, (LoopVar1 - 3) & 3);
+      PutBits (Sd, 2, (LoopVar1 - 3) & 3);
     }
   }
 }
@@ -1066,11 +1079,13 @@ WritePTLen (
 /**
   Outputs the code length array for Char&Length Set.
 
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 WriteCLen (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
   INT32 LoopVar1;
@@ -1082,42 +1097,42 @@ WriteCLen (
   INT32 Count;
 
   LoopVar8 = NC;
-  while (LoopVar8 > 0 && mCLen[LoopVar8 - 1] == 0) {
+  while (LoopVar8 > 0 && Sd->mCLen[LoopVar8 - 1] == 0) {
     LoopVar8--;
   }
 
-  PutBits (CBIT, LoopVar8);
+  PutBits (Sd, CBIT, LoopVar8);
   LoopVar1 = 0;
   while (LoopVar1 < LoopVar8) {
-    LoopVar3 = mCLen[LoopVar1++];
+    LoopVar3 = Sd->mCLen[LoopVar1++];
     if (LoopVar3 == 0) {
       Count = 1;
-      while (LoopVar1 < LoopVar8 && mCLen[LoopVar1] == 0) {
+      while (LoopVar1 < LoopVar8 && Sd->mCLen[LoopVar1] == 0) {
         LoopVar1++;
         Count++;
       }
 
       if (Count <= 2) {
         for (LoopVar3 = 0; LoopVar3 < Count; LoopVar3++) {
-          PutBits (mPTLen[0], mPTCode[0]);
+          PutBits (Sd, Sd->mPTLen[0], Sd->mPTCode[0]);
         }
       } else if (Count <= 18) {
-        PutBits (mPTLen[1], mPTCode[1]);
-        PutBits (4, Count - 3);
+        PutBits (Sd, Sd->mPTLen[1], Sd->mPTCode[1]);
+        PutBits (Sd, 4, Count - 3);
       } else if (Count == 19) {
-        PutBits (mPTLen[0], mPTCode[0]);
-        PutBits (mPTLen[1], mPTCode[1]);
-        PutBits (4, 15);
+        PutBits (Sd, Sd->mPTLen[0], Sd->mPTCode[0]);
+        PutBits (Sd, Sd->mPTLen[1], Sd->mPTCode[1]);
+        PutBits (Sd, 4, 15);
       } else {
-        PutBits (mPTLen[2], mPTCode[2]);
-        PutBits (CBIT, Count - 20);
+        PutBits (Sd, Sd->mPTLen[2], Sd->mPTCode[2]);
+        PutBits (Sd, CBIT, Count - 20);
       }
     } else {
       ASSERT ((LoopVar3 + 2) < NPT);
       if ((LoopVar3 + 2) >= NPT) {
         return;
       }
-      PutBits (mPTLen[LoopVar3 + 2], mPTCode[LoopVar3 + 2]);
+      PutBits (Sd, Sd->mPTLen[LoopVar3 + 2], Sd->mPTCode[LoopVar3 + 2]);
     }
   }
 }
@@ -1125,11 +1140,13 @@ WriteCLen (
 /**
   Huffman code the block and output it.
 
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 SendBlock (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
   UINT32  LoopVar1;
@@ -1145,79 +1162,82 @@ SendBlock (
   UINT32  Size;
   Flags = 0;
 
-  Root = MakeTree (NC, mCFreq, mCLen, mCCode);
-  Size = mCFreq[Root];
-  PutBits (16, Size);
+  Root = MakeTree (Sd, NC, Sd->mCFreq, Sd->mCLen, Sd->mCCode);
+  Size = Sd->mCFreq[Root];
+  PutBits (Sd, 16, Size);
   if (Root >= NC) {
-    CountTFreq ();
-    Root = MakeTree (NT, mTFreq, mPTLen, mPTCode);
+    CountTFreq (Sd);
+    Root = MakeTree (Sd, NT, Sd->mTFreq, Sd->mPTLen, Sd->mPTCode);
     if (Root >= NT) {
-      WritePTLen (NT, TBIT, 3);
+      WritePTLen (Sd, NT, TBIT, 3);
     } else {
-      PutBits (TBIT, 0);
-      PutBits (TBIT, Root);
+      PutBits (Sd, TBIT, 0);
+      PutBits (Sd, TBIT, Root);
     }
 
-    WriteCLen ();
+    WriteCLen (Sd);
   } else {
-    PutBits (TBIT, 0);
-    PutBits (TBIT, 0);
-    PutBits (CBIT, 0);
-    PutBits (CBIT, Root);
+    PutBits (Sd, TBIT, 0);
+    PutBits (Sd, TBIT, 0);
+    PutBits (Sd, CBIT, 0);
+    PutBits (Sd, CBIT, Root);
   }
 
-  Root = MakeTree (NP, mPFreq, mPTLen, mPTCode);
+  Root = MakeTree (Sd, NP, Sd->mPFreq, Sd->mPTLen, Sd->mPTCode);
   if (Root >= NP) {
-    WritePTLen (NP, PBIT, -1);
+    WritePTLen (Sd, NP, PBIT, -1);
   } else {
-    PutBits (PBIT, 0);
-    PutBits (PBIT, Root);
+    PutBits (Sd, PBIT, 0);
+    PutBits (Sd, PBIT, Root);
   }
 
   Pos = 0;
   for (LoopVar1 = 0; LoopVar1 < Size; LoopVar1++) {
     if (LoopVar1 % UINT8_BIT == 0) {
-      Flags = mBuf[Pos++];
+      Flags = Sd->mBuf[Pos++];
     } else {
       Flags <<= 1;
     }
     if ((Flags & (1U << (UINT8_BIT - 1))) != 0) {
-      EncodeC (mBuf[Pos++] + (1U << UINT8_BIT));
-      LoopVar3 = mBuf[Pos++] << UINT8_BIT;
-      LoopVar3 += mBuf[Pos++];
+      EncodeC (Sd, Sd->mBuf[Pos++] + (1U << UINT8_BIT));
+      LoopVar3 = Sd->mBuf[Pos++] << UINT8_BIT;
+      LoopVar3 += Sd->mBuf[Pos++];
 
-      EncodeP (LoopVar3);
+      EncodeP (Sd, LoopVar3);
     } else {
-      EncodeC (mBuf[Pos++]);
+      EncodeC (Sd, Sd->mBuf[Pos++]);
     }
   }
 
-  SetMem (mCFreq, NC * sizeof (UINT16), 0);
-  SetMem (mPFreq, NP * sizeof (UINT16), 0);
+  SetMem (Sd->mCFreq, NC * sizeof (UINT16), 0);
+  SetMem (Sd->mPFreq, NP * sizeof (UINT16), 0);
 }
 
 /**
   Start the huffman encoding.
 
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 HufEncodeStart (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
-  SetMem (mCFreq, NC * sizeof (UINT16), 0);
-  SetMem (mPFreq, NP * sizeof (UINT16), 0);
+  SetMem (Sd->mCFreq, NC * sizeof (UINT16), 0);
+  SetMem (Sd->mPFreq, NP * sizeof (UINT16), 0);
 
-  mOutputPos = mOutputMask = 0;
+  Sd->mOutputPos = Sd->mOutputMask = 0;
 
-  mBitCount   = UINT8_BIT;
-  mSubBitBuf  = 0;
+  Sd->mBitCount  = UINT8_BIT;
+  Sd->mSubBitBuf = 0;
 }
 
 /**
   Outputs an Original Character or a Pointer.
 
+  @param[in, out] Sd   The compression context.
   @param[in] LoopVar5     The original character or the 'String Length' element of
                    a Pointer.
   @param[in] LoopVar7     The 'Position' field of a Pointer.
@@ -1225,135 +1245,186 @@ HufEncodeStart (
 VOID
 EFIAPI
 CompressOutput (
+  IN OUT COMPRESS_CONTEXT  *Sd,
   IN UINT32 LoopVar5,
   IN UINT32 LoopVar7
   )
 {
-  STATIC UINT32 CPos;
-
-  if ((mOutputMask >>= 1) == 0) {
-    mOutputMask = 1U << (UINT8_BIT - 1);
-    if (mOutputPos >= mBufSiz - 3 * UINT8_BIT) {
-      SendBlock ();
-      mOutputPos = 0;
+  if ((Sd->mOutputMask >>= 1) == 0) {
+    Sd->mOutputMask = 1U << (UINT8_BIT - 1);
+    if (Sd->mOutputPos >= Sd->mBufSiz - 3 * UINT8_BIT) {
+      SendBlock (Sd);
+      Sd->mOutputPos = 0;
     }
 
-    CPos        = mOutputPos++;
-    mBuf[CPos]  = 0;
+    Sd->mCPos           = Sd->mOutputPos++;
+    Sd->mBuf[Sd->mCPos] = 0;
   }
-  mBuf[mOutputPos++] = (UINT8) LoopVar5;
-  mCFreq[LoopVar5]++;
+  Sd->mBuf[Sd->mOutputPos++] = (UINT8) LoopVar5;
+  Sd->mCFreq[LoopVar5]++;
   if (LoopVar5 >= (1U << UINT8_BIT)) {
-    mBuf[CPos] = (UINT8) (mBuf[CPos]|mOutputMask);
-    mBuf[mOutputPos++] = (UINT8) (LoopVar7 >> UINT8_BIT);
-    mBuf[mOutputPos++] = (UINT8) LoopVar7;
-    LoopVar5           = 0;
+    Sd->mBuf[Sd->mCPos]        = (UINT8) (Sd->mBuf[Sd->mCPos]|Sd->mOutputMask);
+    Sd->mBuf[Sd->mOutputPos++] = (UINT8) (LoopVar7 >> UINT8_BIT);
+    Sd->mBuf[Sd->mOutputPos++] = (UINT8) LoopVar7;
+    LoopVar5                   = 0;
     while (LoopVar7 != 0) {
       LoopVar7 >>= 1;
       LoopVar5++;
     }
-    mPFreq[LoopVar5]++;
+    Sd->mPFreq[LoopVar5]++;
   }
 }
 
 /**
   End the huffman encoding.
 
+  @param[in, out] Sd   The compression context.
+
 **/
 VOID
 EFIAPI
 HufEncodeEnd (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
-  SendBlock ();
+  SendBlock (Sd);
 
   //
   // Flush remaining bits
   //
-  PutBits (UINT8_BIT - 1, 0);
+  PutBits (Sd, UINT8_BIT - 1, 0);
 }
 
 /**
   The main controlling routine for compression process.
 
-  @retval EFI_SUCCESS           The compression is successful.
-  @retval EFI_OUT_0F_RESOURCES  Not enough memory for compression process.
+  @param[in, out] Sd   The compression context.
+
 **/
-EFI_STATUS
+VOID
 EFIAPI
 Encode (
-  VOID
+  IN OUT COMPRESS_CONTEXT  *Sd
   )
 {
-  EFI_STATUS  Status;
   INT32       LastMatchLen;
   NODE        LastMatchPos;
 
-  Status = AllocateMemory ();
-  if (EFI_ERROR (Status)) {
-    FreeMemory ();
-    return Status;
-  }
-
-  InitSlide ();
+  InitSlide (Sd);
 
-  HufEncodeStart ();
+  HufEncodeStart (Sd);
 
-  mRemainder  = FreadCrc (&mText[WNDSIZ], WNDSIZ + MAXMATCH);
+  Sd->mRemainder = Fread (Sd, &Sd->mText[WNDSIZ], WNDSIZ + MAXMATCH);
 
-  mMatchLen   = 0;
-  mPos        = WNDSIZ;
-  InsertNode ();
-  if (mMatchLen > mRemainder) {
-    mMatchLen = mRemainder;
+  Sd->mMatchLen = 0;
+  Sd->mPos      = WNDSIZ;
+  InsertNode (Sd);
+  if (Sd->mMatchLen > Sd->mRemainder) {
+    Sd->mMatchLen = Sd->mRemainder;
   }
 
-  while (mRemainder > 0) {
-    LastMatchLen = mMatchLen;
-    LastMatchPos = mMatchPos;
-    if (!GetNextMatch ()) {
-      Status = EFI_OUT_OF_RESOURCES;
-    }
-    if (mMatchLen > mRemainder) {
-      mMatchLen = mRemainder;
+  while (Sd->mRemainder > 0) {
+    LastMatchLen = Sd->mMatchLen;
+    LastMatchPos = Sd->mMatchPos;
+    GetNextMatch (Sd);
+    if (Sd->mMatchLen > Sd->mRemainder) {
+      Sd->mMatchLen = Sd->mRemainder;
     }
 
-    if (mMatchLen > LastMatchLen || LastMatchLen < THRESHOLD) {
+    if (Sd->mMatchLen > LastMatchLen || LastMatchLen < THRESHOLD) {
       //
       // Not enough benefits are gained by outputting a pointer,
       // so just output the original character
       //
-      CompressOutput (mText[mPos - 1], 0);
+      CompressOutput (Sd, Sd->mText[Sd->mPos - 1], 0);
     } else {
       //
       // Outputting a pointer is beneficial enough, do it.
       //
 
-      CompressOutput (LastMatchLen + (MAX_UINT8 + 1 - THRESHOLD),
-        (mPos - LastMatchPos - 2) & (WNDSIZ - 1));
+      CompressOutput (Sd, LastMatchLen + (MAX_UINT8 + 1 - THRESHOLD),
+        (Sd->mPos - LastMatchPos - 2) & (WNDSIZ - 1));
       LastMatchLen--;
       while (LastMatchLen > 0) {
-        if (!GetNextMatch ()) {
-          Status = EFI_OUT_OF_RESOURCES;
-        }
+        GetNextMatch (Sd);
         LastMatchLen--;
       }
 
-      if (mMatchLen > mRemainder) {
-        mMatchLen = mRemainder;
+      if (Sd->mMatchLen > Sd->mRemainder) {
+        Sd->mMatchLen = Sd->mRemainder;
       }
     }
   }
 
-  HufEncodeEnd ();
-  FreeMemory ();
-  return (Status);
+  HufEncodeEnd (Sd);
 }
 
 /**
-  The compression routine.
+  Allocate a compression context.
+
+  The context holds the work buffers and all state of the compressor. It can
+  be passed to any number of CompressWithContext() calls, which then do not
+  allocate memory. Callers compressing concurrently need one context each.
+
+  @param[out]  Context       Returned compression context.
+
+  @retval EFI_SUCCESS           The context was allocated.
+  @retval EFI_INVALID_PARAMETER Context is NULL.
+  @retval EFI_OUT_OF_RESOURCES  Not enough memory for the work buffers.
+**/
+EFI_STATUS
+EFIAPI
+CreateCompressContext (
+  OUT COMPRESS_CONTEXT  **Context
+  )
+{
+  EFI_STATUS        Status;
+  COMPRESS_CONTEXT  *Sd;
+
+  if (Context == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  *Context = NULL;
+
+  Sd = AllocateZeroPool (sizeof (*Sd));
+  if (Sd == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = AllocateMemory (Sd);
+  if (EFI_ERROR (Status)) {
+    FreeCompressContext (Sd);
+    return Status;
+  }
+
+  *Context = Sd;
+  return EFI_SUCCESS;
+}
+
+/**
+  Free a compression context allocated by CreateCompressContext().
+
+  @param[in]  Context       The compression context. May be NULL.
+**/
+VOID
+EFIAPI
+FreeCompressContext (
+  IN COMPRESS_CONTEXT  *Context
+  )
+{
+  if (Context == NULL) {
+    return;
+  }
 
+  FreeMemory (Context);
+  FreePool (Context);
+}
+
+/**
+  The compression routine, using the work buffers of a compression context.
+
+  @param[in]       Context       The compression context.
   @param[in]       SrcBuffer     The buffer containing the source data.
   @param[in]       SrcSize       The number of bytes in SrcBuffer.
   @param[in]       DstBuffer     The buffer to put the compressed image in.
@@ -1362,74 +1433,103 @@ Encode (
 
   @retval EFI_SUCCESS           The compression was sucessful.
   @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+  @retval EFI_INVALID_PARAMETER Context or DstSize is NULL.
 **/
 EFI_STATUS
 EFIAPI
-Compress (
-  IN       VOID   *SrcBuffer,
-  IN       UINT64 SrcSize,
-  IN       VOID   *DstBuffer,
-  IN OUT   UINT64 *DstSize
+CompressWithContext (
+  IN       COMPRESS_CONTEXT  *Context,
+  IN       VOID              *SrcBuffer,
+  IN       UINT64            SrcSize,
+  IN       VOID              *DstBuffer,
+  IN OUT   UINT64            *DstSize
   )
 {
-  EFI_STATUS  Status;
+  COMPRESS_CONTEXT  *Sd;
+
+  if ((Context == NULL) || (DstSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
 
   //
   // Initializations
   //
-  mBufSiz         = 0;
-  mBuf            = NULL;
-  mText           = NULL;
-  mLevel          = NULL;
-  mChildCount     = NULL;
-  mPosition       = NULL;
-  mParent         = NULL;
-  mPrev           = NULL;
-  mNext           = NULL;
-
-  mSrc            = SrcBuffer;
-  mSrcUpperLimit  = mSrc + SrcSize;
-  mDst            = DstBuffer;
-  mDstUpperLimit  = mDst + *DstSize;
-
-  PutDword (0L);
-  PutDword (0L);
+  Sd                 = Context;
+  Sd->mSrc           = SrcBuffer;
+  Sd->mSrcUpperLimit = Sd->mSrc + SrcSize;
+  Sd->mDst           = DstBuffer;
+  Sd->mDstUpperLimit = Sd->mDst + *DstSize;
 
-  MakeCrcTable ();
+  PutDword (Sd, 0L);
+  PutDword (Sd, 0L);
 
-  mOrigSize       = mCompSize = 0;
-  mCrc            = INIT_CRC;
+  Sd->mOrigSize = Sd->mCompSize = 0;
 
   //
   // Compress it
   //
-  Status = Encode ();
-  if (EFI_ERROR (Status)) {
-    return EFI_OUT_OF_RESOURCES;
-  }
+  Encode (Sd);
+
   //
   // Null terminate the compressed data
   //
-  if (mDst < mDstUpperLimit) {
-    *mDst++ = 0;
+  if (Sd->mDst < Sd->mDstUpperLimit) {
+    *Sd->mDst++ = 0;
   }
   //
   // Fill in compressed size and original size
   //
-  mDst = DstBuffer;
-  PutDword (mCompSize + 1);
-  PutDword (mOrigSize);
+  Sd->mDst = DstBuffer;
+  PutDword (Sd, Sd->mCompSize + 1);
+  PutDword (Sd, Sd->mOrigSize);
 
   //
   // Return
   //
-  if (mCompSize + 1 + 8 > *DstSize) {
-    *DstSize = mCompSize + 1 + 8;
+  if (Sd->mCompSize + 1 + 8 > *DstSize) {
+    *DstSize = Sd->mCompSize + 1 + 8;
     return EFI_BUFFER_TOO_SMALL;
   } else {
-    *DstSize = mCompSize + 1 + 8;
+    *DstSize = Sd->mCompSize + 1 + 8;
     return EFI_SUCCESS;
   }
-
 }
 
+/**
+  The compression routine.
+
+  Allocates a compression context for this call only. Callers compressing
+  repeatedly should use CreateCompressContext() and CompressWithContext().
+
+  @param[in]       SrcBuffer     The buffer containing the source data.
+  @param[in]       SrcSize       The number of bytes in SrcBuffer.
+  @param[in]       DstBuffer     The buffer to put the compressed image in.
+  @param[in, out]  DstSize       On input the size (in bytes) of DstBuffer, on
+                                return the number of bytes placed in DstBuffer.
+
+  @retval EFI_SUCCESS           The compression was sucessful.
+  @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+  @retval EFI_OUT_OF_RESOURCES  Not enough memory for compression process.
+**/
+EFI_STATUS
+EFIAPI
+Compress (
+  IN       VOID   *SrcBuffer,
+  IN       UINT64 SrcSize,
+  IN       VOID   *DstBuffer,
+  IN OUT   UINT64 *DstSize
+  )
+{
+  EFI_STATUS        Status;
+  COMPRESS_CONTEXT  *Context;
+
+  Status = CreateCompressContext (&Context);
+  if (EFI_ERROR (Status)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = CompressWithContext (Context, SrcBuffer, SrcSize, DstBuffer, DstSize);
+
+  FreeCompressContext (Context);
+  return Status;
+}
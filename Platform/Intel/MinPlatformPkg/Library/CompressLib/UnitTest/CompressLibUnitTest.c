@@ -0,0 +1,593 @@
+/** @file
+  Host based unit tests and benchmark for CompressLib.
+
+  Every buffer is decompressed again with UefiDecompressLib and compared with
+  the source. SaveMemoryConfig compares freshly compressed data with the copy
+  stored in a variable, so the output must not change between releases: the
+  golden test checks the CRC32 of the output for fixed inputs against values
+  taken from the original single-call implementation.
+
+  The benchmark compresses buffers shaped like memory training data and
+  reports throughput for Compress() and for a reused COMPRESS_CONTEXT.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <time.h>
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/CompressLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiDecompressLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_NAME     "CompressLib Unit Tests"
+#define UNIT_TEST_VERSION  "1.0"
+
+#define TEST_MAX_SOURCE_SIZE  (200 * 1024)
+
+//
+// Worst case expansion of incompressible data is well below this.
+//
+#define TEST_DST_SIZE(SrcSize)  ((SrcSize) + (SrcSize) / 8 + 64)
+
+#define BENCH_LARGE_SIZE        SIZE_64KB
+#define BENCH_LARGE_ITERATIONS  32
+#define BENCH_SMALL_SIZE        SIZE_4KB
+#define BENCH_SMALL_ITERATIONS  512
+
+typedef enum {
+  PatternRandom,
+  PatternZero,
+  PatternText,
+  PatternTraining,
+  PatternTwoSymbols,
+  PatternRuns,
+  PatternBackReference,
+  PatternMax
+} TEST_PATTERN;
+
+typedef struct {
+  TEST_PATTERN    Pattern;
+  UINT32          Size;
+  UINT32          Crc32;
+} COMPRESS_GOLDEN;
+
+STATIC CONST CHAR8  *mPatternName[PatternMax] = {
+  "random",
+  "zero",
+  "text",
+  "training",
+  "two symbols",
+  "runs",
+  "back reference"
+};
+
+STATIC CONST UINT32  mSourceSizes[] = {
+  0, 1, 2, 3, 7, 100, 4095, 8191, 8192, 8193, 16384, 16640, 30000, SIZE_64KB, TEST_MAX_SOURCE_SIZE
+};
+
+//
+// CRC32 of the output of the original Compress() for FillPattern (Pattern, Size, Size).
+//
+STATIC CONST COMPRESS_GOLDEN  mGolden[] = {
+  { PatternRandom,        4095,      0xEE38B78A },
+  { PatternRandom,        SIZE_64KB, 0x1CB073C2 },
+  { PatternZero,          4095,      0x3CAD16DF },
+  { PatternZero,          SIZE_64KB, 0x0DB2AAF5 },
+  { PatternText,          4095,      0x6C461710 },
+  { PatternText,          SIZE_64KB, 0x7F72AA40 },
+  { PatternTraining,      4095,      0x556FD874 },
+  { PatternTraining,      SIZE_64KB, 0x2CD10659 },
+  { PatternTwoSymbols,    4095,      0xA71CADB0 },
+  { PatternTwoSymbols,    SIZE_64KB, 0x00E8D6D5 },
+  { PatternRuns,          4095,      0x4D3379CE },
+  { PatternRuns,          SIZE_64KB, 0x34F3B566 },
+  { PatternBackReference, 4095,      0xF7B58B52 },
+  { PatternBackReference, SIZE_64KB, 0xC2ED6709 },
+};
+
+STATIC UINT32  mRandomSeed;
+
+/**
+  Returns the next value of a small linear congruential generator.
+
+  @return  A 24 bit pseudo random value.
+**/
+STATIC
+UINT32
+TestRandom (
+  VOID
+  )
+{
+  mRandomSeed = mRandomSeed * 1103515245 + 12345;
+  return mRandomSeed >> 8;
+}
+
+/**
+  Fills a buffer with reproducible test data.
+
+  @param[out] Buffer   The buffer to fill.
+  @param[in]  Size     Number of bytes to fill.
+  @param[in]  Pattern  Shape of the data.
+  @param[in]  Seed     Seed of the generator.
+**/
+STATIC
+VOID
+FillPattern (
+  OUT UINT8         *Buffer,
+  IN  UINTN         Size,
+  IN  TEST_PATTERN  Pattern,
+  IN  UINT32        Seed
+  )
+{
+  STATIC CONST CHAR8  *Words[] = {
+    "the ", "memory ", "training ", "data ", "channel ", "rank ", "DIMM ", "0x00 ", "timing ", "margin ", "\n", "  "
+  };
+  CONST CHAR8         *Word;
+  UINTN               Index;
+  UINTN               Offset;
+  UINTN               Length;
+  UINTN               Distance;
+  UINT8               Value;
+
+  mRandomSeed = Seed;
+  switch (Pattern) {
+    case PatternRandom:
+      for (Index = 0; Index < Size; Index++) {
+        Buffer[Index] = (UINT8)TestRandom ();
+      }
+
+      break;
+
+    case PatternZero:
+      ZeroMem (Buffer, Size);
+      break;
+
+    case PatternText:
+      for (Index = 0; Index < Size;) {
+        for (Word = Words[TestRandom () % ARRAY_SIZE (Words)]; *Word != '\0' && Index < Size; Word++) {
+          Buffer[Index++] = *Word;
+        }
+      }
+
+      break;
+
+    case PatternTraining:
+      //
+      // 512 byte records: a fixed header, a per record value and zero padding,
+      // with occasional flipped bytes.
+      //
+      for (Index = 0; Index < Size; Index++) {
+        Offset        = Index % 512;
+        Buffer[Index] = (Offset < 64) ? (UINT8)(Offset * 3) : ((Offset < 200) ? (UINT8)((Index / 512) & 0xF) : 0);
+        if (TestRandom () % 97 == 0) {
+          Buffer[Index] ^= (UINT8)TestRandom ();
+        }
+      }
+
+      break;
+
+    case PatternTwoSymbols:
+      for (Index = 0; Index < Size; Index++) {
+        Buffer[Index] = "ab"[TestRandom () % 2];
+      }
+
+      break;
+
+    case PatternRuns:
+      for (Index = 0; Index < Size;) {
+        Value  = (UINT8)TestRandom ();
+        Length = TestRandom () % 600;
+        while (Length-- != 0 && Index < Size) {
+          Buffer[Index++] = Value;
+        }
+      }
+
+      break;
+
+    default:
+      //
+      // Low entropy bytes with frequent copies from up to 9000 bytes back,
+      // which reaches past the 8 KB window.
+      //
+      for (Index = 0; Index < Size; Index++) {
+        if ((TestRandom () % 8 == 0) && (Index > 300)) {
+          Distance = 1 + TestRandom () % MIN (Index, 9000);
+          Length   = TestRandom () % 300;
+          while (Length-- != 0 && Index < Size) {
+            Buffer[Index] = Buffer[Index - Distance];
+            Index++;
+          }
+
+          if (Index >= Size) {
+            break;
+          }
+        }
+
+        Buffer[Index] = (UINT8)(TestRandom () % 16);
+      }
+
+      break;
+  }
+}
+
+/**
+  Decompresses a buffer with UefiDecompressLib and compares it with the source.
+
+  @param[in] Compressed      The compressed data.
+  @param[in] CompressedSize  Size of the compressed data.
+  @param[in] Source          The original data.
+  @param[in] SourceSize      Size of the original data.
+
+  @retval TRUE   The data decompressed to Source.
+  @retval FALSE  Decompression failed or produced different data.
+**/
+STATIC
+BOOLEAN
+DecompressMatches (
+  IN CONST UINT8  *Compressed,
+  IN UINT64       CompressedSize,
+  IN CONST UINT8  *Source,
+  IN UINT32       SourceSize
+  )
+{
+  UINT32   DestinationSize;
+  UINT32   ScratchSize;
+  UINT8    *Destination;
+  VOID     *Scratch;
+  BOOLEAN  Matches;
+
+  if (RETURN_ERROR (UefiDecompressGetInfo (Compressed, (UINT32)CompressedSize, &DestinationSize, &ScratchSize))) {
+    return FALSE;
+  }
+
+  if (DestinationSize != SourceSize) {
+    return FALSE;
+  }
+
+  Destination = AllocatePool (DestinationSize + 1);
+  Scratch     = AllocatePool (ScratchSize);
+  Matches     = FALSE;
+  if ((Destination != NULL) && (Scratch != NULL)) {
+    Matches = !RETURN_ERROR (UefiDecompress (Compressed, Destination, Scratch)) &&
+              (CompareMem (Destination, Source, SourceSize) == 0);
+  }
+
+  if (Destination != NULL) {
+    FreePool (Destination);
+  }
+
+  if (Scratch != NULL) {
+    FreePool (Scratch);
+  }
+
+  return Matches;
+}
+
+/**
+  Compresses every pattern at every size with Compress() and decompresses the
+  result again.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+RoundTrip (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8         *Source;
+  UINT8         *Compressed;
+  UINT64        CompressedSize;
+  TEST_PATTERN  Pattern;
+  UINTN         Index;
+  UINT32        Size;
+
+  Source     = AllocatePool (TEST_MAX_SOURCE_SIZE);
+  Compressed = AllocatePool (TEST_DST_SIZE (TEST_MAX_SOURCE_SIZE));
+  UT_ASSERT_NOT_NULL (Source);
+  UT_ASSERT_NOT_NULL (Compressed);
+
+  for (Pattern = 0; Pattern < PatternMax; Pattern++) {
+    for (Index = 0; Index < ARRAY_SIZE (mSourceSizes); Index++) {
+      Size = mSourceSizes[Index];
+      FillPattern (Source, Size, Pattern, Size);
+      CompressedSize = TEST_DST_SIZE (Size);
+      UT_ASSERT_NOT_EFI_ERROR (Compress (Source, Size, Compressed, &CompressedSize));
+      UT_ASSERT_EQUAL (ReadUnaligned32 ((UINT32 *)Compressed) + 8, CompressedSize);
+      UT_ASSERT_EQUAL (ReadUnaligned32 ((UINT32 *)Compressed + 1), Size);
+      if (!DecompressMatches (Compressed, CompressedSize, Source, Size)) {
+        UT_LOG_ERROR ("%a data of %d bytes does not decompress to its source\n", mPatternName[Pattern], Size);
+        UT_ASSERT_TRUE (FALSE);
+      }
+    }
+  }
+
+  FreePool (Source);
+  FreePool (Compressed);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Checks the output for fixed inputs against the CRC32 of the output of the
+  original implementation.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+GoldenOutput (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8   *Source;
+  UINT8   *Compressed;
+  UINT64  CompressedSize;
+  UINTN   Index;
+  UINT32  Crc32;
+
+  Source     = AllocatePool (SIZE_64KB);
+  Compressed = AllocatePool (TEST_DST_SIZE (SIZE_64KB));
+  UT_ASSERT_NOT_NULL (Source);
+  UT_ASSERT_NOT_NULL (Compressed);
+
+  for (Index = 0; Index < ARRAY_SIZE (mGolden); Index++) {
+    FillPattern (Source, mGolden[Index].Size, mGolden[Index].Pattern, mGolden[Index].Size);
+    CompressedSize = TEST_DST_SIZE (mGolden[Index].Size);
+    UT_ASSERT_NOT_EFI_ERROR (Compress (Source, mGolden[Index].Size, Compressed, &CompressedSize));
+    Crc32 = CalculateCrc32 (Compressed, (UINTN)CompressedSize);
+    if (Crc32 != mGolden[Index].Crc32) {
+      UT_LOG_ERROR (
+        "%a data of %d bytes: CRC32 %08x, expected %08x\n",
+        mPatternName[mGolden[Index].Pattern],
+        mGolden[Index].Size,
+        Crc32,
+        mGolden[Index].Crc32
+        );
+      UT_ASSERT_EQUAL (Crc32, mGolden[Index].Crc32);
+    }
+  }
+
+  FreePool (Source);
+  FreePool (Compressed);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Compresses large and small buffers alternately through one context and
+  checks that the output equals that of Compress(), so no state leaks from
+  one call into the next.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+ContextReuse (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  COMPRESS_CONTEXT  *CompressContext;
+  UINT8             *Source;
+  UINT8             *Expected;
+  UINT8             *Compressed;
+  UINT64            ExpectedSize;
+  UINT64            CompressedSize;
+  TEST_PATTERN      Pattern;
+  UINTN             Index;
+  UINT32            Size;
+
+  Source     = AllocatePool (TEST_MAX_SOURCE_SIZE);
+  Expected   = AllocatePool (TEST_DST_SIZE (TEST_MAX_SOURCE_SIZE));
+  Compressed = AllocatePool (TEST_DST_SIZE (TEST_MAX_SOURCE_SIZE));
+  UT_ASSERT_NOT_NULL (Source);
+  UT_ASSERT_NOT_NULL (Expected);
+  UT_ASSERT_NOT_NULL (Compressed);
+  UT_ASSERT_NOT_EFI_ERROR (CreateCompressContext (&CompressContext));
+
+  for (Pattern = 0; Pattern < PatternMax; Pattern++) {
+    for (Index = 0; Index < ARRAY_SIZE (mSourceSizes); Index++) {
+      //
+      // Alternate between the largest and the smallest remaining sizes.
+      //
+      Size = mSourceSizes[(Index % 2 == 0) ? (ARRAY_SIZE (mSourceSizes) - 1 - Index / 2) : (Index / 2)];
+      FillPattern (Source, Size, (Pattern + Index) % PatternMax, Size);
+      ExpectedSize = TEST_DST_SIZE (Size);
+      UT_ASSERT_NOT_EFI_ERROR (Compress (Source, Size, Expected, &ExpectedSize));
+      CompressedSize = TEST_DST_SIZE (Size);
+      UT_ASSERT_NOT_EFI_ERROR (CompressWithContext (CompressContext, Source, Size, Compressed, &CompressedSize));
+      UT_ASSERT_EQUAL (CompressedSize, ExpectedSize);
+      UT_ASSERT_MEM_EQUAL (Compressed, Expected, (UINTN)ExpectedSize);
+    }
+  }
+
+  FreeCompressContext (CompressContext);
+  FreePool (Source);
+  FreePool (Expected);
+  FreePool (Compressed);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Checks that a short destination buffer is not overrun and that the
+  required size is returned.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BufferTooSmall (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8   *Source;
+  UINT8   *Compressed;
+  UINT64  RequiredSize;
+  UINT64  CompressedSize;
+
+  Source     = AllocatePool (SIZE_64KB);
+  Compressed = AllocatePool (TEST_DST_SIZE (SIZE_64KB));
+  UT_ASSERT_NOT_NULL (Source);
+  UT_ASSERT_NOT_NULL (Compressed);
+  FillPattern (Source, SIZE_64KB, PatternText, 1);
+
+  RequiredSize = TEST_DST_SIZE (SIZE_64KB);
+  UT_ASSERT_NOT_EFI_ERROR (Compress (Source, SIZE_64KB, Compressed, &RequiredSize));
+
+  SetMem (Compressed, TEST_DST_SIZE (SIZE_64KB), 0xA5);
+  CompressedSize = RequiredSize / 2;
+  UT_ASSERT_STATUS_EQUAL (Compress (Source, SIZE_64KB, Compressed, &CompressedSize), EFI_BUFFER_TOO_SMALL);
+  UT_ASSERT_EQUAL (CompressedSize, RequiredSize);
+  UT_ASSERT_EQUAL (Compressed[RequiredSize / 2], 0xA5);
+
+  CompressedSize = RequiredSize;
+  UT_ASSERT_NOT_EFI_ERROR (Compress (Source, SIZE_64KB, Compressed, &CompressedSize));
+  UT_ASSERT_TRUE (DecompressMatches (Compressed, CompressedSize, Source, SIZE_64KB));
+
+  UT_ASSERT_STATUS_EQUAL (CreateCompressContext (NULL), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (CompressWithContext (NULL, Source, SIZE_64KB, Compressed, &CompressedSize), EFI_INVALID_PARAMETER);
+
+  FreePool (Source);
+  FreePool (Compressed);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Times Compress() and CompressWithContext() on every pattern and logs the
+  throughput and compression ratio.
+
+  @param[in]  Context  Points to the UINT32 source size to compress.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+CompressBenchmark (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  COMPRESS_CONTEXT  *CompressContext;
+  UINT8             *Source;
+  UINT8             *Compressed;
+  UINT64            CompressedSize;
+  UINT32            Size;
+  UINTN             Iterations;
+  UINTN             Iteration;
+  TEST_PATTERN      Pattern;
+  clock_t           Start;
+  UINT64            SingleUs;
+  UINT64            ReusedUs;
+
+  Size       = *(CONST UINT32 *)Context;
+  Iterations = (Size >= BENCH_LARGE_SIZE) ? BENCH_LARGE_ITERATIONS : BENCH_SMALL_ITERATIONS;
+  Source     = AllocatePool (Size);
+  Compressed = AllocatePool (TEST_DST_SIZE (Size));
+  UT_ASSERT_NOT_NULL (Source);
+  UT_ASSERT_NOT_NULL (Compressed);
+  UT_ASSERT_NOT_EFI_ERROR (CreateCompressContext (&CompressContext));
+
+  for (Pattern = 0; Pattern < PatternMax; Pattern++) {
+    FillPattern (Source, Size, Pattern, 7);
+
+    Start = clock ();
+    for (Iteration = 0; Iteration < Iterations; Iteration++) {
+      CompressedSize = TEST_DST_SIZE (Size);
+      UT_ASSERT_NOT_EFI_ERROR (Compress (Source, Size, Compressed, &CompressedSize));
+    }
+
+    SingleUs = ((UINT64)(clock () - Start) * 1000000) / CLOCKS_PER_SEC;
+
+    Start = clock ();
+    for (Iteration = 0; Iteration < Iterations; Iteration++) {
+      CompressedSize = TEST_DST_SIZE (Size);
+      UT_ASSERT_NOT_EFI_ERROR (CompressWithContext (CompressContext, Source, Size, Compressed, &CompressedSize));
+    }
+
+    ReusedUs = ((UINT64)(clock () - Start) * 1000000) / CLOCKS_PER_SEC;
+
+    UT_LOG_INFO (
+      "%a, %d bytes -> %d bytes: Compress %d us/call, reused context %d us/call, %d KB/s\n",
+      mPatternName[Pattern],
+      Size,
+      (UINT32)CompressedSize,
+      (UINT32)(SingleUs / Iterations),
+      (UINT32)(ReusedUs / Iterations),
+      (UINT32)((ReusedUs == 0) ? 0 : (UINT64)Size * Iterations * 1000000 / 1024 / ReusedUs)
+      );
+  }
+
+  FreeCompressContext (CompressContext);
+  FreePool (Source);
+  FreePool (Compressed);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  CompressLib and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  STATIC UINT32               LargeSize = BENCH_LARGE_SIZE;
+  STATIC UINT32               SmallSize = BENCH_SMALL_SIZE;
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      CompressSuite;
+  UNIT_TEST_SUITE_HANDLE      BenchmarkSuite;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&CompressSuite, Framework, "Compression Tests", "CompressLib.Compress", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Compression Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (CompressSuite, "Output decompresses to the source", "RoundTrip", RoundTrip, NULL, NULL, NULL);
+  AddTestCase (CompressSuite, "Output matches the original implementation", "GoldenOutput", GoldenOutput, NULL, NULL, NULL);
+  AddTestCase (CompressSuite, "Reused context matches Compress()", "ContextReuse", ContextReuse, NULL, NULL, NULL);
+  AddTestCase (CompressSuite, "Short destination buffer", "BufferTooSmall", BufferTooSmall, NULL, NULL, NULL);
+
+  Status = CreateUnitTestSuite (&BenchmarkSuite, Framework, "Compression Benchmark", "CompressLib.Benchmark", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Compression Benchmark\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (BenchmarkSuite, "64 KB buffers", "Large", CompressBenchmark, NULL, NULL, &LargeSize);
+  AddTestCase (BenchmarkSuite, "4 KB buffers", "Small", CompressBenchmark, NULL, NULL, &SmallSize);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
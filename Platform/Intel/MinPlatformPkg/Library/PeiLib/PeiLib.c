@@ -143,6 +143,7 @@ PeiGetLargeVariable (
   )
 {
   EFI_STATUS                        Status;
+  LARGE_VARIABLE_INFO               Info;
   UINTN                             VariableSize;
   VOID                              *VariableData;
 
@@ -150,17 +151,21 @@ PeiGetLargeVariable (
   ASSERT (Guid != NULL);
   ASSERT (Value != NULL);
 
-  VariableSize = 0;
   VariableData = NULL;
-  Status = GetLargeVariable (Name, Guid, &VariableSize, NULL);
-  if (Status == EFI_BUFFER_TOO_SMALL) {
+  //
+  // Keep the variable count found while sizing, so the read does not have to
+  // probe for the variables of the set again.
+  //
+  Status = GetLargeVariableInfo (Name, Guid, &Info);
+  if (Status == EFI_SUCCESS) {
+    VariableSize = Info.TotalSize;
     VariableData = AllocatePages (EFI_SIZE_TO_PAGES (VariableSize));
     if (VariableData == NULL) {
       DEBUG ((DEBUG_ERROR, "Error: Cannot create VariableData, out of memory!\n"));
       ASSERT (FALSE);
       return EFI_OUT_OF_RESOURCES;
     }
-    Status = GetLargeVariable (Name, Guid, &VariableSize, VariableData);
+    Status = GetLargeVariableWithInfo (Name, Guid, &Info, VariableData);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "Error: Unable to read UEFI variable Status: %r\n", Status));
       ASSERT_EFI_ERROR (Status);
@@ -79,6 +79,8 @@ OnEndOfDxe (
   TestPointEndOfDxeDmaAcpiTableFunctional ();
 
   TestPointEndOfDxeDmaProtectionEnabled ();
+
+  TestPointEndOfDxePerformanceBudget ();
 }
 
 /**
@@ -154,6 +156,7 @@ OnReadyToBootLater (
   TestPointReadyToBootTcgTrustedBootEnabled ();
   TestPointReadyToBootTcgMorEnabled ();
   TestPointReadyToBootEsrtTableFunctional ();
+  TestPointReadyToBootPerformanceBudget ();
 }
 
 /**
@@ -69,6 +69,8 @@ PlatformInitEndOfPei (
 
   TestPointEndOfPeiMtrrFunctional ();
 
+  TestPointEndOfPeiPerformanceBudget ();
+
   return Status;
 }
 
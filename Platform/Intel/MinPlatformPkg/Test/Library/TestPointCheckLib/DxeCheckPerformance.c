@@ -0,0 +1,140 @@
+/** @file
+
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <PiDxe.h>
+#include <Library/TestPointCheckLib.h>
+#include <Library/TestPointLib.h>
+#include <Library/DebugLib.h>
+#include <Library/PcdLib.h>
+#include <IndustryStandard/Acpi.h>
+#include <Guid/ExtendedFirmwarePerformance.h>
+
+#include "TestPointInternal.h"
+
+VOID *
+TestPointGetAcpi (
+  IN UINT32  Signature
+  );
+
+/**
+  Return the boot performance table referenced by the FPDT.
+
+  @return The boot performance table, or NULL if the FPDT is not installed yet.
+**/
+EFI_ACPI_5_0_FPDT_PERFORMANCE_TABLE_HEADER *
+GetBootPerformanceTable (
+  VOID
+  )
+{
+  EFI_ACPI_DESCRIPTION_HEADER                              *Fpdt;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER              *RecordHeader;
+  EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_POINTER_RECORD  *BootPointerRecord;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_TABLE_HEADER               *BootTable;
+  UINTN                                                    Offset;
+
+  Fpdt = TestPointGetAcpi (EFI_ACPI_5_0_FIRMWARE_PERFORMANCE_DATA_TABLE_SIGNATURE);
+  if (Fpdt == NULL) {
+    return NULL;
+  }
+
+  for (Offset = sizeof(*Fpdt); Offset + sizeof(*RecordHeader) <= Fpdt->Length; Offset += RecordHeader->Length) {
+    RecordHeader = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *)((UINT8 *)Fpdt + Offset);
+    if (RecordHeader->Length < sizeof(*RecordHeader)) {
+      break;
+    }
+    if ((RecordHeader->Type != EFI_ACPI_5_0_FPDT_RECORD_TYPE_FIRMWARE_BASIC_BOOT_POINTER) ||
+        (RecordHeader->Length < sizeof(*BootPointerRecord))) {
+      continue;
+    }
+
+    BootPointerRecord = (EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_POINTER_RECORD *)RecordHeader;
+    BootTable = (EFI_ACPI_5_0_FPDT_PERFORMANCE_TABLE_HEADER *)(UINTN)BootPointerRecord->BootPerformanceTablePointer;
+    if ((BootTable == NULL) ||
+        (BootTable->Signature != EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_SIGNATURE) ||
+        (BootTable->Length < sizeof(*BootTable))) {
+      return NULL;
+    }
+    return BootTable;
+  }
+
+  return NULL;
+}
+
+EFI_STATUS
+TestPointCheckEndOfDxePerformance (
+  VOID
+  )
+{
+  BOOLEAN  Result;
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckEndOfDxePerformance - Enter\n"));
+
+  Result = TestPointCheckPerformancePhase ("End of DXE", PcdGet32 (PcdTestPointPerformanceEndOfDxeBudget));
+  if (!Result) {
+    TestPointLibAppendErrorString (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      TEST_POINT_BYTE9_END_OF_DXE_PERFORMANCE_BUDGET_ERROR_CODE \
+        TEST_POINT_END_OF_DXE \
+        TEST_POINT_BYTE9_END_OF_DXE_PERFORMANCE_BUDGET_ERROR_STRING
+      );
+  }
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckEndOfDxePerformance - Exit\n"));
+
+  return Result ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
+}
+
+EFI_STATUS
+TestPointCheckReadyToBootPerformance (
+  VOID
+  )
+{
+  TEST_POINT_PERFORMANCE_CONTEXT              Context;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_TABLE_HEADER  *BootTable;
+  BOOLEAN                                     Result;
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckReadyToBootPerformance - Enter\n"));
+
+  Result = TestPointCheckPerformancePhase ("Ready To Boot", PcdGet32 (PcdTestPointPerformanceReadyToBootBudget));
+
+  //
+  // The boot performance table holds the PEI and DXE records copied by the
+  // DxeCorePerformanceLib, behind the basic boot record.
+  //
+  BootTable = GetBootPerformanceTable ();
+  if (BootTable == NULL) {
+    DEBUG ((DEBUG_INFO, "No FPDT boot performance table, module budget not checked\n"));
+  } else {
+    TestPointInitPerformanceContext (
+      &Context,
+      PcdGet32 (PcdTestPointPerformanceModuleBudget),
+      PcdGet32 (PcdTestPointPerformanceTopCount)
+      );
+    TestPointCheckPerformanceRecords (
+      &Context,
+      (UINT8 *)(BootTable + 1),
+      BootTable->Length - sizeof(*BootTable)
+      );
+    TestPointDumpPerformanceTop (&Context);
+    if (Context.OverBudgetCount != 0) {
+      Result = FALSE;
+    }
+  }
+
+  if (!Result) {
+    TestPointLibAppendErrorString (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      TEST_POINT_BYTE9_READY_TO_BOOT_PERFORMANCE_BUDGET_ERROR_CODE \
+        TEST_POINT_READY_TO_BOOT \
+        TEST_POINT_BYTE9_READY_TO_BOOT_PERFORMANCE_BUDGET_ERROR_STRING
+      );
+  }
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckReadyToBootPerformance - Exit\n"));
+
+  return Result ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
+}
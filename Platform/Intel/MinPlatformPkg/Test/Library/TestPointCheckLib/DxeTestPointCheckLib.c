@@ -138,6 +138,16 @@ TestPointCheckTcgTrustedBoot (
   VOID
   );
 
+EFI_STATUS
+TestPointCheckEndOfDxePerformance (
+  VOID
+  );
+
+EFI_STATUS
+TestPointCheckReadyToBootPerformance (
+  VOID
+  );
+
 EFI_STATUS
 TestPointCheckTcgMor (
   VOID
@@ -351,6 +361,51 @@ TestPointEndOfDxeDmaProtectionEnabled (
   return EFI_SUCCESS;
 }
 
+/**
+  This service verifies boot performance against the platform budget at the end of DXE.
+
+  Test subject: Boot time.
+  Test overview: Verify the time from reset to the end of DXE is within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps results to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointEndOfDxePerformanceBudget (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  BOOLEAN     Result;
+
+  if ((mFeatureImplemented[9] & TEST_POINT_BYTE9_END_OF_DXE_PERFORMANCE_BUDGET) == 0) {
+    return EFI_SUCCESS;
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxePerformanceBudget - Enter\n"));
+
+  Result = TRUE;
+  Status = TestPointCheckEndOfDxePerformance ();
+  if (EFI_ERROR(Status)) {
+    Result = FALSE;
+  }
+
+  if (Result) {
+    TestPointLibSetFeaturesVerified (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      9,
+      TEST_POINT_BYTE9_END_OF_DXE_PERFORMANCE_BUDGET
+      );
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointEndOfDxePerformanceBudget - Exit\n"));
+  return EFI_SUCCESS;
+}
+
 /**
   This service verifies no 3rd party PCI option ROMs (OPROMs) were dispatched prior to the end of DXE.
 
@@ -1062,6 +1117,51 @@ TestPointReadyToBootEsrtTableFunctional (
   return EFI_SUCCESS;
 }
 
+/**
+  This service verifies boot performance against the platform budget at Ready To Boot.
+
+  Test subject: FPDT boot performance records.
+  Test overview: Verify the time from reset to Ready To Boot and the time spent in each module are within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the longest running modules to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootPerformanceBudget (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  BOOLEAN     Result;
+
+  if ((mFeatureImplemented[9] & TEST_POINT_BYTE9_READY_TO_BOOT_PERFORMANCE_BUDGET) == 0) {
+    return EFI_SUCCESS;
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootPerformanceBudget - Enter\n"));
+
+  Result = TRUE;
+  Status = TestPointCheckReadyToBootPerformance ();
+  if (EFI_ERROR(Status)) {
+    Result = FALSE;
+  }
+
+  if (Result) {
+    TestPointLibSetFeaturesVerified (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      9,
+      TEST_POINT_BYTE9_READY_TO_BOOT_PERFORMANCE_BUDGET
+      );
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootPerformanceBudget - Exit\n"));
+  return EFI_SUCCESS;
+}
+
 /**
   This service verifies UEFI Secure Boot is enabled.
 
@@ -0,0 +1,69 @@
+/** @file
+
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+#include <Library/TestPointCheckLib.h>
+#include <Library/TestPointLib.h>
+#include <Library/DebugLib.h>
+#include <Library/HobLib.h>
+#include <Library/PcdLib.h>
+#include <Guid/ExtendedFirmwarePerformance.h>
+
+#include "TestPointInternal.h"
+
+EFI_STATUS
+TestPointCheckPeiPerformance (
+  VOID
+  )
+{
+  TEST_POINT_PERFORMANCE_CONTEXT  Context;
+  EFI_HOB_GUID_TYPE               *GuidHob;
+  FPDT_PEI_EXT_PERF_HEADER        *PeiPerformanceLogHeader;
+  BOOLEAN                         Result;
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckPeiPerformance - Enter\n"));
+
+  Result = TestPointCheckPerformancePhase ("End of PEI", PcdGet32 (PcdTestPointPerformanceEndOfPeiBudget));
+
+  //
+  // PeiPerformanceLib keeps the PEIM records in one or more GUIDed HOBs.
+  //
+  TestPointInitPerformanceContext (
+    &Context,
+    PcdGet32 (PcdTestPointPerformanceModuleBudget),
+    PcdGet32 (PcdTestPointPerformanceTopCount)
+    );
+  GuidHob = GetFirstGuidHob (&gEdkiiFpdtExtendedFirmwarePerformanceGuid);
+  if (GuidHob == NULL) {
+    DEBUG ((DEBUG_INFO, "No PEI performance records\n"));
+  }
+  while (GuidHob != NULL) {
+    PeiPerformanceLogHeader = GET_GUID_HOB_DATA (GuidHob);
+    TestPointCheckPerformanceRecords (
+      &Context,
+      (UINT8 *)(PeiPerformanceLogHeader + 1),
+      PeiPerformanceLogHeader->SizeOfAllEntries
+      );
+    GuidHob = GetNextGuidHob (&gEdkiiFpdtExtendedFirmwarePerformanceGuid, GET_NEXT_HOB (GuidHob));
+  }
+  TestPointDumpPerformanceTop (&Context);
+  if (Context.OverBudgetCount != 0) {
+    Result = FALSE;
+  }
+
+  if (!Result) {
+    TestPointLibAppendErrorString (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      TEST_POINT_BYTE9_END_OF_PEI_PERFORMANCE_BUDGET_ERROR_CODE \
+        TEST_POINT_END_OF_PEI \
+        TEST_POINT_BYTE9_END_OF_PEI_PERFORMANCE_BUDGET_ERROR_STRING
+      );
+  }
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckPeiPerformance - Exit\n"));
+
+  return Result ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
+}
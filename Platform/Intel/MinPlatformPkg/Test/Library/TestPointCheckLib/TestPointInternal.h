@@ -40,4 +40,75 @@ typedef struct {
 
 extern EFI_GUID  mTestPointSmmCommunciationGuid;
 
+#define TEST_POINT_PERFORMANCE_TOP_COUNT_MAX     16
+#define TEST_POINT_PERFORMANCE_NAME_LENGTH       24
+
+typedef struct {
+  EFI_GUID   Guid;
+  CHAR8      Name[TEST_POINT_PERFORMANCE_NAME_LENGTH];
+  UINT64     Duration;
+} TEST_POINT_PERFORMANCE_MODULE;
+
+typedef struct {
+  UINT64                         ModuleBudget;
+  UINTN                          TopCount;
+  UINTN                          ModuleCount;
+  UINTN                          OverBudgetCount;
+  TEST_POINT_PERFORMANCE_MODULE  Top[TEST_POINT_PERFORMANCE_TOP_COUNT_MAX];
+} TEST_POINT_PERFORMANCE_CONTEXT;
+
+/**
+  Initialize a performance check context.
+
+  @param[out] Context       The performance check context.
+  @param[in]  ModuleBudget  The per-module budget in microseconds, 0 means no budget.
+  @param[in]  TopCount      The number of the longest running modules to keep.
+**/
+VOID
+TestPointInitPerformanceContext (
+  OUT TEST_POINT_PERFORMANCE_CONTEXT  *Context,
+  IN  UINT32                          ModuleBudget,
+  IN  UINT32                          TopCount
+  );
+
+/**
+  Check the module start and end records of an FPDT performance record buffer
+  against the per-module budget.
+
+  @param[in, out] Context      The performance check context.
+  @param[in]      Records      The FPDT performance records.
+  @param[in]      RecordsSize  The size of the records in bytes.
+**/
+VOID
+TestPointCheckPerformanceRecords (
+  IN OUT TEST_POINT_PERFORMANCE_CONTEXT  *Context,
+  IN     UINT8                           *Records,
+  IN     UINTN                           RecordsSize
+  );
+
+/**
+  Dump the longest running modules recorded in a performance check context.
+
+  @param[in] Context  The performance check context.
+**/
+VOID
+TestPointDumpPerformanceTop (
+  IN TEST_POINT_PERFORMANCE_CONTEXT  *Context
+  );
+
+/**
+  Check the time elapsed since reset against a phase budget.
+
+  @param[in] Phase   The name of the phase boundary.
+  @param[in] Budget  The phase budget in microseconds, 0 means no budget.
+
+  @retval TRUE   The phase is within budget.
+  @retval FALSE  The phase is over budget.
+**/
+BOOLEAN
+TestPointCheckPerformancePhase (
+  IN CHAR8   *Phase,
+  IN UINT32  Budget
+  );
+
 #endif
\ No newline at end of file
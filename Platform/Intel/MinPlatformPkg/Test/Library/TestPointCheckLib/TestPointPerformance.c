@@ -0,0 +1,260 @@
+/** @file
+  Common FPDT performance record checks used by the performance budget test points.
+
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/TestPointCheckLib.h>
+#include <Library/DebugLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/TimerLib.h>
+#include <Guid/ExtendedFirmwarePerformance.h>
+
+#include "TestPointInternal.h"
+
+/**
+  Initialize a performance check context.
+
+  @param[out] Context       The performance check context.
+  @param[in]  ModuleBudget  The per-module budget in microseconds, 0 means no budget.
+  @param[in]  TopCount      The number of the longest running modules to keep.
+**/
+VOID
+TestPointInitPerformanceContext (
+  OUT TEST_POINT_PERFORMANCE_CONTEXT  *Context,
+  IN  UINT32                          ModuleBudget,
+  IN  UINT32                          TopCount
+  )
+{
+  ZeroMem (Context, sizeof(*Context));
+  Context->ModuleBudget = MultU64x32 (ModuleBudget, 1000);
+  Context->TopCount     = MIN (TopCount, TEST_POINT_PERFORMANCE_TOP_COUNT_MAX);
+}
+
+/**
+  Return a performance record as a module start or end record.
+
+  @param[in] RecordHeader  The performance record.
+  @param[in] ProgressId    MODULE_START_ID or MODULE_END_ID.
+
+  @return The record as a GUID event record, or NULL if it is not a module record
+          with the given progress ID.
+**/
+FPDT_GUID_EVENT_RECORD *
+GetModuleRecord (
+  IN EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *RecordHeader,
+  IN UINT16                                       ProgressId
+  )
+{
+  FPDT_GUID_EVENT_RECORD  *GuidEvent;
+
+  //
+  // Dynamic string records share the GUID event layout, followed by the module name.
+  //
+  if ((RecordHeader->Type != FPDT_GUID_EVENT_TYPE) &&
+      (RecordHeader->Type != FPDT_DYNAMIC_STRING_EVENT_TYPE)) {
+    return NULL;
+  }
+  if (RecordHeader->Length < sizeof(FPDT_GUID_EVENT_RECORD)) {
+    return NULL;
+  }
+
+  GuidEvent = (FPDT_GUID_EVENT_RECORD *)RecordHeader;
+  if (GuidEvent->ProgressID != ProgressId) {
+    return NULL;
+  }
+  return GuidEvent;
+}
+
+/**
+  Insert a module into the list of the longest running modules.
+
+  @param[in, out] Context   The performance check context.
+  @param[in]      Start     The module start record.
+  @param[in]      Duration  The module duration in nanoseconds.
+**/
+VOID
+InsertPerformanceTop (
+  IN OUT TEST_POINT_PERFORMANCE_CONTEXT  *Context,
+  IN     FPDT_GUID_EVENT_RECORD          *Start,
+  IN     UINT64                          Duration
+  )
+{
+  UINTN                          Count;
+  UINTN                          Index;
+  UINTN                          NameLength;
+  TEST_POINT_PERFORMANCE_MODULE  *Module;
+
+  Count = MIN (Context->ModuleCount, Context->TopCount);
+  for (Index = 0; Index < Count; Index++) {
+    if (Duration > Context->Top[Index].Duration) {
+      break;
+    }
+  }
+  if (Index == Context->TopCount) {
+    return;
+  }
+
+  if (Count == Context->TopCount) {
+    Count--;
+  }
+  CopyMem (
+    &Context->Top[Index + 1],
+    &Context->Top[Index],
+    (Count - Index) * sizeof(Context->Top[0])
+    );
+
+  Module = &Context->Top[Index];
+  ZeroMem (Module, sizeof(*Module));
+  CopyGuid (&Module->Guid, &Start->Guid);
+  Module->Duration = Duration;
+  if (Start->Header.Type == FPDT_DYNAMIC_STRING_EVENT_TYPE) {
+    NameLength = MIN (
+                   Start->Header.Length - sizeof(FPDT_GUID_EVENT_RECORD),
+                   sizeof(Module->Name) - 1
+                   );
+    CopyMem (Module->Name, Start + 1, NameLength);
+  }
+}
+
+/**
+  Check the module start and end records of an FPDT performance record buffer
+  against the per-module budget.
+
+  @param[in, out] Context      The performance check context.
+  @param[in]      Records      The FPDT performance records.
+  @param[in]      RecordsSize  The size of the records in bytes.
+**/
+VOID
+TestPointCheckPerformanceRecords (
+  IN OUT TEST_POINT_PERFORMANCE_CONTEXT  *Context,
+  IN     UINT8                           *Records,
+  IN     UINTN                           RecordsSize
+  )
+{
+  UINTN                                        Offset;
+  UINTN                                        EndOffset;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *RecordHeader;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *EndHeader;
+  FPDT_GUID_EVENT_RECORD                       *Start;
+  FPDT_GUID_EVENT_RECORD                       *End;
+  UINT64                                       Duration;
+
+  for (Offset = 0; Offset + sizeof(*RecordHeader) <= RecordsSize; Offset += RecordHeader->Length) {
+    RecordHeader = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *)(Records + Offset);
+    if ((RecordHeader->Length < sizeof(*RecordHeader)) || (RecordHeader->Length > RecordsSize - Offset)) {
+      DEBUG ((DEBUG_ERROR, "Invalid performance record at offset 0x%x\n", Offset));
+      break;
+    }
+
+    Start = GetModuleRecord (RecordHeader, MODULE_START_ID);
+    if (Start == NULL) {
+      continue;
+    }
+
+    //
+    // The matching end record is the next module end record with the same GUID.
+    //
+    End = NULL;
+    for (EndOffset = Offset + RecordHeader->Length; EndOffset + sizeof(*EndHeader) <= RecordsSize; EndOffset += EndHeader->Length) {
+      EndHeader = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *)(Records + EndOffset);
+      if ((EndHeader->Length < sizeof(*EndHeader)) || (EndHeader->Length > RecordsSize - EndOffset)) {
+        break;
+      }
+      End = GetModuleRecord (EndHeader, MODULE_END_ID);
+      if ((End != NULL) && CompareGuid (&End->Guid, &Start->Guid)) {
+        break;
+      }
+      End = NULL;
+    }
+    if ((End == NULL) || (End->Timestamp < Start->Timestamp)) {
+      continue;
+    }
+
+    Duration = End->Timestamp - Start->Timestamp;
+    if ((Context->ModuleBudget != 0) && (Duration > Context->ModuleBudget)) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "Module %g took %ld us, over the budget of %ld us\n",
+        &Start->Guid,
+        DivU64x32 (Duration, 1000),
+        DivU64x32 (Context->ModuleBudget, 1000)
+        ));
+      Context->OverBudgetCount++;
+    }
+    InsertPerformanceTop (Context, Start, Duration);
+    Context->ModuleCount++;
+  }
+}
+
+/**
+  Dump the longest running modules recorded in a performance check context.
+
+  @param[in] Context  The performance check context.
+**/
+VOID
+TestPointDumpPerformanceTop (
+  IN TEST_POINT_PERFORMANCE_CONTEXT  *Context
+  )
+{
+  UINTN  Count;
+  UINTN  Index;
+
+  DEBUG ((DEBUG_INFO, "Modules: %d, over budget: %d\n", Context->ModuleCount, Context->OverBudgetCount));
+
+  Count = MIN (Context->ModuleCount, Context->TopCount);
+  if (Count == 0) {
+    return;
+  }
+
+  DEBUG ((DEBUG_INFO, "Top %d modules:\n", Count));
+  DEBUG ((DEBUG_INFO, "                Module                  Time(us)  Name\n"));
+//DEBUG ((DEBUG_INFO, "  00000000-0000-0000-0000-000000000000  0000000000  Name\n"));
+  for (Index = 0; Index < Count; Index++) {
+    DEBUG ((
+      DEBUG_INFO,
+      "  %g  %10ld  %a\n",
+      &Context->Top[Index].Guid,
+      DivU64x32 (Context->Top[Index].Duration, 1000),
+      Context->Top[Index].Name
+      ));
+  }
+}
+
+/**
+  Check the time elapsed since reset against a phase budget.
+
+  The time is read from the same counter the PerformanceLib instances use to
+  timestamp the FPDT records.
+
+  @param[in] Phase   The name of the phase boundary.
+  @param[in] Budget  The phase budget in microseconds, 0 means no budget.
+
+  @retval TRUE   The phase is within budget.
+  @retval FALSE  The phase is over budget.
+**/
+BOOLEAN
+TestPointCheckPerformancePhase (
+  IN CHAR8   *Phase,
+  IN UINT32  Budget
+  )
+{
+  UINT64  Time;
+
+  Time = DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter ()), 1000);
+  if (Budget == 0) {
+    DEBUG ((DEBUG_INFO, "%a: %ld us\n", Phase, Time));
+    return TRUE;
+  }
+
+  if (Time > Budget) {
+    DEBUG ((DEBUG_ERROR, "%a: %ld us, over the budget of %d us\n", Phase, Time, Budget));
+    return FALSE;
+  }
+
+  DEBUG ((DEBUG_INFO, "%a: %ld us, budget %d us\n", Phase, Time, Budget));
+  return TRUE;
+}
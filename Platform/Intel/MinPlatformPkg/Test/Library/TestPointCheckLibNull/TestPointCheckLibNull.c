@@ -193,6 +193,26 @@ TestPointEndOfPeiPciBusMasterDisabled (
   return EFI_SUCCESS;
 }
 
+/**
+  This service verifies boot performance against the platform budget at the end of PEI.
+
+  Test subject: PEI performance records.
+  Test overview: Verify the time from reset to the end of PEI and the time spent in each PEIM are within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the longest running modules to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointEndOfPeiPerformanceBudget (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
 /**
   This service verifies bus master enable (BME) is disabled after PCI enumeration.
 
@@ -293,6 +313,26 @@ TestPointEndOfDxeDmaProtectionEnabled (
   return EFI_SUCCESS;
 }
 
+/**
+  This service verifies boot performance against the platform budget at the end of DXE.
+
+  Test subject: Boot time.
+  Test overview: Verify the time from reset to the end of DXE is within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps results to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointEndOfDxePerformanceBudget (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
 /**
   This service verifies the validity of System Management RAM (SMRAM) alignment at SMM Ready To Lock.
 
@@ -516,6 +556,26 @@ TestPointReadyToBootEsrtTableFunctional (
   return EFI_SUCCESS;
 }
 
+/**
+  This service verifies boot performance against the platform budget at Ready To Boot.
+
+  Test subject: FPDT boot performance records.
+  Test overview: Verify the time from reset to Ready To Boot and the time spent in each module are within budget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the longest running modules to the debug log.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootPerformanceBudget (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
 /**
   This service verifies UEFI Secure Boot is enabled.
 
@@ -43,6 +43,7 @@ SaveS3StructToNvram (
   VOID                            *CompressedVariableData = NULL;
   UINTN                           CompressedBufferSize;
   EDKII_VARIABLE_LOCK_PROTOCOL    *VariableLock = NULL;
+  COMPRESS_CONTEXT                *CompressContext = NULL;
   
   //
   // Get first S3 data HOB
@@ -60,6 +61,17 @@ SaveS3StructToNvram (
   DEBUG((DEBUG_INFO, "[SaveMemoryConfigEntryPoint] Locate Variable Lock protocol - %r\n", Status));
   ASSERT_EFI_ERROR(Status); 
 
+  //
+  // Every chunk that changed is compressed, so share the work buffers of
+  // one compression context instead of allocating them on each call.
+  //
+  Status = CreateCompressContext (&CompressContext);
+  DEBUG((DEBUG_INFO, "[SaveMemoryConfigEntryPoint] Create compression context - %r\n", Status));
+  if(EFI_ERROR (Status)) {
+    ASSERT_EFI_ERROR (Status);
+    return;
+  }
+
   while (TRUE) {
     if (GuidHob == NULL) {
       break;
@@ -171,7 +183,7 @@ SaveS3StructToNvram (
         ASSERT (CompressedVariableData != NULL); 
         if (Status == EFI_SUCCESS) {
           CompressedBufferSize = BufferSize;
-          Status = Compress(HobData, S3ChunkSize, CompressedVariableData, &CompressedBufferSize);
+          Status = CompressWithContext(CompressContext, HobData, S3ChunkSize, CompressedVariableData, &CompressedBufferSize);
           if (Status == EFI_BUFFER_TOO_SMALL){
             gBS->FreePool(CompressedVariableData);
             Status = gBS->AllocatePool(
@@ -180,7 +192,7 @@ SaveS3StructToNvram (
                             (VOID**)&CompressedVariableData
                             );
             ASSERT (CompressedVariableData != NULL);
-            Status = Compress(HobData, S3ChunkSize, CompressedVariableData, &CompressedBufferSize);
+            Status = CompressWithContext(CompressContext, HobData, S3ChunkSize, CompressedVariableData, &CompressedBufferSize);
           }
           if(Status == EFI_SUCCESS) {
             Status = gRT->SetVariable (
@@ -224,6 +236,8 @@ SaveS3StructToNvram (
     }
   }
 
+  FreeCompressContext (CompressContext);
+
   return;
 }
 
@@ -0,0 +1,463 @@
+## @file
+# Generate a precompiled GPIO PADCFG image from a board GPIO_INIT_CONFIG table
+#
+# The board table is translated into per-community register images the same
+# way GpioConfigurePads () does at runtime in TigerlakeSiliconPkg GpioLib, and
+# the result is consumed by GpioConfigurePadsFromImage (). Silicon register
+# offsets, bit fields and the GPIO group table are read from the silicon
+# package sources so no silicon data is duplicated here.
+#
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+import os
+import re
+import sys
+import struct
+import logging
+import argparse
+
+# Version message
+__prog__ = 'GenGpioPadCfgImage'
+__description__ = 'Generate a precompiled GPIO PADCFG image from a board GPIO table. '
+__version__ = '%s Version %s' % (__prog__, '0.1 ')
+
+_Usage = "Usage: GenGpioPadCfgImage -s SiliconPkgDir -i GpioTableFile -t TableName [-o OutputFile] [-oh OutputHeaderFile -n ArrayName]"
+_ErrorMessageTemplate = '\n\n%(tool)s...\n : error: %(msg)s\n\t%(extra)s'
+_ErrorLogger = logging.getLogger("tool_error")
+_ErrorFormatter = logging.Formatter("%(message)s")
+
+# Error message
+ERRORCODE = 50
+OPTION_MISSING = 'Missing option'
+FILE_NOT_FOUND = 'File/directory not found'
+FORMAT_INVALID = 'Invalid syntax/format'
+CONFIG_INVALID = 'Invalid GPIO configuration'
+
+# Silicon package sources providing defines, relative to the silicon package
+_SiliconHeaders = [
+    'Include/Library/GpioConfig.h',
+    'Include/Register/GpioRegs.h',
+    'Include/Register/GpioRegsVer2.h',
+    'Include/Pins/GpioPinsVer2Lp.h',
+    'Fru/TglPch/IncludePrivate/Register/PchPcrRegs.h',
+    'IpBlock/Gpio/IncludePrivate/Library/GpioPrivateLib.h',
+]
+_GroupInfoSource = 'IpBlock/Gpio/LibraryPrivate/PeiDxeSmmGpioPrivateLib/GpioPrivateLibVer2.c'
+
+# GPIO_GROUP_INFO and GPIO_CONFIG field order
+_GroupInfoFields = ['Community', 'PadOwnOffset', 'HostOwnOffset', 'GpiIsOffset', 'GpiIeOffset',
+                    'GpiGpeStsOffset', 'GpiGpeEnOffset', 'SmiStsOffset', 'SmiEnOffset', 'NmiStsOffset',
+                    'NmiEnOffset', 'PadCfgLockOffset', 'PadCfgLockTxOffset', 'PadCfgOffset', 'PadPerGroup']
+_GpioConfigFields = [('PadMode', 5), ('HostSoftPadOwn', 2), ('Direction', 6), ('OutputState', 2),
+                     ('InterruptConfig', 9), ('PowerConfig', 8), ('ElectricalConfig', 9),
+                     ('LockConfig', 4), ('OtherSettings', 9)]
+
+# Image format, see TigerlakeSiliconPkg/Include/GpioPadCfgImage.h
+_ImageSignature = b'GPCI'
+_ImageRevision = 1
+_ImageHeader = struct.Struct('<4sHHII')
+_ImageCommunity = struct.Struct('<BBHI')
+_ImageGroupDw = struct.Struct('<IIIII')
+_ImageRegister = struct.Struct('<III')
+
+_GroupDwFields = ['Pads', 'HostSoftOwn', 'HostSoftOwnMask', 'GpiGpeEn', 'GpiGpeEnMask', 'GpiNmiEn',
+                  'GpiNmiEnMask', 'GpiSmiEn', 'GpiSmiEnMask', 'ConfigUnlock', 'OutputUnlock']
+
+# Number of DWs per group supported by GpioConfigurePads ()
+_GroupDwNumber = 1
+_PadCfgDwNumber = 3
+
+
+# Output the error message and exit the tool
+def EdkLogger(ToolName, Message, ExtraData):
+    _ErrorLogger.setLevel(logging.INFO)
+    _ErrorCh = logging.StreamHandler(sys.stderr)
+    _ErrorCh.setFormatter(_ErrorFormatter)
+    _ErrorLogger.addHandler(_ErrorCh)
+    TemplateDict = {"tool": ToolName, "msg": Message, "extra": ExtraData}
+    _ErrorLogger.log(ERRORCODE, _ErrorMessageTemplate % TemplateDict)
+    sys.exit(1)
+
+
+# Parse command line options
+def MyOptionParser():
+    parser = argparse.ArgumentParser(prog=__prog__,
+                                     description=__description__ + _Usage,
+                                     conflict_handler='resolve')
+    parser.add_argument('-v', '--version', action='version', version=__version__,
+                        help="show program's version number and exit")
+    parser.add_argument('-s', '--silicon', metavar='DIRECTORY', dest='SiliconPkg',
+                        help="Path to TigerlakeSiliconPkg")
+    parser.add_argument('-i', '--input', metavar='FILENAME', dest='InputFile',
+                        help="Board source or header file holding the GPIO table")
+    parser.add_argument('-t', '--table', metavar='NAME', dest='TableName', help="Name of the GPIO_INIT_CONFIG table")
+    parser.add_argument('-o', '--out', metavar='FILENAME', dest='OutputFile', help="Output binary image")
+    parser.add_argument('-oh', '--header', metavar='FILENAME', dest='OutputHeaderFile',
+                        help="Output C header holding the image as a UINT32 array")
+    parser.add_argument('-n', '--name', metavar='NAME', dest='ArrayName', help="Array name used in the C header")
+    parser.add_argument('-I', '--include', metavar='FILENAME', dest='Includes', action='append', default=[],
+                        help="Additional header providing defines used by the table")
+    parser.add_argument('--group-table', metavar='NAME', dest='GroupTable', default='mPchLpGpioGroupInfo',
+                        help="GPIO_GROUP_INFO table of the target PCH (default: %(default)s)")
+    parser.add_argument('--chipset-id', metavar='NAME', dest='ChipsetId', default='GPIO_VER2_LP_CHIPSET_ID',
+                        help="Define holding the target GPIO chipset ID (default: %(default)s)")
+    parser.add_argument('--dsw-group', metavar='NAME', dest='DswGroup', default='GPIO_VER2_LP_GROUP_GPD',
+                        help="Define of the DeepSleepWell GPIO group (default: %(default)s)")
+    parser.add_argument('--verbose', dest='Verbose', action='store_true', default=False,
+                        help="Print the generated register image")
+    return parser.parse_args()
+
+
+# Check the Tool for missing variables
+def CheckOptions(Options):
+    if not Options.SiliconPkg or not Options.InputFile or not Options.TableName:
+        EdkLogger(__prog__, OPTION_MISSING, ExtraData=_Usage)
+    if not Options.OutputFile and not Options.OutputHeaderFile:
+        EdkLogger(__prog__, OPTION_MISSING, ExtraData=_Usage)
+    if Options.OutputHeaderFile and not Options.ArrayName:
+        EdkLogger(__prog__, OPTION_MISSING, ExtraData="C header output requires --name")
+    for File in [Options.InputFile] + Options.Includes:
+        if not os.path.isfile(File):
+            EdkLogger(__prog__, FILE_NOT_FOUND, ExtraData=File)
+    if not os.path.isdir(Options.SiliconPkg):
+        EdkLogger(__prog__, FILE_NOT_FOUND, ExtraData=Options.SiliconPkg)
+
+
+# Read a C source file with comments removed
+def ReadSource(FileName):
+    with open(FileName, 'r') as Fd:
+        Text = Fd.read()
+    Text = re.sub(r'/\*.*?\*/', ' ', Text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', Text)
+
+
+# Collect object-like defines and explicit enum values
+def CollectDefines(FileList):
+    Defines = {}
+    for Index in range(32):
+        Defines['BIT%d' % Index] = str(1 << Index)
+    for FileName in FileList:
+        Text = ReadSource(FileName)
+        for Match in re.finditer(r'^[ \t]*#define[ \t]+([A-Za-z_]\w*)[ \t]+([^\n]+)$', Text, flags=re.M):
+            Defines.setdefault(Match.group(1), Match.group(2).strip())
+        for Body in re.findall(r'typedef\s+enum\s*\{(.*?)\}', Text, flags=re.S):
+            for Match in re.finditer(r'([A-Za-z_]\w*)\s*=\s*([^,]+)', Body):
+                Defines.setdefault(Match.group(1), Match.group(2).strip())
+    return Defines
+
+
+# Evaluate a C integer expression using the collected defines
+def Evaluate(Expression, Defines, Depth=0):
+    if Depth > 16:
+        EdkLogger(__prog__, FORMAT_INVALID, ExtraData="Recursive define: %s" % Expression)
+    Expression = re.sub(r'\((UINT8|UINT16|UINT32|UINT64|UINTN)\)', '', Expression)
+    Expression = re.sub(r'\b(0[xX][0-9a-fA-F]+|\d+)[uUlL]+\b', r'\1', Expression)
+
+    def Resolve(Match):
+        Name = Match.group(0)
+        if Name not in Defines:
+            EdkLogger(__prog__, FORMAT_INVALID, ExtraData="Undefined symbol %s" % Name)
+        return '(%d)' % Evaluate(Defines[Name], Defines, Depth + 1)
+
+    Expression = re.sub(r'\b[A-Za-z_]\w*\b', Resolve, Expression)
+    if not re.match(r'^[\s0-9a-fA-FxX()|&^~<>+\-*/%]*$', Expression):
+        EdkLogger(__prog__, FORMAT_INVALID, ExtraData="Unsupported expression %s" % Expression)
+    return eval(Expression.replace('/', '//'), {'__builtins__': {}}) & 0xFFFFFFFF
+
+
+# Define values evaluated on first use
+class DefineValues(dict):
+    def __init__(self, Defines):
+        dict.__init__(self)
+        self.Defines = Defines
+
+    def __missing__(self, Name):
+        self[Name] = Evaluate(Name, self.Defines)
+        return self[Name]
+
+
+# Split the text of a brace initializer into its top level elements
+def SplitInitializer(Text):
+    Items = []
+    Depth = 0
+    Start = 0
+    for Index, Char in enumerate(Text):
+        if Char == '{':
+            Depth += 1
+        elif Char == '}':
+            Depth -= 1
+        elif Char == ',' and Depth == 0:
+            Items.append(Text[Start:Index].strip())
+            Start = Index + 1
+    Items.append(Text[Start:].strip())
+    return [Item for Item in Items if Item]
+
+
+# Return the initializer elements of a named array
+def FindArray(FileName, Name):
+    Text = ReadSource(FileName)
+    Match = re.search(r'\b%s\s*\[[^\]]*\]\s*=\s*\{' % re.escape(Name), Text)
+    if not Match:
+        EdkLogger(__prog__, FORMAT_INVALID, ExtraData="Table %s not found in %s" % (Name, FileName))
+    Depth = 1
+    Index = Match.end()
+    while Depth and Index < len(Text):
+        if Text[Index] == '{':
+            Depth += 1
+        elif Text[Index] == '}':
+            Depth -= 1
+        Index += 1
+    Rows = []
+    for Row in SplitInitializer(Text[Match.end():Index - 1]):
+        if not (Row.startswith('{') and Row.endswith('}')):
+            EdkLogger(__prog__, FORMAT_INVALID, ExtraData="Unexpected table element %s" % Row)
+        Rows.append(SplitInitializer(Row[1:-1]))
+    return Rows
+
+
+def ReadGroupInfo(FileName, Name, Defines):
+    GroupInfo = []
+    for Row in FindArray(FileName, Name):
+        if len(Row) != len(_GroupInfoFields):
+            EdkLogger(__prog__, FORMAT_INVALID, ExtraData="Unexpected GPIO_GROUP_INFO row in %s" % Name)
+        GroupInfo.append(dict(zip(_GroupInfoFields, [Evaluate(Item, Defines) for Item in Row])))
+    return GroupInfo
+
+
+def ReadGpioTable(FileName, Name, Defines):
+    Table = []
+    for Row in FindArray(FileName, Name):
+        if len(Row) != 2 or not Row[1].startswith('{'):
+            EdkLogger(__prog__, FORMAT_INVALID, ExtraData="Unexpected GPIO_INIT_CONFIG row %s" % Row)
+        Fields = SplitInitializer(Row[1][1:-1])
+        Config = {}
+        for Index, (Field, Width) in enumerate(_GpioConfigFields):
+            Value = Evaluate(Fields[Index], Defines) if Index < len(Fields) else 0
+            Config[Field] = Value & ((1 << Width) - 1)
+        Table.append((Evaluate(Row[0], Defines), Config))
+    return Table
+
+
+# Port of GpioPadRstCfgFromResetConfig ()
+def PadRstCfgFromResetConfig(Pad, ResetConfig, IsDsw, D):
+    if ResetConfig == D['GpioResetDefault']:
+        return 0
+    if ResetConfig == D['GpioHostDeepReset']:
+        return D['V_GPIO_PCR_RST_CONF_DEEP_RST']
+    if ResetConfig == D['GpioPlatformReset']:
+        return D['V_GPIO_PCR_RST_CONF_GPIO_RST']
+    if ResetConfig == D['GpioResumeReset']:
+        return D['V_GPIO_PCR_RST_CONF_RESUME_RST'] if IsDsw else D['V_GPIO_PCR_RST_CONF_POW_GOOD']
+    if ResetConfig == D['GpioDswReset'] and IsDsw:
+        return D['V_GPIO_PCR_RST_CONF_POW_GOOD']
+    EdkLogger(__prog__, CONFIG_INVALID, ExtraData="Unsupported reset config 0x%x for pad 0x%08x" % (ResetConfig, Pad))
+
+
+# Port of GpioPadCfgRegValueFromGpioConfig ()
+def PadCfgRegValueFromGpioConfig(Pad, Config, IsDsw, D):
+    Reg = [0] * _PadCfgDwNumber
+    Mask = [0] * _PadCfgDwNumber
+
+    def Field(Value, FieldMask, BitPos):
+        return (Value & FieldMask) >> BitPos
+
+    def Setting(Value, FieldMask, BitPos):
+        return (Value & FieldMask) >> (BitPos + 1)
+
+    Default = D['GpioHardwareDefault']
+    PadRstCfg = PadRstCfgFromResetConfig(Pad, Config['PowerConfig'], IsDsw, D)
+    if Field(Config['PowerConfig'], D['B_GPIO_RESET_CONFIG_RESET_MASK'], D['N_GPIO_RESET_CONFIG_RESET_BIT_POS']) != Default:
+        Mask[0] |= D['B_GPIO_PCR_RST_CONF']
+    Reg[0] |= PadRstCfg << D['N_GPIO_PCR_RST_CONF']
+
+    Rules = [
+        (0, 'InterruptConfig', 'B_GPIO_INT_CONFIG_INT_TYPE_MASK', 'N_GPIO_INT_CONFIG_INT_TYPE_BIT_POS',
+         D['B_GPIO_PCR_RX_LVL_EDG'], 'N_GPIO_PCR_RX_LVL_EDG'),
+        (0, 'InterruptConfig', 'B_GPIO_INT_CONFIG_INT_SOURCE_MASK', 'N_GPIO_INT_CONFIG_INT_SOURCE_BIT_POS',
+         D['B_GPIO_PCR_RX_NMI_ROUTE'] | D['B_GPIO_PCR_RX_SCI_ROUTE'] | D['B_GPIO_PCR_RX_SMI_ROUTE'] | D['B_GPIO_PCR_RX_APIC_ROUTE'],
+         'N_GPIO_PCR_RX_NMI_ROUTE'),
+        (0, 'Direction', 'B_GPIO_DIRECTION_DIR_MASK', 'N_GPIO_DIRECTION_DIR_BIT_POS',
+         D['B_GPIO_PCR_RXDIS'] | D['B_GPIO_PCR_TXDIS'], 'N_GPIO_PCR_TXDIS'),
+        (0, 'Direction', 'B_GPIO_DIRECTION_INV_MASK', 'N_GPIO_DIRECTION_INV_BIT_POS',
+         D['B_GPIO_PCR_RXINV'], 'N_GPIO_PCR_RXINV'),
+        (0, 'OutputState', 'B_GPIO_OUTPUT_MASK', 'N_GPIO_OUTPUT_BIT_POS',
+         D['B_GPIO_PCR_TX_STATE'], 'N_GPIO_PCR_TX_STATE'),
+        (0, 'OtherSettings', 'B_GPIO_OTHER_CONFIG_RXRAW_MASK', 'N_GPIO_OTHER_CONFIG_RXRAW_BIT_POS',
+         D['B_GPIO_PCR_RX_RAW1'], 'N_GPIO_PCR_RX_RAW1'),
+        (0, 'PadMode', 'B_GPIO_PAD_MODE_MASK', 'N_GPIO_PAD_MODE_BIT_POS',
+         D['B_GPIO_PCR_PAD_MODE'], 'N_GPIO_PCR_PAD_MODE'),
+        (1, 'ElectricalConfig', 'B_GPIO_ELECTRICAL_CONFIG_TERMINATION_MASK', 'N_GPIO_ELECTRICAL_CONFIG_TERMINATION_BIT_POS',
+         D['B_GPIO_PCR_TERM'], 'N_GPIO_PCR_TERM'),
+    ]
+    for Dw, Name, FieldMask, BitPos, RegMask, RegPos in Rules:
+        Value = Config[Name]
+        if Field(Value, D[FieldMask], D[BitPos]) != Default:
+            Mask[Dw] |= RegMask
+        Reg[Dw] |= Setting(Value, D[FieldMask], D[BitPos]) << D[RegPos]
+    return [Value & 0xFFFFFFFF for Value in Reg], Mask
+
+
+# Port of GpioDwRegValueFromGpioConfig ()
+def DwRegValueFromGpioConfig(PadBit, Config, GroupDw, D):
+    Int = Config['InterruptConfig']
+    Bit = 1 << PadBit
+    GroupDw['HostSoftOwnMask'] |= (Config['HostSoftPadOwn'] & 0x1) * Bit
+    GroupDw['HostSoftOwn'] |= (Config['HostSoftPadOwn'] >> 1) * Bit
+    GroupDw['GpiGpeEnMask'] |= (Int & 0x1) * Bit
+    GroupDw['GpiGpeEn'] |= ((Int & D['GpioIntSci']) >> 3) * Bit
+    GroupDw['GpiNmiEnMask'] |= (Int & 0x1) * Bit
+    GroupDw['GpiNmiEn'] |= ((Int & D['GpioIntNmi']) >> 1) * Bit
+    GroupDw['GpiSmiEnMask'] |= (Int & 0x1) * Bit
+    GroupDw['GpiSmiEn'] |= ((Int & D['GpioIntSmi']) >> 2) * Bit
+    if (Int & D['GpioIntSmi']) == D['GpioIntSmi']:
+        GroupDw['HostSoftOwnMask'] |= Bit
+        GroupDw['HostSoftOwn'] |= Bit
+    GroupDw['ConfigUnlock'] |= ((Config['LockConfig'] >> 1) & 0x1) * Bit
+    GroupDw['OutputUnlock'] |= ((Config['LockConfig'] >> 3) & 0x1) * Bit
+    if (Config['PadMode'] == D['GpioPadModeGpio'] and
+            Config['Direction'] == D['GpioDirOut'] and
+            (Config['LockConfig'] & D['B_GPIO_LOCK_CONFIG_OUTPUT_LOCK_MASK']) == D['GpioLockDefault']):
+        GroupDw['OutputUnlock'] |= Bit
+
+
+# Merge a (Mask, Value) update into the register image, later updates win
+def MergeRegister(Registers, Offset, Mask, Value):
+    if Mask == 0:
+        return
+    OldMask, OldValue = Registers.get(Offset, (0, 0))
+    Registers[Offset] = (OldMask | Mask, (OldValue & ~Mask & 0xFFFFFFFF) | (Value & Mask))
+
+
+# Translate the GPIO table into per-community register images
+def BuildImage(Table, GroupInfo, ChipsetId, DswGroup, D):
+    Communities = {}
+    for Pad, Config in Table:
+        if (Pad >> 24) & 0xF != ChipsetId:
+            EdkLogger(__prog__, CONFIG_INVALID, ExtraData="Pad 0x%08x does not belong to chipset 0x%x" % (Pad, ChipsetId))
+        Group = (Pad & 0x0F1F0000) >> 16
+        GroupIndex = Group & 0x1F
+        PadNumber = Pad & 0x1FF
+        if GroupIndex >= len(GroupInfo) or PadNumber >= GroupInfo[GroupIndex]['PadPerGroup']:
+            EdkLogger(__prog__, CONFIG_INVALID, ExtraData="Pad 0x%08x is out of range" % Pad)
+        if PadNumber // 32 >= _GroupDwNumber:
+            EdkLogger(__prog__, CONFIG_INVALID, ExtraData="Pad 0x%08x exceeds supported DW count" % Pad)
+        if ((Config['InterruptConfig'] & D['GpioIntSci']) == D['GpioIntSci'] and
+                (Config['LockConfig'] & D['B_GPIO_LOCK_CONFIG_PAD_CONF_LOCK_MASK']) != D['GpioPadConfigUnlock']):
+            EdkLogger(__prog__, CONFIG_INVALID, ExtraData="Pad 0x%08x used for SCI is not unlocked" % Pad)
+
+        Info = GroupInfo[GroupIndex]
+        Community = Communities.setdefault(Info['Community'], {'PadCfg': {}, 'GroupDw': {}})
+        Reg, Mask = PadCfgRegValueFromGpioConfig(Pad, Config, Group == DswGroup, D)
+        PadCfgReg = D['S_GPIO_PCR_PADCFG'] * PadNumber + Info['PadCfgOffset']
+        for Dw in range(_PadCfgDwNumber):
+            MergeRegister(Community['PadCfg'], PadCfgReg + Dw * 4, Mask[Dw], Reg[Dw])
+
+        #
+        # Merge the pad into its group DW. Register bits of a pad listed twice
+        # are overridden by the later entry, unlock masks accumulate.
+        #
+        PadDw = dict.fromkeys(_GroupDwFields, 0)
+        DwRegValueFromGpioConfig(PadNumber % 32, Config, PadDw, D)
+        GroupDw = Community['GroupDw'].setdefault((Group, PadNumber // 32), dict.fromkeys(_GroupDwFields, 0))
+        for Name in ['HostSoftOwn', 'GpiGpeEn', 'GpiNmiEn', 'GpiSmiEn']:
+            Mask = PadDw[Name + 'Mask']
+            GroupDw[Name] = (GroupDw[Name] & ~Mask) | PadDw[Name]
+            GroupDw[Name + 'Mask'] |= Mask
+        GroupDw['ConfigUnlock'] |= PadDw['ConfigUnlock']
+        GroupDw['OutputUnlock'] |= PadDw['OutputUnlock']
+        GroupDw['Pads'] |= 1 << (PadNumber % 32)
+
+    NoRegister = D['NO_REGISTER_FOR_PROPERTY']
+    Image = []
+    for Pid in sorted(Communities):
+        Community = Communities[Pid]
+        DwRegisters = {}
+        for (Group, DwNum), GroupDw in sorted(Community['GroupDw'].items()):
+            Info = GroupInfo[Group & 0x1F]
+            for Name, OffsetName in [('HostSoftOwn', 'HostOwnOffset'), ('GpiGpeEn', 'GpiGpeEnOffset'),
+                                     ('GpiNmiEn', 'NmiEnOffset'), ('GpiSmiEn', 'SmiEnOffset')]:
+                if Info[OffsetName] == NoRegister:
+                    if GroupDw[Name] != 0:
+                        EdkLogger(__prog__, CONFIG_INVALID, ExtraData="Group 0x%x has no %s register" % (Group, Name))
+                    continue
+                MergeRegister(DwRegisters, Info[OffsetName] + DwNum * 4, GroupDw[Name + 'Mask'], GroupDw[Name])
+        GroupDwList = [(Group, DwNum, GroupDw['Pads'], GroupDw['ConfigUnlock'], GroupDw['OutputUnlock'])
+                       for (Group, DwNum), GroupDw in sorted(Community['GroupDw'].items())]
+        Registers = [(Offset,) + Community['PadCfg'][Offset] for Offset in sorted(Community['PadCfg'])]
+        Registers += [(Offset,) + DwRegisters[Offset] for Offset in sorted(DwRegisters)]
+        Image.append((Pid, GroupDwList, Registers))
+    return Image
+
+
+def PackImage(Image, ChipsetId):
+    Body = b''
+    for Pid, GroupDwList, Registers in Image:
+        Body += _ImageCommunity.pack(Pid, 0, len(GroupDwList), len(Registers))
+        for GroupDw in GroupDwList:
+            Body += _ImageGroupDw.pack(*GroupDw)
+        for Register in Registers:
+            Body += _ImageRegister.pack(*Register)
+    Size = _ImageHeader.size + len(Body)
+    return _ImageHeader.pack(_ImageSignature, _ImageRevision, len(Image), ChipsetId, Size) + Body
+
+
+def WriteHeaderFile(FileName, ArrayName, Data, Options):
+    Words = struct.unpack('<%dI' % (len(Data) // 4), Data)
+    Lines = ['/** @file',
+             '  GPIO PADCFG image generated by %s from %s in %s.' % (__prog__, Options.TableName,
+                                                                     os.path.basename(Options.InputFile)),
+             '  Do not edit, regenerate the image when the GPIO table changes.',
+             '',
+             '  SPDX-License-Identifier: BSD-2-Clause-Patent',
+             '**/',
+             '',
+             'GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT32 %s[] = {' % ArrayName]
+    for Index in range(0, len(Words), 6):
+        Lines.append('  ' + ', '.join('0x%08X' % Word for Word in Words[Index:Index + 6]) + ',')
+    Lines.append('};')
+    with open(FileName, 'w') as Fd:
+        Fd.write('\n'.join(Lines) + '\n')
+
+
+# Tool entrance method
+def Main():
+    Options = MyOptionParser()
+    CheckOptions(Options)
+    Headers = [os.path.join(Options.SiliconPkg, File) for File in _SiliconHeaders]
+    for File in Headers:
+        if not os.path.isfile(File):
+            EdkLogger(__prog__, FILE_NOT_FOUND, ExtraData=File)
+    Defines = CollectDefines(Headers + Options.Includes + [Options.InputFile])
+    D = DefineValues(Defines)
+    ChipsetId = Evaluate(Options.ChipsetId, Defines)
+    DswGroup = Evaluate(Options.DswGroup, Defines)
+
+    GroupInfo = ReadGroupInfo(os.path.join(Options.SiliconPkg, _GroupInfoSource), Options.GroupTable, Defines)
+    Table = ReadGpioTable(Options.InputFile, Options.TableName, Defines)
+    Image = BuildImage(Table, GroupInfo, ChipsetId, DswGroup, D)
+    Data = PackImage(Image, ChipsetId)
+
+    if Options.Verbose:
+        for Pid, GroupDwList, Registers in Image:
+            print('Community PID 0x%02X: %d group DWs, %d registers' % (Pid, len(GroupDwList), len(Registers)))
+            for Offset, Mask, Value in Registers:
+                print('  0x%04X: mask 0x%08X value 0x%08X' % (Offset, Mask, Value))
+        print('%d pads, %d bytes' % (len(Table), len(Data)))
+
+    if Options.OutputFile:
+        with open(Options.OutputFile, 'wb') as Fd:
+            Fd.write(Data)
+    if Options.OutputHeaderFile:
+        WriteHeaderFile(Options.OutputHeaderFile, Options.ArrayName, Data, Options)
+    return 0
+
+
+if __name__ == '__main__':
+    r = Main()
+    ## 0-127 is a safe return range, and 1 is a standard default error
+    if r < 0 or r > 127: r = 1
+    sys.exit(r)
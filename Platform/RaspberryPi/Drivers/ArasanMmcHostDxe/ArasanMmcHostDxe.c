@@ -18,6 +18,24 @@ UINT32 LastExecutedCommand = (UINT32) -1;
 STATIC RASPBERRY_PI_FIRMWARE_PROTOCOL *mFwProtocol;
 STATIC UINTN mMmcHsBase;
 
+//
+// SDMA state for the block transfer set up by MMCPrepareDataTransfer.
+// mDmaMapping is non-NULL between the prepare call and the end of the
+// following ReadBlockData/WriteBlockData (or a failed SendCommand).
+//
+STATIC BOOLEAN mDmaSupported;
+STATIC VOID *mDmaMapping;
+STATIC EFI_PHYSICAL_ADDRESS mDmaDeviceAddress;
+STATIC UINT32 mDmaBlockCount;
+
+//
+// emmc2 view of system memory: SYSADDR = CPU address + mDmaBusOffset, for
+// CPU addresses below mDmaBusLimit. This depends on the BCM2711 revision,
+// not on the PcdDmaDeviceOffset the DmaLib applies for the legacy DMA masters.
+//
+STATIC UINT64 mDmaBusOffset;
+STATIC UINT64 mDmaBusLimit;
+
 STATIC
 UINT32
 EFIAPI
@@ -236,6 +254,84 @@ SoftReset (
   return EFI_SUCCESS;
 }
 
+STATIC
+VOID
+ReleaseDmaTransfer (
+  VOID
+  )
+{
+  if (mDmaMapping != NULL) {
+    DmaUnmap (mDmaMapping);
+    mDmaMapping = NULL;
+  }
+}
+
+/**
+   Waits for an SDMA transfer started by MMCSendCommand to complete,
+   restarting it at every SDMA buffer boundary.
+**/
+STATIC
+EFI_STATUS
+WaitForDmaTransfer (
+  IN UINTN Length
+  )
+{
+  UINTN MmcStatus;
+  UINTN RetryCount;
+  EFI_PHYSICAL_ADDRESS NextAddress;
+  EFI_STATUS Status;
+
+  mFwProtocol->SetLed (TRUE);
+
+  NextAddress = mDmaDeviceAddress;
+  MmcStatus = 0;
+  RetryCount = 0;
+  Status = EFI_TIMEOUT;
+  while (RetryCount < MAX_RETRY_COUNT) {
+    MmcStatus = MmioRead32 (MMCHS_INT_STAT);
+    if ((MmcStatus & ERRI) != 0) {
+      DEBUG ((DEBUG_ERROR, "%a(%u): ERRI MmcStatus 0x%x\n",
+        __func__, __LINE__, MmcStatus));
+      SoftReset (SRD);
+      Status = EFI_DEVICE_ERROR;
+      break;
+    }
+
+    if ((MmcStatus & TC) != 0) {
+      SdMmioWrite32 (MMCHS_INT_STAT, TC | DINT);
+      Status = EFI_SUCCESS;
+      break;
+    }
+
+    if ((MmcStatus & DINT) != 0) {
+      //
+      // The controller paused at an SDMA buffer boundary, and resumes
+      // once the address of the next buffer is written.
+      //
+      NextAddress = (NextAddress & ~((EFI_PHYSICAL_ADDRESS)SDMA_BOUNDARY_SIZE - 1)) +
+                    SDMA_BOUNDARY_SIZE;
+      SdMmioWrite32 (MMCHS_INT_STAT, DINT);
+      SdMmioWrite32 (MMCHS_SYSADDR, (UINT32)NextAddress);
+      RetryCount = 0;
+      continue;
+    }
+
+    gBS->Stall (STALL_AFTER_RETRY_US);
+    RetryCount++;
+  }
+
+  mFwProtocol->SetLed (FALSE);
+
+  if (Status == EFI_TIMEOUT) {
+    DEBUG ((DEBUG_ERROR, "%a(%u): %lu bytes, MMCHS_INT_STAT: %08x\n",
+      __func__, __LINE__, Length, MmcStatus));
+    SoftReset (SRD);
+  }
+
+  ReleaseDmaTransfer ();
+  return Status;
+}
+
 /**
    Calculate the clock divisor
 **/
@@ -339,6 +435,7 @@ MMCSendCommand (
   BOOLEAN IsAppCmd = (LastExecutedCommand == CMD55);
   BOOLEAN IsDATCmd = FALSE;
   BOOLEAN IsADTCCmd = FALSE;
+  UINT32 TransferMode = 0;
 
   DEBUG ((DEBUG_MMCHOST_SD, "ArasanMMCHost: MMCSendCommand(MmcCmd: %08x, Argument: %08x)\n", MmcCmd, Argument));
 
@@ -348,6 +445,7 @@ MMCSendCommand (
 
   MmcCmd = TranslateCommand (MmcCmd, Argument);
   if (MmcCmd == 0xffffffff) {
+    ReleaseDmaTransfer ();
     return EFI_UNSUPPORTED;
   }
 
@@ -387,10 +485,24 @@ MMCSendCommand (
     SdMmioWrite32 (MMCHS_BLK, 8);
   } else if (!IsAppCmd && MmcCmd == CMD6) {
     SdMmioWrite32 (MMCHS_BLK, 64);
+  } else if (IsADTCCmd && mDmaMapping != NULL &&
+             (MmcCmd == CMD17 || MmcCmd == CMD18 ||
+              MmcCmd == CMD24 || MmcCmd == CMD25)) {
+    SdMmioWrite32 (MMCHS_SYSADDR, (UINT32)mDmaDeviceAddress);
+    SdMmioWrite32 (MMCHS_BLK, BLEN_512BYTES | SDMA_BOUNDARY_512K |
+      (mDmaBlockCount << BLOCK_COUNT_SHIFT));
+    TransferMode = DE_ENABLE | BCE_ENABLE;
   } else if (IsADTCCmd) {
     SdMmioWrite32 (MMCHS_BLK, BLEN_512BYTES);
   }
 
+  if (TransferMode == 0) {
+    //
+    // A DMA transfer was prepared but not used by this command.
+    //
+    ReleaseDmaTransfer ();
+  }
+
   // Set Data timeout counter value to max value.
   SdMmioAndThenOr32 (MMCHS_SYSCTL, (UINT32) ~DTO_MASK, DTO_VAL);
 
@@ -404,7 +516,7 @@ MMCSendCommand (
   SdMmioWrite32 (MMCHS_ARG, Argument);
 
   // Send the command
-  SdMmioWrite32 (MMCHS_CMD, MmcCmd);
+  SdMmioWrite32 (MMCHS_CMD, MmcCmd | TransferMode);
 
   // Check for the command status.
   while (RetryCount < MAX_RETRY_COUNT) {
@@ -449,6 +561,7 @@ MMCSendCommand (
 
 Exit:
   if (EFI_ERROR (Status)) {
+    ReleaseDmaTransfer ();
     LastExecutedCommand = (UINT32) -1;
   } else {
     LastExecutedCommand = MmcCmd;
@@ -514,6 +627,9 @@ MMCNotifyState (
 
       DEBUG ((DEBUG_MMCHOST_SD, "ArasanMMCHost: AC12 %X HCTL %X\n", MmioRead32(MMCHS_AC12),MmioRead32(MMCHS_HCTL)));
 
+      // Select SDMA for DMA transfers
+      SdMmioAndThenOr32 (MMCHS_HCTL, (UINT32) ~DMAS_MASK, DMAS_SDMA);
+
       // Enable interrupts
       SdMmioWrite32 (MMCHS_IE, ALL_EN);
     }
@@ -703,6 +819,10 @@ MMCReadBlockData (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (mDmaMapping != NULL) {
+    return WaitForDmaTransfer (Length);
+  }
+
   RemLength = Length;
   while (RemLength != 0) {
     UINTN RetryCount = 0;
@@ -767,6 +887,10 @@ MMCWriteBlockData (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (mDmaMapping != NULL) {
+    return WaitForDmaTransfer (Length);
+  }
+
   RemLength = Length;
   while (RemLength != 0) {
     UINTN RetryCount = 0;
@@ -814,6 +938,52 @@ MMCIsMultiBlock (
   return TRUE;
 }
 
+EFI_STATUS
+EFIAPI
+MMCPrepareDataTransfer (
+  IN EFI_MMC_HOST_PROTOCOL    *This,
+  IN BOOLEAN                  IsRead,
+  IN UINTN                    Length,
+  IN VOID                     *Buffer
+  )
+{
+  EFI_STATUS           Status;
+  UINTN                MappedLength;
+  EFI_PHYSICAL_ADDRESS CpuAddress;
+
+  ReleaseDmaTransfer ();
+
+  if (!mDmaSupported ||
+      Length == 0 ||
+      Length % BLEN_512BYTES != 0 ||
+      Length / BLEN_512BYTES > MAX_UINT16) {
+    return EFI_UNSUPPORTED;
+  }
+
+  MappedLength = Length;
+  Status = DmaMap (IsRead ? MapOperationBusMasterWrite : MapOperationBusMasterRead,
+             Buffer, &MappedLength, &mDmaDeviceAddress, &mDmaMapping);
+  if (EFI_ERROR (Status)) {
+    mDmaMapping = NULL;
+    return Status;
+  }
+
+  //
+  // DmaMap returns an address for the legacy DMA masters. Translate it to
+  // what emmc2 expects. SDMA only takes a 32-bit system address.
+  //
+  CpuAddress = mDmaDeviceAddress - FixedPcdGet64 (PcdDmaDeviceOffset);
+  if (MappedLength != Length ||
+      CpuAddress + Length > mDmaBusLimit) {
+    ReleaseDmaTransfer ();
+    return EFI_UNSUPPORTED;
+  }
+  mDmaDeviceAddress = CpuAddress + mDmaBusOffset;
+
+  mDmaBlockCount = (UINT32)(Length / BLEN_512BYTES);
+  return EFI_SUCCESS;
+}
+
 EFI_MMC_HOST_PROTOCOL gMMCHost =
 {
   MMC_HOST_PROTOCOL_REVISION,
@@ -826,7 +996,8 @@ EFI_MMC_HOST_PROTOCOL gMMCHost =
   MMCReadBlockData,
   MMCWriteBlockData,
   NULL,
-  MMCIsMultiBlock
+  MMCIsMultiBlock,
+  MMCPrepareDataTransfer
 };
 
 EFI_STATUS
@@ -858,6 +1029,29 @@ MMCInitialize (
     return Status;
   }
 
+  //
+  // Only use SDMA on emmc2. The legacy Arasan controller is left on PIO,
+  // as it is by the OS drivers.
+  //
+  mDmaSupported = mMmcHsBase == MMCHS2_BASE &&
+                  PcdGet32 (PcdMmcDisableDma) == 0 &&
+                  (MmioRead32 (MMCHS_CAPA) & SDMA_SUPPORT) != 0;
+  if (mDmaSupported) {
+    //
+    // BCM2711 before C0 only reaches the low 1GB of memory, through the
+    // 0xC0000000 bus alias. C0 and later see memory untranslated.
+    //
+    if ((MmioRead32 (ID_CHIPREV) & 0xFF) >= 0x20) {
+      mDmaBusOffset = 0;
+      mDmaBusLimit = SIZE_4GB;
+    } else {
+      mDmaBusOffset = BCM2836_DMA_DEVICE_OFFSET;
+      mDmaBusLimit = SIZE_1GB;
+    }
+  }
+  DEBUG ((DEBUG_INFO, "ArasanMMCHost: using %a for block transfers\n",
+    mDmaSupported ? "SDMA" : "PIO"));
+
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &Handle,
                   &gRaspberryPiMmcHostProtocolGuid,
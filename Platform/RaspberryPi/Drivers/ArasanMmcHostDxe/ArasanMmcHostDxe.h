@@ -30,6 +30,7 @@
 #include <IndustryStandard/Bcm2836.h>
 #include <IndustryStandard/Bcm2836Sdio.h>
 #include <IndustryStandard/RpiMbox.h>
+#include <IndustryStandard/Bcm2711.h>
 
 #define MAX_RETRY_COUNT (1000 * 20)
 
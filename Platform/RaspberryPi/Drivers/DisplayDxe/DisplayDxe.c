@@ -20,11 +20,17 @@
 #define JUST_NATIVE_ENABLED   MODE_NATIVE_ENABLED
 #define ALL_MODES             (BIT6 - 1)
 #define POS_TO_FB(posX, posY) ((UINT8*)                                 \
-                               ((UINTN)This->Mode->FrameBufferBase +    \
+                               (FbBase +                                \
                                 (posY) * This->Mode->Info->PixelsPerScanLine * \
                                 PI3_BYTES_PER_PIXEL +                   \
                                 (posX) * PI3_BYTES_PER_PIXEL))
 
+//
+// Dirty spans are widened to this many pixels (16 bytes) so that the
+// flush only ever issues full-width stores to the framebuffer.
+//
+#define SHADOW_FLUSH_ALIGN    4
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -106,11 +112,28 @@ typedef struct {
   UINT32 Height;
 } GOP_MODE_DATA;
 
+//
+// Cached copy of the framebuffer. All Blt operations go through it, so
+// reads never touch the (write-through) VideoCore framebuffer. Modified
+// spans are tracked per scanline and copied out by DisplayFlushShadow ().
+//
+typedef struct {
+  UINT8     *Buffer;
+  UINTN     Pages;
+  UINT32    *DirtyStart;
+  UINT32    *DirtyEnd;
+  UINTN     DirtyFirstLine;
+  UINTN     DirtyLastLine;
+  EFI_EVENT FlushEvent;
+  EFI_EVENT ExitBootServicesEvent;
+} DISPLAY_SHADOW_FB;
+
 STATIC UINT32 mBootWidth;
 STATIC UINT32 mBootHeight;
 STATIC EFI_HANDLE mDevice;
 STATIC RASPBERRY_PI_FIRMWARE_PROTOCOL *mFwProtocol;
 STATIC EFI_CPU_ARCH_PROTOCOL *mCpu;
+STATIC DISPLAY_SHADOW_FB mShadow;
 
 STATIC UINTN mLastMode;
 STATIC GOP_MODE_DATA mGopModeTemplate[] = {
@@ -200,6 +223,198 @@ DisplayQueryMode (
   return EFI_SUCCESS;
 }
 
+/**
+   Mark a rectangle of the shadow framebuffer as modified.
+
+   Must be called at TPL_NOTIFY.
+
+   @param  X        Left edge of the rectangle.
+   @param  Y        Top edge of the rectangle.
+   @param  Width    Width of the rectangle.
+   @param  Height   Height of the rectangle.
+
+**/
+STATIC
+VOID
+DisplayMarkShadowDirty (
+  IN  UINTN X,
+  IN  UINTN Y,
+  IN  UINTN Width,
+  IN  UINTN Height
+  )
+{
+  UINTN Line;
+
+  for (Line = Y; Line < Y + Height; Line++) {
+    mShadow.DirtyStart[Line] = (UINT32)MIN (mShadow.DirtyStart[Line], X);
+    mShadow.DirtyEnd[Line] = (UINT32)MAX (mShadow.DirtyEnd[Line], X + Width);
+  }
+
+  if (mShadow.DirtyFirstLine == mShadow.DirtyLastLine) {
+    mShadow.DirtyFirstLine = Y;
+    mShadow.DirtyLastLine = Y + Height;
+  } else {
+    mShadow.DirtyFirstLine = MIN (mShadow.DirtyFirstLine, Y);
+    mShadow.DirtyLastLine = MAX (mShadow.DirtyLastLine, Y + Height);
+  }
+}
+
+/**
+   Copy all the modified spans of the shadow framebuffer to the VideoCore
+   framebuffer.
+
+   @param  This     The GOP instance.
+
+**/
+STATIC
+VOID
+DisplayFlushShadow (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL *This
+  )
+{
+  EFI_TPL OldTpl;
+  UINTN   Line;
+  UINTN   Start;
+  UINTN   End;
+  UINTN   Offset;
+
+  if (mShadow.Buffer == NULL) {
+    return;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  for (Line = mShadow.DirtyFirstLine; Line < mShadow.DirtyLastLine; Line++) {
+    if (mShadow.DirtyEnd[Line] == 0) {
+      continue;
+    }
+
+    Start = mShadow.DirtyStart[Line] & ~(SHADOW_FLUSH_ALIGN - 1);
+    End = MIN (ALIGN_VALUE (mShadow.DirtyEnd[Line], SHADOW_FLUSH_ALIGN),
+            This->Mode->Info->PixelsPerScanLine);
+    Offset = (Line * This->Mode->Info->PixelsPerScanLine + Start) *
+               PI3_BYTES_PER_PIXEL;
+
+    CopyMem ((VOID*)(UINTN)(This->Mode->FrameBufferBase + Offset),
+      mShadow.Buffer + Offset, (End - Start) * PI3_BYTES_PER_PIXEL);
+
+    mShadow.DirtyStart[Line] = MAX_UINT32;
+    mShadow.DirtyEnd[Line] = 0;
+  }
+
+  mShadow.DirtyFirstLine = 0;
+  mShadow.DirtyLastLine = 0;
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+STATIC
+VOID
+EFIAPI
+DisplayFlushShadowOnTimer (
+  IN  EFI_EVENT Event,
+  IN  VOID      *Context
+  )
+{
+  DisplayFlushShadow (&gDisplayProto);
+}
+
+/**
+   Flush and release the shadow framebuffer of the current mode.
+
+   @param  This     The GOP instance.
+
+**/
+STATIC
+VOID
+DisplayFreeShadow (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL *This
+  )
+{
+  EFI_TPL OldTpl;
+  UINT8   *Buffer;
+
+  if (mShadow.Buffer == NULL) {
+    return;
+  }
+
+  DisplayFlushShadow (This);
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  Buffer = mShadow.Buffer;
+  mShadow.Buffer = NULL;
+  gBS->RestoreTPL (OldTpl);
+
+  FreePages (Buffer, mShadow.Pages);
+  FreePool (mShadow.DirtyStart);
+  FreePool (mShadow.DirtyEnd);
+  mShadow.DirtyStart = NULL;
+  mShadow.DirtyEnd = NULL;
+}
+
+/**
+   Allocate a shadow framebuffer for the current mode. On failure, Blt
+   operations keep going straight to the VideoCore framebuffer.
+
+   @param  This     The GOP instance.
+
+**/
+STATIC
+VOID
+DisplayAllocShadow (
+  IN  EFI_GRAPHICS_OUTPUT_PROTOCOL *This
+  )
+{
+  UINTN Lines;
+  UINTN Index;
+
+  Lines = This->Mode->Info->VerticalResolution;
+  mShadow.Pages = EFI_SIZE_TO_PAGES (This->Mode->FrameBufferSize);
+  mShadow.DirtyStart = AllocatePool (Lines * sizeof (UINT32));
+  mShadow.DirtyEnd = AllocateZeroPool (Lines * sizeof (UINT32));
+  mShadow.Buffer = AllocatePages (mShadow.Pages);
+  if (mShadow.Buffer == NULL || mShadow.DirtyStart == NULL ||
+      mShadow.DirtyEnd == NULL) {
+    DEBUG ((DEBUG_WARN, "Couldn't allocate shadow framebuffer, not using it\n"));
+    if (mShadow.Buffer != NULL) {
+      FreePages (mShadow.Buffer, mShadow.Pages);
+      mShadow.Buffer = NULL;
+    }
+    if (mShadow.DirtyStart != NULL) {
+      FreePool (mShadow.DirtyStart);
+      mShadow.DirtyStart = NULL;
+    }
+    if (mShadow.DirtyEnd != NULL) {
+      FreePool (mShadow.DirtyEnd);
+      mShadow.DirtyEnd = NULL;
+    }
+    return;
+  }
+
+  for (Index = 0; Index < Lines; Index++) {
+    mShadow.DirtyStart[Index] = MAX_UINT32;
+  }
+  mShadow.DirtyFirstLine = 0;
+  mShadow.DirtyLastLine = 0;
+}
+
+STATIC
+VOID
+EFIAPI
+DisplayShadowOnExitBootServices (
+  IN  EFI_EVENT Event,
+  IN  VOID      *Context
+  )
+{
+  //
+  // The OS takes over the framebuffer from here on, so it must be up to
+  // date. Don't free anything, as memory services are no longer usable.
+  //
+  gBS->SetTimer (mShadow.FlushEvent, TimerCancel, 0);
+  DisplayFlushShadow (&gDisplayProto);
+  mShadow.Buffer = NULL;
+}
+
 STATIC
 VOID
 ClearScreen (
@@ -238,6 +453,7 @@ DisplaySetMode (
 
   DEBUG ((DEBUG_INFO, "Setting mode %u from %u: %u x %u\n",
     ModeNumber, This->Mode->Mode, Mode->Width, Mode->Height));
+  DisplayFreeShadow (This);
   Status = mFwProtocol->GetFB (Mode->Width, Mode->Height,
                           PI3_BITS_PER_PIXEL, &FbBase,
                           &FbSize, &FbPitch);
@@ -282,6 +498,10 @@ DisplaySetMode (
   This->Mode->FrameBufferSize = Mode->Width * Mode->Height * PI3_BYTES_PER_PIXEL;
   DEBUG((DEBUG_INFO, "Reported Mode->FrameBufferSize is %u\n", This->Mode->FrameBufferSize));
 
+  if (mShadow.FlushEvent != NULL) {
+    DisplayAllocShadow (This);
+  }
+
   ClearScreen (This);
   return EFI_SUCCESS;
 }
@@ -304,6 +524,9 @@ DisplayBlt (
 {
   UINT8 *VidBuf, *BltBuf, *VidBuf1;
   UINTN i;
+  UINTN FbBase;
+  EFI_TPL OldTpl;
+  BOOLEAN TplRaised;
 
   if ((UINTN)BltOperation >= EfiGraphicsOutputBltOperationMax) {
     return EFI_INVALID_PARAMETER;
@@ -313,6 +536,39 @@ DisplayBlt (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (BltOperation == EfiBltVideoToBltBuffer ||
+      BltOperation == EfiBltVideoToVideo) {
+    if (SourceX + Width > This->Mode->Info->HorizontalResolution ||
+        SourceY + Height > This->Mode->Info->VerticalResolution) {
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  if (BltOperation != EfiBltVideoToBltBuffer) {
+    if (DestinationX + Width > This->Mode->Info->HorizontalResolution ||
+        DestinationY + Height > This->Mode->Info->VerticalResolution) {
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  //
+  // Keep the flush timer from seeing a half-updated shadow buffer. Without
+  // a shadow buffer there is nothing to protect, so the Blt runs at the
+  // caller's TPL.
+  //
+  OldTpl = TPL_APPLICATION;
+  TplRaised = FALSE;
+  if (mShadow.Buffer != NULL) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    TplRaised = TRUE;
+  }
+
+  if (mShadow.Buffer != NULL) {
+    FbBase = (UINTN)mShadow.Buffer;
+  } else {
+    FbBase = (UINTN)This->Mode->FrameBufferBase;
+  }
+
   switch (BltOperation) {
   case EfiBltVideoFill:
     BltBuf = (UINT8*)BltBuffer;
@@ -363,10 +619,20 @@ DisplayBlt (
     break;
 
   default:
+    if (TplRaised) {
+      gBS->RestoreTPL (OldTpl);
+    }
     return EFI_INVALID_PARAMETER;
     break;
   }
 
+  if (mShadow.Buffer != NULL && BltOperation != EfiBltVideoToBltBuffer) {
+    DisplayMarkShadowDirty (DestinationX, DestinationY, Width, Height);
+  }
+
+  if (TplRaised) {
+    gBS->RestoreTPL (OldTpl);
+  }
   return EFI_SUCCESS;
 }
 
@@ -578,6 +844,33 @@ DriverStart (
     ASSERT (FbSize != 0);
   }
 
+  if (PcdGet32 (PcdDisplayShadowFbFlushPeriod) != 0) {
+    Status = gBS->CreateEvent (EVT_TIMER | EVT_NOTIFY_SIGNAL, TPL_NOTIFY,
+                    DisplayFlushShadowOnTimer, NULL, &mShadow.FlushEvent);
+    if (!EFI_ERROR (Status)) {
+      Status = gBS->CreateEventEx (EVT_NOTIFY_SIGNAL, TPL_NOTIFY,
+                      DisplayShadowOnExitBootServices, NULL,
+                      &gEfiEventExitBootServicesGuid,
+                      &mShadow.ExitBootServicesEvent);
+    }
+    if (!EFI_ERROR (Status)) {
+      Status = gBS->SetTimer (mShadow.FlushEvent, TimerPeriodic,
+                      EFI_TIMER_PERIOD_MILLISECONDS (
+                        PcdGet32 (PcdDisplayShadowFbFlushPeriod)));
+    }
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_WARN, "Couldn't set up shadow framebuffer: %r\n", Status));
+      if (mShadow.ExitBootServicesEvent != NULL) {
+        gBS->CloseEvent (mShadow.ExitBootServicesEvent);
+        mShadow.ExitBootServicesEvent = NULL;
+      }
+      if (mShadow.FlushEvent != NULL) {
+        gBS->CloseEvent (mShadow.FlushEvent);
+        mShadow.FlushEvent = NULL;
+      }
+    }
+  }
+
   // Both set the mode and initialize current mode information.
   gDisplayProto.Mode->MaxMode = mLastMode + 1;
   DisplaySetMode (&gDisplayProto, 0);
@@ -598,6 +891,14 @@ DriverStart (
 Done:
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Could not start DisplayDxe: %r\n", Status));
+    if (mShadow.FlushEvent != NULL) {
+      gBS->CloseEvent (mShadow.FlushEvent);
+      gBS->CloseEvent (mShadow.ExitBootServicesEvent);
+      mShadow.FlushEvent = NULL;
+      mShadow.ExitBootServicesEvent = NULL;
+      DisplayFreeShadow (&gDisplayProto);
+    }
+
     if (gDisplayProto.Mode->Info != NULL) {
       FreePool (gDisplayProto.Mode->Info);
       gDisplayProto.Mode->Info = NULL;
@@ -639,6 +940,14 @@ DriverStop (
     return Status;
   }
 
+  if (mShadow.FlushEvent != NULL) {
+    gBS->CloseEvent (mShadow.FlushEvent);
+    gBS->CloseEvent (mShadow.ExitBootServicesEvent);
+    mShadow.FlushEvent = NULL;
+    mShadow.ExitBootServicesEvent = NULL;
+  }
+  DisplayFreeShadow (&gDisplayProto);
+
   FreePool (gDisplayProto.Mode->Info);
   gDisplayProto.Mode->Info = NULL;
   FreePool (gDisplayProto.Mode);
@@ -48,6 +48,11 @@
 #define STATUS_BLUE   0x00, 0x00, 0xff
 #define STATUS_RED    0xff, 0x00, 0x00
 
+/*
+ * Number of full-screen Blt calls timed per operation by the benchmark.
+ */
+#define BENCHMARK_ITERATIONS 16
+
 EFI_STATUS
 ShowStatus (
   IN EFI_GRAPHICS_OUTPUT_PROTOCOL *GraphicsOutput,
@@ -248,6 +253,97 @@ Done:
   }
 }
 
+STATIC
+VOID
+RunBltBenchmark (
+  VOID
+  )
+{
+  EFI_GRAPHICS_OUTPUT_PROTOCOL *GraphicsOutput = &gDisplayProto;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Image = NULL;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *Backup = NULL;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL Fill;
+  EFI_GRAPHICS_OUTPUT_BLT_OPERATION Op;
+  EFI_STATUS Status;
+  UINT32 ScreenWidth;
+  UINT32 ScreenHeight;
+  UINTN ImageSize;
+  UINTN Index;
+  UINT64 Start;
+  UINT64 Elapsed;
+  STATIC CONST CHAR8 *OpNames[] = {
+    "VideoFill", "VideoToBltBuffer", "BufferToVideo", "VideoToVideo"
+  };
+
+  ScreenWidth = GraphicsOutput->Mode->Info->HorizontalResolution;
+  ScreenHeight = GraphicsOutput->Mode->Info->VerticalResolution;
+  ImageSize = ScreenWidth * ScreenHeight * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+
+  Image = AllocateZeroPool (ImageSize);
+  Backup = AllocatePool (ImageSize);
+  if (Image == NULL || Backup == NULL) {
+    ShowStatus (GraphicsOutput, STATUS_RED);
+    goto Done;
+  }
+
+  Status = GraphicsOutput->Blt (GraphicsOutput, Backup,
+                             EfiBltVideoToBltBuffer, 0, 0, 0, 0,
+                             ScreenWidth, ScreenHeight, 0);
+  if (EFI_ERROR (Status)) {
+    ShowStatus (GraphicsOutput, STATUS_RED);
+    goto Done;
+  }
+
+  ZeroMem (&Fill, sizeof (Fill));
+  for (Op = EfiBltVideoFill; Op < EfiGraphicsOutputBltOperationMax; Op++) {
+    Start = GetPerformanceCounter ();
+    for (Index = 0; Index < BENCHMARK_ITERATIONS; Index++) {
+      switch (Op) {
+      case EfiBltVideoFill:
+        Fill.Blue = (UINT8)Index;
+        GraphicsOutput->Blt (GraphicsOutput, &Fill, Op, 0, 0, 0, 0,
+                          ScreenWidth, ScreenHeight, 0);
+        break;
+      case EfiBltVideoToVideo:
+        /*
+         * Scroll up by one line, as a text console would.
+         */
+        GraphicsOutput->Blt (GraphicsOutput, NULL, Op, 0, 1, 0, 0,
+                          ScreenWidth, ScreenHeight - 1, 0);
+        break;
+      default:
+        GraphicsOutput->Blt (GraphicsOutput, Image, Op, 0, 0, 0, 0,
+                          ScreenWidth, ScreenHeight, 0);
+        break;
+      }
+    }
+    Elapsed = GetTimeInNanoSecond (GetPerformanceCounter () - Start);
+
+    /*
+     * Bytes per nanosecond * 1000 is MB/s.
+     */
+    DEBUG ((DEBUG_INFO, "%a: %a: %lu us for %u iterations, %lu MB/s\n",
+      __func__, OpNames[Op], DivU64x32 (Elapsed, 1000), BENCHMARK_ITERATIONS,
+      Elapsed == 0 ? 0 :
+      DivU64x64Remainder (MultU64x32 (ImageSize, BENCHMARK_ITERATIONS * 1000),
+        Elapsed, NULL)));
+  }
+
+  GraphicsOutput->Blt (GraphicsOutput, Backup,
+                    EfiBltBufferToVideo, 0, 0, 0, 0,
+                    ScreenWidth, ScreenHeight, 0);
+  ShowStatus (GraphicsOutput, STATUS_GREEN);
+
+Done:
+  if (Image != NULL) {
+    FreePool (Image);
+  }
+
+  if (Backup != NULL) {
+    FreePool (Backup);
+  }
+}
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -259,6 +355,17 @@ ScreenshotKeyHandler (
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+EFIAPI
+BenchmarkKeyHandler (
+  IN EFI_KEY_DATA *KeyData
+  )
+{
+  RunBltBenchmark ();
+  return EFI_SUCCESS;
+}
+
 STATIC
 EFI_STATUS
 ProcessScreenshotHandler (
@@ -289,6 +396,21 @@ ProcessScreenshotHandler (
     return Status;
   }
 
+  /*
+   * LCtrl+LAlt+F11 runs the Blt benchmark.
+   */
+  ScreenshotKey.Key.ScanCode = SCAN_F11;
+  Status = SimpleTextInEx->RegisterKeyNotify (
+                             SimpleTextInEx,
+                             &ScreenshotKey,
+                             BenchmarkKeyHandler,
+                             &Handle
+                           );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: couldn't register key notification: %r\n", __func__, Status));
+    return Status;
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -223,6 +223,124 @@ DwCoreReset (
   return EFI_SUCCESS;
 }
 
+/*
+ * Host channels are handed out dynamically, so that transfers to
+ * independent endpoints (e.g. interrupt polling from the periodic
+ * handler and a bulk transfer it preempts) can proceed in parallel.
+ */
+STATIC
+EFI_STATUS
+DwHcAcquireChannel (
+  IN  DWUSB_OTGHC_DEV *DwHc,
+  OUT UINT32          *Channel
+  )
+{
+  EFI_TPL    PreviousTpl;
+  EFI_STATUS Status;
+  UINT32     Index;
+
+  Status = EFI_OUT_OF_RESOURCES;
+  PreviousTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  for (Index = 0; Index < DwHc->NumChannels; Index++) {
+    if (!DwHc->Channels[Index].InUse) {
+      DwHc->Channels[Index].InUse = TRUE;
+      *Channel = Index;
+      Status = EFI_SUCCESS;
+      break;
+    }
+  }
+  gBS->RestoreTPL (PreviousTpl);
+
+  return Status;
+}
+
+STATIC
+VOID
+DwHcReleaseChannel (
+  IN  DWUSB_OTGHC_DEV *DwHc,
+  IN  UINT32          Channel
+  )
+{
+  EFI_TPL PreviousTpl;
+
+  MmioWrite32 (DwHc->DwUsbBase + HCINTMSK (Channel), 0);
+  MmioWrite32 (DwHc->DwUsbBase + HCINT (Channel), 0xFFFFFFFF);
+
+  PreviousTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  ASSERT (DwHc->Channels[Channel].InUse);
+  DwHc->Channels[Channel].InUse = FALSE;
+  gBS->RestoreTPL (PreviousTpl);
+}
+
+STATIC
+VOID
+DwHcStartChannel (
+  IN  DWUSB_OTGHC_DEV                    *DwHc,
+  IN  UINT32                             Channel,
+  IN  EFI_USB2_HC_TRANSACTION_TRANSLATOR *Translator,
+  IN  UINT8                              DeviceSpeed,
+  IN  UINT8                              DeviceAddress,
+  IN  UINTN                              MaximumPacketLength,
+  IN  UINT32                             Pid,
+  IN  UINT32                             TransferDirection,
+  IN  UINT32                             TxferLen,
+  IN  UINT32                             NumPackets,
+  IN  UINT32                             EpAddress,
+  IN  UINT32                             EpType,
+  IN  SPLIT_CONTROL                      *Split
+  )
+{
+  MmioWrite32 (DwHc->DwUsbBase + HCDMA (Channel),
+    (UINTN)DwHc->Channels[Channel].BufferBusAddress);
+
+  DwOtgHcInit (DwHc, Channel, Translator, DeviceSpeed,
+    DeviceAddress, EpAddress,
+    TransferDirection, EpType,
+    MaximumPacketLength, Split);
+
+  MmioWrite32 (DwHc->DwUsbBase + HCTSIZ (Channel),
+    (TxferLen << DWC2_HCTSIZ_XFERSIZE_OFFSET) |
+    (NumPackets << DWC2_HCTSIZ_PKTCNT_OFFSET) |
+    (Pid << DWC2_HCTSIZ_PID_OFFSET));
+
+  MmioAndThenOr32 (DwHc->DwUsbBase + HCCHAR (Channel),
+    ~(DWC2_HCCHAR_MULTICNT_MASK |
+      DWC2_HCCHAR_CHEN |
+      DWC2_HCCHAR_CHDIS),
+      ((1 << DWC2_HCCHAR_MULTICNT_OFFSET) |
+        DWC2_HCCHAR_CHEN));
+}
+
+/*
+ * Disable a channel that did not halt by itself.
+ */
+STATIC
+EFI_STATUS
+DwHcAbortChannel (
+  IN  DWUSB_OTGHC_DEV *DwHc,
+  IN  EFI_EVENT       Timeout,
+  IN  UINT32          Channel
+  )
+{
+  EFI_STATUS Status;
+
+  MmioOr32 (DwHc->DwUsbBase + HCCHAR (Channel), DWC2_HCCHAR_CHDIS);
+  Status = gBS->SetTimer (Timeout, TimerRelative,
+                          EFI_TIMER_PERIOD_MILLISECONDS (1));
+  ASSERT_EFI_ERROR (Status);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+  Status = Wait4Bit (Timeout, DwHc->DwUsbBase + HCINT (Channel),
+                     DWC2_HCINT_CHHLTD, 1);
+  if (Status == EFI_SUCCESS) {
+    return EFI_TIMEOUT;
+  }
+
+  DEBUG ((DEBUG_ERROR, "Channel %u did not halt\n", Channel));
+  return EFI_DEVICE_ERROR;
+}
+
 STATIC
 EFI_STATUS
 DwHcTransfer (
@@ -252,7 +370,7 @@ DwHcTransfer (
   EFI_STATUS                      Status = EFI_SUCCESS;
   SPLIT_CONTROL                   Split = { 0 };
 
-  EFI_TPL Tpl = gBS->RaiseTPL (TPL_NOTIFY);
+  UINT8                           *Buffer = DwHc->Channels[Channel].Buffer;
 
   *TransferResult = EFI_USB_NOERROR;
 
@@ -288,50 +406,21 @@ DwHcTransfer (
     if (TransferDirection) { // in
       TxferLen = NumPackets * MaximumPacketLength;
     } else {
-      CopyMem (DwHc->AlignedBuffer, Data + Done, TxferLen);
+      CopyMem (Buffer, Data + Done, TxferLen);
       ArmDataSynchronizationBarrier ();
     }
 
   RestartChannel:
-    MmioWrite32 (DwHc->DwUsbBase + HCDMA (Channel),
-      (UINTN)DwHc->AlignedBufferBusAddress);
-
-    DwOtgHcInit (DwHc, Channel, Translator, DeviceSpeed,
-      DeviceAddress, EpAddress,
-      TransferDirection, EpType,
-      MaximumPacketLength, &Split);
-
-    MmioWrite32 (DwHc->DwUsbBase + HCTSIZ (Channel),
-      (TxferLen << DWC2_HCTSIZ_XFERSIZE_OFFSET) |
-      (NumPackets << DWC2_HCTSIZ_PKTCNT_OFFSET) |
-      (*Pid << DWC2_HCTSIZ_PID_OFFSET));
-
-    MmioAndThenOr32 (DwHc->DwUsbBase + HCCHAR (Channel),
-      ~(DWC2_HCCHAR_MULTICNT_MASK |
-        DWC2_HCCHAR_CHEN |
-        DWC2_HCCHAR_CHDIS),
-        ((1 << DWC2_HCCHAR_MULTICNT_OFFSET) |
-          DWC2_HCCHAR_CHEN));
+    DwHcStartChannel (DwHc, Channel, Translator, DeviceSpeed,
+      DeviceAddress, MaximumPacketLength, *Pid,
+      TransferDirection, TxferLen, NumPackets,
+      EpAddress, EpType, &Split);
 
     Ret = Wait4Chhltd (DwHc, Timeout, Channel, &Sub, Pid, IgnoreAck, &Split);
 
     if (Ret == XFER_NOT_HALTED) {
       *TransferResult = EFI_USB_ERR_TIMEOUT;
-      MmioOr32 (DwHc->DwUsbBase + HCCHAR (Channel), DWC2_HCCHAR_CHDIS);
-      Status = gBS->SetTimer (Timeout, TimerRelative,
-                              EFI_TIMER_PERIOD_MILLISECONDS (1));
-      ASSERT_EFI_ERROR (Status);
-      if (EFI_ERROR (Status)) {
-        break;
-      }
-      Status = Wait4Bit (Timeout, DwHc->DwUsbBase + HCINT (Channel),
-                         DWC2_HCINT_CHHLTD, 1);
-      if (Status == EFI_SUCCESS) {
-        Status = EFI_TIMEOUT;
-      } else {
-        DEBUG ((DEBUG_ERROR, "Channel %u did not halt\n", Channel));
-        Status = EFI_DEVICE_ERROR;
-      }
+      Status = DwHcAbortChannel (DwHc, Timeout, Channel);
       break;
     } else if (Ret == XFER_STALL) {
       *TransferResult = EFI_USB_ERR_STALL;
@@ -369,7 +458,7 @@ DwHcTransfer (
     if (TransferDirection) { // in
       ArmDataSynchronizationBarrier ();
       TxferLen -= Sub;
-      CopyMem (Data + Done, DwHc->AlignedBuffer, TxferLen);
+      CopyMem (Data + Done, Buffer, TxferLen);
       if (Sub) {
         StopTransfer = 1;
       }
@@ -383,7 +472,158 @@ DwHcTransfer (
 
   *DataLength = Done;
 
-  gBS->RestoreTPL (Tpl);
+  ASSERT (!EFI_ERROR (Status) || *TransferResult != EFI_USB_NOERROR);
+
+  return Status;
+}
+
+/*
+ * Largest bulk chunk that fits in one channel's transfer size register
+ * and DMA buffer, in whole packets.
+ */
+STATIC
+UINT32
+DwHcBulkChunkSize (
+  IN  UINTN MaximumPacketLength
+  )
+{
+  UINT32 NumPackets;
+
+  NumPackets = MIN (DWC2_MAX_TRANSFER_SIZE, DWC2_DATA_BUF_SIZE) / MaximumPacketLength;
+  NumPackets = MIN (NumPackets, DWC2_MAX_PACKET_COUNT);
+  return NumPackets * MaximumPacketLength;
+}
+
+/*
+ * High-speed bulk transfer chained across two channels. While one
+ * channel moves a chunk on the bus, the CPU fills (OUT) or drains (IN)
+ * the DMA buffer of the other one, so the copies through the bounce
+ * buffers overlap with the bus transfers. The next chunk is only
+ * started once the previous one completed, as it needs its data toggle.
+ */
+STATIC
+EFI_STATUS
+DwHcBulkTransferChained (
+  IN      DWUSB_OTGHC_DEV        *DwHc,
+  IN      EFI_EVENT              Timeout,
+  IN      UINT32                 *Channels,
+  IN      UINT8                  DeviceAddress,
+  IN      UINTN                  MaximumPacketLength,
+  IN  OUT UINT32                 *Pid,
+  IN      UINT32                 TransferDirection,
+  IN  OUT VOID                   *Data,
+  IN  OUT UINTN                  *DataLength,
+  IN      UINT32                 EpAddress,
+  OUT     UINT32                 *TransferResult
+  )
+{
+  UINT32                          ChunkMax;
+  UINT32                          ChunkLen[2];
+  UINT32                          TxferLen[2];
+  UINT32                          NumPackets[2];
+  UINTN                           Done = 0;
+  UINTN                           Queued;
+  UINT32                          Active = 0;
+  UINT32                          Next;
+  UINT32                          Sub;
+  UINT32                          Received;
+  UINT32                          Ret;
+  BOOLEAN                         Started;
+  EFI_STATUS                      Status = EFI_SUCCESS;
+  SPLIT_CONTROL                   Split = { 0 };
+
+  *TransferResult = EFI_USB_NOERROR;
+  ChunkMax = DwHcBulkChunkSize (MaximumPacketLength);
+
+  ChunkLen[Active] = (UINT32)MIN (*DataLength, ChunkMax);
+  if (!TransferDirection) {
+    CopyMem (DwHc->Channels[Channels[Active]].Buffer, Data, ChunkLen[Active]);
+    ArmDataSynchronizationBarrier ();
+  }
+  Queued = ChunkLen[Active];
+
+  NumPackets[Active] = (ChunkLen[Active] + MaximumPacketLength - 1) / MaximumPacketLength;
+  TxferLen[Active] = TransferDirection ?
+                     NumPackets[Active] * MaximumPacketLength : ChunkLen[Active];
+  DwHcStartChannel (DwHc, Channels[Active], NULL, EFI_USB_SPEED_HIGH,
+    DeviceAddress, MaximumPacketLength, *Pid, TransferDirection,
+    TxferLen[Active], NumPackets[Active], EpAddress,
+    DWC2_HCCHAR_EPTYPE_BULK, &Split);
+
+  for (;;) {
+    Next = Active ^ 1;
+    ChunkLen[Next] = (UINT32)MIN (*DataLength - Queued, ChunkMax);
+
+    if (!TransferDirection && ChunkLen[Next] != 0) {
+      CopyMem (DwHc->Channels[Channels[Next]].Buffer, Data + Queued, ChunkLen[Next]);
+      ArmDataSynchronizationBarrier ();
+    }
+
+    Ret = Wait4Chhltd (DwHc, Timeout, Channels[Active], &Sub, Pid, TRUE, &Split);
+    if (Ret == XFER_FRMOVRUN) {
+      DwHcStartChannel (DwHc, Channels[Active], NULL, EFI_USB_SPEED_HIGH,
+        DeviceAddress, MaximumPacketLength, *Pid, TransferDirection,
+        TxferLen[Active], NumPackets[Active], EpAddress,
+        DWC2_HCCHAR_EPTYPE_BULK, &Split);
+      continue;
+    } else if (Ret == XFER_NOT_HALTED) {
+      *TransferResult = EFI_USB_ERR_TIMEOUT;
+      Status = DwHcAbortChannel (DwHc, Timeout, Channels[Active]);
+      break;
+    } else if (Ret == XFER_STALL) {
+      *TransferResult = EFI_USB_ERR_STALL;
+      Status = EFI_DEVICE_ERROR;
+      break;
+    } else if (Ret == XFER_NAK) {
+      *TransferResult = EFI_USB_ERR_NAK;
+      Status = EFI_DEVICE_ERROR;
+      break;
+    } else if (Ret != XFER_DONE) {
+      *TransferResult =
+        EFI_USB_ERR_CRC |
+        EFI_USB_ERR_TIMEOUT |
+        EFI_USB_ERR_BITSTUFF |
+        EFI_USB_ERR_SYSTEM;
+      Status = EFI_DEVICE_ERROR;
+      break;
+    }
+
+    Received = TxferLen[Active] - Sub;
+
+    //
+    // Kick off the next chunk before draining this one, unless the
+    // device ended the transfer with a short packet.
+    //
+    Started = FALSE;
+    if (ChunkLen[Next] != 0 && (!TransferDirection || Sub == 0)) {
+      NumPackets[Next] = (ChunkLen[Next] + MaximumPacketLength - 1) / MaximumPacketLength;
+      TxferLen[Next] = TransferDirection ?
+                       NumPackets[Next] * MaximumPacketLength : ChunkLen[Next];
+      DwHcStartChannel (DwHc, Channels[Next], NULL, EFI_USB_SPEED_HIGH,
+        DeviceAddress, MaximumPacketLength, *Pid, TransferDirection,
+        TxferLen[Next], NumPackets[Next], EpAddress,
+        DWC2_HCCHAR_EPTYPE_BULK, &Split);
+      Started = TRUE;
+    }
+
+    if (TransferDirection) {
+      ArmDataSynchronizationBarrier ();
+      Received = MIN (Received, ChunkLen[Active]);
+      CopyMem (Data + Done, DwHc->Channels[Channels[Active]].Buffer, Received);
+      Done += Received;
+    } else {
+      Done += ChunkLen[Active];
+    }
+
+    if (!Started) {
+      break;
+    }
+
+    Queued += ChunkLen[Next];
+    Active = Next;
+  }
+
+  *DataLength = Done;
 
   ASSERT (!EFI_ERROR (Status) || *TransferResult != EFI_USB_NOERROR);
 
@@ -421,6 +661,17 @@ DwHcDeferredTransfer (
 {
   EFI_STATUS Status;
   EFI_EVENT TimeoutEvt = NULL;
+  UINT32 Channel;
+
+  //
+  // All channels busy with transfers this handler preempted. The periodic
+  // handler has already moved TargetFrame on by FrameInterval, so the
+  // request is tried again at its next polling interval.
+  //
+  Status = DwHcAcquireChannel (Req->DwHc, &Channel);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
 
   Status = gBS->CreateEvent (EVT_TIMER, 0, NULL, NULL, &TimeoutEvt);
   ASSERT_EFI_ERROR (Status);
@@ -437,7 +688,7 @@ DwHcDeferredTransfer (
 
   Req->TransferResult = EFI_USB_NOERROR;
   Status = DwHcTransfer (Req->DwHc, TimeoutEvt,
-             Req->Channel, Req->Translator,
+             Channel, Req->Translator,
              Req->DeviceSpeed, Req->DeviceAddress,
              Req->MaximumPacketLength, &Req->Pid,
              Req->TransferDirection, Req->Data, &Req->DataLength,
@@ -449,14 +700,22 @@ DwHcDeferredTransfer (
       Req->TransferResult == EFI_USB_ERR_NAK) {
     /*
      * Swallow the NAK, the upper layer expects us to resubmit automatically.
+     * The periodic handler resubmits it at the next polling interval.
      */
     goto Exit;
   }
 
+  DwHcReleaseChannel (Req->DwHc, Channel);
+  Channel = MAX_UINT32;
+
   Req->CallbackFunction (Req->Data, Req->DataLength,
          Req->CallbackContext,
          Req->TransferResult);
 Exit:
+  if (Channel != MAX_UINT32) {
+    DwHcReleaseChannel (Req->DwHc, Channel);
+  }
+
   if (TimeoutEvt != NULL) {
     gBS->CloseEvent (TimeoutEvt);
   }
@@ -834,6 +1093,7 @@ DwHcControlTransfer (
   UINTN                   Length;
   EFI_USB_DATA_DIRECTION  StatusDirection;
   UINT32                  Direction;
+  UINT32                  Channel = MAX_UINT32;
   EFI_EVENT TimeoutEvt = NULL;
 
   if ((Request == NULL) || (TransferResult == NULL)) {
@@ -880,10 +1140,17 @@ DwHcControlTransfer (
     goto Exit;
   }
 
+  Status = DwHcAcquireChannel (DwHc, &Channel);
+  if (EFI_ERROR (Status)) {
+    Channel = MAX_UINT32;
+    *TransferResult = EFI_USB_ERR_SYSTEM;
+    goto Exit;
+  }
+
   Pid = DWC2_HC_PID_SETUP;
   Length = 8;
   Status = DwHcTransfer (DwHc, TimeoutEvt,
-             DWC2_HC_CHANNEL, Translator, DeviceSpeed,
+             Channel, Translator, DeviceSpeed,
              DeviceAddress, MaximumPacketLength, &Pid, 0,
              Request, &Length, 0, DWC2_HCCHAR_EPTYPE_CONTROL,
              TransferResult, 1);
@@ -904,7 +1171,7 @@ DwHcControlTransfer (
     }
 
     Status = DwHcTransfer (DwHc, TimeoutEvt,
-               DWC2_HC_CHANNEL, Translator, DeviceSpeed,
+               Channel, Translator, DeviceSpeed,
                DeviceAddress, MaximumPacketLength, &Pid,
                Direction, Data, DataLength, 0,
                DWC2_HCCHAR_EPTYPE_CONTROL,
@@ -927,7 +1194,7 @@ DwHcControlTransfer (
   Pid = DWC2_HC_PID_DATA1;
   Length = 0;
   Status = DwHcTransfer (DwHc, TimeoutEvt,
-             DWC2_HC_CHANNEL, Translator, DeviceSpeed,
+             Channel, Translator, DeviceSpeed,
              DeviceAddress, MaximumPacketLength, &Pid,
              StatusDirection, DwHc->StatusBuffer, &Length, 0,
              DWC2_HCCHAR_EPTYPE_CONTROL, TransferResult, 1);
@@ -939,6 +1206,10 @@ DwHcControlTransfer (
   }
 
 Exit:
+  if (Channel != MAX_UINT32) {
+    DwHcReleaseChannel (DwHc, Channel);
+  }
+
   if (TimeoutEvt != NULL) {
     gBS->CloseEvent (TimeoutEvt);
   }
@@ -975,6 +1246,7 @@ DwHcBulkTransfer (
   UINT8                   TransferDirection;
   UINT8                   EpAddress;
   UINT32                  Pid;
+  UINT32                  Channels[2] = { MAX_UINT32, MAX_UINT32 };
   EFI_EVENT TimeoutEvt = NULL;
 
   if ((Data == NULL) || (Data[0] == NULL) ||
@@ -1016,15 +1288,45 @@ DwHcBulkTransfer (
   EpAddress = EndPointAddress & 0x0F;
   Pid = (*DataToggle << 1);
 
-  Status = DwHcTransfer (DwHc, TimeoutEvt,
-             DWC2_HC_CHANNEL_BULK, Translator, DeviceSpeed,
-             DeviceAddress, MaximumPacketLength, &Pid,
-             TransferDirection, Data[0], DataLength, EpAddress,
-             DWC2_HCCHAR_EPTYPE_BULK, TransferResult, 1);
+  Status = DwHcAcquireChannel (DwHc, &Channels[0]);
+  if (EFI_ERROR (Status)) {
+    Channels[0] = MAX_UINT32;
+    *TransferResult = EFI_USB_ERR_SYSTEM;
+    goto Exit;
+  }
+
+  //
+  // Chain transfers that span several channel buffers across a second
+  // channel. Split transactions to full-speed devices are left to
+  // DwHcTransfer.
+  //
+  if (DeviceSpeed == EFI_USB_SPEED_HIGH &&
+      *DataLength > DwHcBulkChunkSize (MaximumPacketLength) &&
+      !EFI_ERROR (DwHcAcquireChannel (DwHc, &Channels[1]))) {
+    Status = DwHcBulkTransferChained (DwHc, TimeoutEvt, Channels,
+               DeviceAddress, MaximumPacketLength, &Pid,
+               TransferDirection, Data[0], DataLength, EpAddress,
+               TransferResult);
+  } else {
+    Channels[1] = MAX_UINT32;
+    Status = DwHcTransfer (DwHc, TimeoutEvt,
+               Channels[0], Translator, DeviceSpeed,
+               DeviceAddress, MaximumPacketLength, &Pid,
+               TransferDirection, Data[0], DataLength, EpAddress,
+               DWC2_HCCHAR_EPTYPE_BULK, TransferResult, 1);
+  }
 
   *DataToggle = (Pid >> 1);
 
 Exit:
+  if (Channels[1] != MAX_UINT32) {
+    DwHcReleaseChannel (DwHc, Channels[1]);
+  }
+
+  if (Channels[0] != MAX_UINT32) {
+    DwHcReleaseChannel (DwHc, Channels[0]);
+  }
+
   if (TimeoutEvt != NULL) {
     gBS->CloseEvent (TimeoutEvt);
   }
@@ -1130,7 +1432,6 @@ DwHcAsyncInterruptTransfer (
     NewReq->FrameInterval;
 
   NewReq->DwHc = DwHc;
-  NewReq->Channel = DWC2_HC_CHANNEL_ASYNC;
   NewReq->Translator = Translator;
   NewReq->DeviceSpeed = DeviceSpeed;
   NewReq->DeviceAddress = DeviceAddress;
@@ -1187,6 +1488,7 @@ DwHcSyncInterruptTransfer (
   UINT8 TransferDirection;
   UINT8 EpAddress;
   UINT32 Pid;
+  UINT32 Channel;
 
   DwHc = DWHC_FROM_THIS (This);
 
@@ -1225,14 +1527,21 @@ DwHcSyncInterruptTransfer (
   TransferDirection = (EndPointAddress >> 7) & 0x01;
   EpAddress = EndPointAddress & 0x0F;
   Pid = (*DataToggle << 1);
+  Status = DwHcAcquireChannel (DwHc, &Channel);
+  if (EFI_ERROR (Status)) {
+    *TransferResult = EFI_USB_ERR_SYSTEM;
+    goto Exit;
+  }
+
   Status = DwHcTransfer (DwHc, TimeoutEvt,
-             DWC2_HC_CHANNEL_SYNC, Translator,
+             Channel, Translator,
              DeviceSpeed, DeviceAddress,
              MaximumPacketLength,
              &Pid, TransferDirection, Data,
              DataLength, EpAddress,
              DWC2_HCCHAR_EPTYPE_INTR,
              TransferResult, 0);
+  DwHcReleaseChannel (DwHc, Channel);
   *DataToggle = (Pid >> 1);
 
 Exit:
@@ -1457,6 +1766,7 @@ DestroyDwUsbHc (
   )
 {
   UINT32 Pages;
+  UINT32 Index;
   EFI_TPL PreviousTpl;
 
   if (DwHc == NULL) {
@@ -1473,9 +1783,18 @@ DestroyDwUsbHc (
     gBS->CloseEvent (DwHc->ExitBootServiceEvent);
   }
 
-  Pages = EFI_SIZE_TO_PAGES (DWC2_DATA_BUF_SIZE);
-  DmaUnmap (DwHc->AlignedBufferMapping);
-  DmaFreeBuffer (Pages, DwHc->AlignedBuffer);
+  if (DwHc->Channels != NULL) {
+    Pages = EFI_SIZE_TO_PAGES (DWC2_DATA_BUF_SIZE);
+    for (Index = 0; Index < DwHc->NumChannels; Index++) {
+      if (DwHc->Channels[Index].BufferMapping != NULL) {
+        DmaUnmap (DwHc->Channels[Index].BufferMapping);
+      }
+      if (DwHc->Channels[Index].Buffer != NULL) {
+        DmaFreeBuffer (Pages, DwHc->Channels[Index].Buffer);
+      }
+    }
+    FreePool (DwHc->Channels);
+  }
 
   Pages = EFI_SIZE_TO_PAGES (DWC2_STATUS_BUF_SIZE);
   FreePages (DwHc->StatusBuffer, Pages);
@@ -1562,7 +1881,9 @@ CreateDwUsbHc (
   )
 {
   DWUSB_OTGHC_DEV *DwHc;
+  DWUSB_CHANNEL   *Channel;
   UINT32          Pages;
+  UINT32          Index;
   UINTN           BufferSize;
   EFI_STATUS      Status;
 
@@ -1596,19 +1917,35 @@ CreateDwUsbHc (
     return EFI_OUT_OF_RESOURCES;
   }
 
-  Pages = EFI_SIZE_TO_PAGES (DWC2_DATA_BUF_SIZE);
-  Status = DmaAllocateBuffer (EfiBootServicesData, Pages, (VOID**)&DwHc->AlignedBuffer);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "CreateDwUsbHc: DmaAllocateBuffer: %r\n", Status));
-    return Status;
+  DwHc->NumChannels = MmioRead32 (DwHc->DwUsbBase + GHWCFG2);
+  DwHc->NumChannels &= DWC2_HWCFG2_NUM_HOST_CHAN_MASK;
+  DwHc->NumChannels >>= DWC2_HWCFG2_NUM_HOST_CHAN_OFFSET;
+  DwHc->NumChannels += 1;
+  DwHc->NumChannels = MIN (DwHc->NumChannels, DWC2_MAX_CHANNELS);
+
+  DwHc->Channels = AllocateZeroPool (DwHc->NumChannels * sizeof (DWUSB_CHANNEL));
+  if (DwHc->Channels == NULL) {
+    DEBUG ((DEBUG_ERROR, "CreateDwUsbHc: No memory for channels\n"));
+    return EFI_OUT_OF_RESOURCES;
   }
 
-  BufferSize = EFI_PAGES_TO_SIZE (Pages);
-  Status = DmaMap (MapOperationBusMasterCommonBuffer, DwHc->AlignedBuffer, &BufferSize,
-             &DwHc->AlignedBufferBusAddress, &DwHc->AlignedBufferMapping);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "CreateDwUsbHc: DmaMap: %r\n", Status));
-    return Status;
+  Pages = EFI_SIZE_TO_PAGES (DWC2_DATA_BUF_SIZE);
+  for (Index = 0; Index < DwHc->NumChannels; Index++) {
+    Channel = &DwHc->Channels[Index];
+
+    Status = DmaAllocateBuffer (EfiBootServicesData, Pages, (VOID**)&Channel->Buffer);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "CreateDwUsbHc: DmaAllocateBuffer: %r\n", Status));
+      return Status;
+    }
+
+    BufferSize = EFI_PAGES_TO_SIZE (Pages);
+    Status = DmaMap (MapOperationBusMasterCommonBuffer, Channel->Buffer, &BufferSize,
+               &Channel->BufferBusAddress, &Channel->BufferMapping);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "CreateDwUsbHc: DmaMap: %r\n", Status));
+      return Status;
+    }
   }
 
   InitializeListHead (&DwHc->DeferredList);
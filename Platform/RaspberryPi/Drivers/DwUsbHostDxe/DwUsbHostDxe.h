@@ -74,7 +74,6 @@ typedef struct {
 typedef struct _DWUSB_DEFERRED_REQ {
   IN OUT LIST_ENTRY                         List;
   IN     struct _DWUSB_OTGHC_DEV            *DwHc;
-  IN     UINT32                             Channel;
   IN     UINT32                             FrameInterval;
   IN     UINT32                             TargetFrame;
   IN     EFI_USB2_HC_TRANSACTION_TRANSLATOR *Translator;
@@ -94,6 +93,17 @@ typedef struct _DWUSB_DEFERRED_REQ {
   IN     UINTN                              TimeOut;
 } DWUSB_DEFERRED_REQ;
 
+/*
+ * Host channel state. Each channel has its own DMA buffer, so
+ * transfers on different channels can be in flight at the same time.
+ */
+typedef struct {
+  BOOLEAN                         InUse;
+  UINT8                           *Buffer;
+  VOID                            *BufferMapping;
+  UINTN                           BufferBusAddress;
+} DWUSB_CHANNEL;
+
 typedef struct _DWUSB_OTGHC_DEV {
   UINTN                           Signature;
 
@@ -108,9 +118,8 @@ typedef struct _DWUSB_OTGHC_DEV {
   EFI_PHYSICAL_ADDRESS            DwUsbBase;
   UINT8                           *StatusBuffer;
 
-  UINT8                           *AlignedBuffer;
-  VOID *                          AlignedBufferMapping;
-  UINTN                           AlignedBufferBusAddress;
+  UINT32                          NumChannels;
+  DWUSB_CHANNEL                   *Channels;
   LIST_ENTRY                      DeferredList;
   /*
    * 1ms frames.
@@ -242,6 +242,15 @@ MmcTransferBlock (
     CmdArg = Lba * This->Media->BlockSize;
   }
 
+  //
+  // Give the host a chance to set up DMA for the data phase. The host
+  // silently falls back to PIO if it can't, so the result is not checked.
+  //
+  if (MMC_HOST_HAS_PREPAREDATATRANSFER (MmcHost)) {
+    MmcHost->PrepareDataTransfer (MmcHost, Transfer == MMC_IOBLOCKS_READ,
+               BufferSize, Buffer);
+  }
+
   Status = MmcHost->SendCommand (MmcHost, Cmd, CmdArg);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a(MMC_CMD%d): Error %r\n", __func__, MMC_INDX (Cmd), Status));
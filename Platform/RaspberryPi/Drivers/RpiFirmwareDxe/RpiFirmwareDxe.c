@@ -18,6 +18,7 @@
 #include <Library/DebugLib.h>
 #include <Library/IoLib.h>
 #include <Library/SynchronizationLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 
@@ -60,58 +61,23 @@ typedef struct {
   UINT32                    Size;
 } RPI_FW_ARM_MEMORY_TAG;
 
-typedef struct {
-  RPI_FW_BUFFER_HEAD        BufferHead;
-  RPI_FW_TAG_HEAD           TagHead;
-  RPI_FW_ARM_MEMORY_TAG     TagBody;
-  UINT32                    EndTag;
-} RPI_FW_GET_ARM_MEMORY_CMD;
-
 typedef struct {
   UINT8                     MacAddress[6];
   UINT32                    Padding;
 } RPI_FW_MAC_ADDR_TAG;
 
-typedef struct {
-  RPI_FW_BUFFER_HEAD        BufferHead;
-  RPI_FW_TAG_HEAD           TagHead;
-  RPI_FW_MAC_ADDR_TAG       TagBody;
-  UINT32                    EndTag;
-} RPI_FW_GET_MAC_ADDR_CMD;
-
 typedef struct {
   UINT64                    Serial;
 } RPI_FW_SERIAL_TAG;
 
-typedef struct {
-  RPI_FW_BUFFER_HEAD        BufferHead;
-  RPI_FW_TAG_HEAD           TagHead;
-  RPI_FW_SERIAL_TAG         TagBody;
-  UINT32                    EndTag;
-} RPI_FW_GET_SERIAL_CMD;
-
 typedef struct {
   UINT32                    Model;
 } RPI_FW_MODEL_TAG;
 
-typedef struct {
-  RPI_FW_BUFFER_HEAD        BufferHead;
-  RPI_FW_TAG_HEAD           TagHead;
-  RPI_FW_MODEL_TAG          TagBody;
-  UINT32                    EndTag;
-} RPI_FW_GET_MODEL_CMD;
-
 typedef struct {
   UINT32                    Revision;
 } RPI_FW_MODEL_REVISION_TAG;
 
-typedef struct {
-  RPI_FW_BUFFER_HEAD        BufferHead;
-  RPI_FW_TAG_HEAD           TagHead;
-  RPI_FW_MODEL_REVISION_TAG TagBody;
-  UINT32                    EndTag;
-} RPI_FW_GET_REVISION_CMD;
-
 typedef struct {
   UINT32 Width;
   UINT32 Height;
@@ -256,12 +222,69 @@ typedef struct {
 } RPI_FW_NOTIFY_GPIO_SET_CFG_CMD;
 #pragma pack()
 
+//
+// Describes one property tag of a batched mailbox transaction. Value holds
+// the request data on input and receives the response data on output.
+//
+typedef struct {
+  UINT32                    TagId;
+  UINT32                    ValueSize;
+  VOID                      *Value;
+} RPI_FW_BATCH_TAG;
+
+//
+// Board properties that cannot change while the firmware is running
+//
+typedef enum {
+  RpiFwBoardSerial,
+  RpiFwBoardModel,
+  RpiFwBoardModelRevision,
+  RpiFwBoardFirmwareRevision,
+  RpiFwBoardMacAddress,
+  RpiFwBoardArmMemory,
+  RpiFwBoardInfoMax
+} RPI_FW_BOARD_INFO_ID;
+
+typedef struct {
+  RPI_FW_SERIAL_TAG         Serial;
+  RPI_FW_MODEL_TAG          Model;
+  RPI_FW_MODEL_REVISION_TAG ModelRevision;
+  RPI_FW_MODEL_REVISION_TAG FirmwareRevision;
+  RPI_FW_MAC_ADDR_TAG       MacAddress;
+  RPI_FW_ARM_MEMORY_TAG     ArmMemory;
+} RPI_FW_BOARD_INFO;
+
+typedef struct {
+  UINT64                    Transactions;
+  UINT64                    TotalTicks;
+  UINT64                    MaxTicks;
+  UINT64                    CacheHits;
+} RPI_FW_MAILBOX_STATS;
+
 STATIC VOID  *mDmaBuffer;
 STATIC VOID  *mDmaBufferMapping;
 STATIC UINTN mDmaBufferBusAddress;
 
 STATIC SPIN_LOCK mMailboxLock;
 
+STATIC RPI_FW_BOARD_INFO    mBoardInfo;
+STATIC UINT32               mBoardInfoValid;
+STATIC BOOLEAN              mBoardInfoBatchTried;
+STATIC RPI_FW_MAILBOX_STATS mMailboxStats;
+
+//
+// Indexed by RPI_FW_BOARD_INFO_ID. The MAC address is 6 bytes on the wire,
+// the padding only exists so that the following tag stays aligned.
+//
+STATIC RPI_FW_BATCH_TAG mBoardInfoTags[RpiFwBoardInfoMax] = {
+  { RPI_MBOX_GET_BOARD_SERIAL,   sizeof (RPI_FW_SERIAL_TAG),           &mBoardInfo.Serial           },
+  { RPI_MBOX_GET_BOARD_MODEL,    sizeof (RPI_FW_MODEL_TAG),            &mBoardInfo.Model            },
+  { RPI_MBOX_GET_BOARD_REVISION, sizeof (RPI_FW_MODEL_REVISION_TAG),   &mBoardInfo.ModelRevision    },
+  { RPI_MBOX_GET_REVISION,       sizeof (RPI_FW_MODEL_REVISION_TAG),   &mBoardInfo.FirmwareRevision },
+  { RPI_MBOX_GET_MAC_ADDRESS,    sizeof (mBoardInfo.MacAddress.MacAddress), &mBoardInfo.MacAddress },
+  { RPI_MBOX_GET_ARM_MEMSIZE,    sizeof (RPI_FW_ARM_MEMORY_TAG),       &mBoardInfo.ArmMemory        },
+};
+
 STATIC
 BOOLEAN
 DrainMailbox (
@@ -319,10 +342,15 @@ MailboxTransaction (
   OUT   UINT32  *Result
   )
 {
+  UINT64  Start;
+  UINT64  Ticks;
+
   if (Channel >= BCM2836_MBOX_NUM_CHANNELS) {
     return EFI_INVALID_PARAMETER;
   }
 
+  Start = GetPerformanceCounter ();
+
   //
   // Get rid of stale response data in the mailbox
   //
@@ -367,9 +395,150 @@ MailboxTransaction (
   *Result = MmioRead32 (BCM2836_MBOX_BASE_ADDRESS + BCM2836_MBOX_READ_OFFSET);
   ArmDataSynchronizationBarrier ();
 
+  //
+  // Account for the round trip to the VideoCore
+  //
+  Ticks = GetPerformanceCounter () - Start;
+  mMailboxStats.Transactions++;
+  mMailboxStats.TotalTicks += Ticks;
+  if (Ticks > mMailboxStats.MaxTicks) {
+    mMailboxStats.MaxTicks = Ticks;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Pack several property tags into the DMA buffer and submit them to the
+  VideoCore as a single mailbox transaction.
+
+  The caller must hold mMailboxLock.
+
+  @param[in,out]  Tags      The tags to submit. The response data of each
+                            tag is copied back into its Value buffer.
+  @param[in]      TagCount  The number of entries in Tags.
+
+  @retval EFI_SUCCESS           All tags were answered by the firmware.
+  @retval EFI_BUFFER_TOO_SMALL  The tags do not fit in the DMA buffer.
+  @retval EFI_DEVICE_ERROR      The transaction or one of the tags failed.
+
+**/
+STATIC
+EFI_STATUS
+MailboxBatchTransaction (
+  IN OUT  RPI_FW_BATCH_TAG  *Tags,
+  IN      UINTN             TagCount
+  )
+{
+  RPI_FW_BUFFER_HEAD          *BufferHead;
+  RPI_FW_TAG_HEAD             *TagHead;
+  UINT8                       *Ptr;
+  UINTN                       Size;
+  UINTN                       Index;
+  EFI_STATUS                  Status;
+  UINT32                      Result;
+
+  Size = sizeof (RPI_FW_BUFFER_HEAD) + sizeof (UINT32);
+  for (Index = 0; Index < TagCount; Index++) {
+    Size += sizeof (RPI_FW_TAG_HEAD) +
+            ALIGN_VALUE (Tags[Index].ValueSize, sizeof (UINT32));
+  }
+
+  if (Size > EFI_PAGES_TO_SIZE (NUM_PAGES)) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  //
+  // Zeroing the buffer also takes care of the end tag
+  //
+  BufferHead = mDmaBuffer;
+  ZeroMem (BufferHead, Size);
+
+  BufferHead->BufferSize = (UINT32)Size;
+  BufferHead->Response   = 0;
+
+  Ptr = (UINT8 *)(BufferHead + 1);
+  for (Index = 0; Index < TagCount; Index++) {
+    TagHead               = (RPI_FW_TAG_HEAD *)Ptr;
+    TagHead->TagId        = Tags[Index].TagId;
+    TagHead->TagSize      = ALIGN_VALUE (Tags[Index].ValueSize, sizeof (UINT32));
+    TagHead->TagValueSize = 0;
+    CopyMem (TagHead + 1, Tags[Index].Value, Tags[Index].ValueSize);
+    Ptr += sizeof (*TagHead) + TagHead->TagSize;
+  }
+
+  Status = MailboxTransaction (BufferHead->BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
+
+  if (EFI_ERROR (Status) ||
+      BufferHead->Response != RPI_MBOX_RESP_SUCCESS) {
+    DEBUG ((DEBUG_ERROR,
+      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
+      __func__, Status, BufferHead->Response));
+    return EFI_DEVICE_ERROR;
+  }
+
+  Ptr = (UINT8 *)(BufferHead + 1);
+  for (Index = 0; Index < TagCount; Index++) {
+    TagHead = (RPI_FW_TAG_HEAD *)Ptr;
+    if ((TagHead->TagValueSize & RPI_MBOX_VALUE_SIZE_RESPONSE_MASK) == 0) {
+      DEBUG ((DEBUG_ERROR, "%a: tag 0x%x was not processed\n",
+        __func__, TagHead->TagId));
+      return EFI_DEVICE_ERROR;
+    }
+    CopyMem (Tags[Index].Value, TagHead + 1, Tags[Index].ValueSize);
+    Ptr += sizeof (*TagHead) + TagHead->TagSize;
+  }
+
   return EFI_SUCCESS;
 }
 
+/**
+  Make sure a board property is present in the cache.
+
+  The first query fetches all the immutable board properties in a single
+  mailbox transaction. Should the firmware reject the batch, each property
+  is then fetched on its own the first time it is asked for.
+
+  The caller must hold mMailboxLock.
+
+  @param[in]  Id  The property to look up.
+
+  @retval EFI_SUCCESS       mBoardInfo holds a valid copy of the property.
+  @retval EFI_DEVICE_ERROR  The firmware could not be queried.
+
+**/
+STATIC
+EFI_STATUS
+GetBoardInfo (
+  IN  RPI_FW_BOARD_INFO_ID  Id
+  )
+{
+  EFI_STATUS                  Status;
+
+  if ((mBoardInfoValid & (1U << Id)) != 0) {
+    mMailboxStats.CacheHits++;
+    return EFI_SUCCESS;
+  }
+
+  if (!mBoardInfoBatchTried) {
+    mBoardInfoBatchTried = TRUE;
+    Status = MailboxBatchTransaction (mBoardInfoTags, ARRAY_SIZE (mBoardInfoTags));
+    if (!EFI_ERROR (Status)) {
+      mBoardInfoValid = (1U << RpiFwBoardInfoMax) - 1;
+      return EFI_SUCCESS;
+    }
+    DEBUG ((DEBUG_WARN, "%a: batched query failed, falling back to single tags\n",
+      __func__));
+  }
+
+  Status = MailboxBatchTransaction (&mBoardInfoTags[Id], 1);
+  if (!EFI_ERROR (Status)) {
+    mBoardInfoValid |= 1U << Id;
+  }
+
+  return Status;
+}
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -431,42 +600,21 @@ RpiFirmwareGetArmMemory (
   OUT   UINT32 *Size
   )
 {
-  RPI_FW_GET_ARM_MEMORY_CMD   *Cmd;
   EFI_STATUS                  Status;
-  UINT32                      Result;
 
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __func__));
     return EFI_DEVICE_ERROR;
   }
 
-  Cmd = mDmaBuffer;
-  ZeroMem (Cmd, sizeof (*Cmd));
-
-  Cmd->BufferHead.BufferSize  = sizeof (*Cmd);
-  Cmd->BufferHead.Response    = 0;
-  Cmd->TagHead.TagId          = RPI_MBOX_GET_ARM_MEMSIZE;
-  Cmd->TagHead.TagSize        = sizeof (Cmd->TagBody);
-  Cmd->TagHead.TagValueSize   = 0;
-  Cmd->EndTag                 = 0;
-
-  Status = MailboxTransaction (Cmd->BufferHead.BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
-
-
-  if (EFI_ERROR (Status) ||
-      Cmd->BufferHead.Response != RPI_MBOX_RESP_SUCCESS) {
-    DEBUG ((DEBUG_ERROR,
-      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
-      __func__, Status, Cmd->BufferHead.Response));
-    ReleaseSpinLock (&mMailboxLock);
-    return EFI_DEVICE_ERROR;
+  Status = GetBoardInfo (RpiFwBoardArmMemory);
+  if (!EFI_ERROR (Status)) {
+    *Base = mBoardInfo.ArmMemory.Base;
+    *Size = mBoardInfo.ArmMemory.Size;
   }
-
-  *Base = Cmd->TagBody.Base;
-  *Size = Cmd->TagBody.Size;
   ReleaseSpinLock (&mMailboxLock);
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 STATIC
@@ -476,40 +624,21 @@ RpiFirmwareGetMacAddress (
   OUT   UINT8   MacAddress[6]
   )
 {
-  RPI_FW_GET_MAC_ADDR_CMD     *Cmd;
   EFI_STATUS                  Status;
-  UINT32                      Result;
 
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __func__));
     return EFI_DEVICE_ERROR;
   }
 
-  Cmd = mDmaBuffer;
-  ZeroMem (Cmd, sizeof (*Cmd));
-
-  Cmd->BufferHead.BufferSize  = sizeof (*Cmd);
-  Cmd->BufferHead.Response    = 0;
-  Cmd->TagHead.TagId          = RPI_MBOX_GET_MAC_ADDRESS;
-  Cmd->TagHead.TagSize        = sizeof (Cmd->TagBody);
-  Cmd->TagHead.TagValueSize   = 0;
-  Cmd->EndTag                 = 0;
-
-  Status = MailboxTransaction (Cmd->BufferHead.BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
-
-  if (EFI_ERROR (Status) ||
-      Cmd->BufferHead.Response != RPI_MBOX_RESP_SUCCESS) {
-    DEBUG ((DEBUG_ERROR,
-      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
-      __func__, Status, Cmd->BufferHead.Response));
-    ReleaseSpinLock (&mMailboxLock);
-    return EFI_DEVICE_ERROR;
+  Status = GetBoardInfo (RpiFwBoardMacAddress);
+  if (!EFI_ERROR (Status)) {
+    CopyMem (MacAddress, mBoardInfo.MacAddress.MacAddress,
+      sizeof (mBoardInfo.MacAddress.MacAddress));
   }
-
-  CopyMem (MacAddress, Cmd->TagBody.MacAddress, sizeof (Cmd->TagBody.MacAddress));
   ReleaseSpinLock (&mMailboxLock);
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 STATIC
@@ -519,37 +648,20 @@ RpiFirmwareGetSerial (
   OUT   UINT64 *Serial
   )
 {
-  RPI_FW_GET_SERIAL_CMD       *Cmd;
   EFI_STATUS                  Status;
-  UINT32                      Result;
 
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __func__));
     return EFI_DEVICE_ERROR;
   }
 
-  Cmd = mDmaBuffer;
-  ZeroMem (Cmd, sizeof (*Cmd));
-
-  Cmd->BufferHead.BufferSize  = sizeof (*Cmd);
-  Cmd->BufferHead.Response    = 0;
-  Cmd->TagHead.TagId          = RPI_MBOX_GET_BOARD_SERIAL;
-  Cmd->TagHead.TagSize        = sizeof (Cmd->TagBody);
-  Cmd->TagHead.TagValueSize   = 0;
-  Cmd->EndTag                 = 0;
-
-  Status = MailboxTransaction (Cmd->BufferHead.BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
-
-  if (EFI_ERROR (Status) ||
-      Cmd->BufferHead.Response != RPI_MBOX_RESP_SUCCESS) {
-    DEBUG ((DEBUG_ERROR,
-      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
-      __func__, Status, Cmd->BufferHead.Response));
+  Status = GetBoardInfo (RpiFwBoardSerial);
+  if (EFI_ERROR (Status)) {
     ReleaseSpinLock (&mMailboxLock);
-    return EFI_DEVICE_ERROR;
+    return Status;
   }
 
-  *Serial = Cmd->TagBody.Serial;
+  *Serial = mBoardInfo.Serial.Serial;
   ReleaseSpinLock (&mMailboxLock);
   // Some platforms return 0 or 0x0000000010000000 for serial.
   // For those, try to use the MAC address.
@@ -569,40 +681,20 @@ RpiFirmwareGetModel (
   OUT   UINT32 *Model
   )
 {
-  RPI_FW_GET_MODEL_CMD       *Cmd;
   EFI_STATUS                  Status;
-  UINT32                      Result;
 
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __func__));
     return EFI_DEVICE_ERROR;
   }
 
-  Cmd = mDmaBuffer;
-  ZeroMem (Cmd, sizeof (*Cmd));
-
-  Cmd->BufferHead.BufferSize  = sizeof (*Cmd);
-  Cmd->BufferHead.Response    = 0;
-  Cmd->TagHead.TagId          = RPI_MBOX_GET_BOARD_MODEL;
-  Cmd->TagHead.TagSize        = sizeof (Cmd->TagBody);
-  Cmd->TagHead.TagValueSize   = 0;
-  Cmd->EndTag                 = 0;
-
-  Status = MailboxTransaction (Cmd->BufferHead.BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
-
-  if (EFI_ERROR (Status) ||
-      Cmd->BufferHead.Response != RPI_MBOX_RESP_SUCCESS) {
-    DEBUG ((DEBUG_ERROR,
-      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
-      __func__, Status, Cmd->BufferHead.Response));
-    ReleaseSpinLock (&mMailboxLock);
-    return EFI_DEVICE_ERROR;
+  Status = GetBoardInfo (RpiFwBoardModel);
+  if (!EFI_ERROR (Status)) {
+    *Model = mBoardInfo.Model.Model;
   }
-
-  *Model = Cmd->TagBody.Model;
   ReleaseSpinLock (&mMailboxLock);
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 STATIC
@@ -612,40 +704,20 @@ RpiFirmwareGetModelRevision (
   OUT   UINT32 *Revision
   )
 {
-  RPI_FW_GET_REVISION_CMD       *Cmd;
   EFI_STATUS                    Status;
-  UINT32                        Result;
 
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __func__));
     return EFI_DEVICE_ERROR;
   }
 
-  Cmd = mDmaBuffer;
-  ZeroMem (Cmd, sizeof (*Cmd));
-
-  Cmd->BufferHead.BufferSize  = sizeof (*Cmd);
-  Cmd->BufferHead.Response    = 0;
-  Cmd->TagHead.TagId          = RPI_MBOX_GET_BOARD_REVISION;
-  Cmd->TagHead.TagSize        = sizeof (Cmd->TagBody);
-  Cmd->TagHead.TagValueSize   = 0;
-  Cmd->EndTag                 = 0;
-
-  Status = MailboxTransaction (Cmd->BufferHead.BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
-
-  if (EFI_ERROR (Status) ||
-      Cmd->BufferHead.Response != RPI_MBOX_RESP_SUCCESS) {
-    DEBUG ((DEBUG_ERROR,
-      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
-      __func__, Status, Cmd->BufferHead.Response));
-    ReleaseSpinLock (&mMailboxLock);
-    return EFI_DEVICE_ERROR;
+  Status = GetBoardInfo (RpiFwBoardModelRevision);
+  if (!EFI_ERROR (Status)) {
+    *Revision = mBoardInfo.ModelRevision.Revision;
   }
-
-  *Revision = Cmd->TagBody.Revision;
   ReleaseSpinLock (&mMailboxLock);
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 STATIC
@@ -655,40 +727,20 @@ RpiFirmwareGetFirmwareRevision (
   OUT   UINT32 *Revision
   )
 {
-  RPI_FW_GET_REVISION_CMD       *Cmd;
   EFI_STATUS                    Status;
-  UINT32                        Result;
 
   if (!AcquireSpinLockOrFail (&mMailboxLock)) {
     DEBUG ((DEBUG_ERROR, "%a: failed to acquire spinlock\n", __func__));
     return EFI_DEVICE_ERROR;
   }
 
-  Cmd = mDmaBuffer;
-  ZeroMem (Cmd, sizeof (*Cmd));
-
-  Cmd->BufferHead.BufferSize  = sizeof (*Cmd);
-  Cmd->BufferHead.Response    = 0;
-  Cmd->TagHead.TagId          = RPI_MBOX_GET_REVISION;
-  Cmd->TagHead.TagSize        = sizeof (Cmd->TagBody);
-  Cmd->TagHead.TagValueSize   = 0;
-  Cmd->EndTag                 = 0;
-
-  Status = MailboxTransaction (Cmd->BufferHead.BufferSize, RPI_MBOX_VC_CHANNEL, &Result);
-
-  if (EFI_ERROR (Status) ||
-      Cmd->BufferHead.Response != RPI_MBOX_RESP_SUCCESS) {
-    DEBUG ((DEBUG_ERROR,
-      "%a: mailbox transaction error: Status == %r, Response == 0x%x\n",
-      __func__, Status, Cmd->BufferHead.Response));
-    ReleaseSpinLock (&mMailboxLock);
-    return EFI_DEVICE_ERROR;
+  Status = GetBoardInfo (RpiFwBoardFirmwareRevision);
+  if (!EFI_ERROR (Status)) {
+    *Revision = mBoardInfo.FirmwareRevision.Revision;
   }
-
-  *Revision = Cmd->TagBody.Revision;
   ReleaseSpinLock (&mMailboxLock);
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 STATIC
@@ -1529,6 +1581,33 @@ STATIC RASPBERRY_PI_FIRMWARE_PROTOCOL mRpiFirmwareProtocol = {
   RpiFirmwareNotifyGpioSetCfg
 };
 
+/**
+  Report how much time was spent waiting on the VideoCore mailbox.
+
+  @param  Event     The ReadyToBoot event.
+  @param  Context   Unused.
+
+**/
+STATIC
+VOID
+EFIAPI
+RpiFirmwareReportMailboxStats (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  UINT64          TotalNs;
+
+  gBS->CloseEvent (Event);
+
+  TotalNs = GetTimeInNanoSecond (mMailboxStats.TotalTicks);
+  DEBUG ((DEBUG_INFO,
+    "%a: %lu mailbox transactions, %lu us total, %lu us max, %lu cache hits\n",
+    __func__, mMailboxStats.Transactions, DivU64x32 (TotalNs, 1000),
+    DivU64x32 (GetTimeInNanoSecond (mMailboxStats.MaxTicks), 1000),
+    mMailboxStats.CacheHits));
+}
+
 /**
   Initialize the state information for the CPU Architectural Protocol
 
@@ -1548,6 +1627,7 @@ RpiFirmwareDxeInitialize (
 {
   EFI_STATUS      Status;
   UINTN           BufferSize;
+  EFI_EVENT       Event;
 
   //
   // We only need one of these
@@ -1586,6 +1666,12 @@ RpiFirmwareDxeInitialize (
     goto UnmapBuffer;
   }
 
+  //
+  // Not being able to report the statistics is not fatal
+  //
+  EfiCreateEventReadyToBootEx (TPL_CALLBACK, RpiFirmwareReportMailboxStats,
+    NULL, &Event);
+
   return EFI_SUCCESS;
 
 UnmapBuffer:
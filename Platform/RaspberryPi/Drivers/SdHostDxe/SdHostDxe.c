@@ -28,9 +28,17 @@
 #include <IndustryStandard/Bcm2836.h>
 #include <IndustryStandard/RpiMbox.h>
 #include <IndustryStandard/Bcm2836SdHost.h>
+#include <IndustryStandard/Bcm2836Dma.h>
 
 #define SDHOST_BLOCK_BYTE_LENGTH            512
 
+// DMA parameters
+#define SDHOST_DMA_CHANNEL                  4
+#define SDHOST_DMA_FIFO_THRESHOLD           4
+// The FIFO only raises DREQ above the threshold, so the tail of a read
+// is left in the FIFO and drained by PIO.
+#define SDHOST_DMA_READ_DRAIN_BYTES         ((SDHOST_DMA_FIFO_THRESHOLD - 1) * sizeof (UINT32))
+
 // Driver Timing Parameters
 #define CMD_STALL_AFTER_POLL_US             1
 #define CMD_MIN_POLL_TOTAL_TIME_US          100000 // 100ms
@@ -51,6 +59,9 @@
 #define DEBUG_MMCHOST_SD_ERROR DEBUG_ERROR
 
 STATIC RASPBERRY_PI_FIRMWARE_PROTOCOL   *mFwProtocol;
+STATIC BCM2836_DMA_CONTROL_BLOCK        *mDmaControlBlock;
+STATIC EFI_PHYSICAL_ADDRESS             mDmaControlBlockAddress;
+STATIC VOID                             *mDmaControlBlockMapping;
 
 // Per Physical Layer Simplified Specs
 #ifndef NDEBUG
@@ -495,6 +506,141 @@ SdReceiveResponse (
   return EFI_SUCCESS;
 }
 
+/**
+  Transfer whole blocks between the SdHost FIFO and Buffer using the
+  BCM283x DMA engine. Must be called after the data command was sent.
+
+  @retval EFI_SUCCESS      The transfer completed.
+  @retval EFI_UNSUPPORTED  Buffer could not be mapped for DMA. Nothing was
+                           transferred, so the caller should use PIO.
+  @retval other            The transfer failed.
+**/
+STATIC EFI_STATUS
+SdHostDmaTransfer (
+  IN BOOLEAN    IsRead,
+  IN UINTN      Length,
+  IN UINT32     *Buffer
+  )
+{
+  EFI_STATUS            Status;
+  UINTN                 DmaLength;
+  UINTN                 MappedLength;
+  EFI_PHYSICAL_ADDRESS  DeviceAddress;
+  VOID                  *Mapping;
+  UINTN                 ChannelBase;
+  UINT32                SavedEdm;
+  UINT32                Cs;
+  UINT32                Hsts;
+  UINT32                PollCount;
+  UINTN                 WordIdx;
+
+  DmaLength = IsRead ? Length - SDHOST_DMA_READ_DRAIN_BYTES : Length;
+  MappedLength = DmaLength;
+  Status = DmaMap (IsRead ? MapOperationBusMasterWrite : MapOperationBusMasterRead,
+             Buffer, &MappedLength, &DeviceAddress, &Mapping);
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (MappedLength != DmaLength) {
+    DmaUnmap (Mapping);
+    return EFI_UNSUPPORTED;
+  }
+
+  if (IsRead) {
+    mDmaControlBlock->TransferInformation = BCM2836_DMA_TI_SRC_DREQ |
+                                            BCM2836_DMA_TI_DEST_INC;
+    mDmaControlBlock->SourceAddress = BCM2836_PERIPHERAL_BUS_ADDRESS (SDHOST_DATA);
+    mDmaControlBlock->DestinationAddress = (UINT32)DeviceAddress;
+  } else {
+    mDmaControlBlock->TransferInformation = BCM2836_DMA_TI_DEST_DREQ |
+                                            BCM2836_DMA_TI_SRC_INC;
+    mDmaControlBlock->SourceAddress = (UINT32)DeviceAddress;
+    mDmaControlBlock->DestinationAddress = BCM2836_PERIPHERAL_BUS_ADDRESS (SDHOST_DATA);
+  }
+  mDmaControlBlock->TransferInformation |= BCM2836_DMA_TI_WAIT_RESP |
+                                           BCM2836_DMA_TI_PERMAP (BCM2836_DMA_DREQ_SDHOST);
+  mDmaControlBlock->TransferLength = (UINT32)DmaLength;
+  mDmaControlBlock->Stride = 0;
+  mDmaControlBlock->NextControlBlock = 0;
+  MemoryFence ();
+
+  // DREQ is driven by the FIFO thresholds, which PIO leaves alone.
+  SavedEdm = MmioRead32 (SDHOST_EDM);
+  MmioWrite32 (SDHOST_EDM, (SavedEdm & ~SDHOST_EDM_THRESHOLDS) |
+    SDHOST_EDM_READ_THRESHOLD (SDHOST_DMA_FIFO_THRESHOLD) |
+    SDHOST_EDM_WRITE_THRESHOLD (SDHOST_DMA_FIFO_THRESHOLD));
+
+  ChannelBase = BCM2836_DMA_CHANNEL_BASE_ADDRESS (SDHOST_DMA_CHANNEL);
+  MmioWrite32 (ChannelBase + BCM2836_DMA_CONBLK_AD, (UINT32)mDmaControlBlockAddress);
+  MmioWrite32 (ChannelBase + BCM2836_DMA_CS,
+    BCM2836_DMA_CS_ACTIVE | BCM2836_DMA_CS_WAIT_FOR_OUTSTANDING_WRITES);
+
+  Status = EFI_TIMEOUT;
+  Cs = 0;
+  Hsts = 0;
+  for (PollCount = 0; PollCount < FIFO_MAX_POLL_COUNT; ++PollCount) {
+    Cs = MmioRead32 (ChannelBase + BCM2836_DMA_CS);
+    if ((Cs & BCM2836_DMA_CS_ERROR) != 0) {
+      Status = EFI_DEVICE_ERROR;
+      break;
+    }
+
+    if ((Cs & BCM2836_DMA_CS_END) != 0) {
+      Status = EFI_SUCCESS;
+      break;
+    }
+
+    Hsts = MmioRead32 (SDHOST_HSTS);
+    if ((Hsts & SDHOST_HSTS_ERROR) != 0) {
+      Status = EFI_DEVICE_ERROR;
+      break;
+    }
+
+    gBS->Stall (CMD_STALL_AFTER_RETRY_US);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_MMCHOST_SD_ERROR,
+      "SdHost: SdHostDmaTransfer(): %r, CS 0x%8.8X, TXFR_LEN 0x%8.8X, HSTS 0x%8.8X\n",
+      Status, Cs, MmioRead32 (ChannelBase + BCM2836_DMA_TXFR_LEN), Hsts));
+    SdHostDumpStatus ();
+    MmioWrite32 (ChannelBase + BCM2836_DMA_CS, BCM2836_DMA_CS_RESET);
+    MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_CLEAR);
+  } else {
+    MmioWrite32 (ChannelBase + BCM2836_DMA_CS, BCM2836_DMA_CS_END);
+  }
+
+  DmaUnmap (Mapping);
+
+  if (!EFI_ERROR (Status) && IsRead) {
+    for (WordIdx = DmaLength / 4; WordIdx < Length / 4; ++WordIdx) {
+      for (PollCount = 0; PollCount < FIFO_MAX_POLL_COUNT; ++PollCount) {
+        if (SDHOST_EDM_FIFO_LEVEL (MmioRead32 (SDHOST_EDM)) != 0) {
+          break;
+        }
+        gBS->Stall (CMD_STALL_AFTER_RETRY_US);
+      }
+
+      if (PollCount == FIFO_MAX_POLL_COUNT) {
+        DEBUG ((DEBUG_MMCHOST_SD_ERROR,
+          "SdHost: SdHostDmaTransfer(): Block Word%d drain timed-out\n", WordIdx));
+        SdHostDumpStatus ();
+        MmioWrite32 (SDHOST_HSTS, SDHOST_HSTS_CLEAR);
+        Status = EFI_TIMEOUT;
+        break;
+      }
+
+      Buffer[WordIdx] = MmioRead32 (SDHOST_DATA);
+    }
+  }
+
+  MmioAndThenOr32 (SDHOST_EDM, ~SDHOST_EDM_THRESHOLDS,
+    SavedEdm & SDHOST_EDM_THRESHOLDS);
+
+  return Status;
+}
+
 STATIC EFI_STATUS
 SdReadBlockData (
   IN EFI_MMC_HOST_PROTOCOL    *This,
@@ -512,6 +658,16 @@ SdReadBlockData (
   EFI_STATUS Status = EFI_SUCCESS;
 
   mFwProtocol->SetLed (TRUE);
+  if (mDmaControlBlock != NULL && Length != 0 &&
+      Length % SDHOST_BLOCK_BYTE_LENGTH == 0) {
+    Status = SdHostDmaTransfer (TRUE, Length, Buffer);
+    if (Status != EFI_UNSUPPORTED) {
+      mFwProtocol->SetLed (FALSE);
+      return Status;
+    }
+    Status = EFI_SUCCESS;
+  }
+
   {
     UINT32 NumWords = Length / 4;
     UINT32 WordIdx;
@@ -563,6 +719,16 @@ SdWriteBlockData (
   EFI_STATUS Status = EFI_SUCCESS;
 
   mFwProtocol->SetLed (TRUE);
+  if (mDmaControlBlock != NULL && Length != 0 &&
+      Length % SDHOST_BLOCK_BYTE_LENGTH == 0) {
+    Status = SdHostDmaTransfer (FALSE, Length, Buffer);
+    if (Status != EFI_UNSUPPORTED) {
+      mFwProtocol->SetLed (FALSE);
+      return Status;
+    }
+    Status = EFI_SUCCESS;
+  }
+
   {
     UINT32 NumWords = Length / 4;
     UINT32 WordIdx;
@@ -787,6 +953,51 @@ SdIsMultiBlock (
   return TRUE;
 }
 
+/**
+  Set up the DMA channel and control block used for block transfers.
+  On failure SdHost silently stays on PIO.
+**/
+STATIC VOID
+SdHostDmaInitialize (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       MappedLength;
+  UINTN       ChannelBase;
+
+  if (PcdGet32 (PcdMmcDisableDma) != 0) {
+    return;
+  }
+
+  Status = DmaAllocateBuffer (EfiBootServicesData,
+             EFI_SIZE_TO_PAGES (sizeof (BCM2836_DMA_CONTROL_BLOCK)),
+             (VOID**)&mDmaControlBlock);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_MMCHOST_SD_ERROR, "SdHost: Failed to allocate DMA control block: %r\n", Status));
+    mDmaControlBlock = NULL;
+    return;
+  }
+
+  ASSERT (((UINTN)mDmaControlBlock % BCM2836_DMA_CONTROL_BLOCK_ALIGNMENT) == 0);
+
+  MappedLength = sizeof (BCM2836_DMA_CONTROL_BLOCK);
+  Status = DmaMap (MapOperationBusMasterCommonBuffer, mDmaControlBlock,
+             &MappedLength, &mDmaControlBlockAddress, &mDmaControlBlockMapping);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_MMCHOST_SD_ERROR, "SdHost: Failed to map DMA control block: %r\n", Status));
+    DmaFreeBuffer (EFI_SIZE_TO_PAGES (sizeof (BCM2836_DMA_CONTROL_BLOCK)), mDmaControlBlock);
+    mDmaControlBlock = NULL;
+    return;
+  }
+
+  ChannelBase = BCM2836_DMA_CHANNEL_BASE_ADDRESS (SDHOST_DMA_CHANNEL);
+  MmioOr32 (BCM2836_DMA_ENABLE, 1 << SDHOST_DMA_CHANNEL);
+  MmioWrite32 (ChannelBase + BCM2836_DMA_CS, BCM2836_DMA_CS_RESET);
+
+  DEBUG ((DEBUG_MMCHOST_SD_INFO, "SdHost: Using DMA channel %d\n", SDHOST_DMA_CHANNEL));
+}
+
 EFI_MMC_HOST_PROTOCOL gMmcHost =
   {
     MMC_HOST_PROTOCOL_REVISION,
@@ -799,7 +1010,8 @@ EFI_MMC_HOST_PROTOCOL gMmcHost =
     SdReadBlockData,
     SdWriteBlockData,
     SdSetIos,
-    SdIsMultiBlock
+    SdIsMultiBlock,
+    NULL
   };
 
 EFI_STATUS
@@ -831,6 +1043,8 @@ SdHostInitialize (
   DEBUG ((DEBUG_MMCHOST_SD, " - CMD_MAX_RETRY_COUNT=%d\n", CMD_MAX_RETRY_COUNT));
   DEBUG ((DEBUG_MMCHOST_SD, " - CMD_STALL_AFTER_RETRY_US=%dus\n", CMD_STALL_AFTER_RETRY_US));
 
+  SdHostDmaInitialize ();
+
   Status = gBS->InstallMultipleProtocolInterfaces (
     &Handle,
     &gRaspberryPiMmcHostProtocolGuid,
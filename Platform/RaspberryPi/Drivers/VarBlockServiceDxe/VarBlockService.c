@@ -86,6 +86,32 @@ EFI_FW_VOL_BLOCK_DEVICE mFvbDeviceTemplate = {
 };
 
 
+STATIC
+VOID
+VarStoreMarkDirty (
+  IN UINTN Address,
+  IN UINTN Length
+  )
+{
+  UINTN Block;
+  UINTN LastBlock;
+
+  if (Length == 0) {
+    return;
+  }
+
+  Block = (Address - mFvInstance->FvBase) / mFvInstance->DirtyBlockSize;
+  LastBlock = (Address - mFvInstance->FvBase + Length - 1) /
+                mFvInstance->DirtyBlockSize;
+  ASSERT (LastBlock < mFvInstance->NumOfDirtyBlocks);
+
+  for (; Block <= LastBlock; Block++) {
+    mFvInstance->DirtyBitmap[Block / 8] |= (UINT8)(1U << (Block % 8));
+  }
+  mFvInstance->Dirty = TRUE;
+}
+
+
 EFI_STATUS
 VarStoreWrite (
   IN     UINTN Address,
@@ -94,7 +120,7 @@ VarStoreWrite (
   )
 {
   CopyMem ((VOID*)Address, Buffer, *NumBytes);
-  mFvInstance->Dirty = TRUE;
+  VarStoreMarkDirty (Address, *NumBytes);
 
   return EFI_SUCCESS;
 }
@@ -107,7 +133,7 @@ VarStoreErase (
   )
 {
   SetMem ((VOID*)Address, LbaLength, 0xff);
-  mFvInstance->Dirty = TRUE;
+  VarStoreMarkDirty (Address, LbaLength);
 
   return EFI_SUCCESS;
 }
@@ -848,6 +874,16 @@ FvbInitialize (
    */
   mFvInstance->MappedFile = L"RPI_EFI.FD";
 
+  mFvInstance->DirtyBlockSize = PcdGet32 (PcdFirmwareBlockSize);
+  mFvInstance->NumOfDirtyBlocks = (Length + mFvInstance->DirtyBlockSize - 1) /
+                                    mFvInstance->DirtyBlockSize;
+  mFvInstance->DirtyBitmap = AllocateRuntimeZeroPool (
+                               (mFvInstance->NumOfDirtyBlocks + 7) / 8);
+  if (mFvInstance->DirtyBitmap == NULL) {
+    FreePool (mFvInstance);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   Status = ValidateFvHeader (mFvInstance->VolumeHeader);
   if (!EFI_ERROR (Status)) {
     if (mFvInstance->VolumeHeader->FvLength != Length ||
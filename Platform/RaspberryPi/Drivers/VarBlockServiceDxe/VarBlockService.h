@@ -33,8 +33,18 @@ typedef struct {
   EFI_DEVICE_PATH_PROTOCOL   *Device;
   CHAR16                     *MappedFile;
   BOOLEAN                    Dirty;
+  //
+  // One bit per PcdFirmwareBlockSize chunk of the FV that has been
+  // modified since it was last written back to MappedFile.
+  //
+  UINT8                      *DirtyBitmap;
+  UINTN                      DirtyBlockSize;
+  UINTN                      NumOfDirtyBlocks;
 } EFI_FW_VOL_INSTANCE;
 
+#define IS_BLOCK_DIRTY(Block) \
+          ((mFvInstance->DirtyBitmap[(Block) / 8] & (1U << ((Block) % 8))) != 0)
+
 extern EFI_FW_VOL_INSTANCE *mFvInstance;
 
 typedef struct {
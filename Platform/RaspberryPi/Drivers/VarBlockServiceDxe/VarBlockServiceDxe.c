@@ -10,6 +10,7 @@
 
 #include "VarBlockService.h"
 
+#include <Library/BaseLib.h>
 #include <Protocol/ResetNotification.h>
 
 //
@@ -24,6 +25,13 @@
 #define PLATFORM_RESET_DELAY    3500000
 #endif
 
+//
+// The delay above is sized for a rewrite of the whole variable store. It
+// gets scaled down to the amount of data actually written, but never
+// below this.
+//
+#define PLATFORM_RESET_DELAY_MIN  (PLATFORM_RESET_DELAY / 10)
+
 VOID *mSFSRegistration;
 
 
@@ -110,6 +118,7 @@ FvbVirtualAddressChangeEvent (
 {
   EfiConvertPointer (0x0, (VOID**)&mFvInstance->FvBase);
   EfiConvertPointer (0x0, (VOID**)&mFvInstance->VolumeHeader);
+  EfiConvertPointer (0x0, (VOID**)&mFvInstance->DirtyBitmap);
   EfiConvertPointer (0x0, (VOID**)&mFvInstance);
 }
 
@@ -134,14 +143,35 @@ InstallVirtualAddressChangeHandler (
 }
 
 
+/**
+  Write the variable store back to MappedFile.
+
+  @param[in]  Device        The device holding MappedFile.
+  @param[in]  DirtyOnly     If TRUE, only write the blocks modified since the
+                            last dump, and mark them clean once written.
+                            Otherwise write the whole FV.
+  @param[out] BytesWritten  The number of bytes written to the file.
+
+  @retval EFI_SUCCESS       The variable store was written back.
+  @retval other             MappedFile could not be opened or written.
+
+**/
 STATIC
 EFI_STATUS
 DoDump (
-  IN EFI_DEVICE_PATH_PROTOCOL *Device
+  IN  EFI_DEVICE_PATH_PROTOCOL *Device,
+  IN  BOOLEAN                  DirtyOnly,
+  OUT UINTN                    *BytesWritten
   )
 {
   EFI_STATUS Status;
   EFI_FILE_PROTOCOL *File;
+  UINTN Block;
+  UINTN EndBlock;
+  UINTN Start;
+  UINTN Length;
+
+  *BytesWritten = 0;
 
   Status = FileOpen (Device,
              mFvInstance->MappedFile,
@@ -152,10 +182,50 @@ DoDump (
     return Status;
   }
 
-  Status = FileWrite (File,
-             mFvInstance->Offset,
-             mFvInstance->FvBase,
-             mFvInstance->FvLength);
+  if (!DirtyOnly) {
+    Status = FileWrite (File,
+               mFvInstance->Offset,
+               mFvInstance->FvBase,
+               mFvInstance->FvLength);
+    if (!EFI_ERROR (Status)) {
+      *BytesWritten = mFvInstance->FvLength;
+    }
+    FileClose (File);
+    return Status;
+  }
+
+  //
+  // Write each run of consecutive dirty blocks at its offset in the file.
+  //
+  Block = 0;
+  while (Block < mFvInstance->NumOfDirtyBlocks) {
+    if (!IS_BLOCK_DIRTY (Block)) {
+      Block++;
+      continue;
+    }
+
+    EndBlock = Block + 1;
+    while (EndBlock < mFvInstance->NumOfDirtyBlocks && IS_BLOCK_DIRTY (EndBlock)) {
+      EndBlock++;
+    }
+
+    Start = Block * mFvInstance->DirtyBlockSize;
+    Length = MIN (EndBlock * mFvInstance->DirtyBlockSize,
+               mFvInstance->FvLength) - Start;
+    Status = FileWrite (File,
+               mFvInstance->Offset + Start,
+               mFvInstance->FvBase + Start,
+               Length);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    *BytesWritten += Length;
+    for (; Block < EndBlock; Block++) {
+      mFvInstance->DirtyBitmap[Block / 8] &= (UINT8)~(1U << (Block % 8));
+    }
+  }
+
   FileClose (File);
   return Status;
 }
@@ -169,6 +239,8 @@ DumpVars (
 {
   EFI_STATUS Status;
   RETURN_STATUS PcdStatus;
+  UINTN BytesWritten;
+  UINT32 ResetDelay;
 
   if (mFvInstance->Device == NULL) {
     DEBUG ((DEBUG_INFO, "Variable store not found?\n"));
@@ -180,22 +252,29 @@ DumpVars (
     return;
   }
 
-  Status = DoDump (mFvInstance->Device);
+  Status = DoDump (mFvInstance->Device, TRUE, &BytesWritten);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Couldn't dump '%s'\n", mFvInstance->MappedFile));
     ASSERT_EFI_ERROR (Status);
     return;
   }
 
-  DEBUG ((DEBUG_INFO, "Variables dumped!\n"));
+  DEBUG ((DEBUG_INFO, "Variables dumped (%lu of %lu bytes)!\n",
+    (UINT64)BytesWritten, (UINT64)mFvInstance->FvLength));
 
   //
   // Add a reset delay to give time for slow/cached devices
-  // to flush the NV variables write to permanent storage.
+  // to flush the NV variables write to permanent storage,
+  // in proportion to the amount of data written.
   // But only do so if this won't reduce an existing user-set delay.
   //
-  if (PcdGet32 (PcdPlatformResetDelay) < PLATFORM_RESET_DELAY) {
-    PcdStatus = PcdSet32S (PcdPlatformResetDelay, PLATFORM_RESET_DELAY);
+  ResetDelay = (UINT32)DivU64x64Remainder (
+                         MultU64x32 (BytesWritten, PLATFORM_RESET_DELAY),
+                         mFvInstance->FvLength,
+                         NULL);
+  ResetDelay = MAX (ResetDelay, PLATFORM_RESET_DELAY_MIN);
+  if (PcdGet32 (PcdPlatformResetDelay) < ResetDelay) {
+    PcdStatus = PcdSet32S (PcdPlatformResetDelay, ResetDelay);
     ASSERT_RETURN_ERROR (PcdStatus);
   }
 
@@ -304,6 +383,7 @@ OnSimpleFileSystemInstall (
   UINTN HandleSize;
   EFI_HANDLE Handle;
   EFI_DEVICE_PATH_PROTOCOL *Device;
+  UINTN BytesWritten;
 
   if ((mFvInstance->Device != NULL) &&
       !EFI_ERROR (CheckStoreExists (mFvInstance->Device))) {
@@ -334,7 +414,11 @@ OnSimpleFileSystemInstall (
       continue;
     }
 
-    Status = DoDump (Device);
+    //
+    // The file on a newly found store may hold anything, so sync it in
+    // full. The dirty blocks are still written again by DumpVars ().
+    //
+    Status = DoDump (Device, FALSE, &BytesWritten);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "Couldn't update '%s'\n", mFvInstance->MappedFile));
       ASSERT_EFI_ERROR (Status);
@@ -178,6 +178,21 @@ BOOLEAN
   IN  EFI_MMC_HOST_PROTOCOL     *This
   );
 
+//
+// Called before the command that starts a block transfer, so that the
+// host can program a DMA for its data phase. Returns EFI_SUCCESS if the
+// following ReadBlockData/WriteBlockData call completes the transfer
+// by DMA, or an error if the host will fall back to PIO.
+//
+typedef
+EFI_STATUS
+(EFIAPI *MMC_PREPAREDATATRANSFER) (
+  IN  EFI_MMC_HOST_PROTOCOL     *This,
+  IN  BOOLEAN                   IsRead,
+  IN  UINTN                     Length,
+  IN  VOID                      *Buffer
+  );
+
 struct _EFI_MMC_HOST_PROTOCOL {
   UINT32                  Revision;
   MMC_ISCARDPRESENT       IsCardPresent;
@@ -194,13 +209,17 @@ struct _EFI_MMC_HOST_PROTOCOL {
 
   MMC_SETIOS              SetIos;
   MMC_ISMULTIBLOCK        IsMultiBlock;
+
+  MMC_PREPAREDATATRANSFER PrepareDataTransfer;
 };
 
-#define MMC_HOST_PROTOCOL_REVISION    0x00010002    // 1.2
+#define MMC_HOST_PROTOCOL_REVISION    0x00010003    // 1.3
 
-#define MMC_HOST_HAS_SETIOS(Host)       (Host->Revision >= MMC_HOST_PROTOCOL_REVISION && \
+#define MMC_HOST_HAS_SETIOS(Host)       (Host->Revision >= 0x00010002 && \
                                          Host->SetIos != NULL)
-#define MMC_HOST_HAS_ISMULTIBLOCK(Host) (Host->Revision >= MMC_HOST_PROTOCOL_REVISION && \
+#define MMC_HOST_HAS_ISMULTIBLOCK(Host) (Host->Revision >= 0x00010002 && \
                                          Host->IsMultiBlock != NULL)
+#define MMC_HOST_HAS_PREPAREDATATRANSFER(Host) (Host->Revision >= 0x00010003 && \
+                                         Host->PrepareDataTransfer != NULL)
 
 #endif /* __RASPBERRY_PI_MMC_HOST_PROTOCOL_H__ */
@@ -19,6 +19,34 @@
 #define DDR_NVPARAM_ERRCTRL_FI_FIELD_SHIFT  1
 #define DDR_NVPARAM_ERRCTRL_FI_FIELD_MASK   0x2
 
+//
+// Index of each parameter read by MemInfoNvparamGet () in mMemInfoNvParams
+//
+typedef enum {
+  MemInfoNvDdrSpeed = 0,
+  MemInfoNvDdrEccMode,
+  MemInfoNvDdrErrCtrl,
+  MemInfoNvDdrSlave32bitMemEn,
+  MemInfoNvDdrScrubEn,
+  MemInfoNvDdrWrBackEn,
+  MemInfoNvDdrCrcMode,
+  MemInfoNvDdrRefreshGranularity,
+  MemInfoNvNvdimmMode,
+  MemInfoNvMax
+} MEM_INFO_NVPARAM_INDEX;
+
+STATIC CONST UINT32  mMemInfoNvParams[MemInfoNvMax] = {
+  NV_SI_DDR_SPEED,
+  NV_SI_DDR_ECC_MODE,
+  NV_SI_DDR_ERRCTRL,
+  NV_SI_DDR_SLAVE_32BIT_MEM_EN,
+  NV_SI_DDR_SCRUB_EN,
+  NV_SI_DDR_WR_BACK_EN,
+  NV_SI_DDR_CRC_MODE,
+  NV_SI_DDR_REFRESH_GRANULARITY,
+  NV_SI_NVDIMM_MODE
+};
+
 /**
   This is function collects meminfo from NVParam
 
@@ -32,112 +60,79 @@ MemInfoNvparamGet (
   OUT MEM_INFO_VARSTORE_DATA  *VarStoreConfig
   )
 {
-  UINT32      Value;
-  EFI_STATUS  Status;
+  UINT32      Value[MemInfoNvMax];
+  EFI_STATUS  Status[MemInfoNvMax];
 
   ASSERT (VarStoreConfig != NULL);
 
-  Status = NVParamGet (
-             NV_SI_DDR_SPEED,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  //
+  // The form is reloaded each time it is opened; read all parameters at once
+  // so the ones already read come from the NVParam read cache.
+  //
+  NVParamGetMany (
+    mMemInfoNvParams,
+    MemInfoNvMax,
+    NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
+    Value,
+    Status
+    );
+
+  if (EFI_ERROR (Status[MemInfoNvDdrSpeed])) {
     VarStoreConfig->DDRSpeedSel = 0; /* Default auto mode */
   } else {
-    VarStoreConfig->DDRSpeedSel = Value;
+    VarStoreConfig->DDRSpeedSel = Value[MemInfoNvDdrSpeed];
   }
 
-  Status = NVParamGet (
-             NV_SI_DDR_ECC_MODE,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvDdrEccMode])) {
     VarStoreConfig->EccMode = EccAuto;
   } else {
-    VarStoreConfig->EccMode = Value;
+    VarStoreConfig->EccMode = Value[MemInfoNvDdrEccMode];
   }
 
-  Status = NVParamGet (
-             NV_SI_DDR_ERRCTRL,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvDdrErrCtrl])) {
     VarStoreConfig->ErrCtrl_DE = ErrCtrlDeEnable;
     VarStoreConfig->ErrCtrl_FI = ErrCtrlFiEnable;
   } else {
-    VarStoreConfig->ErrCtrl_DE = (Value & DDR_NVPARAM_ERRCTRL_DE_FIELD_MASK) >> DDR_NVPARAM_ERRCTRL_DE_FIELD_SHIFT;
-    VarStoreConfig->ErrCtrl_FI = (Value & DDR_NVPARAM_ERRCTRL_FI_FIELD_MASK) >> DDR_NVPARAM_ERRCTRL_FI_FIELD_SHIFT;
+    VarStoreConfig->ErrCtrl_DE = (Value[MemInfoNvDdrErrCtrl] & DDR_NVPARAM_ERRCTRL_DE_FIELD_MASK) >> DDR_NVPARAM_ERRCTRL_DE_FIELD_SHIFT;
+    VarStoreConfig->ErrCtrl_FI = (Value[MemInfoNvDdrErrCtrl] & DDR_NVPARAM_ERRCTRL_FI_FIELD_MASK) >> DDR_NVPARAM_ERRCTRL_FI_FIELD_SHIFT;
   }
 
-  Status = NVParamGet (
-             NV_SI_DDR_SLAVE_32BIT_MEM_EN,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvDdrSlave32bitMemEn])) {
     VarStoreConfig->Slave32bit = 0; /* Default disabled */
   } else {
-    VarStoreConfig->Slave32bit = Value;
+    VarStoreConfig->Slave32bit = Value[MemInfoNvDdrSlave32bitMemEn];
   }
 
-  Status = NVParamGet (
-             NV_SI_DDR_SCRUB_EN,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvDdrScrubEn])) {
     VarStoreConfig->ScrubPatrol = DDR_DEFAULT_SCRUB_PATROL_DURATION;
   } else {
-    VarStoreConfig->ScrubPatrol = Value;
+    VarStoreConfig->ScrubPatrol = Value[MemInfoNvDdrScrubEn];
   }
 
-  Status = NVParamGet (
-             NV_SI_DDR_WR_BACK_EN,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvDdrWrBackEn])) {
     VarStoreConfig->DemandScrub = DDR_DEFAULT_DEMAND_SCRUB;
   } else {
-    VarStoreConfig->DemandScrub = Value;
+    VarStoreConfig->DemandScrub = Value[MemInfoNvDdrWrBackEn];
   }
 
-  Status = NVParamGet (
-             NV_SI_DDR_CRC_MODE,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvDdrCrcMode])) {
     VarStoreConfig->WriteCrc = DDR_DEFAULT_WRITE_CRC;
   } else {
-    VarStoreConfig->WriteCrc = Value;
+    VarStoreConfig->WriteCrc = Value[MemInfoNvDdrCrcMode];
   }
 
-  Status = NVParamGet (
-             NV_SI_DDR_REFRESH_GRANULARITY,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvDdrRefreshGranularity])) {
     VarStoreConfig->FGRMode   = DDR_DEFAULT_FGR_MODE;
     VarStoreConfig->Refresh2x = DDR_DEFAULT_REFRESH2X_MODE;
   } else {
-    VarStoreConfig->FGRMode   = DDR_FGR_MODE_GET (Value);
-    VarStoreConfig->Refresh2x = DDR_REFRESH_2X_GET (Value);
+    VarStoreConfig->FGRMode   = DDR_FGR_MODE_GET (Value[MemInfoNvDdrRefreshGranularity]);
+    VarStoreConfig->Refresh2x = DDR_REFRESH_2X_GET (Value[MemInfoNvDdrRefreshGranularity]);
   }
 
-  Status = NVParamGet (
-             NV_SI_NVDIMM_MODE,
-             NV_PERM_ATF | NV_PERM_BIOS | NV_PERM_MANU | NV_PERM_BMC,
-             &Value
-             );
-  if (EFI_ERROR (Status)) {
+  if (EFI_ERROR (Status[MemInfoNvNvdimmMode])) {
     VarStoreConfig->NvdimmModeSel = DDR_DEFAULT_NVDIMM_MODE_SEL;
   } else {
-    VarStoreConfig->NvdimmModeSel = Value & DDR_NVDIMM_MODE_SEL_MASK; /* Mask out valid bit */
+    VarStoreConfig->NvdimmModeSel = Value[MemInfoNvNvdimmMode] & DDR_NVDIMM_MODE_SEL_MASK; /* Mask out valid bit */
   }
 
   return EFI_SUCCESS;
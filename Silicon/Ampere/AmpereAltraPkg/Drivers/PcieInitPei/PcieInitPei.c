@@ -18,6 +18,7 @@
 #include <Library/Ac01PcieLib.h>
 #include <Library/PcieHotPlugLib.h>
 #include <Library/PeiServicesLib.h>
+#include <Library/ReportStatusCodeLib.h>
 #include <Platform/Ac01.h>
 #include <Ppi/ReadOnlyVariable2.h>
 
@@ -173,6 +174,51 @@ BuildRootComplexData (
   ConfigureRootComplex (IsConfigFound, RootComplexConfig);
 }
 
+/**
+  Log the bring-up time of each active Root Complex and report it as a PCI
+  init progress code, with the timing as extended data, so that it reaches the
+  BootProgress listeners.
+
+  @param TimingList  Timing of each Root Complex, indexed like mRootComplexList
+**/
+STATIC
+VOID
+ReportRootComplexTiming (
+  IN AC01_PCIE_RC_TIMING  *TimingList
+  )
+{
+  AC01_ROOT_COMPLEX  *RootComplex;
+  UINT8              Index;
+
+  for (Index = 0; Index < AC01_PCIE_MAX_ROOT_COMPLEX; Index++) {
+    RootComplex = &mRootComplexList[Index];
+    if (!RootComplex->Active) {
+      continue;
+    }
+
+    DEBUG ((
+      DEBUG_INIT,
+      "S%d-RC%d: DevMapLow/High: %d/%d, setup %d us, link up %d us\n",
+      RootComplex->Socket,
+      RootComplex->ID,
+      RootComplex->DevMapLow,
+      RootComplex->DevMapHigh,
+      TimingList[Index].SetupTimeUs,
+      TimingList[Index].LinkUpTimeUs
+      ));
+
+    REPORT_STATUS_CODE_EX (
+      EFI_PROGRESS_CODE,
+      EFI_IO_BUS_PCI | EFI_IOB_PC_INIT,
+      Index + 1,
+      &gEfiCallerIdGuid,
+      NULL,
+      &TimingList[Index],
+      sizeof (AC01_PCIE_RC_TIMING)
+      );
+  }
+}
+
 EFI_STATUS
 EFIAPI
 PcieInitEntry (
@@ -180,33 +226,18 @@ PcieInitEntry (
   IN CONST EFI_PEI_SERVICES     **PeiServices
   )
 {
-  AC01_ROOT_COMPLEX  *RootComplex;
-  EFI_STATUS         Status;
-  UINT8              Index;
+  AC01_PCIE_RC_TIMING  Timing[AC01_PCIE_MAX_ROOT_COMPLEX];
 
   BuildRootComplexData ();
 
   //
-  // Initialize Root Complex and underneath controllers
+  // Initialize all Root Complexes and underneath controllers together
   //
-  for (Index = 0; Index < AC01_PCIE_MAX_ROOT_COMPLEX; Index++) {
-    RootComplex = &mRootComplexList[Index];
-    if (!RootComplex->Active) {
-      continue;
-    }
+  Ac01PcieCoreSetupAllRC (mRootComplexList, Timing);
 
-    DEBUG ((DEBUG_INIT, "Initializing S%d-RC%d...", RootComplex->Socket, RootComplex->ID));
-    Status = Ac01PcieCoreSetupRC (RootComplex, FALSE, 0);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "Failed\n"));
-      RootComplex->Active = FALSE;
-      continue;
-    } else {
-      DEBUG ((DEBUG_INIT, "Done + DevMapLow/High: %d/%d\n", RootComplex->DevMapLow, RootComplex->DevMapHigh));
-    }
-  }
+  Ac01PcieCorePostSetupRC (mRootComplexList, Timing);
 
-  Ac01PcieCorePostSetupRC (mRootComplexList);
+  ReportRootComplexTiming (Timing);
 
   PcieHotPlugStart ();
 
@@ -9,6 +9,16 @@
 #ifndef AC01_PCIE_LIB_H_
 #define AC01_PCIE_LIB_H_
 
+//
+// Time spent bringing up one Root Complex, reported per Root Complex by the
+// caller of Ac01PcieCoreSetupAllRC ().
+//
+typedef struct {
+  UINT32    SetupTimeUs;      // Programming time, shared settle times excluded
+  UINT32    LinkUpTimeUs;     // From start of link polling until every active
+                              // controller is up, or until the polling deadline
+} AC01_PCIE_RC_TIMING;
+
 /**
   Setup and initialize the AC01 PCIe Root Complex and underneath PCIe controllers
 
@@ -26,14 +36,36 @@ Ac01PcieCoreSetupRC (
   IN UINT8              ReInitPcieIndex
   );
 
+/**
+  Setup and initialize all active Root Complexes and underneath PCIe controllers.
+
+  The Root Complexes are brought up together in phases, so the settle times
+  after Host Bridge programming, controller reset and auto bifurcation training
+  are waited for once for all of them. A Root Complex that fails to initialize
+  is marked inactive.
+
+  @param RootComplexList       Pointer to the Root Complex list
+  @param TimingList            Optional AC01_PCIE_MAX_ROOT_COMPLEX entries that
+                               receive the setup time of each Root Complex.
+**/
+VOID
+Ac01PcieCoreSetupAllRC (
+  IN OUT AC01_ROOT_COMPLEX    *RootComplexList,
+  OUT    AC01_PCIE_RC_TIMING  *TimingList  OPTIONAL
+  );
+
 /**
   Verify the link status and retry to initialize the Root Complex if there's any issue.
 
   @param RootComplexList      Pointer to the Root Complex list
+  @param TimingList           Optional AC01_PCIE_MAX_ROOT_COMPLEX entries whose
+                              LinkUpTimeUs receives the link up time of each
+                              Root Complex.
 **/
 VOID
 Ac01PcieCorePostSetupRC (
-  IN AC01_ROOT_COMPLEX  *RootComplexList
+  IN     AC01_ROOT_COMPLEX    *RootComplexList,
+  IN OUT AC01_PCIE_RC_TIMING  *TimingList  OPTIONAL
   );
 
 /**
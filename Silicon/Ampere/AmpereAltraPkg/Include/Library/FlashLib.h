@@ -63,6 +63,8 @@ FlashGetNvRam2Info (
 /**
   Erase a region of the Flash.
 
+  Sectors that already read back as erased are not erased again.
+
   @param[in] ByteAddress         Start address of the region.
   @param[in] Length              Number of bytes to erase.
 
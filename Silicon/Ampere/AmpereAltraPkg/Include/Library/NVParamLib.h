@@ -50,6 +50,23 @@
 
 #define NVPARAM_SIZE  0x8
 
+typedef struct {
+  //
+  // Requests sent to the secure world through the MM interface.
+  //
+  UINT32    MmTransitions;
+
+  //
+  // NVParamGet calls answered from the read cache.
+  //
+  UINT32    CacheHits;
+
+  //
+  // NVParamGet calls that had to query the secure world.
+  //
+  UINT32    CacheMisses;
+} NVPARAM_STATISTICS;
+
 /**
   Retrieve a non-volatile parameter.
 
@@ -73,6 +90,35 @@ NVParamGet (
   OUT UINT32  *Val
   );
 
+/**
+  Retrieve a list of non-volatile parameters sharing the same read permission.
+
+  Parameters already read by the calling module are served from its read cache;
+  only the remaining ones are requested from the secure world. Every entry is
+  attempted even if an earlier one fails, and ValueList entries that could not
+  be read are left untouched so the caller can pre-load them with defaults.
+
+  @param[in]  ParamList           Array of parameter IDs to retrieve.
+  @param[in]  Count               Number of entries in ParamList.
+  @param[in]  ACLRd               Permission for read operation.
+  @param[out] ValueList           Array of Count UINT32 receiving the values.
+  @param[out] StatusList          Optional array of Count EFI_STATUS receiving
+                                  the NVParamGet status of each entry.
+
+  @retval EFI_SUCCESS             All parameters were retrieved.
+  @retval EFI_INVALID_PARAMETER   ParamList or ValueList is NULL.
+  @retval Others                  Status of the first parameter that could not
+                                  be retrieved, as returned by NVParamGet.
+**/
+EFI_STATUS
+NVParamGetMany (
+  IN  CONST UINT32  *ParamList,
+  IN  UINTN         Count,
+  IN  UINT16        ACLRd,
+  OUT UINT32        *ValueList,
+  OUT EFI_STATUS    *StatusList OPTIONAL
+  );
+
 /**
   Set a non-volatile parameter.
 
@@ -131,4 +177,17 @@ NVParamClrAll (
   VOID
   );
 
+/**
+  Retrieve the NVParam access statistics of the calling module.
+
+  @param[out] Statistics          Receives the current counter values.
+
+  @retval EFI_SUCCESS             Operation succeeded.
+  @retval EFI_INVALID_PARAMETER   Statistics is NULL.
+**/
+EFI_STATUS
+NVParamGetStatistics (
+  OUT NVPARAM_STATISTICS  *Statistics
+  );
+
 #endif /* NV_PARAM_LIB_H_ */
@@ -11,6 +11,7 @@
 #include <Guid/PlatformInfoHob.h>
 #include <Guid/RootComplexInfoHob.h>
 #include <IndustryStandard/Pci.h>
+#include <Library/Ac01PcieLib.h>
 #include <Library/ArmGenericTimerCounterLib.h>
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -937,286 +938,546 @@ Ac01PcieCorrectBifurcation (
 }
 
 /**
-  Setup and initialize the AC01 PCIe Root Complex and underneath PCIe controllers
+  Convert the generic timer ticks elapsed since StartTick to microseconds.
+
+  @param StartTick             Generic timer count at the start of the interval
+
+  @return                      Elapsed time in microseconds
+**/
+STATIC
+UINT32
+GetElapsedTimeUs (
+  IN UINT64  StartTick
+  )
+{
+  UINT64  Ticks;
+
+  Ticks = ArmGenericTimerGetSystemCount () - StartTick;
+  return (UINT32)DivU64x64Remainder (
+                   MultU64x32 (Ticks, 1000000),
+                   ArmGenericTimerGetTimerFreq (),
+                   NULL
+                   );
+}
+
+/**
+  Select the bifurcation mode the Root Complex trains in first and program
+  the Host Bridge accordingly.
 
   @param RootComplex           Pointer to Root Complex structure
-  @param ReInit                Re-init status
-  @param ReInitPcieIndex       PCIe controller index
 
-  @retval RETURN_SUCCESS       The Root Complex has been initialized successfully.
-  @retval RETURN_DEVICE_ERROR  PHY, Memory or PIPE is not ready.
+  @retval TRUE                 Auto bifurcation is enabled. The links are trained
+                               in the lowest mode and the mode must be corrected
+                               once they are up.
+  @retval FALSE                The configured bifurcation mode is used.
+**/
+STATIC
+BOOLEAN
+Ac01PcieCorePrepareRC (
+  IN AC01_ROOT_COMPLEX  *RootComplex
+  )
+{
+  BOOLEAN  AutoLaneBifurcationEnabled;
+
+  AutoLaneBifurcationEnabled = FALSE;
+  if (RootComplex->DevMapLow == DevMapModeAuto) {
+    // Set lowest bifurcation mode
+    RootComplex->DevMapLow = DevMapMode4;
+
+    AutoLaneBifurcationEnabled = TRUE;
+    DEBUG ((
+      DEBUG_INFO,
+      "RootComplex->ID:%d Auto Bifurcation enabled\n",
+      RootComplex->ID
+      ));
+  }
+
+  ProgramHostBridgeInfo (RootComplex);
+
+  return AutoLaneBifurcationEnabled;
+}
+
+/**
+  Put a PCIe controller into reset if it is not in reset already.
+
+  @param RootComplex           Pointer to Root Complex structure
+  @param PcieIndex             PCIe controller index
+
+  @retval TRUE                 The reset was asserted now. The caller must wait
+                               CONTROLLER_RESET_DELAY_US before programming the
+                               controller.
+  @retval FALSE                The controller was already in reset.
+**/
+STATIC
+BOOLEAN
+Ac01PcieCoreAssertReset (
+  IN AC01_ROOT_COMPLEX  *RootComplex,
+  IN UINT8              PcieIndex
+  )
+{
+  PHYSICAL_ADDRESS  TargetAddress;
+  UINT32            Val;
+
+  TargetAddress = RootComplex->Pcie[PcieIndex].CsrBase + AC01_PCIE_CORE_RESET_REG;
+  Val           = MmioRead32 (TargetAddress);
+  if (Val & RESET_MASK) {
+    return FALSE;
+  }
+
+  Val = DWC_PCIE_SET (Val, ASSERT_RESET);
+  MmioWrite32 (TargetAddress, Val);
+
+  return TRUE;
+}
+
+/**
+  Program a PCIe controller that has been held in reset and start link training.
+
+  @param RootComplex           Pointer to Root Complex structure
+  @param PcieIndex             PCIe controller index
+
+  @retval RETURN_SUCCESS       Link training has been started.
+  @retval RETURN_DEVICE_ERROR  Memory or PIPE is not ready.
 **/
+STATIC
 RETURN_STATUS
-Ac01PcieCoreSetupRC (
+Ac01PcieCoreSetupController (
   IN AC01_ROOT_COMPLEX  *RootComplex,
-  IN BOOLEAN            ReInit,
-  IN UINT8              ReInitPcieIndex
+  IN UINT8              PcieIndex
   )
 {
-  PHYSICAL_ADDRESS              CfgBase;
-  PHYSICAL_ADDRESS              CsrBase;
-  PHYSICAL_ADDRESS              TargetAddress;
-  RETURN_STATUS                 Status;
-  UINT32                        Val;
-  UINT8                         PcieIndex;
-  BOOLEAN                       AutoLaneBifurcationEnabled = FALSE;
-  PCI_REG_PCIE_LINK_CAPABILITY  LinkCap[MaxPcieController];
-  AC01_PCIE_CONTROLLER          *Pcie;
-  DEV_MAP_MODE                  DevMapMode;
+  PHYSICAL_ADDRESS  CfgBase;
+  PHYSICAL_ADDRESS  CsrBase;
+  PHYSICAL_ADDRESS  TargetAddress;
+  UINT32            Val;
 
-  DEBUG ((DEBUG_INFO, "Initializing Socket%d RootComplex%d\n", RootComplex->Socket, RootComplex->ID));
+  DEBUG ((DEBUG_INFO, "Initializing Controller %d\n", PcieIndex));
 
-AutoLaneBifurcationRetry:
-  if (!ReInit) {
-    if (AutoLaneBifurcationEnabled) {
-      //
-      // We are here after the first round
-      //
-      // As per 2.7.2. AC Specifications of PCIe card specification this TPVPERL time and
-      // should be minimum 100ms. So this is minimum time we need add and found during test.
-      //
-      MicroSecondDelay (100000);
-      SetMem ((VOID *)LinkCap, sizeof (LinkCap), 0);
-      for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
-        Pcie = &RootComplex->Pcie[PcieIndex];
-        if (!Pcie->Active || !PcieLinkUpCheck (Pcie)) {
-          continue;
-        }
+  CsrBase = RootComplex->Pcie[PcieIndex].CsrBase;
+  CfgBase = RootComplex->MmcfgBase + (RootComplex->Pcie[PcieIndex].DevNum << DEV_SHIFT);
 
-        DEBUG ((DEBUG_INFO, "RootComplex->ID:%d Port:%d link up\n", RootComplex->ID, PcieIndex));
-        TargetAddress = GetCapabilityBase (RootComplex, PcieIndex, FALSE, EFI_PCI_CAPABILITY_ID_PCIEXP);
-        if (TargetAddress == 0) {
-          continue;
-        }
+  if (!EnableItsMemory (RootComplex, PcieIndex)) {
+    DEBUG ((DEBUG_ERROR, "- Pcie[%d] - ITS Memory is not ready\n", PcieIndex));
+    return RETURN_DEVICE_ERROR;
+  }
 
-        LinkCap[PcieIndex].Uint32 = MmioRead32 (TargetAddress + LINK_CAPABILITIES_REG);
-      }
+  // Hold link training
+  StartLinkTraining (RootComplex, PcieIndex, FALSE);
 
-      Status = Ac01PcieCorrectBifurcation (RootComplex, LinkCap, MaxPcieControllerOfRootComplexA, &DevMapMode);
-      if (!EFI_ERROR (Status)) {
-        RootComplex->DevMapLow = DevMapMode;
-        DEBUG ((
-          DEBUG_INFO,
-          "RootComplex->ID:%d Auto Bifurcation done, DevMapMode:%d\n",
-          RootComplex->ID,
-          RootComplex->DevMapLow
-          ));
-      } else {
-        RootComplex->DevMapLow = DevMapMode1;
-        DEBUG ((
-          DEBUG_INFO,
-          "RootComplex->ID:%d Auto Bifurcation failed, revert to DevMapMode1\n",
-          RootComplex->ID
-          ));
-      }
+  // Clear BUSCTRL.CfgUrMask to set CRS (Configuration Request Retry Status) to 0xFFFF.FFFF
+  // rather than 0xFFFF.0001 as per PCIe specification requirement. Otherwise, this causes
+  // device drivers respond incorrectly on timeout due to long device operations.
+  TargetAddress = CsrBase + AC01_PCIE_CORE_BUS_CONTROL_REG;
+  Val           = MmioRead32 (TargetAddress);
+  Val          &= ~BUS_CTL_CFG_UR_MASK;
+  MmioWrite32 (TargetAddress, Val);
 
-      AutoLaneBifurcationEnabled = FALSE;
+  if (!EnableAxiPipeClock (RootComplex, PcieIndex)) {
+    DEBUG ((DEBUG_ERROR, "- Pcie[%d] - PIPE clock is not stable\n", PcieIndex));
+    return RETURN_DEVICE_ERROR;
+  }
 
-      if (DevMapMode == DevMapMode4) {
-        // Return directly as the RootComplex already initialized in this mode
-        return EFI_SUCCESS;
-      }
+  // Start PERST pulse
+  BoardPcieAssertPerst (RootComplex, PcieIndex, TRUE);
 
-      //
-      // Update the RootComplex data with new DevMapMode
-      //
-      Ac01PcieUpdateActive (RootComplex);
-      Ac01PcieUpdateMaxWidth (RootComplex);
-    } else {
-      if (RootComplex->DevMapLow == DevMapModeAuto) {
-        // Set lowest bifurcation mode
-        RootComplex->DevMapLow = DevMapMode4;
+  // Allow programming to config space
+  EnableDbiAccess (RootComplex, PcieIndex, TRUE);
 
-        AutoLaneBifurcationEnabled = TRUE;
-        DEBUG ((
-          DEBUG_INFO,
-          "RootComplex->ID:%d Auto Bifurcation enabled\n",
-          RootComplex->ID
-          ));
-      }
-    }
+  // Program the power limit
+  TargetAddress = CfgBase + PCIE_CAPABILITY_BASE + SLOT_CAPABILITIES_REG;
+  Val           = MmioRead32 (TargetAddress);
+  // In order to detect the NVMe after OS boots successfully but
+  // that NVMe's not present previously. Hot Plug Slot Capable
+  // will help PCI Linux driver to initialize its slot iomem resource
+  // which is used for detecting the disk when it's inserted.
+  Val = SLOT_HPC_SET (Val, 1);
+  Val = SLOT_CAP_SLOT_POWER_LIMIT_VALUE_SET (Val, SLOT_POWER_LIMIT_75W);
+  MmioWrite32 (TargetAddress, Val);
 
-    ProgramHostBridgeInfo (RootComplex);
+  // Program DTI for ATS support
+  TargetAddress = CfgBase + DTIM_CTRL0_OFF;
+  Val           = MmioRead32 (TargetAddress);
+  Val           = DTIM_CTRL0_ROOT_PORT_ID_SET (Val, 0);
+  MmioWrite32 (TargetAddress, Val);
 
-    // Fix for UEFI hang due to timing change with bifurcation
-    // register moved very close to PHY initialization.
-    MicroSecondDelay (100000);
+  //
+  // Program number of lanes used
+  // - Reprogram LINK_CAPABLE of PORT_LINK_CTRL_OFF
+  // - Reprogram NUM_OF_LANES of GEN2_CTRL_OFF
+  // - Reprogram CAP_MAX_LINK_WIDTH of LINK_CAPABILITIES_REG
+  //
+  ProgramLinkCapabilities (RootComplex, PcieIndex);
+
+  // Set Zero byte request handling
+  TargetAddress = CfgBase + FILTER_MASK_2_OFF;
+  Val           = MmioRead32 (TargetAddress);
+  Val           = CX_FLT_MASK_VENMSG0_DROP_SET (Val, 0);
+  Val           = CX_FLT_MASK_VENMSG1_DROP_SET (Val, 0);
+  Val           = CX_FLT_MASK_DABORT_4UCPL_SET (Val, 0);
+  MmioWrite32 (TargetAddress, Val);
+
+  TargetAddress = CfgBase + AMBA_ORDERING_CTRL_OFF;
+  Val           = MmioRead32 (TargetAddress);
+  Val           = AX_MSTR_ZEROLREAD_FW_SET (Val, 0);
+  MmioWrite32 (TargetAddress, Val);
+
+  //
+  // Set Completion with CRS handling for CFG Request
+  // Set Completion with CA/UR handling non-CFG Request
+  //
+  TargetAddress = CfgBase + AMBA_ERROR_RESPONSE_DEFAULT_OFF;
+  Val           = MmioRead32 (TargetAddress);
+  // 0x2: OKAY with FFFF_0001 and FFFF_FFFF
+  Val = AMBA_ERROR_RESPONSE_CRS_SET (Val, 0x2);
+  MmioWrite32 (TargetAddress, Val);
+
+  // Set Legacy PCIE interrupt map to INTA
+  TargetAddress = CfgBase + BRIDGE_CTRL_INT_PIN_INT_LINE_REG;
+  Val           = MmioRead32 (TargetAddress);
+  Val           = INT_PIN_SET (Val, IRQ_INT_A);
+  MmioWrite32 (TargetAddress, Val);
+
+  TargetAddress = CsrBase + AC01_PCIE_CORE_IRQ_SEL_REG;
+  Val           = MmioRead32 (TargetAddress);
+  Val           = INTPIN_SET (Val, IRQ_INT_A);
+  MmioWrite32 (TargetAddress, Val);
 
-    Status = PciePhyInit (RootComplex->SerdesBase);
-    if (RETURN_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "%a: Failed to initialize the PCIe PHY\n", __func__));
-      return RETURN_DEVICE_ERROR;
+  if (RootComplex->Pcie[PcieIndex].MaxGen >= LINK_SPEED_GEN2) {
+    ConfigureEqualization (RootComplex, PcieIndex);
+    if (RootComplex->Pcie[PcieIndex].MaxGen >= LINK_SPEED_GEN3) {
+      ConfigurePresetGen3 (RootComplex, PcieIndex);
+      if (RootComplex->Pcie[PcieIndex].MaxGen >= LINK_SPEED_GEN4) {
+        ConfigurePresetGen4 (RootComplex, PcieIndex);
+      }
     }
   }
 
-  // Setup each controller
+  //
+  // As AMBA_LINK_TIMEOUT_OFF spec, it impacts OS HP removal delay.
+  // The greater value the longer delay it is. Per discussion,
+  // set it 2 from beginning of RP initialization.
+  //
+  SetLinkTimeout (RootComplex, PcieIndex, 2);
+
+  DisableCompletionTimeOut (RootComplex, PcieIndex, TRUE);
+
+  ProgramRootPortInfo (RootComplex, PcieIndex);
+
+  // Enable common clock for downstream
+  TargetAddress = CfgBase + PCIE_CAPABILITY_BASE + LINK_CONTROL_LINK_STATUS_REG;
+  Val           = MmioRead32 (TargetAddress);
+  Val           = CAP_SLOT_CLK_CONFIG_SET (Val, 1);
+  Val           = CAP_COMMON_CLK_SET (Val, 1);
+  MmioWrite32 (TargetAddress, Val);
+
+  // Match aux_clk to system
+  TargetAddress = CfgBase + AUX_CLK_FREQ_OFF;
+  Val           = MmioRead32 (TargetAddress);
+  Val           = AUX_CLK_FREQ_SET (Val, AUX_CLK_500MHZ);
+  MmioWrite32 (TargetAddress, Val);
+
+  // Assert PERST low to reset endpoint
+  BoardPcieAssertPerst (RootComplex, PcieIndex, FALSE);
+
+  // Complete the PERST pulse
+  BoardPcieAssertPerst (RootComplex, PcieIndex, TRUE);
+
+  // Start link training
+  StartLinkTraining (RootComplex, PcieIndex, TRUE);
+
+  // Lock programming of config space
+  EnableDbiAccess (RootComplex, PcieIndex, FALSE);
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Read the link capabilities of the endpoints trained in the lowest bifurcation
+  mode and switch the Root Complex to the mode that fits them.
+
+  @param RootComplex           Pointer to Root Complex structure
+
+  @retval TRUE                 The bifurcation mode changed and the Root Complex
+                               must be set up again.
+  @retval FALSE                The Root Complex is already set up in its mode.
+**/
+STATIC
+BOOLEAN
+Ac01PcieCoreUpdateBifurcation (
+  IN AC01_ROOT_COMPLEX  *RootComplex
+  )
+{
+  PHYSICAL_ADDRESS              TargetAddress;
+  EFI_STATUS                    Status;
+  UINT8                         PcieIndex;
+  PCI_REG_PCIE_LINK_CAPABILITY  LinkCap[MaxPcieController];
+  AC01_PCIE_CONTROLLER          *Pcie;
+  DEV_MAP_MODE                  DevMapMode;
+
+  SetMem ((VOID *)LinkCap, sizeof (LinkCap), 0);
   for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
-    if (ReInit) {
-      PcieIndex = ReInitPcieIndex;
+    Pcie = &RootComplex->Pcie[PcieIndex];
+    if (!Pcie->Active || !PcieLinkUpCheck (Pcie)) {
+      continue;
     }
 
-    if (!RootComplex->Pcie[PcieIndex].Active) {
+    DEBUG ((DEBUG_INFO, "RootComplex->ID:%d Port:%d link up\n", RootComplex->ID, PcieIndex));
+    TargetAddress = GetCapabilityBase (RootComplex, PcieIndex, FALSE, EFI_PCI_CAPABILITY_ID_PCIEXP);
+    if (TargetAddress == 0) {
       continue;
     }
 
-    DEBUG ((DEBUG_INFO, "Initializing Controller %d\n", PcieIndex));
+    LinkCap[PcieIndex].Uint32 = MmioRead32 (TargetAddress + LINK_CAPABILITIES_REG);
+  }
 
-    CsrBase = RootComplex->Pcie[PcieIndex].CsrBase;
-    CfgBase = RootComplex->MmcfgBase + (RootComplex->Pcie[PcieIndex].DevNum << DEV_SHIFT);
+  Status = Ac01PcieCorrectBifurcation (RootComplex, LinkCap, MaxPcieControllerOfRootComplexA, &DevMapMode);
+  if (!EFI_ERROR (Status)) {
+    RootComplex->DevMapLow = DevMapMode;
+    DEBUG ((
+      DEBUG_INFO,
+      "RootComplex->ID:%d Auto Bifurcation done, DevMapMode:%d\n",
+      RootComplex->ID,
+      RootComplex->DevMapLow
+      ));
+  } else {
+    RootComplex->DevMapLow = DevMapMode1;
+    DEBUG ((
+      DEBUG_INFO,
+      "RootComplex->ID:%d Auto Bifurcation failed, revert to DevMapMode1\n",
+      RootComplex->ID
+      ));
+  }
 
-    // Put Controller into reset if not in reset already
-    TargetAddress = CsrBase + AC01_PCIE_CORE_RESET_REG;
-    Val           = MmioRead32 (TargetAddress);
-    if (!(Val & RESET_MASK)) {
-      Val = DWC_PCIE_SET (Val, ASSERT_RESET);
-      MmioWrite32 (TargetAddress, Val);
+  if (RootComplex->DevMapLow == DevMapMode4) {
+    // The RootComplex is already initialized in this mode
+    return FALSE;
+  }
 
-      // Delay 50ms to ensure controller finish its reset
-      MicroSecondDelay (50000);
-    }
+  //
+  // Update the RootComplex data with new DevMapMode
+  //
+  Ac01PcieUpdateActive (RootComplex);
+  Ac01PcieUpdateMaxWidth (RootComplex);
 
-    if (!EnableItsMemory (RootComplex, PcieIndex)) {
-      DEBUG ((DEBUG_ERROR, "- Pcie[%d] - ITS Memory is not ready\n", PcieIndex));
-      return RETURN_DEVICE_ERROR;
-    }
+  return TRUE;
+}
+
+/**
+  Bring up a list of Root Complexes in phases.
+
+  Every phase is applied to all Root Complexes before the settle time that
+  follows it, so each settle time is waited for once per phase rather than once
+  per Root Complex and PCIe controller:
+
+    1. Select the bifurcation mode and program the Host Bridge.
+    2. Initialize the PHY and put the PCIe controllers into reset.
+    3. Program the PCIe controllers and start link training.
+    4. For Root Complexes in auto bifurcation mode, correct the mode from the
+       trained links and repeat from 1 for those whose mode changed.
+
+  A Root Complex that fails to initialize is marked inactive.
+
+  @param RootComplexList       Pointer to the Root Complex list
+  @param Count                 Number of entries in RootComplexList
+  @param TimingList            Optional per Root Complex timing, indexed like
+                               RootComplexList. SetupTimeUs is filled in.
+**/
+STATIC
+VOID
+Ac01PcieCoreSetupRootComplexes (
+  IN OUT AC01_ROOT_COMPLEX    *RootComplexList,
+  IN     UINTN                Count,
+  IN OUT AC01_PCIE_RC_TIMING  *TimingList  OPTIONAL
+  )
+{
+  AC01_ROOT_COMPLEX  *RootComplex;
+  BOOLEAN            Pending[AC01_PCIE_MAX_ROOT_COMPLEX];
+  BOOLEAN            AutoLaneBifurcationEnabled[AC01_PCIE_MAX_ROOT_COMPLEX];
+  BOOLEAN            AnyPending;
+  BOOLEAN            ResetAsserted;
+  RETURN_STATUS      Status;
+  UINT64             StartTick;
+  UINT32             SetupTimeUs[AC01_PCIE_MAX_ROOT_COMPLEX];
+  UINTN              Index;
+  UINT8              PcieIndex;
+
+  ASSERT (Count <= AC01_PCIE_MAX_ROOT_COMPLEX);
+
+  for (Index = 0; Index < Count; Index++) {
+    Pending[Index]                    = RootComplexList[Index].Active;
+    AutoLaneBifurcationEnabled[Index] = FALSE;
+    SetupTimeUs[Index]                = 0;
+  }
 
-    // Hold link training
-    StartLinkTraining (RootComplex, PcieIndex, FALSE);
+  while (TRUE) {
+    AnyPending = FALSE;
+    for (Index = 0; Index < Count; Index++) {
+      if (!Pending[Index]) {
+        continue;
+      }
 
-    // Clear BUSCTRL.CfgUrMask to set CRS (Configuration Request Retry Status) to 0xFFFF.FFFF
-    // rather than 0xFFFF.0001 as per PCIe specification requirement. Otherwise, this causes
-    // device drivers respond incorrectly on timeout due to long device operations.
-    TargetAddress = CsrBase + AC01_PCIE_CORE_BUS_CONTROL_REG;
-    Val           = MmioRead32 (TargetAddress);
-    Val          &= ~BUS_CTL_CFG_UR_MASK;
-    MmioWrite32 (TargetAddress, Val);
+      RootComplex = &RootComplexList[Index];
+      DEBUG ((DEBUG_INFO, "Initializing Socket%d RootComplex%d\n", RootComplex->Socket, RootComplex->ID));
 
-    if (!EnableAxiPipeClock (RootComplex, PcieIndex)) {
-      DEBUG ((DEBUG_ERROR, "- Pcie[%d] - PIPE clock is not stable\n", PcieIndex));
-      return RETURN_DEVICE_ERROR;
+      StartTick                         = ArmGenericTimerGetSystemCount ();
+      AutoLaneBifurcationEnabled[Index] = Ac01PcieCorePrepareRC (RootComplex);
+      SetupTimeUs[Index]               += GetElapsedTimeUs (StartTick);
+      AnyPending                        = TRUE;
     }
 
-    // Start PERST pulse
-    BoardPcieAssertPerst (RootComplex, PcieIndex, TRUE);
+    if (!AnyPending) {
+      break;
+    }
 
-    // Allow programming to config space
-    EnableDbiAccess (RootComplex, PcieIndex, TRUE);
+    // Fix for UEFI hang due to timing change with bifurcation
+    // register moved very close to PHY initialization.
+    MicroSecondDelay (HOST_BRIDGE_SETTLE_DELAY_US);
 
-    // Program the power limit
-    TargetAddress = CfgBase + PCIE_CAPABILITY_BASE + SLOT_CAPABILITIES_REG;
-    Val           = MmioRead32 (TargetAddress);
-    // In order to detect the NVMe after OS boots successfully but
-    // that NVMe's not present previously. Hot Plug Slot Capable
-    // will help PCI Linux driver to initialize its slot iomem resource
-    // which is used for detecting the disk when it's inserted.
-    Val = SLOT_HPC_SET (Val, 1);
-    Val = SLOT_CAP_SLOT_POWER_LIMIT_VALUE_SET (Val, SLOT_POWER_LIMIT_75W);
-    MmioWrite32 (TargetAddress, Val);
-
-    // Program DTI for ATS support
-    TargetAddress = CfgBase + DTIM_CTRL0_OFF;
-    Val           = MmioRead32 (TargetAddress);
-    Val           = DTIM_CTRL0_ROOT_PORT_ID_SET (Val, 0);
-    MmioWrite32 (TargetAddress, Val);
+    ResetAsserted = FALSE;
+    for (Index = 0; Index < Count; Index++) {
+      if (!Pending[Index]) {
+        continue;
+      }
 
-    //
-    // Program number of lanes used
-    // - Reprogram LINK_CAPABLE of PORT_LINK_CTRL_OFF
-    // - Reprogram NUM_OF_LANES of GEN2_CTRL_OFF
-    // - Reprogram CAP_MAX_LINK_WIDTH of LINK_CAPABILITIES_REG
-    //
-    ProgramLinkCapabilities (RootComplex, PcieIndex);
+      RootComplex = &RootComplexList[Index];
+      StartTick   = ArmGenericTimerGetSystemCount ();
+      Status      = PciePhyInit (RootComplex->SerdesBase);
+      if (RETURN_ERROR (Status)) {
+        DEBUG ((
+          DEBUG_ERROR,
+          "%a: S%d-RC%d: Failed to initialize the PCIe PHY\n",
+          __func__,
+          RootComplex->Socket,
+          RootComplex->ID
+          ));
+        RootComplex->Active = FALSE;
+        Pending[Index]      = FALSE;
+        continue;
+      }
 
-    // Set Zero byte request handling
-    TargetAddress = CfgBase + FILTER_MASK_2_OFF;
-    Val           = MmioRead32 (TargetAddress);
-    Val           = CX_FLT_MASK_VENMSG0_DROP_SET (Val, 0);
-    Val           = CX_FLT_MASK_VENMSG1_DROP_SET (Val, 0);
-    Val           = CX_FLT_MASK_DABORT_4UCPL_SET (Val, 0);
-    MmioWrite32 (TargetAddress, Val);
+      for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+        if (RootComplex->Pcie[PcieIndex].Active &&
+            Ac01PcieCoreAssertReset (RootComplex, PcieIndex))
+        {
+          ResetAsserted = TRUE;
+        }
+      }
 
-    TargetAddress = CfgBase + AMBA_ORDERING_CTRL_OFF;
-    Val           = MmioRead32 (TargetAddress);
-    Val           = AX_MSTR_ZEROLREAD_FW_SET (Val, 0);
-    MmioWrite32 (TargetAddress, Val);
+      SetupTimeUs[Index] += GetElapsedTimeUs (StartTick);
+    }
 
-    //
-    // Set Completion with CRS handling for CFG Request
-    // Set Completion with CA/UR handling non-CFG Request
-    //
-    TargetAddress = CfgBase + AMBA_ERROR_RESPONSE_DEFAULT_OFF;
-    Val           = MmioRead32 (TargetAddress);
-    // 0x2: OKAY with FFFF_0001 and FFFF_FFFF
-    Val = AMBA_ERROR_RESPONSE_CRS_SET (Val, 0x2);
-    MmioWrite32 (TargetAddress, Val);
-
-    // Set Legacy PCIE interrupt map to INTA
-    TargetAddress = CfgBase + BRIDGE_CTRL_INT_PIN_INT_LINE_REG;
-    Val           = MmioRead32 (TargetAddress);
-    Val           = INT_PIN_SET (Val, IRQ_INT_A);
-    MmioWrite32 (TargetAddress, Val);
-
-    TargetAddress = CsrBase + AC01_PCIE_CORE_IRQ_SEL_REG;
-    Val           = MmioRead32 (TargetAddress);
-    Val           = INTPIN_SET (Val, IRQ_INT_A);
-    MmioWrite32 (TargetAddress, Val);
-
-    if (RootComplex->Pcie[PcieIndex].MaxGen >= LINK_SPEED_GEN2) {
-      ConfigureEqualization (RootComplex, PcieIndex);
-      if (RootComplex->Pcie[PcieIndex].MaxGen >= LINK_SPEED_GEN3) {
-        ConfigurePresetGen3 (RootComplex, PcieIndex);
-        if (RootComplex->Pcie[PcieIndex].MaxGen >= LINK_SPEED_GEN4) {
-          ConfigurePresetGen4 (RootComplex, PcieIndex);
+    if (ResetAsserted) {
+      // Delay 50ms to ensure controllers finish their reset
+      MicroSecondDelay (CONTROLLER_RESET_DELAY_US);
+    }
+
+    AnyPending = FALSE;
+    for (Index = 0; Index < Count; Index++) {
+      if (!Pending[Index]) {
+        continue;
+      }
+
+      RootComplex = &RootComplexList[Index];
+      StartTick   = ArmGenericTimerGetSystemCount ();
+      for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+        if (!RootComplex->Pcie[PcieIndex].Active) {
+          continue;
+        }
+
+        Status = Ac01PcieCoreSetupController (RootComplex, PcieIndex);
+        if (RETURN_ERROR (Status)) {
+          DEBUG ((DEBUG_ERROR, "S%d-RC%d: Failed\n", RootComplex->Socket, RootComplex->ID));
+          RootComplex->Active               = FALSE;
+          AutoLaneBifurcationEnabled[Index] = FALSE;
+          break;
         }
       }
+
+      SetupTimeUs[Index] += GetElapsedTimeUs (StartTick);
+      Pending[Index]      = AutoLaneBifurcationEnabled[Index];
+      AnyPending         |= Pending[Index];
+    }
+
+    if (!AnyPending) {
+      break;
     }
 
     //
-    // As AMBA_LINK_TIMEOUT_OFF spec, it impacts OS HP removal delay.
-    // The greater value the longer delay it is. Per discussion,
-    // set it 2 from beginning of RP initialization.
+    // As per 2.7.2. AC Specifications of PCIe card specification this TPVPERL time and
+    // should be minimum 100ms. So this is minimum time we need add and found during test.
     //
-    SetLinkTimeout (RootComplex, PcieIndex, 2);
-
-    DisableCompletionTimeOut (RootComplex, PcieIndex, TRUE);
+    MicroSecondDelay (TPVPERL_DELAY_US);
 
-    ProgramRootPortInfo (RootComplex, PcieIndex);
+    for (Index = 0; Index < Count; Index++) {
+      if (!Pending[Index]) {
+        continue;
+      }
 
-    // Enable common clock for downstream
-    TargetAddress = CfgBase + PCIE_CAPABILITY_BASE + LINK_CONTROL_LINK_STATUS_REG;
-    Val           = MmioRead32 (TargetAddress);
-    Val           = CAP_SLOT_CLK_CONFIG_SET (Val, 1);
-    Val           = CAP_COMMON_CLK_SET (Val, 1);
-    MmioWrite32 (TargetAddress, Val);
+      StartTick           = ArmGenericTimerGetSystemCount ();
+      Pending[Index]      = Ac01PcieCoreUpdateBifurcation (&RootComplexList[Index]);
+      SetupTimeUs[Index] += GetElapsedTimeUs (StartTick);
+    }
+  }
 
-    // Match aux_clk to system
-    TargetAddress = CfgBase + AUX_CLK_FREQ_OFF;
-    Val           = MmioRead32 (TargetAddress);
-    Val           = AUX_CLK_FREQ_SET (Val, AUX_CLK_500MHZ);
-    MmioWrite32 (TargetAddress, Val);
+  if (TimingList != NULL) {
+    for (Index = 0; Index < Count; Index++) {
+      TimingList[Index].SetupTimeUs = SetupTimeUs[Index];
+    }
+  }
+}
 
-    // Assert PERST low to reset endpoint
-    BoardPcieAssertPerst (RootComplex, PcieIndex, FALSE);
+/**
+  Setup and initialize the AC01 PCIe Root Complex and underneath PCIe controllers
 
-    // Complete the PERST pulse
-    BoardPcieAssertPerst (RootComplex, PcieIndex, TRUE);
+  @param RootComplex           Pointer to Root Complex structure
+  @param ReInit                Re-init status
+  @param ReInitPcieIndex       PCIe controller index
 
-    // Start link training
-    StartLinkTraining (RootComplex, PcieIndex, TRUE);
+  @retval RETURN_SUCCESS       The Root Complex has been initialized successfully.
+  @retval RETURN_DEVICE_ERROR  PHY, Memory or PIPE is not ready.
+**/
+RETURN_STATUS
+Ac01PcieCoreSetupRC (
+  IN AC01_ROOT_COMPLEX  *RootComplex,
+  IN BOOLEAN            ReInit,
+  IN UINT8              ReInitPcieIndex
+  )
+{
+  if (!ReInit) {
+    Ac01PcieCoreSetupRootComplexes (RootComplex, 1, NULL);
+    return RootComplex->Active ? RETURN_SUCCESS : RETURN_DEVICE_ERROR;
+  }
 
-    // Lock programming of config space
-    EnableDbiAccess (RootComplex, PcieIndex, FALSE);
+  if (!RootComplex->Pcie[ReInitPcieIndex].Active) {
+    return RETURN_SUCCESS;
+  }
 
-    if (ReInit) {
-      return RETURN_SUCCESS;
-    }
+  if (Ac01PcieCoreAssertReset (RootComplex, ReInitPcieIndex)) {
+    // Delay 50ms to ensure controller finish its reset
+    MicroSecondDelay (CONTROLLER_RESET_DELAY_US);
   }
 
-  if (AutoLaneBifurcationEnabled) {
-    goto AutoLaneBifurcationRetry;
+  return Ac01PcieCoreSetupController (RootComplex, ReInitPcieIndex);
+}
+
+/**
+  Setup and initialize all active Root Complexes and underneath PCIe controllers.
+
+  @param RootComplexList       Pointer to the Root Complex list
+  @param TimingList            Optional AC01_PCIE_MAX_ROOT_COMPLEX entries that
+                               receive the setup time of each Root Complex.
+**/
+VOID
+Ac01PcieCoreSetupAllRC (
+  IN OUT AC01_ROOT_COMPLEX    *RootComplexList,
+  OUT    AC01_PCIE_RC_TIMING  *TimingList  OPTIONAL
+  )
+{
+  if (TimingList != NULL) {
+    ZeroMem (TimingList, sizeof (AC01_PCIE_RC_TIMING) * AC01_PCIE_MAX_ROOT_COMPLEX);
   }
 
-  return RETURN_SUCCESS;
+  Ac01PcieCoreSetupRootComplexes (RootComplexList, AC01_PCIE_MAX_ROOT_COMPLEX, TimingList);
 }
 
 BOOLEAN
@@ -1798,23 +2059,69 @@ Ac01PcieCoreUpdateLink (
   }
 }
 
+/**
+  Check whether every active PCIe controller of the Root Complex that has a
+  link partner has link up.
+
+  Controllers without a device behind them never train, so they are not
+  waited for. They are still retried by Ac01PcieCoreUpdateLink once the
+  polling ends.
+
+  @param RootComplex          Pointer to the Root Complex structure
+
+  @retval TRUE                All active controllers with a device present are in L0.
+**/
+STATIC
+BOOLEAN
+Ac01PcieCoreAllLinkUp (
+  IN AC01_ROOT_COMPLEX  *RootComplex
+  )
+{
+  AC01_PCIE_CONTROLLER  *Pcie;
+  UINT8                 PcieIndex;
+
+  for (PcieIndex = 0; PcieIndex < RootComplex->MaxPcieController; PcieIndex++) {
+    Pcie = &RootComplex->Pcie[PcieIndex];
+    if (Pcie->Active && !Pcie->LinkUp && !PcieLinkUpCheck (Pcie) &&
+        Ac01PcieCoreCheckCardPresent (Pcie))
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
   Verify the link status and retry to initialize the Root Complex if there's any issue.
 
+  The links of all Root Complexes are polled against a single deadline. Polling
+  ends early, after a short settle time, once every active controller with a
+  device present is up. A device detected during the settle time restores the
+  full deadline.
+
   @param RootComplexList      Pointer to the Root Complex list
+  @param TimingList           Optional AC01_PCIE_MAX_ROOT_COMPLEX entries whose
+                              LinkUpTimeUs receives the time each Root Complex
+                              took to bring all its links up in the first round.
 **/
 VOID
 Ac01PcieCorePostSetupRC (
-  IN AC01_ROOT_COMPLEX  *RootComplexList
+  IN     AC01_ROOT_COMPLEX    *RootComplexList,
+  IN OUT AC01_PCIE_RC_TIMING  *TimingList  OPTIONAL
   )
 {
   UINT8    RCIndex, Idx;
   BOOLEAN  IsNextRoundNeeded, NextRoundNeeded;
-  UINT64   PrevTick, CurrTick, ElapsedCycle;
+  UINT64   StartTick, PrevTick, CurrTick, ElapsedCycle;
   UINT64   TimerTicks64;
+  UINT64   LinkUpTicks;
+  UINT64   SettleTicks;
   UINT8    ReInit;
   INT8     FailedPciePtr[MaxPcieControllerOfRootComplexB];
   INT8     FailedPcieCount;
+  BOOLEAN  AllLinkUp;
+  BOOLEAN  LinkUpDone[AC01_PCIE_MAX_ROOT_COMPLEX];
 
   ReInit = 0;
 
@@ -1824,9 +2131,13 @@ _link_polling:
   // It is not guaranteed the timer service is ready prior to PCI Dxe.
   // Calculate system ticks for link training.
   //
-  TimerTicks64 = ArmGenericTimerGetTimerFreq (); /* 1 Second */
-  PrevTick     = ArmGenericTimerGetSystemCount ();
+  LinkUpTicks  = ArmGenericTimerGetTimerFreq (); /* 1 Second */
+  SettleTicks  = DivU64x32 (MultU64x32 (LinkUpTicks, LINK_SETTLE_TIMEOUT_US), 1000000);
+  TimerTicks64 = LinkUpTicks;
+  StartTick    = ArmGenericTimerGetSystemCount ();
+  PrevTick     = StartTick;
   ElapsedCycle = 0;
+  SetMem (LinkUpDone, sizeof (LinkUpDone), FALSE);
 
   do {
     CurrTick = ArmGenericTimerGetSystemCount ();
@@ -1837,8 +2148,50 @@ _link_polling:
 
     ElapsedCycle += (CurrTick - PrevTick);
     PrevTick      = CurrTick;
+
+    AllLinkUp = TRUE;
+    for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
+      if (!RootComplexList[RCIndex].Active) {
+        continue;
+      }
+
+      //
+      // Keep checking Root Complexes that are already up, a device may be
+      // detected on one of their controllers later.
+      //
+      if (!Ac01PcieCoreAllLinkUp (&RootComplexList[RCIndex])) {
+        AllLinkUp = FALSE;
+        continue;
+      }
+
+      if (!LinkUpDone[RCIndex]) {
+        LinkUpDone[RCIndex] = TRUE;
+        if ((TimingList != NULL) && (ReInit == 0)) {
+          TimingList[RCIndex].LinkUpTimeUs = GetElapsedTimeUs (StartTick);
+        }
+      }
+    }
+
+    if (AllLinkUp) {
+      //
+      // Every link with a device reached L0. Leave time for speed changes that
+      // follow the initial training before the links are checked, then stop
+      // waiting.
+      //
+      TimerTicks64 = MIN (TimerTicks64, ElapsedCycle + SettleTicks);
+    } else {
+      TimerTicks64 = LinkUpTicks;
+    }
   } while (ElapsedCycle < TimerTicks64);
 
+  if ((TimingList != NULL) && (ReInit == 0)) {
+    for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
+      if (RootComplexList[RCIndex].Active && !LinkUpDone[RCIndex]) {
+        TimingList[RCIndex].LinkUpTimeUs = GetElapsedTimeUs (StartTick);
+      }
+    }
+  }
+
   for (RCIndex = 0; RCIndex < AC01_PCIE_MAX_ROOT_COMPLEX; RCIndex++) {
     Ac01PcieCoreUpdateLink (&RootComplexList[RCIndex], &IsNextRoundNeeded, FailedPciePtr, &FailedPcieCount);
     if (IsNextRoundNeeded) {
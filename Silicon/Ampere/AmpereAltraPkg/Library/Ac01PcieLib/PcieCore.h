@@ -42,6 +42,11 @@
 #define EP_LINKUP_EXTRA_TIMEOUT   (500 * 1000)       // 500ms
 #define LINK_WAIT_INTERVAL_US     50
 
+#define HOST_BRIDGE_SETTLE_DELAY_US  100000          // 100 ms
+#define CONTROLLER_RESET_DELAY_US    50000           // 50 ms
+#define TPVPERL_DELAY_US             100000          // 100 ms
+#define LINK_SETTLE_TIMEOUT_US       100000          // 100 ms
+
 #define PFA_MODE_ENABLE  0
 #define PFA_MODE_CLEAR   1
 #define PFA_MODE_READ    2
@@ -8,16 +8,22 @@
 
 #include <Uefi.h>
 
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/FlashLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Protocol/FirmwareManagement.h>
 
 #include "FlashLibCommon.h"
 
 UINT8  *gFlashLibPhysicalBuffer;
 UINT8  *gFlashLibVirtualBuffer;
 
+STATIC UINT32   mFlashSectorSize        = 0;
+STATIC BOOLEAN  mFlashSectorSizeQueried = FALSE;
+
 /**
   Convert Virtual Address to Physical Address at Runtime.
 
@@ -38,6 +44,211 @@ ConvertToPhysicalBuffer (
   return gFlashLibPhysicalBuffer;
 }
 
+/**
+  Check whether a buffer only holds erased Flash content.
+
+  @param[in] Buffer           Pointer to the buffer.
+  @param[in] Length           Number of bytes to check.
+
+  @retval TRUE                Every byte reads as erased.
+  @retval FALSE               At least one byte is programmed.
+**/
+STATIC
+BOOLEAN
+IsBufferErased (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    if (Buffer[Index] != FLASH_ERASED_BYTE) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Get the erase granularity of the Flash device.
+
+  The value is queried from the secure world once and then remembered.
+
+  @retval Sector size in bytes, or zero if it is not available.
+**/
+STATIC
+UINT32
+FlashGetSectorSize (
+  VOID
+  )
+{
+  EFI_MM_COMMUNICATE_SPINOR_RESPONSE  MmSpiNorRes;
+  EFI_STATUS                          Status;
+  UINT64                              MmData[5];
+
+  if (mFlashSectorSizeQueried) {
+    return mFlashSectorSize;
+  }
+
+  mFlashSectorSizeQueried = TRUE;
+
+  MmData[0] = MM_SPINOR_FUNC_GET_INFO;
+
+  Status = FlashMmCommunicate (
+             MmData,
+             sizeof (MmData),
+             &MmSpiNorRes,
+             sizeof (MmSpiNorRes)
+             );
+  if (  EFI_ERROR (Status)
+     || (MmSpiNorRes.Status != MM_SPINOR_RES_SUCCESS)
+     || (MmSpiNorRes.SectorSize > MAX_UINT32))
+  {
+    return 0;
+  }
+
+  mFlashSectorSize = (UINT32)MmSpiNorRes.SectorSize;
+
+  return mFlashSectorSize;
+}
+
+/**
+  Read at most one temp buffer worth of data from the Flash.
+
+  The data is left in the temp buffer and can be accessed through
+  gFlashLibVirtualBuffer.
+
+  @param[in] ByteAddress         Start address of the region.
+  @param[in] Length              Number of bytes to read.
+
+  @retval EFI_SUCCESS            Operation succeeded.
+  @retval Others                 An error has occurred.
+**/
+STATIC
+EFI_STATUS
+FlashReadToTempBuffer (
+  IN UINTN   ByteAddress,
+  IN UINT32  Length
+  )
+{
+  EFI_MM_COMMUNICATE_SPINOR_RESPONSE  MmSpiNorRes;
+  EFI_STATUS                          Status;
+  UINT64                              MmData[5];
+
+  ASSERT (Length <= EFI_MM_MAX_TMP_BUF_SIZE);
+
+  MmData[0] = MM_SPINOR_FUNC_READ;
+  MmData[1] = ByteAddress;
+  MmData[2] = Length;
+  MmData[3] = (UINT64)gFlashLibPhysicalBuffer;  // Read data into the temp buffer with specified virtual address
+
+  Status = FlashMmCommunicate (
+             MmData,
+             sizeof (MmData),
+             &MmSpiNorRes,
+             sizeof (MmSpiNorRes)
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (MmSpiNorRes.Status != MM_SPINOR_RES_SUCCESS) {
+    DEBUG ((DEBUG_ERROR, "%a: Device error %llx\n", __func__, MmSpiNorRes.Status));
+    return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Check whether a region of the Flash already reads back as erased.
+
+  The region is read one temp buffer at a time and the check stops at the
+  first programmed byte, so a programmed region usually costs a single read.
+
+  @param[in]  ByteAddress        Start address of the region.
+  @param[in]  Length             Number of bytes to check.
+  @param[out] Erased             TRUE if the whole region is erased.
+
+  @retval EFI_SUCCESS            Operation succeeded.
+  @retval Others                 An error has occurred.
+**/
+STATIC
+EFI_STATUS
+FlashIsRegionErased (
+  IN  UINTN    ByteAddress,
+  IN  UINT32   Length,
+  OUT BOOLEAN  *Erased
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      NumRead;
+  UINT32      Count;
+
+  *Erased = FALSE;
+
+  for (Count = 0; Count < Length; Count += NumRead) {
+    NumRead = MIN (Length - Count, EFI_MM_MAX_TMP_BUF_SIZE);
+
+    Status = FlashReadToTempBuffer (ByteAddress + Count, NumRead);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (!IsBufferErased (gFlashLibVirtualBuffer, NumRead)) {
+      return EFI_SUCCESS;
+    }
+  }
+
+  *Erased = TRUE;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Send a single erase request for a region of the Flash.
+
+  @param[in] ByteAddress         Start address of the region.
+  @param[in] Length              Number of bytes to erase.
+
+  @retval EFI_SUCCESS            Operation succeeded.
+  @retval Others                 An error has occurred.
+**/
+STATIC
+EFI_STATUS
+FlashEraseRegion (
+  IN  UINTN   ByteAddress,
+  IN  UINT32  Length
+  )
+{
+  EFI_MM_COMMUNICATE_SPINOR_RESPONSE  MmSpiNorRes;
+  EFI_STATUS                          Status;
+  UINT64                              MmData[5];
+
+  MmData[0] = MM_SPINOR_FUNC_ERASE;
+  MmData[1] = ByteAddress;
+  MmData[2] = Length;
+
+  Status = FlashMmCommunicate (
+             MmData,
+             sizeof (MmData),
+             &MmSpiNorRes,
+             sizeof (MmSpiNorRes)
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (MmSpiNorRes.Status != MM_SPINOR_RES_SUCCESS) {
+    DEBUG ((DEBUG_ERROR, "%a: Device error %llx\n", __func__, MmSpiNorRes.Status));
+    return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Get the information about the Flash region to store the FailSafe status.
 
@@ -212,53 +423,97 @@ FlashEraseCommand (
   IN  UINT32  Length
   )
 {
-  EFI_MM_COMMUNICATE_SPINOR_RESPONSE  MmSpiNorRes;
-  EFI_STATUS                          Status;
-  UINT64                              MmData[5];
+  EFI_STATUS  Status;
+  BOOLEAN     Erased;
+  UINT32      SectorSize;
+  UINT32      Offset;
+  UINT32      PendingOffset;
+  UINT32      PendingLength;
 
   if (Length == 0) {
     return EFI_INVALID_PARAMETER;
   }
 
-  MmData[0] = MM_SPINOR_FUNC_ERASE;
-  MmData[1] = ByteAddress;
-  MmData[2] = Length;
+  //
+  // Sector erases are slow compared to reading the sector back, so only the
+  // sectors that are not already blank are erased. Adjacent sectors that need
+  // erasing are still sent as one request. If the sector size is unknown or
+  // the region is not sector aligned, the region is checked as a whole.
+  //
+  SectorSize = FlashGetSectorSize ();
+  if (  (SectorSize == 0)
+     || ((ByteAddress % SectorSize) != 0)
+     || ((Length % SectorSize) != 0))
+  {
+    SectorSize = Length;
+  }
 
-  Status = FlashMmCommunicate (
-             MmData,
-             sizeof (MmData),
-             &MmSpiNorRes,
-             sizeof (MmSpiNorRes)
-             );
-  if (EFI_ERROR (Status)) {
-    return Status;
+  PendingOffset = 0;
+  PendingLength = 0;
+  for (Offset = 0; Offset < Length; Offset += SectorSize) {
+    Status = FlashIsRegionErased (ByteAddress + Offset, SectorSize, &Erased);
+    if (EFI_ERROR (Status)) {
+      Erased = FALSE;
+    }
+
+    if (!Erased) {
+      if (PendingLength == 0) {
+        PendingOffset = Offset;
+      }
+
+      PendingLength += SectorSize;
+      continue;
+    }
+
+    if (PendingLength > 0) {
+      Status = FlashEraseRegion (ByteAddress + PendingOffset, PendingLength);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      PendingLength = 0;
+    }
   }
 
-  if (MmSpiNorRes.Status != MM_SPINOR_RES_SUCCESS) {
-    DEBUG ((DEBUG_ERROR, "%a: Device error %llx\n", __func__, MmSpiNorRes.Status));
-    return EFI_DEVICE_ERROR;
+  if (PendingLength > 0) {
+    return FlashEraseRegion (ByteAddress + PendingOffset, PendingLength);
   }
 
   return EFI_SUCCESS;
 }
 
 /**
-  Write data buffer to the Flash.
+  Write data buffer to the Flash and report the progress of the operation.
+
+  NOR Flash programming can only clear bits, so programming a chunk that only
+  holds erased bytes leaves the Flash unchanged. Such chunks are skipped
+  instead of being sent to the secure world. As with FlashWriteCommand, the
+  caller is responsible for erasing the region first.
 
   @param[in] ByteAddress         Start address of the region.
   @param[in] Buffer              Pointer to the data buffer.
   @param[in] Length              Number of bytes to write.
+  @param[in] Progress            Optional function used to report the progress
+                                 of the operation.
+  @param[in] StartPercentage     The completion percentage reported before the
+                                 first chunk is written.
+  @param[in] EndPercentage       The completion percentage reported once the
+                                 last chunk is written.
 
   @retval EFI_SUCCESS            Operation succeeded.
-  @retval EFI_INVALID_PARAMETER  Buffer is NULL or Length is Zero.
+  @retval EFI_INVALID_PARAMETER  Buffer is NULL or Length is Zero, or
+                                 StartPercentage is above EndPercentage.
   @retval Others                 An error has occurred.
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-FlashWriteCommand (
-  IN  UINTN   ByteAddress,
-  IN  VOID    *Buffer,
-  IN  UINT32  Length
+FlashWriteCommandWithProgress (
+  IN  UINTN                                          ByteAddress,
+  IN  VOID                                           *Buffer,
+  IN  UINT32                                         Length,
+  IN  EFI_FIRMWARE_MANAGEMENT_UPDATE_IMAGE_PROGRESS  Progress         OPTIONAL,
+  IN  UINTN                                          StartPercentage,
+  IN  UINTN                                          EndPercentage
   )
 {
   EFI_MM_COMMUNICATE_SPINOR_RESPONSE  MmSpiNorRes;
@@ -266,42 +521,105 @@ FlashWriteCommand (
   UINT64                              MmData[5];
   UINTN                               Remain, NumWrite;
   UINTN                               Count = 0;
+  UINTN                               Skipped;
+  UINTN                               Percentage;
+  UINTN                               LastPercentage;
+  UINT64                              StartTick;
+  UINT64                              ElapsedUs;
 
-  if ((Buffer == NULL) || (Length == 0)) {
+  if ((Buffer == NULL) || (Length == 0) || (StartPercentage > EndPercentage)) {
     return EFI_INVALID_PARAMETER;
   }
 
+  Skipped        = 0;
+  LastPercentage = StartPercentage;
+  StartTick      = GetPerformanceCounter ();
+
+  if (Progress != NULL) {
+    Progress (StartPercentage);
+  }
+
   Remain = Length;
   while (Remain > 0) {
     NumWrite = (Remain > EFI_MM_MAX_TMP_BUF_SIZE) ? EFI_MM_MAX_TMP_BUF_SIZE : Remain;
 
-    MmData[0] = MM_SPINOR_FUNC_WRITE;
-    MmData[1] = ByteAddress + Count;
-    MmData[2] = NumWrite;
-    MmData[3] = (UINT64)ConvertToPhysicalBuffer (Buffer + Count, NumWrite);
-
-    Status = FlashMmCommunicate (
-               MmData,
-               sizeof (MmData),
-               &MmSpiNorRes,
-               sizeof (MmSpiNorRes)
-               );
-    if (EFI_ERROR (Status)) {
-      return Status;
-    }
-
-    if (MmSpiNorRes.Status != MM_SPINOR_RES_SUCCESS) {
-      DEBUG ((DEBUG_ERROR, "%a: Device error 0x%llx\n", __func__, MmSpiNorRes.Status));
-      return EFI_DEVICE_ERROR;
+    if (IsBufferErased ((UINT8 *)Buffer + Count, NumWrite)) {
+      Skipped += NumWrite;
+    } else {
+      MmData[0] = MM_SPINOR_FUNC_WRITE;
+      MmData[1] = ByteAddress + Count;
+      MmData[2] = NumWrite;
+      MmData[3] = (UINT64)ConvertToPhysicalBuffer ((UINT8 *)Buffer + Count, NumWrite);
+
+      Status = FlashMmCommunicate (
+                 MmData,
+                 sizeof (MmData),
+                 &MmSpiNorRes,
+                 sizeof (MmSpiNorRes)
+                 );
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      if (MmSpiNorRes.Status != MM_SPINOR_RES_SUCCESS) {
+        DEBUG ((DEBUG_ERROR, "%a: Device error 0x%llx\n", __func__, MmSpiNorRes.Status));
+        return EFI_DEVICE_ERROR;
+      }
     }
 
     Remain -= NumWrite;
     Count  += NumWrite;
+
+    if (Progress != NULL) {
+      Percentage = StartPercentage + ((EndPercentage - StartPercentage) * Count) / Length;
+      if (Percentage != LastPercentage) {
+        Progress (Percentage);
+        LastPercentage = Percentage;
+      }
+    }
+  }
+
+  if (Progress != NULL) {
+    ElapsedUs = DivU64x32 (
+                  GetTimeInNanoSecond (GetPerformanceCounter () - StartTick),
+                  1000
+                  );
+    DEBUG ((
+      DEBUG_INFO,
+      "%a: Wrote 0x%x bytes (0x%lx blank bytes skipped) in %lu ms, %lu KB/s\n",
+      __func__,
+      Length,
+      Skipped,
+      DivU64x32 (ElapsedUs, 1000),
+      (ElapsedUs == 0) ? 0 : DivU64x64Remainder (MultU64x32 (Length, 1000000), MultU64x32 (ElapsedUs, 1024), NULL)
+      ));
   }
 
   return EFI_SUCCESS;
 }
 
+/**
+  Write data buffer to the Flash.
+
+  @param[in] ByteAddress         Start address of the region.
+  @param[in] Buffer              Pointer to the data buffer.
+  @param[in] Length              Number of bytes to write.
+
+  @retval EFI_SUCCESS            Operation succeeded.
+  @retval EFI_INVALID_PARAMETER  Buffer is NULL or Length is Zero.
+  @retval Others                 An error has occurred.
+**/
+EFI_STATUS
+EFIAPI
+FlashWriteCommand (
+  IN  UINTN   ByteAddress,
+  IN  VOID    *Buffer,
+  IN  UINT32  Length
+  )
+{
+  return FlashWriteCommandWithProgress (ByteAddress, Buffer, Length, NULL, 0, 0);
+}
+
 /**
   Read data from the Flash into Buffer.
 
@@ -321,11 +639,9 @@ FlashReadCommand (
   IN  UINT32  Length
   )
 {
-  EFI_MM_COMMUNICATE_SPINOR_RESPONSE  MmSpiNorRes;
-  EFI_STATUS                          Status;
-  UINT64                              MmData[5];
-  UINTN                               Remain, NumRead;
-  UINTN                               Count = 0;
+  EFI_STATUS  Status;
+  UINTN       Remain, NumRead;
+  UINTN       Count = 0;
 
   if ((Buffer == NULL) || (Length == 0)) {
     return EFI_INVALID_PARAMETER;
@@ -335,26 +651,11 @@ FlashReadCommand (
   while (Remain > 0) {
     NumRead = (Remain > EFI_MM_MAX_TMP_BUF_SIZE) ? EFI_MM_MAX_TMP_BUF_SIZE : Remain;
 
-    MmData[0] = MM_SPINOR_FUNC_READ;
-    MmData[1] = ByteAddress + Count;
-    MmData[2] = NumRead;
-    MmData[3] = (UINT64)gFlashLibPhysicalBuffer;  // Read data into the temp buffer with specified virtual address
-
-    Status = FlashMmCommunicate (
-               MmData,
-               sizeof (MmData),
-               &MmSpiNorRes,
-               sizeof (MmSpiNorRes)
-               );
+    Status = FlashReadToTempBuffer (ByteAddress + Count, (UINT32)NumRead);
     if (EFI_ERROR (Status)) {
       return Status;
     }
 
-    if (MmSpiNorRes.Status != MM_SPINOR_RES_SUCCESS) {
-      DEBUG ((DEBUG_ERROR, "%a: Device error %llx\n", __func__, MmSpiNorRes.Status));
-      return EFI_DEVICE_ERROR;
-    }
-
     //
     // Get data from the virtual address of the temp buffer.
     //
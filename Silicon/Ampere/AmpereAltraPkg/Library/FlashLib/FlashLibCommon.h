@@ -12,6 +12,8 @@
 #define EFI_MM_MAX_TMP_BUF_SIZE  0x4000
 #define EFI_MM_MAX_PAYLOAD_SIZE  0x50
 
+#define FLASH_ERASED_BYTE  0xFF
+
 #define MM_SPINOR_FUNC_GET_INFO           0x00
 #define MM_SPINOR_FUNC_READ               0x01
 #define MM_SPINOR_FUNC_WRITE              0x02
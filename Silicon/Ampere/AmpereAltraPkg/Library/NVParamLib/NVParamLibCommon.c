@@ -12,9 +12,146 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/NVParamLib.h>
+#include <Library/PcdLib.h>
 
 #include "NVParamLibCommon.h"
 
+STATIC NVPARAM_CACHE_ENTRY  mNVParamCache[NVPARAM_CACHE_ENTRIES];
+STATIC NVPARAM_STATISTICS   mNVParamStatistics;
+STATIC BOOLEAN              mNVParamCacheDisabled = FALSE;
+STATIC UINT32               mNVParamCacheGeneration;
+
+/**
+  Drop the whole read cache if any module has changed an NVParam since it
+  was filled.
+
+  Every module links its own copy of this library, so the read caches are
+  tied together by PcdNVParamGeneration, which all writers bump.
+**/
+STATIC
+VOID
+NVParamCacheSync (
+  VOID
+  )
+{
+  UINT32  Generation;
+
+  Generation = PcdGet32 (PcdNVParamGeneration);
+  if (Generation != mNVParamCacheGeneration) {
+    ZeroMem (mNVParamCache, sizeof (mNVParamCache));
+    mNVParamCacheGeneration = Generation;
+  }
+}
+
+/**
+  Tell the read caches of all modules that an NVParam has changed.
+
+  The new generation is taken from the PCD rather than from this module's
+  copy, which may be stale, so it never goes back to a value another module
+  already holds.
+**/
+STATIC
+VOID
+NVParamCacheBumpGeneration (
+  VOID
+  )
+{
+  RETURN_STATUS  Status;
+  UINT32         Generation;
+
+  Generation = PcdGet32 (PcdNVParamGeneration) + 1;
+  Status     = PcdSet32S (PcdNVParamGeneration, Generation);
+  ASSERT_RETURN_ERROR (Status);
+  mNVParamCacheGeneration = Generation;
+}
+
+/**
+  Return the cache slot that holds, or would hold, a parameter.
+
+  @param[in]  Param               Parameter ID.
+
+  @return  Pointer to the cache slot.
+**/
+STATIC
+NVPARAM_CACHE_ENTRY *
+NVParamCacheSlot (
+  IN UINT32  Param
+  )
+{
+  return &mNVParamCache[(Param / NVPARAM_SIZE) % NVPARAM_CACHE_ENTRIES];
+}
+
+/**
+  Drop any cached value of a parameter, in this module and in all others.
+
+  The slot is keyed by parameter only, so reads of the same parameter with a
+  different read permission are dropped as well.
+
+  @param[in]  Param               Parameter ID.
+**/
+STATIC
+VOID
+NVParamCacheInvalidate (
+  IN UINT32  Param
+  )
+{
+  NVPARAM_CACHE_ENTRY  *Entry;
+
+  if (mNVParamCacheDisabled) {
+    return;
+  }
+
+  NVParamCacheSync ();
+
+  Entry = NVParamCacheSlot (Param);
+  if (Entry->Valid && (Entry->Param == Param)) {
+    Entry->Valid = FALSE;
+  }
+
+  NVParamCacheBumpGeneration ();
+}
+
+/**
+  Stop serving reads from the cache and drop everything cached so far.
+
+  Used by library instances that outlive boot services, where parameters may
+  be changed behind the firmware's back.
+**/
+VOID
+NVParamCacheDisable (
+  VOID
+  )
+{
+  mNVParamCacheDisabled = TRUE;
+  ZeroMem (mNVParamCache, sizeof (mNVParamCache));
+}
+
+/**
+  Send one NVParam request to the secure world and account for it.
+
+  @param[in]  MmData              Request arguments.
+  @param[out] MmNVParamRes        Response from the secure world.
+
+  @retval EFI_SUCCESS             The request was delivered.
+  @retval Others                  An error has occurred.
+**/
+STATIC
+EFI_STATUS
+NVParamRequest (
+  IN  UINT64                               MmData[NVPARAM_MM_DATA_COUNT],
+  OUT EFI_MM_COMMUNICATE_NVPARAM_RESPONSE  *MmNVParamRes
+  )
+{
+  mNVParamStatistics.MmTransitions++;
+
+  return NVParamMmCommunicate (
+           MmData,
+           sizeof (UINT64) * NVPARAM_MM_DATA_COUNT,
+           MmNVParamRes,
+           sizeof (*MmNVParamRes)
+           );
+}
+
 /**
   Retrieve a non-volatile parameter.
 
@@ -40,32 +177,68 @@ NVParamGet (
 {
   EFI_MM_COMMUNICATE_NVPARAM_RESPONSE  MmNVParamRes;
   EFI_STATUS                           Status;
-  UINT64                               MmData[5];
+  NVPARAM_CACHE_ENTRY                  *Entry;
+  UINT64                               MmData[NVPARAM_MM_DATA_COUNT];
 
   if (Val == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
+  if (!mNVParamCacheDisabled) {
+    NVParamCacheSync ();
+  }
+
+  Entry = NVParamCacheSlot (Param);
+  if (  !mNVParamCacheDisabled && Entry->Valid
+     && (Entry->Param == Param) && (Entry->ACLRd == ACLRd))
+  {
+    mNVParamStatistics.CacheHits++;
+    if (Entry->NotSet) {
+      return EFI_NOT_FOUND;
+    }
+
+    *Val = Entry->Value;
+    return EFI_SUCCESS;
+  }
+
+  mNVParamStatistics.CacheMisses++;
+
+  ZeroMem (MmData, sizeof (MmData));
   MmData[0] = MM_NVPARAM_FUNC_READ;
   MmData[1] = Param;
   MmData[2] = (UINT64)ACLRd;
 
-  Status = NVParamMmCommunicate (
-             MmData,
-             sizeof (MmData),
-             &MmNVParamRes,
-             sizeof (MmNVParamRes)
-             );
+  Status = NVParamRequest (MmData, &MmNVParamRes);
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
+  //
+  // Only definite answers are cached. Permission and service failures are
+  // retried on the next read.
+  //
   switch (MmNVParamRes.Status) {
     case MM_NVPARAM_RES_SUCCESS:
       *Val = (UINT32)MmNVParamRes.Value;
+      if (!mNVParamCacheDisabled) {
+        Entry->Param  = Param;
+        Entry->ACLRd  = ACLRd;
+        Entry->Value  = *Val;
+        Entry->NotSet = FALSE;
+        Entry->Valid  = TRUE;
+      }
+
       return EFI_SUCCESS;
 
     case MM_NVPARAM_RES_NOT_SET:
+      if (!mNVParamCacheDisabled) {
+        Entry->Param  = Param;
+        Entry->ACLRd  = ACLRd;
+        Entry->Value  = 0;
+        Entry->NotSet = TRUE;
+        Entry->Valid  = TRUE;
+      }
+
       return EFI_NOT_FOUND;
 
     case MM_NVPARAM_RES_NO_PERM:
@@ -79,6 +252,58 @@ NVParamGet (
   }
 }
 
+/**
+  Retrieve a list of non-volatile parameters sharing the same read permission.
+
+  Parameters already read by the calling module are served from its read cache;
+  only the remaining ones are requested from the secure world. Every entry is
+  attempted even if an earlier one fails, and ValueList entries that could not
+  be read are left untouched so the caller can pre-load them with defaults.
+
+  @param[in]  ParamList           Array of parameter IDs to retrieve.
+  @param[in]  Count               Number of entries in ParamList.
+  @param[in]  ACLRd               Permission for read operation.
+  @param[out] ValueList           Array of Count UINT32 receiving the values.
+  @param[out] StatusList          Optional array of Count EFI_STATUS receiving
+                                  the NVParamGet status of each entry.
+
+  @retval EFI_SUCCESS             All parameters were retrieved.
+  @retval EFI_INVALID_PARAMETER   ParamList or ValueList is NULL.
+  @retval Others                  Status of the first parameter that could not
+                                  be retrieved, as returned by NVParamGet.
+**/
+EFI_STATUS
+NVParamGetMany (
+  IN  CONST UINT32  *ParamList,
+  IN  UINTN         Count,
+  IN  UINT16        ACLRd,
+  OUT UINT32        *ValueList,
+  OUT EFI_STATUS    *StatusList OPTIONAL
+  )
+{
+  EFI_STATUS  Status;
+  EFI_STATUS  ReturnStatus;
+  UINTN       Index;
+
+  if ((ParamList == NULL) || (ValueList == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ReturnStatus = EFI_SUCCESS;
+  for (Index = 0; Index < Count; Index++) {
+    Status = NVParamGet (ParamList[Index], ACLRd, &ValueList[Index]);
+    if (StatusList != NULL) {
+      StatusList[Index] = Status;
+    }
+
+    if (EFI_ERROR (Status) && !EFI_ERROR (ReturnStatus)) {
+      ReturnStatus = Status;
+    }
+  }
+
+  return ReturnStatus;
+}
+
 /**
   Set a non-volatile parameter.
 
@@ -107,20 +332,21 @@ NVParamSet (
 {
   EFI_MM_COMMUNICATE_NVPARAM_RESPONSE  MmNVParamRes;
   EFI_STATUS                           Status;
-  UINT64                               MmData[5];
+  UINT64                               MmData[NVPARAM_MM_DATA_COUNT];
 
+  ZeroMem (MmData, sizeof (MmData));
   MmData[0] = MM_NVPARAM_FUNC_WRITE;
   MmData[1] = Param;
   MmData[2] = (UINT64)ACLRd;
   MmData[3] = (UINT64)ACLWr;
   MmData[4] = (UINT64)Val;
 
-  Status = NVParamMmCommunicate (
-             MmData,
-             sizeof (MmData),
-             &MmNVParamRes,
-             sizeof (MmNVParamRes)
-             );
+  //
+  // Whatever the outcome, the cached copy can no longer be trusted.
+  //
+  NVParamCacheInvalidate (Param);
+
+  Status = NVParamRequest (MmData, &MmNVParamRes);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -162,19 +388,17 @@ NVParamClr (
 {
   EFI_MM_COMMUNICATE_NVPARAM_RESPONSE  MmNVParamRes;
   EFI_STATUS                           Status;
-  UINT64                               MmData[5];
+  UINT64                               MmData[NVPARAM_MM_DATA_COUNT];
 
+  ZeroMem (MmData, sizeof (MmData));
   MmData[0] = MM_NVPARAM_FUNC_CLEAR;
   MmData[1] = Param;
   MmData[2] = 0;
   MmData[3] = (UINT64)ACLWr;
 
-  Status = NVParamMmCommunicate (
-             MmData,
-             sizeof (MmData),
-             &MmNVParamRes,
-             sizeof (MmNVParamRes)
-             );
+  NVParamCacheInvalidate (Param);
+
+  Status = NVParamRequest (MmData, &MmNVParamRes);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -208,16 +432,17 @@ NVParamClrAll (
 {
   EFI_MM_COMMUNICATE_NVPARAM_RESPONSE  MmNVParamRes;
   EFI_STATUS                           Status;
-  UINT64                               MmData[5];
+  UINT64                               MmData[NVPARAM_MM_DATA_COUNT];
 
+  ZeroMem (MmData, sizeof (MmData));
   MmData[0] = MM_NVPARAM_FUNC_CLEAR_ALL;
 
-  Status = NVParamMmCommunicate (
-             MmData,
-             sizeof (MmData),
-             &MmNVParamRes,
-             sizeof (MmNVParamRes)
-             );
+  if (!mNVParamCacheDisabled) {
+    ZeroMem (mNVParamCache, sizeof (mNVParamCache));
+    NVParamCacheBumpGeneration ();
+  }
+
+  Status = NVParamRequest (MmData, &MmNVParamRes);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -233,3 +458,25 @@ NVParamClrAll (
       return EFI_INVALID_PARAMETER;
   }
 }
+
+/**
+  Retrieve the NVParam access statistics of the calling module.
+
+  @param[out] Statistics          Receives the current counter values.
+
+  @retval EFI_SUCCESS             Operation succeeded.
+  @retval EFI_INVALID_PARAMETER   Statistics is NULL.
+**/
+EFI_STATUS
+NVParamGetStatistics (
+  OUT NVPARAM_STATISTICS  *Statistics
+  )
+{
+  if (Statistics == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  CopyMem (Statistics, &mNVParamStatistics, sizeof (mNVParamStatistics));
+
+  return EFI_SUCCESS;
+}
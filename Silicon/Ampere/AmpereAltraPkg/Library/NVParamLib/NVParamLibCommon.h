@@ -21,6 +21,23 @@
 #define MM_NVPARAM_RES_NO_PERM  0xAABBCC02
 #define MM_NVPARAM_RES_FAIL     0xAABBCCFF
 
+#define NVPARAM_MM_DATA_COUNT  5
+
+//
+// Number of direct-mapped read cache slots, indexed by parameter entry. Each
+// module has its own cache; PcdNVParamGeneration invalidates all of them when
+// any module changes an NVParam.
+//
+#define NVPARAM_CACHE_ENTRIES  128
+
+typedef struct {
+  UINT32     Param;
+  UINT32     Value;
+  UINT16     ACLRd;
+  BOOLEAN    NotSet;
+  BOOLEAN    Valid;
+} NVPARAM_CACHE_ENTRY;
+
 #pragma pack (1)
 
 typedef struct {
@@ -68,4 +85,15 @@ NVParamMmCommunicate (
   IN  UINT32  ResponseDataSize
   );
 
+/**
+  Stop serving reads from the cache and drop everything cached so far.
+
+  Used by library instances that outlive boot services, where parameters may
+  be changed behind the firmware's back.
+**/
+VOID
+NVParamCacheDisable (
+  VOID
+  );
+
 #endif /* NV_PARAM_LIB_COMMON_H_ */
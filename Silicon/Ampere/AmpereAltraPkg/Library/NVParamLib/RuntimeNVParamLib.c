@@ -12,6 +12,7 @@
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/NVParamLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 #include <Protocol/MmCommunication2.h>
 
@@ -36,6 +37,36 @@ NVParamLibAddressChangeEvent (
   gRT->ConvertPointer (0x0, (VOID **)&mMmCommunicationProtocol);
 }
 
+/**
+  This is a notification function registered on EVT_SIGNAL_EXIT_BOOT_SERVICES
+  event. NVParams may be changed out of band once the OS owns the platform, so
+  runtime reads stop using the read cache.
+
+  @param  Event        Event whose notification function is being invoked.
+  @param  Context      Pointer to the notification function's context
+**/
+VOID
+EFIAPI
+NVParamLibExitBootServicesEvent (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  NVPARAM_STATISTICS  Statistics;
+
+  NVParamGetStatistics (&Statistics);
+  DEBUG ((
+    DEBUG_INFO,
+    "%a: %u MM transitions, %u cache hits, %u cache misses\n",
+    __func__,
+    Statistics.MmTransitions,
+    Statistics.CacheHits,
+    Statistics.CacheMisses
+    ));
+
+  NVParamCacheDisable ();
+}
+
 /**
   Constructor function of the RuntimeNVParamLib.
 
@@ -53,6 +84,7 @@ NVParamLibConstructor (
   )
 {
   EFI_EVENT   VirtualAddressChangeEvent = NULL;
+  EFI_EVENT   ExitBootServicesEvent     = NULL;
   EFI_STATUS  Status;
 
   Status = gBS->LocateProtocol (
@@ -71,6 +103,15 @@ NVParamLibConstructor (
                   );
   ASSERT_EFI_ERROR (Status);
 
+  Status = gBS->CreateEvent (
+                  EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                  TPL_CALLBACK,
+                  NVParamLibExitBootServicesEvent,
+                  NULL,
+                  &ExitBootServicesEvent
+                  );
+  ASSERT_EFI_ERROR (Status);
+
   return Status;
 }
 
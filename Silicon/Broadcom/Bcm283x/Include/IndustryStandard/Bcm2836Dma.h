@@ -0,0 +1,62 @@
+/** @file
+ *
+ *  SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ **/
+
+#ifndef __BCM2836_DMA_H__
+#define __BCM2836_DMA_H__
+
+#include <IndustryStandard/Bcm2836.h>
+
+/* DMA controller constants */
+
+#define BCM2836_DMA_CHANNEL_BASE_ADDRESS(Channel)           (BCM2836_DMA0_BASE_ADDRESS + (Channel) * BCM2836_DMA_CHANNEL_LENGTH)
+#define BCM2836_DMA_ENABLE                                  (BCM2836_DMA_CTRL_BASE_ADDRESS + 0x00000010)
+
+/*
+ * Offset between the ARM's view and the VC's (bus) view of the peripherals.
+ */
+#define BCM2836_PERIPHERAL_BUS_BASE_ADDRESS                 0x7E000000
+#define BCM2836_PERIPHERAL_BUS_ADDRESS(Address)             ((UINT32)((Address) - BCM2836_SOC_REGISTERS) + BCM2836_PERIPHERAL_BUS_BASE_ADDRESS)
+
+/* per-channel registers */
+#define BCM2836_DMA_CS                                      0x00000000
+#define BCM2836_DMA_CONBLK_AD                               0x00000004
+#define BCM2836_DMA_TXFR_LEN                                0x00000014
+#define BCM2836_DMA_DEBUG                                   0x00000020
+
+#define BCM2836_DMA_CS_ACTIVE                               BIT0
+#define BCM2836_DMA_CS_END                                  BIT1
+#define BCM2836_DMA_CS_INT                                  BIT2
+#define BCM2836_DMA_CS_ERROR                                BIT8
+#define BCM2836_DMA_CS_WAIT_FOR_OUTSTANDING_WRITES          BIT28
+#define BCM2836_DMA_CS_ABORT                                BIT30
+#define BCM2836_DMA_CS_RESET                                BIT31
+
+#define BCM2836_DMA_TI_WAIT_RESP                            BIT3
+#define BCM2836_DMA_TI_DEST_INC                             BIT4
+#define BCM2836_DMA_TI_DEST_DREQ                            BIT6
+#define BCM2836_DMA_TI_SRC_INC                              BIT8
+#define BCM2836_DMA_TI_SRC_DREQ                             BIT10
+#define BCM2836_DMA_TI_PERMAP(Dreq)                         (((Dreq) & 0x1F) << 16)
+
+/* peripheral DREQ numbers */
+#define BCM2836_DMA_DREQ_SDHOST                             13
+
+/*
+ * Control blocks must be 32-byte aligned.
+ */
+#define BCM2836_DMA_CONTROL_BLOCK_ALIGNMENT                 32
+
+typedef struct {
+  UINT32 TransferInformation;
+  UINT32 SourceAddress;
+  UINT32 DestinationAddress;
+  UINT32 TransferLength;
+  UINT32 Stride;
+  UINT32 NextControlBlock;
+  UINT32 Reserved[2];
+} BCM2836_DMA_CONTROL_BLOCK;
+
+#endif /* __BCM2836_DMA_H__ */
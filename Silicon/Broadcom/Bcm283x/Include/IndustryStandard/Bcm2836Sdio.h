@@ -19,12 +19,17 @@
 #define MMCHS1_LENGTH     0x00000100
 #define MMCHS2_LENGTH     0x00000100
 
+#define MMCHS_SYSADDR     (mMmcHsBase + 0x0)
+
 #define MMCHS_BLK         (mMmcHsBase + 0x4)
 #define BLEN_512BYTES     (0x200UL << 0)
+#define SDMA_BOUNDARY_512K (0x7UL << 12)
+#define SDMA_BOUNDARY_SIZE SIZE_512KB
 
 #define MMCHS_ARG         (mMmcHsBase + 0x8)
 
 #define MMCHS_CMD         (mMmcHsBase + 0xC)
+#define DE_ENABLE         BIT0
 #define BCE_ENABLE        BIT1
 #define DDIR_READ         BIT4
 #define DDIR_WRITE        (0x0UL << 4)
@@ -64,6 +69,8 @@
 #define MMCHS_HCTL        (mMmcHsBase + 0x28)
 #define DTW_1_BIT         (0x0UL << 1)
 #define DTW_4_BIT         BIT1
+#define DMAS_MASK         (0x3UL << 3)
+#define DMAS_SDMA         (0x0UL << 3)
 #define SDBP_MASK         BIT8
 #define SDBP_OFF          (0x0UL << 8)
 #define SDBP_ON           BIT8
@@ -92,6 +99,7 @@
 #define MMCHS_INT_STAT    (mMmcHsBase + 0x30)
 #define CC                BIT0
 #define TC                BIT1
+#define DINT              BIT3
 #define BWR               BIT4
 #define BRR               BIT5
 #define CARD_INS          BIT6
@@ -136,6 +144,7 @@
 #define MMCHS_HC2R        (mMmcHsBase + 0x3E)
 
 #define MMCHS_CAPA        (mMmcHsBase + 0x40)
+#define SDMA_SUPPORT      BIT22
 #define VS30              BIT25
 #define VS18              BIT26
 
@@ -1779,10 +1779,14 @@ PchSmiTypeCallbackDispatcher (
 {
   EFI_STATUS                            Status;
   PCH_SMI_TYPES                         PchSmiType;
+  UINT64                                EntryTsc;
+  UINT64                                Handler;
 
   PchSmiType = Record->PchSmiType;
   Status     = EFI_SUCCESS;
 
+  Handler  = (UINT64) (UINTN) Record->PchSmiCallback;
+  EntryTsc = SmiLatencyProfileBegin ();
   switch (PchSmiType) {
     case PchTcoSmiMchType:
     case PchTcoSmiTcoTimeoutType:
@@ -1816,6 +1820,8 @@ PchSmiTypeCallbackDispatcher (
       break;
   }
 
+  SmiLatencyProfileEnd (PCH_SMI_DISPATCH_SOURCE_PCH, Handler, EntryTsc);
+
   return Status;
 }
 
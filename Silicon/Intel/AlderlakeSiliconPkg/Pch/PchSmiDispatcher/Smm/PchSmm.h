@@ -27,6 +27,7 @@
 #include <Library/SmmServicesTableLib.h>
 #include <Library/ReportStatusCodeLib.h>
 #include <Library/PerformanceLib.h>
+#include <Library/SmiLatencyProfileLib.h>
 #include <Protocol/SmmReadyToLock.h>
 #include <IndustryStandard/Pci30.h>
 #include <Library/PchCycleDecodingLib.h>
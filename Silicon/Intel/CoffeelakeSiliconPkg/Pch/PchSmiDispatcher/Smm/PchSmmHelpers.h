@@ -11,6 +11,28 @@
 
 #include "PchSmm.h"
 #include "PchxSmmHelpers.h"
+
+///
+/// Number of distinct ACPI/TCO I/O registers remembered by one register snapshot
+///
+#define PCH_SMM_REGISTER_SNAPSHOT_SIZE  16
+
+typedef struct {
+  ADDR_TYPE Type;
+  UINT16    Offset;
+  UINT8     SizeInBytes;
+  UINT32    Value;
+} PCH_SMM_REGISTER_SNAPSHOT_ENTRY;
+
+///
+/// Values of the I/O status and enable registers read during one dispatch pass.
+/// Each register is read from hardware at most once per pass.
+///
+typedef struct {
+  UINTN                           Count;
+  UINTN                           Reads;    ///< hardware reads done through the snapshot
+  PCH_SMM_REGISTER_SNAPSHOT_ENTRY Entry[PCH_SMM_REGISTER_SNAPSHOT_SIZE];
+} PCH_SMM_REGISTER_SNAPSHOT;
 //
 // ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // SUPPORT / HELPER FUNCTIONS (PCH version-independent)
@@ -86,23 +108,36 @@ CompareSources (
   CONST IN PCH_SMM_SOURCE_DESC *Src2
   );
 
+/**
+  Start a new register snapshot, seeded with the SMI_EN and SMI_STS values the
+  dispatcher has already read for this pass.
+
+  @param[out] Snapshot            Pointer to the register snapshot
+  @param[in]  SmiEnValue          Value from R_ACPI_IO_SMI_EN
+  @param[in]  SmiStsValue         Value from R_ACPI_IO_SMI_STS
+**/
+VOID
+PchSmmInitRegisterSnapshot (
+  OUT PCH_SMM_REGISTER_SNAPSHOT *Snapshot,
+  IN  UINT32                    SmiEnValue,
+  IN  UINT32                    SmiStsValue
+  );
+
 /**
   Check if an SMM source is active.
 
   @param[in] Src                  Pointer to the PCH SMI source description table
   @param[in] SciEn                Indicate if SCI is enabled or not
-  @param[in] SmiEnValue           Value from R_PCH_SMI_EN
-  @param[in] SmiStsValue          Value from R_PCH_SMI_STS
+  @param[in, out] Snapshot        Register snapshot of the current dispatch pass
 
   @retval TRUE                    It is active.
   @retval FALSE                   It is inactive.
 **/
 BOOLEAN
 SourceIsActive (
-  CONST IN PCH_SMM_SOURCE_DESC  *Src,
-  CONST IN BOOLEAN              SciEn,
-  CONST IN UINT32               SmiEnValue,
-  CONST IN UINT32               SmiStsValue
+  CONST IN PCH_SMM_SOURCE_DESC        *Src,
+  CONST IN BOOLEAN                    SciEn,
+  IN OUT   PCH_SMM_REGISTER_SNAPSHOT  *Snapshot
   );
 
 /**
@@ -0,0 +1,494 @@
+/** @file
+  Shell application that prints per-handler SMI latency histograms.
+
+  The records are read from the SmmSmiLatencyProfileLib ring buffer through
+  SMM communicate. Run with -c to clear the ring after printing it.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Protocol/SmmCommunication.h>
+#include <Protocol/ShellParameters.h>
+#include <Guid/PiSmmCommunicationRegionTable.h>
+#include <Guid/SmiLatencyProfile.h>
+
+//
+// Bucket 0 counts handlers that ran for less than 1us, bucket N the ones that
+// ran for [2^(N-1), 2^N) us and the last bucket everything longer.
+//
+#define HISTOGRAM_BUCKETS    16
+#define HISTOGRAM_BAR_WIDTH  40
+
+typedef struct {
+  UINT32    Source;
+  UINT64    Handler;
+  UINT64    Count;
+  UINT64    TotalUs;
+  UINT64    MinUs;
+  UINT64    MaxUs;
+  UINT64    Buckets[HISTOGRAM_BUCKETS];
+} HANDLER_HISTOGRAM;
+
+GLOBAL_REMOVE_IF_UNREFERENCED CHAR16  *mSourceName[PCH_SMI_DISPATCH_SOURCE_MAX] = {
+  L"USB",
+  L"SX",
+  L"SW",
+  L"GPI",
+  L"POWER BUTTON",
+  L"PERIODIC TIMER",
+  L"PCH"
+};
+
+EFI_SMM_COMMUNICATION_PROTOCOL  *mSmmCommunication;
+UINT8                           *mCommBuffer;
+UINTN                           mCommBufferSize;
+UINT64                          mTscFrequency;
+
+/**
+  Locate the SMM communication protocol and a communication buffer.
+
+  @retval EFI_SUCCESS  mSmmCommunication and mCommBuffer are set.
+  @retval other        SMM communication is not available.
+**/
+EFI_STATUS
+InitializeCommunication (
+  VOID
+  )
+{
+  EFI_STATUS                               Status;
+  EDKII_PI_SMM_COMMUNICATION_REGION_TABLE  *PiSmmCommunicationRegionTable;
+  EFI_MEMORY_DESCRIPTOR                    *Entry;
+  UINT32                                   Index;
+
+  Status = gBS->LocateProtocol (&gEfiSmmCommunicationProtocolGuid, NULL, (VOID **)&mSmmCommunication);
+  if (EFI_ERROR (Status)) {
+    Print (L"SmiLatencyProfile: Locate SmmCommunication protocol - %r\n", Status);
+    return Status;
+  }
+
+  Status = EfiGetSystemConfigurationTable (
+             &gEdkiiPiSmmCommunicationRegionTableGuid,
+             (VOID **)&PiSmmCommunicationRegionTable
+             );
+  if (EFI_ERROR (Status)) {
+    Print (L"SmiLatencyProfile: Get PiSmmCommunicationRegionTable - %r\n", Status);
+    return Status;
+  }
+
+  Entry = (EFI_MEMORY_DESCRIPTOR *)(PiSmmCommunicationRegionTable + 1);
+  for (Index = 0; Index < PiSmmCommunicationRegionTable->NumberOfEntries; Index++) {
+    if ((Entry->Type == EfiConventionalMemory) &&
+        (EFI_PAGES_TO_SIZE ((UINTN)Entry->NumberOfPages) >= EFI_PAGE_SIZE))
+    {
+      mCommBuffer     = (UINT8 *)(UINTN)Entry->PhysicalStart;
+      mCommBufferSize = EFI_PAGES_TO_SIZE ((UINTN)Entry->NumberOfPages);
+      return EFI_SUCCESS;
+    }
+
+    Entry = (EFI_MEMORY_DESCRIPTOR *)((UINT8 *)Entry + PiSmmCommunicationRegionTable->DescriptorSize);
+  }
+
+  Print (L"SmiLatencyProfile: No SMM communication region\n");
+  return EFI_NOT_FOUND;
+}
+
+/**
+  Send the parameter block at the start of the communicate data to SMM.
+
+  @param[in]  Command        SMI_LATENCY_PROFILE_COMMAND_* to send.
+  @param[in]  ParameterSize  Size of the parameter block.
+
+  @retval EFI_SUCCESS  The command completed, the results are in the parameter block.
+  @retval other        The command could not be sent or failed in SMM.
+**/
+EFI_STATUS
+SendCommand (
+  IN UINT32  Command,
+  IN UINTN   ParameterSize
+  )
+{
+  EFI_STATUS                            Status;
+  EFI_SMM_COMMUNICATE_HEADER            *CommHeader;
+  SMI_LATENCY_PROFILE_PARAMETER_HEADER  *Header;
+  UINTN                                 CommSize;
+
+  CommHeader = (EFI_SMM_COMMUNICATE_HEADER *)mCommBuffer;
+  CopyGuid (&CommHeader->HeaderGuid, &gSmiLatencyProfileGuid);
+  CommHeader->MessageLength = ParameterSize;
+
+  Header               = (SMI_LATENCY_PROFILE_PARAMETER_HEADER *)CommHeader->Data;
+  Header->Command      = Command;
+  Header->DataLength   = (UINT32)ParameterSize;
+  Header->ReturnStatus = (UINT64)-1;
+
+  CommSize = OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data) + ParameterSize;
+  Status   = mSmmCommunication->Communicate (mSmmCommunication, mCommBuffer, &CommSize);
+  if (EFI_ERROR (Status)) {
+    Print (L"SmiLatencyProfile: SmmCommunication - %r\n", Status);
+    return Status;
+  }
+
+  if (Header->ReturnStatus != 0) {
+    Print (L"SmiLatencyProfile: Command 0x%x - 0x%lx\n", Command, Header->ReturnStatus);
+    return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Read every record still held in the SMM ring buffer, oldest first.
+
+  @param[out]  Records      Allocated array of records. Free with FreePool().
+  @param[out]  RecordCount  Number of records in Records.
+
+  @retval EFI_SUCCESS  The records were read.
+  @retval other        The ring buffer could not be read.
+**/
+EFI_STATUS
+GetRecords (
+  OUT SMI_LATENCY_PROFILE_RECORD  **Records,
+  OUT UINTN                       *RecordCount
+  )
+{
+  EFI_STATUS                                 Status;
+  SMI_LATENCY_PROFILE_PARAMETER_GET_INFO     *GetInfo;
+  SMI_LATENCY_PROFILE_PARAMETER_GET_RECORDS  *GetRecords;
+  UINT64                                     Next;
+  UINT64                                     End;
+  UINTN                                      DataOffset;
+  UINTN                                      ChunkCount;
+  UINTN                                      Count;
+
+  GetInfo = (SMI_LATENCY_PROFILE_PARAMETER_GET_INFO *)((EFI_SMM_COMMUNICATE_HEADER *)mCommBuffer)->Data;
+  Status  = SendCommand (SMI_LATENCY_PROFILE_COMMAND_GET_INFO, sizeof (*GetInfo));
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (GetInfo->RecordSize != sizeof (SMI_LATENCY_PROFILE_RECORD)) {
+    Print (L"SmiLatencyProfile: Unexpected record size %d\n", GetInfo->RecordSize);
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Every communicate call adds records of its own, so only read up to the
+  // records that existed when the information was taken.
+  //
+  End  = GetInfo->RecordCount;
+  Next = End - MIN (End, GetInfo->Capacity);
+
+  *Records = AllocatePool ((UINTN)(End - Next) * sizeof (SMI_LATENCY_PROFILE_RECORD) + 1);
+  if (*Records == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // The rest of the communication buffer receives the records.
+  //
+  DataOffset = OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data) + sizeof (*GetRecords);
+  DataOffset = ALIGN_VALUE (DataOffset, sizeof (UINT64));
+  ChunkCount = (mCommBufferSize - DataOffset) / sizeof (SMI_LATENCY_PROFILE_RECORD);
+
+  GetRecords = (SMI_LATENCY_PROFILE_PARAMETER_GET_RECORDS *)((EFI_SMM_COMMUNICATE_HEADER *)mCommBuffer)->Data;
+  Count      = 0;
+  while (Next < End) {
+    GetRecords->FirstRecord = Next;
+    GetRecords->RecordCount = MIN (ChunkCount, End - Next);
+    GetRecords->DataBuffer  = (PHYSICAL_ADDRESS)(UINTN)(mCommBuffer + DataOffset);
+    Status                  = SendCommand (SMI_LATENCY_PROFILE_COMMAND_GET_RECORDS, sizeof (*GetRecords));
+    if (EFI_ERROR (Status)) {
+      FreePool (*Records);
+      return Status;
+    }
+
+    //
+    // Records overwritten since the information was taken are skipped.
+    //
+    if ((GetRecords->RecordCount == 0) || (GetRecords->FirstRecord >= End)) {
+      break;
+    }
+
+    GetRecords->RecordCount = MIN (GetRecords->RecordCount, End - GetRecords->FirstRecord);
+    CopyMem (
+      &(*Records)[Count],
+      mCommBuffer + DataOffset,
+      (UINTN)GetRecords->RecordCount * sizeof (SMI_LATENCY_PROFILE_RECORD)
+      );
+    Count += (UINTN)GetRecords->RecordCount;
+    Next   = GetRecords->FirstRecord + GetRecords->RecordCount;
+  }
+
+  *RecordCount = Count;
+  return EFI_SUCCESS;
+}
+
+/**
+  Measure the time stamp counter frequency against the boot services stall.
+**/
+VOID
+CalibrateTsc (
+  VOID
+  )
+{
+  UINT64  Start;
+
+  Start = AsmReadTsc ();
+  gBS->Stall (10000);
+  mTscFrequency = MultU64x32 (AsmReadTsc () - Start, 100);
+}
+
+/**
+  Convert time stamp counter ticks to microseconds.
+
+  @param[in]  Ticks  Time stamp counter ticks.
+
+  @return  Microseconds.
+**/
+UINT64
+TicksToMicroseconds (
+  IN UINT64  Ticks
+  )
+{
+  if (mTscFrequency == 0) {
+    return 0;
+  }
+
+  return DivU64x64Remainder (MultU64x32 (Ticks, 1000000), mTscFrequency, NULL);
+}
+
+/**
+  Sort the records into one histogram per handler.
+
+  @param[in]   Records         Records read from SMM.
+  @param[in]   RecordCount     Number of records.
+  @param[out]  Histograms      Allocated array of histograms, busiest handler
+                               first. Free with FreePool().
+  @param[out]  HistogramCount  Number of histograms.
+
+  @retval EFI_SUCCESS           The histograms were built.
+  @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+**/
+EFI_STATUS
+BuildHistograms (
+  IN  SMI_LATENCY_PROFILE_RECORD  *Records,
+  IN  UINTN                       RecordCount,
+  OUT HANDLER_HISTOGRAM           **Histograms,
+  OUT UINTN                       *HistogramCount
+  )
+{
+  HANDLER_HISTOGRAM  *Histogram;
+  HANDLER_HISTOGRAM  Swap;
+  UINTN              Count;
+  UINTN              Index;
+  UINTN              Slot;
+  UINTN              Bucket;
+  UINT64             Us;
+
+  //
+  // At most one histogram per record.
+  //
+  *Histograms = AllocateZeroPool (RecordCount * sizeof (HANDLER_HISTOGRAM) + 1);
+  if (*Histograms == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Count = 0;
+  for (Index = 0; Index < RecordCount; Index++) {
+    for (Slot = 0; Slot < Count; Slot++) {
+      Histogram = &(*Histograms)[Slot];
+      if ((Histogram->Source == Records[Index].Source) && (Histogram->Handler == Records[Index].Handler)) {
+        break;
+      }
+    }
+
+    Histogram = &(*Histograms)[Slot];
+    if (Slot == Count) {
+      Histogram->Source  = Records[Index].Source;
+      Histogram->Handler = Records[Index].Handler;
+      Histogram->MinUs   = MAX_UINT64;
+      Count++;
+    }
+
+    Us = TicksToMicroseconds (Records[Index].ExitTsc - Records[Index].EntryTsc);
+    Histogram->Count++;
+    Histogram->TotalUs += Us;
+    Histogram->MinUs    = MIN (Histogram->MinUs, Us);
+    Histogram->MaxUs    = MAX (Histogram->MaxUs, Us);
+
+    Bucket = (Us == 0) ? 0 : (UINTN)HighBitSet64 (Us) + 1;
+    Histogram->Buckets[MIN (Bucket, HISTOGRAM_BUCKETS - 1)]++;
+  }
+
+  //
+  // Print the handlers that cost the most time first.
+  //
+  for (Index = 1; Index < Count; Index++) {
+    CopyMem (&Swap, &(*Histograms)[Index], sizeof (Swap));
+    for (Slot = Index; (Slot > 0) && ((*Histograms)[Slot - 1].TotalUs < Swap.TotalUs); Slot--) {
+      CopyMem (&(*Histograms)[Slot], &(*Histograms)[Slot - 1], sizeof (Swap));
+    }
+
+    CopyMem (&(*Histograms)[Slot], &Swap, sizeof (Swap));
+  }
+
+  *HistogramCount = Count;
+  return EFI_SUCCESS;
+}
+
+/**
+  Print one handler histogram.
+
+  @param[in]  Histogram  The histogram to print.
+**/
+VOID
+PrintHistogram (
+  IN HANDLER_HISTOGRAM  *Histogram
+  )
+{
+  UINT64  MaxBucket;
+  UINTN   Bucket;
+  UINTN   Bar;
+  UINTN   Index;
+
+  if (Histogram->Source == SMI_LATENCY_PROFILE_SOURCE_ROOT) {
+    Print (L"ROOT           ");
+  } else if (Histogram->Source < PCH_SMI_DISPATCH_SOURCE_MAX) {
+    Print (L"%-15s", mSourceName[Histogram->Source]);
+  } else {
+    Print (L"SOURCE 0x%-6x", Histogram->Source);
+  }
+
+  Print (
+    L" 0x%016lx  count %ld  min %ldus  avg %ldus  max %ldus  total %ldus\n",
+    Histogram->Handler,
+    Histogram->Count,
+    Histogram->MinUs,
+    DivU64x64Remainder (Histogram->TotalUs, Histogram->Count, NULL),
+    Histogram->MaxUs,
+    Histogram->TotalUs
+    );
+
+  MaxBucket = 0;
+  for (Bucket = 0; Bucket < HISTOGRAM_BUCKETS; Bucket++) {
+    MaxBucket = MAX (MaxBucket, Histogram->Buckets[Bucket]);
+  }
+
+  for (Bucket = 0; Bucket < HISTOGRAM_BUCKETS; Bucket++) {
+    if (Histogram->Buckets[Bucket] == 0) {
+      continue;
+    }
+
+    if (Bucket == 0) {
+      Print (L"  %13s", L"< 1us");
+    } else if (Bucket == HISTOGRAM_BUCKETS - 1) {
+      Print (L"  >= %7dus", 1 << (Bucket - 1));
+    } else {
+      Print (L"  %5d-%5dus", 1 << (Bucket - 1), 1 << Bucket);
+    }
+
+    Print (L" %10ld ", Histogram->Buckets[Bucket]);
+    Bar = (UINTN)DivU64x64Remainder (MultU64x32 (Histogram->Buckets[Bucket], HISTOGRAM_BAR_WIDTH), MaxBucket, NULL);
+    for (Index = 0; Index < MAX (Bar, 1); Index++) {
+      Print (L"#");
+    }
+
+    Print (L"\n");
+  }
+}
+
+/**
+  Check whether the application was started with the given flag.
+
+  @param[in]  ImageHandle  Image handle of this application.
+  @param[in]  Flag         Flag to look for, for example L"-c".
+
+  @retval TRUE   The flag is on the command line.
+  @retval FALSE  The flag is not on the command line.
+**/
+BOOLEAN
+HasFlag (
+  IN EFI_HANDLE    ImageHandle,
+  IN CONST CHAR16  *Flag
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_SHELL_PARAMETERS_PROTOCOL  *ShellParameters;
+  UINTN                          Index;
+
+  Status = gBS->HandleProtocol (ImageHandle, &gEfiShellParametersProtocolGuid, (VOID **)&ShellParameters);
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  for (Index = 1; Index < ShellParameters->Argc; Index++) {
+    if (StrCmp (ShellParameters->Argv[Index], Flag) == 0) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+EFI_STATUS
+EFIAPI
+SmiLatencyProfileAppEntrypoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                  Status;
+  SMI_LATENCY_PROFILE_RECORD  *Records;
+  UINTN                       RecordCount;
+  HANDLER_HISTOGRAM           *Histograms;
+  UINTN                       HistogramCount;
+  UINTN                       Index;
+
+  Status = InitializeCommunication ();
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = GetRecords (&Records, &RecordCount);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  CalibrateTsc ();
+
+  Status = BuildHistograms (Records, RecordCount, &Histograms, &HistogramCount);
+  if (EFI_ERROR (Status)) {
+    FreePool (Records);
+    return Status;
+  }
+
+  Print (
+    L"SMI latency profile: %d records, %d handlers, TSC %ld MHz\n",
+    RecordCount,
+    HistogramCount,
+    DivU64x32 (mTscFrequency, 1000000)
+    );
+  for (Index = 0; Index < HistogramCount; Index++) {
+    Print (L"\n");
+    PrintHistogram (&Histograms[Index]);
+  }
+
+  FreePool (Histograms);
+  FreePool (Records);
+
+  if (HasFlag (ImageHandle, L"-c")) {
+    Status = SendCommand (SMI_LATENCY_PROFILE_COMMAND_CLEAR, sizeof (SMI_LATENCY_PROFILE_PARAMETER_HEADER));
+    if (!EFI_ERROR (Status)) {
+      Print (L"\nSMI latency profile cleared\n");
+    }
+  }
+
+  return Status;
+}
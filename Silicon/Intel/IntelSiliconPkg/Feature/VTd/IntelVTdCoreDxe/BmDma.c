@@ -25,6 +25,7 @@ typedef struct {
 typedef struct {
   UINT32                                    Signature;
   LIST_ENTRY                                Link;
+  LIST_ENTRY                                AddressLink;
   EDKII_IOMMU_OPERATION                     Operation;
   UINTN                                     NumberOfBytes;
   UINTN                                     NumberOfPages;
@@ -33,8 +34,100 @@ typedef struct {
   LIST_ENTRY                                HandleList;
 } MAP_INFO;
 #define MAP_INFO_FROM_LINK(a) CR (a, MAP_INFO, Link, MAP_INFO_SIGNATURE)
+#define MAP_INFO_FROM_ADDRESS_LINK(a) CR (a, MAP_INFO, AddressLink, MAP_INFO_SIGNATURE)
 
-LIST_ENTRY                        gMaps = INITIALIZE_LIST_HEAD_VARIABLE(gMaps);
+//
+// Active mappings are indexed twice: by the Mapping value returned from Map()
+// (used by Unmap() and SetAttribute()), and by the device address (used by
+// SyncDeviceHandleToMapInfo()). Each index is a power-of-2 array of buckets,
+// so the cost of a lookup no longer grows with the number of live mappings.
+//
+#define MAP_INFO_HASH_BUCKET_NUMBER  0x400
+
+#define MAP_INFO_HASH_MAPPING(Mapping) \
+  ((UINTN) (((UINTN) (Mapping) >> 4) ^ ((UINTN) (Mapping) >> 14)) & (MAP_INFO_HASH_BUCKET_NUMBER - 1))
+#define MAP_INFO_HASH_ADDRESS(Address) \
+  ((UINTN) (RShiftU64 ((Address), EFI_PAGE_SHIFT) ^ RShiftU64 ((Address), 22)) & (MAP_INFO_HASH_BUCKET_NUMBER - 1))
+
+LIST_ENTRY                        gMaps[MAP_INFO_HASH_BUCKET_NUMBER];
+LIST_ENTRY                        gMapsByAddress[MAP_INFO_HASH_BUCKET_NUMBER];
+
+/**
+  Initialize the mapping indexes used by Map(), Unmap() and SetAttribute().
+**/
+VOID
+InitializeMapInfoTable (
+  VOID
+  )
+{
+  UINTN                    Index;
+
+  for (Index = 0; Index < MAP_INFO_HASH_BUCKET_NUMBER; Index++) {
+    InitializeListHead (&gMaps[Index]);
+    InitializeListHead (&gMapsByAddress[Index]);
+  }
+}
+
+/**
+  Find the MAP_INFO according to the Mapping value returned from Map().
+
+  The caller must hold VTD_TPL_LEVEL.
+
+  @param[in]  Mapping           The mapping value returned from Map().
+
+  @return The MAP_INFO for this mapping, or NULL if Mapping is not a valid
+          value returned by Map().
+**/
+MAP_INFO *
+FindMapInfoByMapping (
+  IN VOID                  *Mapping
+  )
+{
+  LIST_ENTRY               *Bucket;
+  LIST_ENTRY               *Link;
+
+  Bucket = &gMaps[MAP_INFO_HASH_MAPPING (Mapping)];
+  for (Link = GetFirstNode (Bucket)
+       ; !IsNull (Bucket, Link)
+       ; Link = GetNextNode (Bucket, Link)
+       ) {
+    if (MAP_INFO_FROM_LINK (Link) == Mapping) {
+      return MAP_INFO_FROM_LINK (Link);
+    }
+  }
+  return NULL;
+}
+
+/**
+  Find the oldest MAP_INFO whose device address is DeviceAddress.
+
+  The caller must hold VTD_TPL_LEVEL.
+
+  @param[in]  DeviceAddress     The device address of the mapping.
+
+  @return The MAP_INFO for this device address, or NULL if it is not found.
+**/
+MAP_INFO *
+FindMapInfoByDeviceAddress (
+  IN EFI_PHYSICAL_ADDRESS  DeviceAddress
+  )
+{
+  LIST_ENTRY               *Bucket;
+  LIST_ENTRY               *Link;
+  MAP_INFO                 *MapInfo;
+
+  Bucket = &gMapsByAddress[MAP_INFO_HASH_ADDRESS (DeviceAddress)];
+  for (Link = GetFirstNode (Bucket)
+       ; !IsNull (Bucket, Link)
+       ; Link = GetNextNode (Bucket, Link)
+       ) {
+    MapInfo = MAP_INFO_FROM_ADDRESS_LINK (Link);
+    if (MapInfo->DeviceAddress == DeviceAddress) {
+      return MapInfo;
+    }
+  }
+  return NULL;
+}
 
 /**
   This function fills DeviceHandle/IoMmuAccess to the MAP_HANDLE_INFO,
@@ -63,17 +156,8 @@ SyncDeviceHandleToMapInfo (
   // Find MapInfo according to DeviceAddress
   //
   OriginalTpl = gBS->RaiseTPL (VTD_TPL_LEVEL);
-  MapInfo = NULL;
-  for (Link = GetFirstNode (&gMaps)
-       ; !IsNull (&gMaps, Link)
-       ; Link = GetNextNode (&gMaps, Link)
-       ) {
-    MapInfo = MAP_INFO_FROM_LINK (Link);
-    if (MapInfo->DeviceAddress == DeviceAddress) {
-      break;
-    }
-  }
-  if ((MapInfo == NULL) || (MapInfo->DeviceAddress != DeviceAddress)) {
+  MapInfo = FindMapInfoByDeviceAddress (DeviceAddress);
+  if (MapInfo == NULL) {
     DEBUG ((DEBUG_ERROR, "SyncDeviceHandleToMapInfo: DeviceAddress(0x%lx) - not found\n", DeviceAddress));
     gBS->RestoreTPL (OriginalTpl);
     return ;
@@ -280,7 +364,8 @@ IoMmuMap (
   }
 
   OriginalTpl = gBS->RaiseTPL (VTD_TPL_LEVEL);
-  InsertTailList (&gMaps, &MapInfo->Link);
+  InsertTailList (&gMaps[MAP_INFO_HASH_MAPPING (MapInfo)], &MapInfo->Link);
+  InsertTailList (&gMapsByAddress[MAP_INFO_HASH_ADDRESS (MapInfo->DeviceAddress)], &MapInfo->AddressLink);
   gBS->RestoreTPL (OriginalTpl);
 
   //
@@ -318,7 +403,6 @@ IoMmuUnmap (
 {
   MAP_INFO                 *MapInfo;
   MAP_HANDLE_INFO          *MapHandleInfo;
-  LIST_ENTRY               *Link;
   EFI_TPL                  OriginalTpl;
 
   DEBUG ((DEBUG_VERBOSE, "IoMmuUnmap: 0x%08x\n", Mapping));
@@ -329,25 +413,17 @@ IoMmuUnmap (
   }
 
   OriginalTpl = gBS->RaiseTPL (VTD_TPL_LEVEL);
-  MapInfo = NULL;
-  for (Link = GetFirstNode (&gMaps)
-       ; !IsNull (&gMaps, Link)
-       ; Link = GetNextNode (&gMaps, Link)
-       ) {
-    MapInfo = MAP_INFO_FROM_LINK (Link);
-    if (MapInfo == Mapping) {
-      break;
-    }
-  }
+  MapInfo = FindMapInfoByMapping (Mapping);
   //
   // Mapping is not a valid value returned by Map()
   //
-  if (MapInfo != Mapping) {
+  if (MapInfo == NULL) {
     gBS->RestoreTPL (OriginalTpl);
     DEBUG ((DEBUG_ERROR, "IoMmuUnmap: %r\n", EFI_INVALID_PARAMETER));
     return EFI_INVALID_PARAMETER;
   }
   RemoveEntryList (&MapInfo->Link);
+  RemoveEntryList (&MapInfo->AddressLink);
   gBS->RestoreTPL (OriginalTpl);
 
   //
@@ -517,26 +593,16 @@ GetDeviceInfoFromMapping (
   )
 {
   MAP_INFO                 *MapInfo;
-  LIST_ENTRY               *Link;
 
   if (Mapping == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  MapInfo = NULL;
-  for (Link = GetFirstNode (&gMaps)
-       ; !IsNull (&gMaps, Link)
-       ; Link = GetNextNode (&gMaps, Link)
-       ) {
-    MapInfo = MAP_INFO_FROM_LINK (Link);
-    if (MapInfo == Mapping) {
-      break;
-    }
-  }
+  MapInfo = FindMapInfoByMapping (Mapping);
   //
   // Mapping is not a valid value returned by Map()
   //
-  if (MapInfo != Mapping) {
+  if (MapInfo == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
@@ -514,6 +514,12 @@ SetupVtd (
     return;
   }
 
+  //
+  // Apply the platform policy, RMRR and recorded requests as one page table
+  // transaction, so the write-back and invalidation are done once per engine.
+  //
+  VtdBeginPageTableTransaction ();
+
   InitializePlatformVTdPolicy ();
 
   ParseDmarAcpiTableRmrr ();
@@ -526,6 +532,8 @@ SetupVtd (
     ProcessRequestedAccessAttribute ();
   }
 
+  VtdCommitPageTableTransaction ();
+
   for (Index = 0; Index < mVtdUnitNumber; Index++) {
     DEBUG ((DEBUG_INFO,"VTD Unit %d (Segment: %04x)\n", Index, mVtdUnitInformation[Index].Segment));
 
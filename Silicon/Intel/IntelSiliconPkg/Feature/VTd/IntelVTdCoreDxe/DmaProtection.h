@@ -63,6 +63,25 @@
 //
 #define MAX_VTD_PCI_DATA_NUMBER             0x100
 
+//
+// The number of pending page table write-back ranges kept per VTd engine
+// while a page table transaction is open. The ranges are cache line aligned
+// and merged when they overlap or are adjacent.
+//
+#define MAX_VTD_DIRTY_RANGE_NUMBER          0x20
+#define VTD_CACHE_LINE_SIZE                 64
+
+//
+// DirtyDomainIdentifier values other than a real domain ID.
+//
+#define VTD_DIRTY_DOMAIN_NONE               0
+#define VTD_DIRTY_DOMAIN_MULTIPLE           MAX_UINT16
+
+typedef struct {
+  UINTN                            Base;
+  UINTN                            End;
+} VTD_DIRTY_RANGE;
+
 typedef struct {
   UINTN                            VtdUnitBaseAddress;
   UINT16                           Segment;
@@ -79,6 +98,9 @@ typedef struct {
   UINT8                            EnableQueuedInvalidation;
   VOID                             *QiDescBuffer;
   UINTN                            QiDescBufferSize;
+  UINT16                           DirtyDomainIdentifier;
+  UINTN                            DirtyRangeCount;
+  VTD_DIRTY_RANGE                  DirtyRange[MAX_VTD_DIRTY_RANGE_NUMBER];
 } VTD_UNIT_INFORMATION;
 
 //
@@ -123,6 +145,7 @@ extern EFI_ACPI_DMAR_HEADER  *mAcpiDmarTable;
 
 extern UINTN                            mVtdUnitNumber;
 extern VTD_UNIT_INFORMATION             *mVtdUnitInformation;
+extern UINTN                            mVtdTransactionDepth;
 
 extern UINT64                           mBelow4GMemoryLimit;
 extern UINT64                           mAbove4GMemoryLimit;
@@ -217,6 +240,16 @@ InvalidateVtdIOTLBGlobal (
   IN UINTN  VtdIndex
   );
 
+/**
+  Invalid page entry.
+
+  @param VtdIndex  The VTd engine index.
+**/
+VOID
+InvalidatePageEntry (
+  IN UINTN                 VtdIndex
+  );
+
 /**
   Dump VTd registers.
 
@@ -517,6 +550,14 @@ DeviceHandleToSourceId (
   OUT VTD_SOURCE_ID        *SourceId
   );
 
+/**
+  Initialize the mapping indexes used by Map(), Unmap() and SetAttribute().
+**/
+VOID
+InitializeMapInfoTable (
+  VOID
+  );
+
 /**
   Get device information from mapping.
 
@@ -572,6 +613,42 @@ FlushPageTableMemory (
   IN UINTN  Size
   );
 
+/**
+  Write back all page table memory ranges which were deferred by
+  FlushPageTableMemory() while a page table transaction is open.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+**/
+VOID
+FlushDirtyPageTableMemory (
+  IN UINTN  VtdIndex
+  );
+
+/**
+  Begin a page table transaction.
+
+  Until the matching VtdCommitPageTableTransaction(), page table entry
+  updates are written back in coalesced ranges and the IOTLB of each VTd
+  engine is invalidated once, instead of once per SetAccessAttribute().
+  Transactions may be nested; only the outermost commit takes effect.
+**/
+VOID
+VtdBeginPageTableTransaction (
+  VOID
+  );
+
+/**
+  Commit a page table transaction.
+
+  When the outermost transaction is committed, the pending page table
+  memory is written back and every VTd engine with dirty context or pages
+  is invalidated with a single batch of invalidation descriptors.
+**/
+VOID
+VtdCommitPageTableTransaction (
+  VOID
+  );
+
 /**
   Get PCI device information from DMAR DevScopeEntry.
 
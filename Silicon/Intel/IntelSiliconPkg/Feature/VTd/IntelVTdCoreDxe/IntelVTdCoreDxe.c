@@ -263,7 +263,14 @@ VTdSetAttribute (
       PERF_START_EX (gImageHandle, PerfToken, "IntelVTD", 0, Identifier);
     );
 
+    //
+    // Update the page table in a transaction, so the entries changed for the
+    // range are written back in merged ranges and the engine is invalidated
+    // once when it is committed.
+    //
+    VtdBeginPageTableTransaction ();
     Status = SetAccessAttribute (Segment, SourceId, DeviceAddress, Length, IoMmuAccess);
+    VtdCommitPageTableTransaction ();
 
     PERF_CODE (
       Identifier = (Segment << 16) | SourceId.Uint16;
@@ -395,6 +402,8 @@ IntelVTdInitialize (
 
   VTdLogInitialize ();
 
+  InitializeMapInfoTable ();
+
   InitializeDmaProtection ();
 
   Handle = NULL;
@@ -503,11 +503,37 @@ InvalidatePageEntry (
   IN UINTN                 VtdIndex
   )
 {
+  FlushDirtyPageTableMemory (VtdIndex);
   if (mVtdUnitInformation[VtdIndex].HasDirtyContext || mVtdUnitInformation[VtdIndex].HasDirtyPages) {
     InvalidateVtdIOTLBGlobal (VtdIndex);
   }
   mVtdUnitInformation[VtdIndex].HasDirtyContext = FALSE;
   mVtdUnitInformation[VtdIndex].HasDirtyPages = FALSE;
+  mVtdUnitInformation[VtdIndex].DirtyDomainIdentifier = VTD_DIRTY_DOMAIN_NONE;
+}
+
+/**
+  Record that the pages of a domain are modified, so that the IOTLB
+  invalidation can be limited to this domain if it is the only one.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+  @param[in]  DomainIdentifier  The domain ID of the modified pages.
+**/
+VOID
+MarkDirtyPages (
+  IN UINTN                 VtdIndex,
+  IN UINT16                DomainIdentifier
+  )
+{
+  VTD_UNIT_INFORMATION  *VtdUnitInfo;
+
+  VtdUnitInfo = &mVtdUnitInformation[VtdIndex];
+  VtdUnitInfo->HasDirtyPages = TRUE;
+  if (VtdUnitInfo->DirtyDomainIdentifier == VTD_DIRTY_DOMAIN_NONE) {
+    VtdUnitInfo->DirtyDomainIdentifier = DomainIdentifier;
+  } else if (VtdUnitInfo->DirtyDomainIdentifier != DomainIdentifier) {
+    VtdUnitInfo->DirtyDomainIdentifier = VTD_DIRTY_DOMAIN_MULTIPLE;
+  }
 }
 
 #define VTD_PG_R                   BIT0
@@ -884,7 +910,7 @@ SetSecondLevelPagingAttribute (
     if (SplitAttribute == PageNone) {
       ConvertSecondLevelPageEntryAttribute (VtdIndex, PageEntry, IoMmuAccess, &IsEntryModified);
       if (IsEntryModified) {
-        mVtdUnitInformation[VtdIndex].HasDirtyPages = TRUE;
+        MarkDirtyPages (VtdIndex, DomainIdentifier);
       }
       //
       // Convert success, move to next
@@ -897,7 +923,7 @@ SetSecondLevelPagingAttribute (
         DEBUG ((DEBUG_ERROR, "SplitSecondLevelPage - %r\n", Status));
         return RETURN_UNSUPPORTED;
       }
-      mVtdUnitInformation[VtdIndex].HasDirtyPages = TRUE;
+      MarkDirtyPages (VtdIndex, DomainIdentifier);
       //
       // Just split current page
       // Convert success in next around
@@ -1054,7 +1080,12 @@ SetAccessAttribute (
     }
   }
 
-  InvalidatePageEntry (VtdIndex);
+  //
+  // Inside a page table transaction, the invalidation is done at commit.
+  //
+  if (mVtdTransactionDepth == 0) {
+    InvalidatePageEntry (VtdIndex);
+  }
 
   return EFI_SUCCESS;
 }
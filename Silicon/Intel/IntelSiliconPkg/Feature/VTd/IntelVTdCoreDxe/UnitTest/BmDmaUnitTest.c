@@ -0,0 +1,689 @@
+/** @file
+  Host based unit tests for the DMA mapping bookkeeping of IntelVTdCoreDxe.
+
+  BmDma.c is built into the test with a boot services table that backs
+  AllocatePages() with host memory, so Map(), Unmap() and the SetAttribute()
+  bookkeeping run unchanged. The stress test interleaves them in a
+  reproducible random order and checks both mapping indexes against a shadow
+  copy as it goes, and reports the rate of each operation.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <time.h>
+
+#include "../BmDma.c"
+
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_NAME     "IntelVTdCoreDxe BmDma Unit Tests"
+#define UNIT_TEST_VERSION  "1.0"
+
+#define TEST_MAPPING_NUMBER       256
+#define TEST_HANDLE_NUMBER        4
+#define TEST_HOST_BUFFER_PAGES    4
+#define TEST_STRESS_STEPS         20000
+#define TEST_STRESS_CHECK_PERIOD  256
+
+typedef enum {
+  TestOperationMap,
+  TestOperationUnmap,
+  TestOperationSetAttribute,
+  TestOperationMax
+} TEST_OPERATION;
+
+typedef struct {
+  UINT8                    *HostBuffer;
+  VOID                     *Mapping;
+  EDKII_IOMMU_OPERATION    Operation;
+  UINTN                    NumberOfBytes;
+  EFI_PHYSICAL_ADDRESS     DeviceAddress;
+  //
+  // IoMmuAccess last set through each handle, 0 if it never was.
+  //
+  UINT64                   IoMmuAccess[TEST_HANDLE_NUMBER];
+} TEST_MAPPING;
+
+STATIC EFI_TPL            mTestTpl;
+STATIC UINTN              mTestPagesAllocated;
+STATIC EFI_BOOT_SERVICES  mTestBootServices;
+STATIC TEST_MAPPING       mTestMapping[TEST_MAPPING_NUMBER];
+STATIC UINT32             mRandomSeed;
+
+STATIC CONST CHAR8  *mTestOperationName[TestOperationMax] = {
+  "Map",
+  "Unmap",
+  "SetAttribute"
+};
+
+EFI_BOOT_SERVICES  *gBS = &mTestBootServices;
+
+/**
+  Returns the next value of a small linear congruential generator.
+
+  @return  A 24 bit pseudo random value.
+**/
+STATIC
+UINT32
+TestRandom (
+  VOID
+  )
+{
+  mRandomSeed = mRandomSeed * 1103515245 + 12345;
+  return mRandomSeed >> 8;
+}
+
+/**
+  Raise the task priority level of the test.
+
+  @param[in]  NewTpl  The new task priority level.
+
+  @return  The previous task priority level.
+**/
+STATIC
+EFI_TPL
+EFIAPI
+TestRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl = mTestTpl;
+  ASSERT (NewTpl >= OldTpl);
+  mTestTpl = NewTpl;
+  return OldTpl;
+}
+
+/**
+  Restore the task priority level of the test.
+
+  @param[in]  OldTpl  The task priority level to restore.
+**/
+STATIC
+VOID
+EFIAPI
+TestRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+  ASSERT (OldTpl <= mTestTpl);
+  mTestTpl = OldTpl;
+}
+
+/**
+  Allocate pages from host memory. The address limit is ignored.
+
+  @param[in]      Type        The type of allocation.
+  @param[in]      MemoryType  The type of memory to allocate.
+  @param[in]      Pages       The number of pages to allocate.
+  @param[in, out] Memory      The address of the allocated pages.
+
+  @retval EFI_SUCCESS           The pages are allocated.
+  @retval EFI_OUT_OF_RESOURCES  The pages could not be allocated.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+TestAllocatePages (
+  IN     EFI_ALLOCATE_TYPE     Type,
+  IN     EFI_MEMORY_TYPE       MemoryType,
+  IN     UINTN                 Pages,
+  IN OUT EFI_PHYSICAL_ADDRESS  *Memory
+  )
+{
+  VOID  *Buffer;
+
+  Buffer = AllocateAlignedPages (Pages, EFI_PAGE_SIZE);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  mTestPagesAllocated += Pages;
+  *Memory = (EFI_PHYSICAL_ADDRESS)(UINTN)Buffer;
+  return EFI_SUCCESS;
+}
+
+/**
+  Free pages allocated by TestAllocatePages().
+
+  @param[in]  Memory  The address of the pages.
+  @param[in]  Pages   The number of pages.
+
+  @retval EFI_SUCCESS  The pages are freed.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+TestFreePages (
+  IN EFI_PHYSICAL_ADDRESS  Memory,
+  IN UINTN                 Pages
+  )
+{
+  ASSERT (mTestPagesAllocated >= Pages);
+  mTestPagesAllocated -= Pages;
+  FreeAlignedPages ((VOID *)(UINTN)Memory, Pages);
+  return EFI_SUCCESS;
+}
+
+/**
+  The VTd log is not part of this test.
+**/
+VOID
+VTdLogAddEvent (
+  IN  CONST VTDLOG_EVENT_TYPE  EventType,
+  IN  CONST UINT64             Data1,
+  IN  CONST UINT64             Data2
+  )
+{
+}
+
+/**
+  Return the device handle used by the test for an index.
+
+  @param[in]  Index  The handle index, below TEST_HANDLE_NUMBER.
+
+  @return  A fake device handle.
+**/
+STATIC
+EFI_HANDLE
+TestHandle (
+  IN UINTN  Index
+  )
+{
+  return (EFI_HANDLE)(UINTN)(0x1000 + Index * 0x10);
+}
+
+/**
+  Count the entries of every bucket of a mapping index.
+
+  @param[in]  Buckets  gMaps or gMapsByAddress.
+
+  @return  The number of entries.
+**/
+STATIC
+UINTN
+CountMapInfo (
+  IN LIST_ENTRY  *Buckets
+  )
+{
+  LIST_ENTRY  *Link;
+  UINTN       Index;
+  UINTN       Count;
+
+  Count = 0;
+  for (Index = 0; Index < MAP_INFO_HASH_BUCKET_NUMBER; Index++) {
+    for (Link = GetFirstNode (&Buckets[Index])
+         ; !IsNull (&Buckets[Index], Link)
+         ; Link = GetNextNode (&Buckets[Index], Link)
+         ) {
+      Count++;
+    }
+  }
+
+  return Count;
+}
+
+/**
+  Check that a live mapping is found through both indexes and carries the
+  handles and IoMmuAccess recorded in its shadow copy.
+
+  @param[in]  Shadow  The shadow copy of the mapping.
+
+  @retval  UNIT_TEST_PASSED  The mapping matches its shadow copy.
+**/
+STATIC
+UNIT_TEST_STATUS
+CheckMapping (
+  IN TEST_MAPPING  *Shadow
+  )
+{
+  MAP_INFO              *MapInfo;
+  MAP_HANDLE_INFO       *MapHandleInfo;
+  LIST_ENTRY            *Link;
+  EFI_PHYSICAL_ADDRESS  DeviceAddress;
+  UINTN                 NumberOfPages;
+  UINTN                 HandleCount;
+  UINTN                 Index;
+
+  MapInfo = FindMapInfoByMapping (Shadow->Mapping);
+  UT_ASSERT_NOT_NULL (MapInfo);
+  UT_ASSERT_TRUE (FindMapInfoByDeviceAddress (Shadow->DeviceAddress) == MapInfo);
+
+  UT_ASSERT_NOT_EFI_ERROR (GetDeviceInfoFromMapping (Shadow->Mapping, &DeviceAddress, &NumberOfPages));
+  UT_ASSERT_EQUAL (DeviceAddress, Shadow->DeviceAddress);
+  UT_ASSERT_EQUAL (NumberOfPages, EFI_SIZE_TO_PAGES (Shadow->NumberOfBytes));
+  UT_ASSERT_EQUAL (MapInfo->HostAddress, (UINTN)Shadow->HostBuffer);
+
+  HandleCount = 0;
+  for (Link = GetFirstNode (&MapInfo->HandleList)
+       ; !IsNull (&MapInfo->HandleList, Link)
+       ; Link = GetNextNode (&MapInfo->HandleList, Link)
+       ) {
+    MapHandleInfo = MAP_HANDLE_INFO_FROM_LINK (Link);
+    for (Index = 0; Index < TEST_HANDLE_NUMBER; Index++) {
+      if (MapHandleInfo->DeviceHandle == TestHandle (Index)) {
+        break;
+      }
+    }
+
+    UT_ASSERT_TRUE (Index < TEST_HANDLE_NUMBER);
+    UT_ASSERT_EQUAL (MapHandleInfo->IoMmuAccess, Shadow->IoMmuAccess[Index]);
+    HandleCount++;
+  }
+
+  for (Index = 0; Index < TEST_HANDLE_NUMBER; Index++) {
+    if (Shadow->IoMmuAccess[Index] != 0) {
+      HandleCount--;
+    }
+  }
+
+  UT_ASSERT_EQUAL (HandleCount, 0);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check every live mapping, and that the indexes hold nothing else.
+
+  @param[in]  LiveCount  The number of live mappings.
+
+  @retval  UNIT_TEST_PASSED  The indexes match the shadow copies.
+**/
+STATIC
+UNIT_TEST_STATUS
+CheckAllMappings (
+  IN UINTN  LiveCount
+  )
+{
+  UNIT_TEST_STATUS  Status;
+  UINTN             Index;
+
+  UT_ASSERT_EQUAL (CountMapInfo (gMaps), LiveCount);
+  UT_ASSERT_EQUAL (CountMapInfo (gMapsByAddress), LiveCount);
+
+  for (Index = 0; Index < TEST_MAPPING_NUMBER; Index++) {
+    if (mTestMapping[Index].Mapping != NULL) {
+      Status = CheckMapping (&mTestMapping[Index]);
+      if (Status != UNIT_TEST_PASSED) {
+        return Status;
+      }
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Map the host buffer of a shadow slot.
+
+  Page aligned common buffers keep the host address as the device address.
+  Unaligned bus master reads and writes are bounced through a new buffer.
+
+  @param[in, out]  Shadow  The shadow slot, with no live mapping.
+
+  @retval  UNIT_TEST_PASSED  The buffer is mapped.
+**/
+STATIC
+UNIT_TEST_STATUS
+TestMap (
+  IN OUT TEST_MAPPING  *Shadow
+  )
+{
+  UINTN   NumberOfBytes;
+  UINT32  Kind;
+
+  Kind = TestRandom () % 3;
+  if (Kind == 0) {
+    Shadow->Operation     = EdkiiIoMmuOperationBusMasterCommonBuffer64;
+    Shadow->NumberOfBytes = EFI_PAGES_TO_SIZE (1 + TestRandom () % TEST_HOST_BUFFER_PAGES);
+  } else {
+    Shadow->Operation     = (Kind == 1) ? EdkiiIoMmuOperationBusMasterRead64 : EdkiiIoMmuOperationBusMasterWrite64;
+    Shadow->NumberOfBytes = 1 + TestRandom () % (EFI_PAGES_TO_SIZE (TEST_HOST_BUFFER_PAGES) - 1);
+    if ((Shadow->NumberOfBytes & EFI_PAGE_MASK) == 0) {
+      Shadow->NumberOfBytes--;
+    }
+  }
+
+  SetMem (Shadow->HostBuffer, Shadow->NumberOfBytes, (UINT8)TestRandom ());
+  ZeroMem (Shadow->IoMmuAccess, sizeof (Shadow->IoMmuAccess));
+
+  NumberOfBytes = Shadow->NumberOfBytes;
+  UT_ASSERT_NOT_EFI_ERROR (
+    IoMmuMap (
+      NULL,
+      Shadow->Operation,
+      Shadow->HostBuffer,
+      &NumberOfBytes,
+      &Shadow->DeviceAddress,
+      &Shadow->Mapping
+      )
+    );
+  UT_ASSERT_EQUAL (NumberOfBytes, Shadow->NumberOfBytes);
+  UT_ASSERT_EQUAL (mTestTpl, TPL_APPLICATION);
+
+  if (Kind == 0) {
+    UT_ASSERT_EQUAL (Shadow->DeviceAddress, (UINTN)Shadow->HostBuffer);
+  } else {
+    UT_ASSERT_NOT_EQUAL (Shadow->DeviceAddress, (UINTN)Shadow->HostBuffer);
+    UT_ASSERT_EQUAL (Shadow->DeviceAddress & EFI_PAGE_MASK, 0);
+  }
+
+  if (Shadow->Operation == EdkiiIoMmuOperationBusMasterRead64) {
+    UT_ASSERT_MEM_EQUAL ((VOID *)(UINTN)Shadow->DeviceAddress, Shadow->HostBuffer, Shadow->NumberOfBytes);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Unmap the live mapping of a shadow slot.
+
+  @param[in, out]  Shadow  The shadow slot, with a live mapping.
+
+  @retval  UNIT_TEST_PASSED  The buffer is unmapped.
+**/
+STATIC
+UNIT_TEST_STATUS
+TestUnmap (
+  IN OUT TEST_MAPPING  *Shadow
+  )
+{
+  UINT8  Value;
+
+  Value = (UINT8)TestRandom ();
+  if (Shadow->Operation == EdkiiIoMmuOperationBusMasterWrite64) {
+    SetMem ((VOID *)(UINTN)Shadow->DeviceAddress, Shadow->NumberOfBytes, Value);
+  }
+
+  UT_ASSERT_NOT_EFI_ERROR (IoMmuUnmap (NULL, Shadow->Mapping));
+  UT_ASSERT_EQUAL (mTestTpl, TPL_APPLICATION);
+
+  if (Shadow->Operation == EdkiiIoMmuOperationBusMasterWrite64) {
+    UT_ASSERT_EQUAL (Shadow->HostBuffer[0], Value);
+    UT_ASSERT_EQUAL (Shadow->HostBuffer[Shadow->NumberOfBytes - 1], Value);
+  }
+
+  Shadow->Mapping = NULL;
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Record an IoMmuAccess for a live mapping the way IoMmuSetAttribute() does
+  once the page table is updated.
+
+  @param[in, out]  Shadow  The shadow slot, with a live mapping.
+
+  @retval  UNIT_TEST_PASSED  The access is recorded.
+**/
+STATIC
+UNIT_TEST_STATUS
+TestSetAttribute (
+  IN OUT TEST_MAPPING  *Shadow
+  )
+{
+  EFI_PHYSICAL_ADDRESS  DeviceAddress;
+  UINTN                 NumberOfPages;
+  UINTN                 HandleIndex;
+  UINT64                IoMmuAccess;
+
+  HandleIndex = TestRandom () % TEST_HANDLE_NUMBER;
+  IoMmuAccess = 1 + TestRandom () % (EDKII_IOMMU_ACCESS_READ | EDKII_IOMMU_ACCESS_WRITE);
+
+  UT_ASSERT_NOT_EFI_ERROR (GetDeviceInfoFromMapping (Shadow->Mapping, &DeviceAddress, &NumberOfPages));
+  SyncDeviceHandleToMapInfo (TestHandle (HandleIndex), DeviceAddress, EFI_PAGES_TO_SIZE (NumberOfPages), IoMmuAccess);
+  UT_ASSERT_EQUAL (mTestTpl, TPL_APPLICATION);
+
+  Shadow->IoMmuAccess[HandleIndex] = IoMmuAccess;
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Allocate the host buffers and reset the mapping indexes.
+
+  @param[in]  Context  Unused.
+
+  @retval  UNIT_TEST_PASSED                    The test may run.
+  @retval  UNIT_TEST_ERROR_PREREQUISITE_NOT_MET  A host buffer could not be allocated.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+MappingSetup (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Index;
+
+  mTestTpl            = TPL_APPLICATION;
+  mTestPagesAllocated = 0;
+  mRandomSeed         = 0x1F2E3D4C;
+  InitializeMapInfoTable ();
+
+  ZeroMem (mTestMapping, sizeof (mTestMapping));
+  for (Index = 0; Index < TEST_MAPPING_NUMBER; Index++) {
+    mTestMapping[Index].HostBuffer = AllocateAlignedPages (TEST_HOST_BUFFER_PAGES, EFI_PAGE_SIZE);
+    if (mTestMapping[Index].HostBuffer == NULL) {
+      return UNIT_TEST_ERROR_PREREQUISITE_NOT_MET;
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Free the host buffers. Live mappings are left to the process exit.
+
+  @param[in]  Context  Unused.
+**/
+STATIC
+VOID
+EFIAPI
+MappingCleanup (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < TEST_MAPPING_NUMBER; Index++) {
+    if (mTestMapping[Index].HostBuffer != NULL) {
+      FreeAlignedPages (mTestMapping[Index].HostBuffer, TEST_HOST_BUFFER_PAGES);
+      mTestMapping[Index].HostBuffer = NULL;
+    }
+  }
+}
+
+/**
+  Unmap() and SetAttribute() reject a Mapping that Map() did not return.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+InvalidMapping (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_PHYSICAL_ADDRESS  DeviceAddress;
+  UINTN                 NumberOfPages;
+  MAP_INFO              Bogus;
+
+  ZeroMem (&Bogus, sizeof (Bogus));
+  Bogus.Signature = MAP_INFO_SIGNATURE;
+
+  UT_ASSERT_STATUS_EQUAL (IoMmuUnmap (NULL, NULL), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (IoMmuUnmap (NULL, &Bogus), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (GetDeviceInfoFromMapping (NULL, &DeviceAddress, &NumberOfPages), EFI_INVALID_PARAMETER);
+  UT_ASSERT_STATUS_EQUAL (GetDeviceInfoFromMapping (&Bogus, &DeviceAddress, &NumberOfPages), EFI_INVALID_PARAMETER);
+
+  UT_ASSERT_EQUAL (TestMap (&mTestMapping[0]), UNIT_TEST_PASSED);
+  UT_ASSERT_EQUAL (TestUnmap (&mTestMapping[0]), UNIT_TEST_PASSED);
+  UT_ASSERT_EQUAL (CheckAllMappings (0), UNIT_TEST_PASSED);
+  UT_ASSERT_EQUAL (mTestPagesAllocated, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Interleave Map(), Unmap() and the SetAttribute() bookkeeping on many live
+  mappings, checking both indexes against the shadow copies as it goes, and
+  log how many calls of each kind run per second.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+InterleavedMapping (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TEST_MAPPING      *Shadow;
+  UNIT_TEST_STATUS  Status;
+  TEST_OPERATION    Operation;
+  UINTN             Step;
+  UINTN             Index;
+  UINTN             LiveCount;
+  UINTN             MaxLiveCount;
+  UINTN             Count[TestOperationMax];
+  clock_t           Elapsed[TestOperationMax];
+  clock_t           Start;
+  UINT64            ElapsedUs;
+
+  ZeroMem (Count, sizeof (Count));
+  ZeroMem (Elapsed, sizeof (Elapsed));
+  LiveCount    = 0;
+  MaxLiveCount = 0;
+  for (Step = 0; Step < TEST_STRESS_STEPS; Step++) {
+    Shadow = &mTestMapping[TestRandom () % TEST_MAPPING_NUMBER];
+    if (Shadow->Mapping == NULL) {
+      Operation = TestOperationMap;
+    } else if ((TestRandom () % 4) == 0) {
+      Operation = TestOperationUnmap;
+    } else {
+      Operation = TestOperationSetAttribute;
+    }
+
+    Start = clock ();
+    switch (Operation) {
+      case TestOperationMap:
+        Status = TestMap (Shadow);
+        break;
+
+      case TestOperationUnmap:
+        Status = TestUnmap (Shadow);
+        break;
+
+      default:
+        Status = TestSetAttribute (Shadow);
+        break;
+    }
+
+    Elapsed[Operation] += clock () - Start;
+    Count[Operation]++;
+    UT_ASSERT_EQUAL (Status, UNIT_TEST_PASSED);
+
+    if (Operation == TestOperationMap) {
+      LiveCount++;
+      MaxLiveCount = MAX (MaxLiveCount, LiveCount);
+    } else if (Operation == TestOperationUnmap) {
+      LiveCount--;
+    }
+
+    if ((Step % TEST_STRESS_CHECK_PERIOD) == 0) {
+      UT_ASSERT_EQUAL (CheckAllMappings (LiveCount), UNIT_TEST_PASSED);
+    }
+  }
+
+  UT_ASSERT_EQUAL (CheckAllMappings (LiveCount), UNIT_TEST_PASSED);
+  UT_LOG_INFO ("%d steps, up to %d live mappings\n", TEST_STRESS_STEPS, MaxLiveCount);
+
+  //
+  // The rates include the shadow bookkeeping of each step, but not the
+  // periodic index checks.
+  //
+  for (Operation = 0; Operation < TestOperationMax; Operation++) {
+    ElapsedUs = ((UINT64)Elapsed[Operation] * 1000000) / CLOCKS_PER_SEC;
+    UT_LOG_INFO (
+      "%a: %d calls in %d us, %d calls/s\n",
+      mTestOperationName[Operation],
+      Count[Operation],
+      (UINT32)ElapsedUs,
+      (UINT32)((ElapsedUs == 0) ? 0 : (UINT64)Count[Operation] * 1000000 / ElapsedUs)
+      );
+  }
+
+  for (Index = 0; Index < TEST_MAPPING_NUMBER; Index++) {
+    if (mTestMapping[Index].Mapping != NULL) {
+      UT_ASSERT_EQUAL (TestUnmap (&mTestMapping[Index]), UNIT_TEST_PASSED);
+    }
+  }
+
+  UT_ASSERT_EQUAL (CheckAllMappings (0), UNIT_TEST_PASSED);
+  UT_ASSERT_EQUAL (mTestPagesAllocated, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the DMA
+  mapping bookkeeping and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      MappingSuite;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_NAME, UNIT_TEST_VERSION));
+
+  mTestBootServices.RaiseTPL      = TestRaiseTpl;
+  mTestBootServices.RestoreTPL    = TestRestoreTpl;
+  mTestBootServices.AllocatePages = TestAllocatePages;
+  mTestBootServices.FreePages     = TestFreePages;
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_NAME, gEfiCallerBaseName, UNIT_TEST_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&MappingSuite, Framework, "DMA Mapping Tests", "IntelVTdCoreDxe.BmDma", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for DMA Mapping Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (MappingSuite, "Unknown mappings are rejected", "InvalidMapping", InvalidMapping, MappingSetup, MappingCleanup, NULL);
+  AddTestCase (MappingSuite, "Interleaved Map, Unmap and SetAttribute", "InterleavedMapping", InterleavedMapping, MappingSetup, MappingCleanup, NULL);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
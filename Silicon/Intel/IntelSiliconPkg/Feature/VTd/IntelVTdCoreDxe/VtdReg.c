@@ -15,11 +15,42 @@ VTD_REGESTER_INFO                *mVtdRegsInfoBuffer = NULL;
 
 BOOLEAN  mVtdEnabled;
 
+UINTN    mVtdTransactionDepth = 0;
+
+/**
+  Write back all page table memory ranges which were deferred by
+  FlushPageTableMemory() while a page table transaction is open.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+**/
+VOID
+FlushDirtyPageTableMemory (
+  IN UINTN  VtdIndex
+  )
+{
+  VTD_UNIT_INFORMATION  *VtdUnitInfo;
+  UINTN                 Index;
+
+  VtdUnitInfo = &mVtdUnitInformation[VtdIndex];
+  for (Index = 0; Index < VtdUnitInfo->DirtyRangeCount; Index++) {
+    WriteBackDataCacheRange (
+      (VOID *)VtdUnitInfo->DirtyRange[Index].Base,
+      VtdUnitInfo->DirtyRange[Index].End - VtdUnitInfo->DirtyRange[Index].Base
+      );
+  }
+  VtdUnitInfo->DirtyRangeCount = 0;
+}
+
 /**
   Flush VTD page table and context table memory.
 
   This action is to make sure the IOMMU engine can get final data in memory.
 
+  While a page table transaction is open, updates smaller than a page are
+  recorded as cache line aligned dirty ranges and written back at commit
+  time. Whole pages (newly created tables) are still written back at once,
+  so the hardware never walks into a table whose content is not in memory.
+
   @param[in]  VtdIndex          The index used to identify a VTd engine.
   @param[in]  Base              The base address of memory to be flushed.
   @param[in]  Size              The size of memory in bytes to be flushed.
@@ -31,8 +62,88 @@ FlushPageTableMemory (
   IN UINTN  Size
   )
 {
-  if (mVtdUnitInformation[VtdIndex].ECapReg.Bits.C == 0) {
+  VTD_UNIT_INFORMATION  *VtdUnitInfo;
+  VTD_DIRTY_RANGE       *DirtyRange;
+  UINTN                 End;
+  UINTN                 Index;
+
+  VtdUnitInfo = &mVtdUnitInformation[VtdIndex];
+  if (VtdUnitInfo->ECapReg.Bits.C != 0) {
+    return;
+  }
+
+  if ((mVtdTransactionDepth == 0) || (Size >= SIZE_4KB)) {
     WriteBackDataCacheRange ((VOID *)Base, Size);
+    return;
+  }
+
+  End  = ALIGN_VALUE_UP (Base + Size, VTD_CACHE_LINE_SIZE);
+  Base = ALIGN_VALUE_LOW (Base, VTD_CACHE_LINE_SIZE);
+
+  //
+  // Merge with a pending range if they overlap or are adjacent.
+  //
+  for (Index = 0; Index < VtdUnitInfo->DirtyRangeCount; Index++) {
+    DirtyRange = &VtdUnitInfo->DirtyRange[Index];
+    if ((Base <= DirtyRange->End) && (End >= DirtyRange->Base)) {
+      DirtyRange->Base = MIN (DirtyRange->Base, Base);
+      DirtyRange->End  = MAX (DirtyRange->End, End);
+      return;
+    }
+  }
+
+  if (VtdUnitInfo->DirtyRangeCount == MAX_VTD_DIRTY_RANGE_NUMBER) {
+    FlushDirtyPageTableMemory (VtdIndex);
+  }
+
+  DirtyRange = &VtdUnitInfo->DirtyRange[VtdUnitInfo->DirtyRangeCount];
+  DirtyRange->Base = Base;
+  DirtyRange->End  = End;
+  VtdUnitInfo->DirtyRangeCount++;
+}
+
+/**
+  Begin a page table transaction.
+
+  Until the matching VtdCommitPageTableTransaction(), page table entry
+  updates are written back in coalesced ranges and the IOTLB of each VTd
+  engine is invalidated once, instead of once per SetAccessAttribute().
+  Transactions may be nested; only the outermost commit takes effect.
+**/
+VOID
+VtdBeginPageTableTransaction (
+  VOID
+  )
+{
+  mVtdTransactionDepth++;
+}
+
+/**
+  Commit a page table transaction.
+
+  When the outermost transaction is committed, the pending page table
+  memory is written back and every VTd engine with dirty context or pages
+  is invalidated with a single batch of invalidation descriptors.
+**/
+VOID
+VtdCommitPageTableTransaction (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  ASSERT (mVtdTransactionDepth != 0);
+  if (mVtdTransactionDepth == 0) {
+    return;
+  }
+
+  mVtdTransactionDepth--;
+  if (mVtdTransactionDepth != 0) {
+    return;
+  }
+
+  for (Index = 0; Index < mVtdUnitNumber; Index++) {
+    InvalidatePageEntry (Index);
   }
 }
 
@@ -242,6 +353,79 @@ InvalidateIOTLB (
   return EFI_SUCCESS;
 }
 
+/**
+  Invalidate the context cache and IOTLB of a VTd engine with one batch of
+  queued invalidation descriptors.
+
+  The context cache is invalidated globally if any context entry is dirty.
+  If only the pages of a single domain are dirty, the IOTLB invalidation is
+  domain-selective; otherwise it is global.
+
+  @param[in]  VtdIndex          The index used to identify a VTd engine.
+
+  @retval EFI_SUCCESS           The invalidation is completed.
+  @retval EFI_DEVICE_ERROR      A queued invalidation fault is detected.
+**/
+EFI_STATUS
+InvalidateQueuedBatch (
+  IN UINTN  VtdIndex
+  )
+{
+  VTD_UNIT_INFORMATION  *VtdUnitInfo;
+  QI_256_DESC           QiDesc[2];
+  UINTN                 QiDescCount;
+  UINT64                IotlbGranularity;
+  UINT16                DomainIdentifier;
+  EFI_STATUS            Status;
+  VTD_REGESTER_QI_INFO  RegisterQi;
+
+  VtdUnitInfo = &mVtdUnitInformation[VtdIndex];
+  ZeroMem (QiDesc, sizeof (QiDesc));
+  QiDescCount = 0;
+
+  if (VtdUnitInfo->HasDirtyContext) {
+    QiDesc[QiDescCount].Uint64[0] = QI_CC_FM(0) | QI_CC_SID(0) | QI_CC_DID(0) | QI_CC_GRAN(1) | QI_CC_TYPE;
+    QiDescCount++;
+  }
+
+  if (VtdUnitInfo->HasDirtyContext || VtdUnitInfo->HasDirtyPages) {
+    if (!VtdUnitInfo->HasDirtyContext &&
+        (VtdUnitInfo->DirtyDomainIdentifier != VTD_DIRTY_DOMAIN_NONE) &&
+        (VtdUnitInfo->DirtyDomainIdentifier != VTD_DIRTY_DOMAIN_MULTIPLE)) {
+      //
+      // Domain-selective invalidation
+      //
+      IotlbGranularity = 2;
+      DomainIdentifier = VtdUnitInfo->DirtyDomainIdentifier;
+    } else {
+      //
+      // Global invalidation
+      //
+      IotlbGranularity = 1;
+      DomainIdentifier = 0;
+    }
+    QiDesc[QiDescCount].Uint64[0] = QI_IOTLB_DID(DomainIdentifier) | QI_IOTLB_DR(CAP_READ_DRAIN(VtdUnitInfo->CapReg.Uint64)) | QI_IOTLB_DW(CAP_WRITE_DRAIN(VtdUnitInfo->CapReg.Uint64)) | QI_IOTLB_GRAN(IotlbGranularity) | QI_IOTLB_TYPE;
+    QiDesc[QiDescCount].Uint64[1] = QI_IOTLB_ADDR(0) | QI_IOTLB_IH(0) | QI_IOTLB_AM(0);
+    QiDescCount++;
+  }
+
+  if (QiDescCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Status = VtdLibSubmitQueuedInvalidationDescriptors (VtdUnitInfo->VtdUnitBaseAddress, QiDesc, QiDescCount, FALSE);
+  if (Status == EFI_DEVICE_ERROR) {
+    RegisterQi.BaseAddress = VtdUnitInfo->VtdUnitBaseAddress;
+    RegisterQi.FstsReg     = MmioRead32 (VtdUnitInfo->VtdUnitBaseAddress + R_FSTS_REG);
+    RegisterQi.IqercdReg   = MmioRead64 (VtdUnitInfo->VtdUnitBaseAddress + R_IQERCD_REG);
+    VTdLogAddDataEvent (VTDLOG_PEI_REGISTER, VTDLOG_REGISTER_QI, &RegisterQi, sizeof (VTD_REGESTER_QI_INFO));
+
+    MmioWrite32 (VtdUnitInfo->VtdUnitBaseAddress + R_FSTS_REG, RegisterQi.FstsReg & (B_FSTS_REG_IQE | B_FSTS_REG_ITE | B_FSTS_REG_ICE));
+  }
+
+  return Status;
+}
+
 /**
   Invalid VTd global IOTLB.
 
@@ -266,6 +450,13 @@ InvalidateVtdIOTLBGlobal (
   //
   VtdLibFlushWriteBuffer (mVtdUnitInformation[VtdIndex].VtdUnitBaseAddress);
 
+  if (mVtdUnitInformation[VtdIndex].EnableQueuedInvalidation != 0) {
+    //
+    // Queue the context cache and IOTLB invalidation together and wait once.
+    //
+    return InvalidateQueuedBatch (VtdIndex);
+  }
+
   //
   // Invalidate the context cache
   //
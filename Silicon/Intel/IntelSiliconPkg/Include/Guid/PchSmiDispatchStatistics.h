@@ -0,0 +1,68 @@
+/** @file
+  The definition of the PCH SMI dispatcher statistics table.
+
+  The PCH SMI dispatcher installs this structure as an SMM configuration table
+  so that SMM test point checks can report how long each class of PCH SMI
+  source spends in its child handlers.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _PCH_SMI_DISPATCH_STATISTICS_H_
+#define _PCH_SMI_DISPATCH_STATISTICS_H_
+
+///
+/// The Global ID of the SMM configuration table holding PCH_SMI_DISPATCH_STATISTICS.
+///
+#define PCH_SMI_DISPATCH_STATISTICS_GUID \
+  { \
+    0x97e7687a, 0x0522, 0x4335, { 0x82, 0xea, 0x22, 0x89, 0x42, 0x6d, 0xd4, 0x4d } \
+  }
+
+extern EFI_GUID gPchSmiDispatchStatisticsGuid;
+
+#define PCH_SMI_DISPATCH_STATISTICS_REVISION  1
+
+///
+/// Indexes into PCH_SMI_DISPATCH_STATISTICS.Source, one per dispatch protocol.
+/// PCH_SMI_DISPATCH_SOURCE_PCH covers the TCO, PCIe, ACPI, GPIO unlock and eSPI
+/// dispatch protocols.
+///
+#define PCH_SMI_DISPATCH_SOURCE_USB             0
+#define PCH_SMI_DISPATCH_SOURCE_SX              1
+#define PCH_SMI_DISPATCH_SOURCE_SW              2
+#define PCH_SMI_DISPATCH_SOURCE_GPI             3
+#define PCH_SMI_DISPATCH_SOURCE_POWER_BUTTON    4
+#define PCH_SMI_DISPATCH_SOURCE_PERIODIC_TIMER  5
+#define PCH_SMI_DISPATCH_SOURCE_PCH             6
+#define PCH_SMI_DISPATCH_SOURCE_MAX             7
+
+typedef struct {
+  //
+  // Number of times a child handler of this source was dispatched.
+  //
+  UINT64    DispatchCount;
+  //
+  // Sum and maximum of the time spent in those handlers, in nanoseconds.
+  //
+  UINT64    TotalTimeNs;
+  UINT64    MaxTimeNs;
+} PCH_SMI_DISPATCH_SOURCE_STATISTICS;
+
+typedef struct {
+  UINT32                                Revision;
+  UINT32                                SourceCount;
+  //
+  // Number of times the PCH root SMI handler was entered.
+  //
+  UINT64                                RootHandlerCount;
+  //
+  // Number of status and enable register reads, besides SMI_EN and SMI_STS,
+  // done while looking for active sources. Each I/O register is read at most
+  // once per dispatch pass.
+  //
+  UINT64                                RegisterReads;
+  PCH_SMI_DISPATCH_SOURCE_STATISTICS    Source[PCH_SMI_DISPATCH_SOURCE_MAX];
+} PCH_SMI_DISPATCH_STATISTICS;
+
+#endif
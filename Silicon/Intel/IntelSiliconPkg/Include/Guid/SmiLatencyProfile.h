@@ -0,0 +1,87 @@
+/** @file
+  The definition of the SMI latency profile communication interface.
+
+  The SMM instance of SmiLatencyProfileLib keeps a ring buffer of entry and
+  exit time stamps for SMI handlers. A non-SMM agent reads the records back
+  through an SMM communicate call using this GUID as the header GUID.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _SMI_LATENCY_PROFILE_H_
+#define _SMI_LATENCY_PROFILE_H_
+
+#include <Guid/PchSmiDispatchStatistics.h>
+
+///
+/// The Global ID of the SMI latency profile communicate handler. It is also
+/// the GUID of the SMM configuration table holding the ring buffer, so that
+/// every driver linking the SMM library instance records into the same ring.
+///
+#define SMI_LATENCY_PROFILE_GUID \
+  { \
+    0xe6a64c72, 0x7d86, 0x4796, { 0xa5, 0x71, 0x55, 0xf4, 0xad, 0xff, 0x91, 0xef } \
+  }
+
+extern EFI_GUID gSmiLatencyProfileGuid;
+
+///
+/// Records of a child handler carry the PCH_SMI_DISPATCH_SOURCE_* index of the
+/// dispatch protocol it was registered through. Records of a root SMI handler
+/// carry SMI_LATENCY_PROFILE_SOURCE_ROOT.
+///
+#define SMI_LATENCY_PROFILE_SOURCE_ROOT  0xFFFFFFFF
+
+typedef struct {
+  //
+  // Address of the handler entry point.
+  //
+  UINT64    Handler;
+  UINT32    Source;
+  UINT32    Reserved;
+  //
+  // Time stamp counter values read on entry to and on return from the handler.
+  //
+  UINT64    EntryTsc;
+  UINT64    ExitTsc;
+} SMI_LATENCY_PROFILE_RECORD;
+
+#define SMI_LATENCY_PROFILE_COMMAND_GET_INFO     0x1
+#define SMI_LATENCY_PROFILE_COMMAND_GET_RECORDS  0x2
+#define SMI_LATENCY_PROFILE_COMMAND_CLEAR        0x3
+
+typedef struct {
+  UINT32    Command;
+  UINT32    DataLength;
+  UINT64    ReturnStatus;
+} SMI_LATENCY_PROFILE_PARAMETER_HEADER;
+
+typedef struct {
+  SMI_LATENCY_PROFILE_PARAMETER_HEADER    Header;
+  //
+  // Number of records the ring buffer holds and the size of one record.
+  //
+  UINT32                                  Capacity;
+  UINT32                                  RecordSize;
+  //
+  // Number of records written since the last clear. Records are numbered from
+  // zero in the order they were written; only the last Capacity of them are
+  // still in the ring.
+  //
+  UINT64                                  RecordCount;
+} SMI_LATENCY_PROFILE_PARAMETER_GET_INFO;
+
+typedef struct {
+  SMI_LATENCY_PROFILE_PARAMETER_HEADER    Header;
+  //
+  // On input, the number of the first record wanted and the number of records
+  // DataBuffer can hold. On output, the number of the first record copied,
+  // which is later than requested if the ring has since overwritten it, and
+  // the number of records copied.
+  //
+  UINT64                                  FirstRecord;
+  UINT64                                  RecordCount;
+  PHYSICAL_ADDRESS                        DataBuffer;
+} SMI_LATENCY_PROFILE_PARAMETER_GET_RECORDS;
+
+#endif
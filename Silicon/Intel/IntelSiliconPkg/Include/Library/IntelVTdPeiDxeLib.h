@@ -420,4 +420,35 @@ VtdLibSubmitQueuedInvalidationDescriptor (
   IN BOOLEAN                    ClearFaultBits
   );
 
+/**
+  Submit a batch of queued invalidation descriptors to the remapping
+    hardware unit and wait once for the completion of all of them.
+
+  The descriptors are copied to the invalidation queue back to back and the
+  tail register is written once, so the whole batch costs a single wait.
+
+  [Consumption]
+    Operate VTd engine
+
+  @param[in] VtdUnitBaseAddress     The base address of the VTd engine.
+  @param[in] Desc                   The array of invalidate descriptors, in the
+                                    descriptor width configured in IQA_REG.
+  @param[in] DescCount              The number of descriptors in Desc. It must
+                                    be less than the queue size.
+  @param[in] ClearFaultBits         TRUE  - This API will clear the queued invalidation fault bits if any.
+                                    FALSE - The caller need to check and clear the queued invalidation fault bits.
+
+  @retval EFI_SUCCESS               The operation was successful.
+  @retval EFI_INVALID_PARAMETER     Parameter is invalid.
+  @retval EFI_NOT_READY             Queued invalidation is not inited.
+  @retval EFI_DEVICE_ERROR          Detect fault, need to clear fault bits if ClearFaultBits is FALSE
+**/
+EFI_STATUS
+VtdLibSubmitQueuedInvalidationDescriptors (
+  IN UINTN                      VtdUnitBaseAddress,
+  IN VOID                       *Desc,
+  IN UINTN                      DescCount,
+  IN BOOLEAN                    ClearFaultBits
+  );
+
 #endif
@@ -0,0 +1,47 @@
+/** @file
+  Library for recording the latency of SMI handlers.
+
+  A dispatcher calls SmiLatencyProfileBegin() right before it enters a handler
+  and SmiLatencyProfileEnd() right after the handler returns. The SMM instance
+  stores one SMI_LATENCY_PROFILE_RECORD per call in a ring buffer that can be
+  read through the gSmiLatencyProfileGuid SMM communicate handler.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _SMI_LATENCY_PROFILE_LIB_H_
+#define _SMI_LATENCY_PROFILE_LIB_H_
+
+#include <Guid/SmiLatencyProfile.h>
+
+/**
+  Starts timing an SMI handler.
+
+  @return  Time stamp to pass to SmiLatencyProfileEnd(), or 0 if profiling is
+           not active.
+**/
+UINT64
+EFIAPI
+SmiLatencyProfileBegin (
+  VOID
+  );
+
+/**
+  Records the latency of an SMI handler that has just returned.
+
+  @param[in]  Source    PCH_SMI_DISPATCH_SOURCE_* index of the dispatch protocol
+                        the handler was registered through, or
+                        SMI_LATENCY_PROFILE_SOURCE_ROOT for a root SMI handler.
+  @param[in]  Handler   Address of the handler entry point.
+  @param[in]  EntryTsc  Value returned by SmiLatencyProfileBegin() before the
+                        handler was entered. Nothing is recorded if it is 0.
+**/
+VOID
+EFIAPI
+SmiLatencyProfileEnd (
+  IN UINT32  Source,
+  IN UINT64  Handler,
+  IN UINT64  EntryTsc
+  );
+
+#endif
@@ -1681,11 +1681,12 @@ VtdLibDisableQueuedInvalidationInterface (
 }
 
 /**
-  Submit the queued invalidation descriptor to the remapping
-   hardware unit and wait for its completion.
+  Submit a batch of queued invalidation descriptors to the remapping
+   hardware unit and wait once for the completion of all of them.
 
   @param[in] VtdUnitBaseAddress     The base address of the VTd engine.
-  @param[in] Desc                   The invalidate descriptor
+  @param[in] Desc                   The array of invalidate descriptors
+  @param[in] DescCount              The number of descriptors in Desc
   @param[in] ClearFaultBits         Clear Error bits
 
   @retval EFI_SUCCESS               The operation was successful.
@@ -1695,12 +1696,14 @@ VtdLibDisableQueuedInvalidationInterface (
 
 **/
 EFI_STATUS
-VtdLibSubmitQueuedInvalidationDescriptor (
+VtdLibSubmitQueuedInvalidationDescriptors (
   IN UINTN                      VtdUnitBaseAddress,
   IN VOID                       *Desc,
+  IN UINTN                      DescCount,
   IN BOOLEAN                    ClearFaultBits
   )
 {
+  UINTN          Index;
   UINTN          QueueSize;
   UINTN          QueueTail;
   UINTN          QueueHead;
@@ -1713,7 +1716,7 @@ VtdLibSubmitQueuedInvalidationDescriptor (
   UINT64         IqercdReg;
   UINT64         IQBassAddress;
 
-  if (Desc == NULL) {
+  if ((Desc == NULL) || (DescCount == 0)) {
     return EFI_INVALID_PARAMETER;
   }
 
@@ -1736,20 +1739,24 @@ VtdLibSubmitQueuedInvalidationDescriptor (
     // 128-bit descriptor
     //
     QueueSize = (UINTN) (1 << (IqaReg.Bits.QS + 8));
-    Qi128Desc = (QI_DESC *) (UINTN) LShiftU64 (IQBassAddress, VTD_PAGE_SHIFT);
+    if (DescCount >= QueueSize) {
+      return EFI_INVALID_PARAMETER;
+    }
     //
     // Get IQT_REG.QT for 128-bit descriptors
     //
     QueueTail = (UINTN) (RShiftU64 (IqtReg.Uint64, 4) & 0x7FFF);
-    Qi128Desc += QueueTail;
-    CopyMem (Qi128Desc, Desc, sizeof (QI_DESC));
-    QueueTail = (QueueTail + 1) % QueueSize;
-
-    DEBUG ((DEBUG_VERBOSE, "[0x%x] Submit QI Descriptor 0x%x [0x%016lx, 0x%016lx]\n",
-            VtdUnitBaseAddress,
-            QueueTail,
-            Qi128Desc->Low,
-            Qi128Desc->High));
+    for (Index = 0; Index < DescCount; Index++) {
+      Qi128Desc = (QI_DESC *) (UINTN) LShiftU64 (IQBassAddress, VTD_PAGE_SHIFT) + QueueTail;
+      CopyMem (Qi128Desc, (QI_DESC *) Desc + Index, sizeof (QI_DESC));
+      QueueTail = (QueueTail + 1) % QueueSize;
+
+      DEBUG ((DEBUG_VERBOSE, "[0x%x] Submit QI Descriptor 0x%x [0x%016lx, 0x%016lx]\n",
+              VtdUnitBaseAddress,
+              QueueTail,
+              Qi128Desc->Low,
+              Qi128Desc->High));
+    }
 
     IqtReg.Uint64 &= ~(0x7FFF << 4);
     IqtReg.Uint64 |= LShiftU64 (QueueTail, 4);
@@ -1758,22 +1765,26 @@ VtdLibSubmitQueuedInvalidationDescriptor (
     // 256-bit descriptor
     //
     QueueSize = (UINTN) (1 << (IqaReg.Bits.QS + 7));
-    Qi256Desc = (QI_256_DESC *) (UINTN) LShiftU64 (IQBassAddress, VTD_PAGE_SHIFT);
+    if (DescCount >= QueueSize) {
+      return EFI_INVALID_PARAMETER;
+    }
     //
     // Get IQT_REG.QT for 256-bit descriptors
     //
     QueueTail = (UINTN) (RShiftU64 (IqtReg.Uint64, 5) & 0x3FFF);
-    Qi256Desc += QueueTail;
-    CopyMem (Qi256Desc, Desc, sizeof (QI_256_DESC));
-    QueueTail = (QueueTail + 1) % QueueSize;
-
-    DEBUG ((DEBUG_VERBOSE, "[0x%x] Submit QI Descriptor 0x%x [0x%016lx, 0x%016lx, 0x%016lx, 0x%016lx]\n",
-            VtdUnitBaseAddress,
-            QueueTail,
-            Qi256Desc->Uint64[0],
-            Qi256Desc->Uint64[1],
-            Qi256Desc->Uint64[2],
-            Qi256Desc->Uint64[3]));
+    for (Index = 0; Index < DescCount; Index++) {
+      Qi256Desc = (QI_256_DESC *) (UINTN) LShiftU64 (IQBassAddress, VTD_PAGE_SHIFT) + QueueTail;
+      CopyMem (Qi256Desc, (QI_256_DESC *) Desc + Index, sizeof (QI_256_DESC));
+      QueueTail = (QueueTail + 1) % QueueSize;
+
+      DEBUG ((DEBUG_VERBOSE, "[0x%x] Submit QI Descriptor 0x%x [0x%016lx, 0x%016lx, 0x%016lx, 0x%016lx]\n",
+              VtdUnitBaseAddress,
+              QueueTail,
+              Qi256Desc->Uint64[0],
+              Qi256Desc->Uint64[1],
+              Qi256Desc->Uint64[2],
+              Qi256Desc->Uint64[3]));
+    }
 
     IqtReg.Uint64 &= ~(0x3FFF << 5);
     IqtReg.Uint64 |= LShiftU64 (QueueTail, 5);
@@ -1809,3 +1820,27 @@ VtdLibSubmitQueuedInvalidationDescriptor (
 
   return EFI_SUCCESS;
 }
+
+/**
+  Submit the queued invalidation descriptor to the remapping
+   hardware unit and wait for its completion.
+
+  @param[in] VtdUnitBaseAddress     The base address of the VTd engine.
+  @param[in] Desc                   The invalidate descriptor
+  @param[in] ClearFaultBits         Clear Error bits
+
+  @retval EFI_SUCCESS               The operation was successful.
+  @retval EFI_INVALID_PARAMETER     Parameter is invalid.
+  @retval EFI_NOT_READY             Queued invalidation is not inited.
+  @retval EFI_DEVICE_ERROR          Detect fault, need to clear fault bits if ClearFaultBits is FALSE
+
+**/
+EFI_STATUS
+VtdLibSubmitQueuedInvalidationDescriptor (
+  IN UINTN                      VtdUnitBaseAddress,
+  IN VOID                       *Desc,
+  IN BOOLEAN                    ClearFaultBits
+  )
+{
+  return VtdLibSubmitQueuedInvalidationDescriptors (VtdUnitBaseAddress, Desc, 1, ClearFaultBits);
+}
@@ -0,0 +1,40 @@
+/** @file
+  Null Library instance of SMI Latency Profile Library Class
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/SmiLatencyProfileLib.h>
+
+/**
+  Starts timing an SMI handler.
+
+  @return  Always 0, profiling is never active.
+**/
+UINT64
+EFIAPI
+SmiLatencyProfileBegin (
+  VOID
+  )
+{
+  return 0;
+}
+
+/**
+  Records the latency of an SMI handler that has just returned.
+
+  @param[in]  Source    Dispatch source of the handler.
+  @param[in]  Handler   Address of the handler entry point.
+  @param[in]  EntryTsc  Value returned by SmiLatencyProfileBegin().
+**/
+VOID
+EFIAPI
+SmiLatencyProfileEnd (
+  IN UINT32  Source,
+  IN UINT64  Handler,
+  IN UINT64  EntryTsc
+  )
+{
+}
@@ -0,0 +1,319 @@
+/** @file
+  SMM Library instance of SMI Latency Profile Library Class
+
+  The first driver linking this instance allocates the ring buffer, publishes
+  it as an SMM configuration table and registers the communicate handler.
+  Drivers loaded later find the table and record into the same ring, so a
+  single read returns the records of every profiled dispatcher in the order
+  they were written.
+
+  SMI handlers only run on the SMM monarch processor, so the ring is updated
+  without locking.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiSmm.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/PcdLib.h>
+#include <Library/SmmMemLib.h>
+#include <Library/SmmServicesTableLib.h>
+#include <Library/SmiLatencyProfileLib.h>
+
+typedef struct {
+  UINT32    Capacity;
+  //
+  // Slot the next record is written to.
+  //
+  UINT32    WriteIndex;
+  //
+  // Number of records written since the last clear.
+  //
+  UINT64    RecordCount;
+  //
+  // SMI_LATENCY_PROFILE_RECORD Records[Capacity] follows.
+  //
+} SMI_LATENCY_PROFILE_RING;
+
+#define SMI_LATENCY_PROFILE_RING_RECORDS(Ring)  ((SMI_LATENCY_PROFILE_RECORD *)((SMI_LATENCY_PROFILE_RING *)(Ring) + 1))
+
+GLOBAL_REMOVE_IF_UNREFERENCED SMI_LATENCY_PROFILE_RING  *mSmiLatencyProfileRing;
+
+/**
+  Starts timing an SMI handler.
+
+  @return  Current time stamp counter value, or 0 if there is no ring buffer.
+**/
+UINT64
+EFIAPI
+SmiLatencyProfileBegin (
+  VOID
+  )
+{
+  if (mSmiLatencyProfileRing == NULL) {
+    return 0;
+  }
+
+  return AsmReadTsc ();
+}
+
+/**
+  Records the latency of an SMI handler that has just returned.
+
+  @param[in]  Source    PCH_SMI_DISPATCH_SOURCE_* index of the dispatch protocol
+                        the handler was registered through, or
+                        SMI_LATENCY_PROFILE_SOURCE_ROOT for a root SMI handler.
+  @param[in]  Handler   Address of the handler entry point.
+  @param[in]  EntryTsc  Value returned by SmiLatencyProfileBegin() before the
+                        handler was entered. Nothing is recorded if it is 0.
+**/
+VOID
+EFIAPI
+SmiLatencyProfileEnd (
+  IN UINT32  Source,
+  IN UINT64  Handler,
+  IN UINT64  EntryTsc
+  )
+{
+  UINT64                      ExitTsc;
+  SMI_LATENCY_PROFILE_RING    *Ring;
+  SMI_LATENCY_PROFILE_RECORD  *Record;
+
+  ExitTsc = AsmReadTsc ();
+
+  Ring = mSmiLatencyProfileRing;
+  if ((Ring == NULL) || (EntryTsc == 0)) {
+    return;
+  }
+
+  Record           = &SMI_LATENCY_PROFILE_RING_RECORDS (Ring)[Ring->WriteIndex];
+  Record->Handler  = Handler;
+  Record->Source   = Source;
+  Record->Reserved = 0;
+  Record->EntryTsc = EntryTsc;
+  Record->ExitTsc  = ExitTsc;
+
+  Ring->WriteIndex++;
+  if (Ring->WriteIndex == Ring->Capacity) {
+    Ring->WriteIndex = 0;
+  }
+
+  Ring->RecordCount++;
+}
+
+/**
+  Copies a range of records out of the ring buffer.
+
+  @param[in, out]  Parameter  The GET_RECORDS parameter block in the communicate buffer.
+**/
+STATIC
+VOID
+SmiLatencyProfileGetRecords (
+  IN OUT SMI_LATENCY_PROFILE_PARAMETER_GET_RECORDS  *Parameter
+  )
+{
+  SMI_LATENCY_PROFILE_PARAMETER_GET_RECORDS  GetRecords;
+  SMI_LATENCY_PROFILE_RING                   *Ring;
+  SMI_LATENCY_PROFILE_RECORD                 *Records;
+  UINT64                                     Oldest;
+  UINT64                                     First;
+  UINTN                                      Count;
+  UINTN                                      Index;
+  UINTN                                      Chunk;
+  UINT8                                      *Buffer;
+
+  //
+  // Work on a copy so the caller cannot change the parameters after they are checked.
+  //
+  CopyMem (&GetRecords, Parameter, sizeof (GetRecords));
+
+  Ring   = mSmiLatencyProfileRing;
+  Oldest = Ring->RecordCount - MIN (Ring->RecordCount, Ring->Capacity);
+  First  = MIN (MAX (GetRecords.FirstRecord, Oldest), Ring->RecordCount);
+  Count  = (UINTN)MIN (GetRecords.RecordCount, Ring->RecordCount - First);
+
+  Buffer = (UINT8 *)(UINTN)GetRecords.DataBuffer;
+  if ((Count != 0) &&
+      !SmmIsBufferOutsideSmmValid ((UINTN)Buffer, Count * sizeof (SMI_LATENCY_PROFILE_RECORD)))
+  {
+    DEBUG ((DEBUG_ERROR, "SmiLatencyProfile: Data buffer in SMRAM or overflow!\n"));
+    Parameter->Header.ReturnStatus = (UINT64)(INT64)(INTN)EFI_ACCESS_DENIED;
+    return;
+  }
+
+  //
+  // Record First is (RecordCount - First) slots behind the write index.
+  //
+  Index = Ring->WriteIndex + Ring->Capacity - (UINTN)(Ring->RecordCount - First);
+  if (Index >= Ring->Capacity) {
+    Index -= Ring->Capacity;
+  }
+
+  Records = SMI_LATENCY_PROFILE_RING_RECORDS (Ring);
+  Chunk   = MIN (Count, Ring->Capacity - Index);
+  CopyMem (Buffer, &Records[Index], Chunk * sizeof (SMI_LATENCY_PROFILE_RECORD));
+  CopyMem (
+    Buffer + Chunk * sizeof (SMI_LATENCY_PROFILE_RECORD),
+    Records,
+    (Count - Chunk) * sizeof (SMI_LATENCY_PROFILE_RECORD)
+    );
+
+  Parameter->FirstRecord         = First;
+  Parameter->RecordCount         = Count;
+  Parameter->Header.ReturnStatus = 0;
+}
+
+/**
+  Dispatch function for the SMI latency profile communicate requests.
+
+  @param[in]     DispatchHandle  The unique handle assigned to this handler by SmiHandlerRegister().
+  @param[in]     Context         Points to an optional handler context which was specified when the
+                                 handler was registered.
+  @param[in,out] CommBuffer      A pointer to a collection of data in memory that will
+                                 be conveyed from a non-SMM environment into an SMM environment.
+  @param[in,out] CommBufferSize  The size of the CommBuffer.
+
+  @retval EFI_SUCCESS            The request was handled, the result is in the parameter header.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+SmiLatencyProfileHandler (
+  IN     EFI_HANDLE  DispatchHandle,
+  IN     CONST VOID  *Context         OPTIONAL,
+  IN OUT VOID        *CommBuffer      OPTIONAL,
+  IN OUT UINTN       *CommBufferSize  OPTIONAL
+  )
+{
+  SMI_LATENCY_PROFILE_PARAMETER_HEADER    *Header;
+  SMI_LATENCY_PROFILE_PARAMETER_GET_INFO  *GetInfo;
+  UINTN                                   TempCommBufferSize;
+
+  if ((CommBuffer == NULL) || (CommBufferSize == NULL)) {
+    return EFI_SUCCESS;
+  }
+
+  TempCommBufferSize = *CommBufferSize;
+  if (TempCommBufferSize < sizeof (SMI_LATENCY_PROFILE_PARAMETER_HEADER)) {
+    DEBUG ((DEBUG_ERROR, "SmiLatencyProfile: SMM communication buffer size invalid!\n"));
+    return EFI_SUCCESS;
+  }
+
+  if (!SmmIsBufferOutsideSmmValid ((UINTN)CommBuffer, TempCommBufferSize)) {
+    DEBUG ((DEBUG_ERROR, "SmiLatencyProfile: SMM communication buffer in SMRAM or overflow!\n"));
+    return EFI_SUCCESS;
+  }
+
+  Header               = (SMI_LATENCY_PROFILE_PARAMETER_HEADER *)CommBuffer;
+  Header->ReturnStatus = (UINT64)-1;
+
+  switch (Header->Command) {
+    case SMI_LATENCY_PROFILE_COMMAND_GET_INFO:
+      if (TempCommBufferSize != sizeof (SMI_LATENCY_PROFILE_PARAMETER_GET_INFO)) {
+        DEBUG ((DEBUG_ERROR, "SmiLatencyProfile: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+
+      GetInfo              = (SMI_LATENCY_PROFILE_PARAMETER_GET_INFO *)CommBuffer;
+      GetInfo->Capacity    = mSmiLatencyProfileRing->Capacity;
+      GetInfo->RecordSize  = sizeof (SMI_LATENCY_PROFILE_RECORD);
+      GetInfo->RecordCount = mSmiLatencyProfileRing->RecordCount;
+      Header->ReturnStatus = 0;
+      break;
+
+    case SMI_LATENCY_PROFILE_COMMAND_GET_RECORDS:
+      if (TempCommBufferSize != sizeof (SMI_LATENCY_PROFILE_PARAMETER_GET_RECORDS)) {
+        DEBUG ((DEBUG_ERROR, "SmiLatencyProfile: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+
+      SmiLatencyProfileGetRecords ((SMI_LATENCY_PROFILE_PARAMETER_GET_RECORDS *)CommBuffer);
+      break;
+
+    case SMI_LATENCY_PROFILE_COMMAND_CLEAR:
+      mSmiLatencyProfileRing->WriteIndex  = 0;
+      mSmiLatencyProfileRing->RecordCount = 0;
+      Header->ReturnStatus                = 0;
+      break;
+
+    default:
+      break;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Attaches to the SMI latency profile ring buffer, creating it if this is the
+  first driver linking the library.
+
+  Failures are not returned so that the driver still loads without profiling.
+
+  @param[in]  ImageHandle  The firmware allocated handle for the EFI image.
+  @param[in]  SystemTable  A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS  Always.
+**/
+EFI_STATUS
+EFIAPI
+SmmSmiLatencyProfileLibConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                Status;
+  UINTN                     Index;
+  UINT32                    Capacity;
+  SMI_LATENCY_PROFILE_RING  *Ring;
+  EFI_HANDLE                DispatchHandle;
+
+  for (Index = 0; Index < gSmst->NumberOfTableEntries; Index++) {
+    if (CompareGuid (&gSmst->SmmConfigurationTable[Index].VendorGuid, &gSmiLatencyProfileGuid)) {
+      mSmiLatencyProfileRing = gSmst->SmmConfigurationTable[Index].VendorTable;
+      return EFI_SUCCESS;
+    }
+  }
+
+  Capacity = PcdGet32 (PcdSmiLatencyProfileRecordCount);
+  if (Capacity == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Status = gSmst->SmmAllocatePool (
+                    EfiRuntimeServicesData,
+                    sizeof (SMI_LATENCY_PROFILE_RING) + Capacity * sizeof (SMI_LATENCY_PROFILE_RECORD),
+                    (VOID **)&Ring
+                    );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "SmiLatencyProfile: Cannot allocate %d records - %r\n", Capacity, Status));
+    return EFI_SUCCESS;
+  }
+
+  ZeroMem (Ring, sizeof (SMI_LATENCY_PROFILE_RING));
+  Ring->Capacity = Capacity;
+
+  Status = gSmst->SmmInstallConfigurationTable (
+                    gSmst,
+                    &gSmiLatencyProfileGuid,
+                    Ring,
+                    sizeof (SMI_LATENCY_PROFILE_RING)
+                    );
+  if (!EFI_ERROR (Status)) {
+    Status = gSmst->SmiHandlerRegister (SmiLatencyProfileHandler, &gSmiLatencyProfileGuid, &DispatchHandle);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "SmiLatencyProfile: Cannot publish the ring buffer - %r\n", Status));
+    gSmst->SmmInstallConfigurationTable (gSmst, &gSmiLatencyProfileGuid, NULL, 0);
+    gSmst->SmmFreePool (Ring);
+    return EFI_SUCCESS;
+  }
+
+  mSmiLatencyProfileRing = Ring;
+  DEBUG ((DEBUG_INFO, "SmiLatencyProfile: %d records at 0x%p\n", Capacity, Ring));
+
+  return EFI_SUCCESS;
+}
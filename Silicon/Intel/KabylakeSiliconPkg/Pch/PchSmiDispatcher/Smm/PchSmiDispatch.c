@@ -2274,12 +2274,16 @@ PchSmiTypeCallbackDispatcher (
 {
   EFI_STATUS                            Status;
   PCH_SMI_TYPES                         PchSmiType;
+  UINT64                                EntryTsc;
+  UINT64                                Handler;
   UINTN                                 RpIndex;
   PCH_PCIE_SMI_RP_CONTEXT               RpContext;
 
   PchSmiType = Record->PchSmiType;
   Status     = EFI_SUCCESS;
 
+  Handler  = (UINT64) (UINTN) Record->PchSmiCallback;
+  EntryTsc = SmiLatencyProfileBegin ();
   switch (PchSmiType) {
     case PchTcoSmiMchType:
     case PchTcoSmiTcoTimeoutType:
@@ -2325,6 +2329,8 @@ PchSmiTypeCallbackDispatcher (
       break;
   }
 
+  SmiLatencyProfileEnd (PCH_SMI_DISPATCH_SOURCE_PCH, Handler, EntryTsc);
+
   return Status;
 }
 
@@ -9,6 +9,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "PchSmm.h"
 #include "PchSmmHelpers.h"
 #include "PchSmmEspi.h"
+#include <Library/TimerLib.h>
+#include <Guid/PchSmiDispatchStatistics.h>
 
 //
 // MODULE / GLOBAL DATA
@@ -124,6 +126,29 @@ GLOBAL_REMOVE_IF_UNREFERENCED CONTEXT_FUNCTIONS     mContextFunctions[PCH_SMM_PR
   },
 };
 
+///
+/// Dispatch index. For each SMI_STS bit it lists the database records whose source is
+/// gated by that bit, so a dispatch pass only evaluates records whose top level status
+/// is set. Records without an SMI_STS bit go to the ungated bucket and are always evaluated.
+/// The index is built at SmmReadyToLock, after which the database can no longer change.
+///
+#define DISPATCH_INDEX_UNGATED_BUCKET  32
+#define DISPATCH_INDEX_BUCKET_COUNT    33
+
+typedef struct {
+  BOOLEAN          Ready;
+  UINTN            RecordCount;
+  DATABASE_RECORD  **Records;                                     ///< Records in database order
+  UINTN            *Positions;                                    ///< Positions in Records, grouped by bucket
+  UINTN            BucketStart[DISPATCH_INDEX_BUCKET_COUNT + 1];
+  UINT32           GatedMask;                                     ///< SMI_STS bits that gate at least one record
+} DISPATCH_INDEX;
+
+GLOBAL_REMOVE_IF_UNREFERENCED DISPATCH_INDEX                mDispatchIndex;
+GLOBAL_REMOVE_IF_UNREFERENCED PCH_SMI_DISPATCH_STATISTICS   mSmiDispatchStatistics;
+GLOBAL_REMOVE_IF_UNREFERENCED UINT64                        mPerformanceCounterStart;
+GLOBAL_REMOVE_IF_UNREFERENCED UINT64                        mPerformanceCounterEnd;
+
 //
 // PROTOTYPES
 //
@@ -141,6 +166,219 @@ PchSmmCoreDispatcher (
 //
 // FUNCTIONS
 //
+/**
+  Get the dispatch index bucket of a source, which is the SMI_STS bit that gates it.
+
+  @param[in] SrcDesc              Pointer to the PCH SMI source description table
+
+  @retval 0..31                   The SMI_STS bit SourceIsActive checks for this source
+  @retval DISPATCH_INDEX_UNGATED_BUCKET  The source is not gated by an SMI_STS bit
+**/
+STATIC
+UINTN
+GetDispatchIndexBucket (
+  CONST PCH_SMM_SOURCE_DESC *SrcDesc
+  )
+{
+  if (!IS_BIT_DESC_NULL (SrcDesc->PmcSmiSts) &&
+      (SrcDesc->PmcSmiSts.Reg.Type == ACPI_ADDR_TYPE) &&
+      (SrcDesc->PmcSmiSts.Reg.Data.acpi == R_PCH_SMI_STS) &&
+      (SrcDesc->PmcSmiSts.Bit < 32)) {
+    return SrcDesc->PmcSmiSts.Bit;
+  }
+  if (!IS_BIT_DESC_NULL (SrcDesc->Sts[0]) &&
+      (SrcDesc->Sts[0].Reg.Type == ACPI_ADDR_TYPE) &&
+      (SrcDesc->Sts[0].Reg.Data.acpi == R_PCH_SMI_STS) &&
+      (SrcDesc->Sts[0].Bit < 32)) {
+    return SrcDesc->Sts[0].Bit;
+  }
+  return DISPATCH_INDEX_UNGATED_BUCKET;
+}
+
+/**
+  Build the dispatch index from the callback database.
+  If the index cannot be allocated the dispatcher keeps walking the whole database.
+**/
+STATIC
+VOID
+BuildDispatchIndex (
+  VOID
+  )
+{
+  EFI_STATUS        Status;
+  LIST_ENTRY        *LinkInDb;
+  UINTN             Count;
+  UINTN             Position;
+  UINTN             Bucket;
+  UINTN             Fill[DISPATCH_INDEX_BUCKET_COUNT];
+
+  Count    = 0;
+  LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
+  while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
+    Count++;
+    LinkInDb = GetNextNode (&mPrivateData.CallbackDataBase, LinkInDb);
+  }
+  if (Count == 0) {
+    return;
+  }
+
+  Status = gSmst->SmmAllocatePool (
+                    EfiRuntimeServicesData,
+                    Count * (sizeof (DATABASE_RECORD *) + sizeof (UINTN)),
+                    (VOID **) &mDispatchIndex.Records
+                    );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "PchSmmCore: No memory for the dispatch index, the full database will be walked\n"));
+    return;
+  }
+  mDispatchIndex.Positions = (UINTN *) (mDispatchIndex.Records + Count);
+  mDispatchIndex.GatedMask = 0;
+  ZeroMem (mDispatchIndex.BucketStart, sizeof (mDispatchIndex.BucketStart));
+  ZeroMem (Fill, sizeof (Fill));
+
+  ///
+  /// Count the records of each bucket, then place the positions bucket by bucket.
+  /// Positions stay in database order within a bucket.
+  ///
+  Position = 0;
+  LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
+  while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
+    mDispatchIndex.Records[Position] = DATABASE_RECORD_FROM_LINK (LinkInDb);
+    Bucket = GetDispatchIndexBucket (&mDispatchIndex.Records[Position]->SrcDesc);
+    mDispatchIndex.BucketStart[Bucket + 1]++;
+    if (Bucket != DISPATCH_INDEX_UNGATED_BUCKET) {
+      mDispatchIndex.GatedMask |= (1u << Bucket);
+    }
+    Position++;
+    LinkInDb = GetNextNode (&mPrivateData.CallbackDataBase, LinkInDb);
+  }
+  for (Bucket = 0; Bucket < DISPATCH_INDEX_BUCKET_COUNT; Bucket++) {
+    mDispatchIndex.BucketStart[Bucket + 1] += mDispatchIndex.BucketStart[Bucket];
+  }
+  for (Position = 0; Position < Count; Position++) {
+    Bucket = GetDispatchIndexBucket (&mDispatchIndex.Records[Position]->SrcDesc);
+    mDispatchIndex.Positions[mDispatchIndex.BucketStart[Bucket] + Fill[Bucket]] = Position;
+    Fill[Bucket]++;
+  }
+
+  mDispatchIndex.RecordCount = Count;
+  mDispatchIndex.Ready       = TRUE;
+  DEBUG ((DEBUG_INFO, "PchSmmCore: Dispatch index built for %d records, SMI_STS mask 0x%08x\n", (UINT32) Count, mDispatchIndex.GatedMask));
+}
+
+/**
+  Find the first record of the database whose source is active.
+
+  @param[in] SciEn                Indicate if SCI is enabled or not
+  @param[in] SmiStsValue          Value from R_PCH_SMI_STS
+  @param[in, out] Snapshot        Register snapshot of the current dispatch pass
+
+  @retval NULL                    No registered source is active
+  @retval Others                  The first active record in database order
+**/
+STATIC
+DATABASE_RECORD *
+FindFirstActiveRecord (
+  IN     BOOLEAN                    SciEn,
+  IN     UINT32                     SmiStsValue,
+  IN OUT PCH_SMM_REGISTER_SNAPSHOT  *Snapshot
+  )
+{
+  LIST_ENTRY        *LinkInDb;
+  DATABASE_RECORD   *RecordInDb;
+  UINT32            Pending;
+  UINTN             Bucket;
+  UINTN             Slot;
+  UINTN             Position;
+  UINTN             First;
+
+  if (!mDispatchIndex.Ready) {
+    LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
+    while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
+      RecordInDb = DATABASE_RECORD_FROM_LINK (LinkInDb);
+      if (SourceIsActive (&RecordInDb->SrcDesc, SciEn, Snapshot)) {
+        return RecordInDb;
+      }
+      LinkInDb = GetNextNode (&mPrivateData.CallbackDataBase, &RecordInDb->Link);
+    }
+    return NULL;
+  }
+
+  ///
+  /// Only evaluate the ungated bucket and the buckets of the SMI_STS bits that are set.
+  /// The lowest active position wins, so the same record is found as with a full walk.
+  ///
+  First   = mDispatchIndex.RecordCount;
+  Pending = SmiStsValue & mDispatchIndex.GatedMask;
+  Bucket  = DISPATCH_INDEX_UNGATED_BUCKET;
+  while (TRUE) {
+    for (Slot = mDispatchIndex.BucketStart[Bucket]; Slot < mDispatchIndex.BucketStart[Bucket + 1]; Slot++) {
+      Position = mDispatchIndex.Positions[Slot];
+      if (Position >= First) {
+        break;
+      }
+      if (SourceIsActive (&mDispatchIndex.Records[Position]->SrcDesc, SciEn, Snapshot)) {
+        First = Position;
+        break;
+      }
+    }
+    if (Pending == 0) {
+      break;
+    }
+    Bucket   = (UINTN) LowBitSet32 (Pending);
+    Pending &= Pending - 1;
+  }
+
+  if (First == mDispatchIndex.RecordCount) {
+    return NULL;
+  }
+  return mDispatchIndex.Records[First];
+}
+
+/**
+  Account the time spent in one child dispatch to the statistics of its source.
+
+  @param[in] ProtocolType         Dispatch protocol of the child
+  @param[in] StartTicks           Performance counter value taken before the child was called
+**/
+STATIC
+VOID
+UpdateDispatchStatistics (
+  IN PCH_SMM_PROTOCOL_TYPE  ProtocolType,
+  IN UINT64                 StartTicks
+  )
+{
+  UINT64                              EndTicks;
+  UINT64                              Ticks;
+  UINT64                              TimeNs;
+  PCH_SMI_DISPATCH_SOURCE_STATISTICS  *Source;
+
+  EndTicks = GetPerformanceCounter ();
+  if (mPerformanceCounterEnd >= mPerformanceCounterStart) {
+    Ticks = EndTicks - StartTicks;
+    if (EndTicks < StartTicks) {
+      Ticks += mPerformanceCounterEnd - mPerformanceCounterStart;
+    }
+  } else {
+    Ticks = StartTicks - EndTicks;
+    if (StartTicks < EndTicks) {
+      Ticks += mPerformanceCounterStart - mPerformanceCounterEnd;
+    }
+  }
+  TimeNs = GetTimeInNanoSecond (Ticks);
+
+  ///
+  /// PCH_SMM_PROTOCOL_TYPE follows the order of the PCH_SMI_DISPATCH_SOURCE_* indexes
+  ///
+  ASSERT ((UINTN) ProtocolType < PCH_SMI_DISPATCH_SOURCE_MAX);
+  Source = &mSmiDispatchStatistics.Source[ProtocolType];
+  Source->DispatchCount++;
+  Source->TotalTimeNs += TimeNs;
+  if (TimeNs > Source->MaxTimeNs) {
+    Source->MaxTimeNs = TimeNs;
+  }
+}
+
 /**
   SMM ready to lock notification event handler.
 
@@ -160,6 +398,7 @@ SmmReadyToLockCallback (
   )
 {
   mReadyToLock = TRUE;
+  BuildDispatchIndex ();
 
   return EFI_SUCCESS;
 }
@@ -263,6 +502,20 @@ InitializePchSmmDispatcher (
   InstallEspiSmi (ImageHandle);
   InstallPchSmmPeriodicTimerControlProtocol (mPrivateData.InstallMultProtHandle);
 
+  ///
+  /// Publish the dispatch statistics for SMM test point checks
+  ///
+  GetPerformanceCounterProperties (&mPerformanceCounterStart, &mPerformanceCounterEnd);
+  mSmiDispatchStatistics.Revision    = PCH_SMI_DISPATCH_STATISTICS_REVISION;
+  mSmiDispatchStatistics.SourceCount = PCH_SMI_DISPATCH_SOURCE_MAX;
+  Status = gSmst->SmmInstallConfigurationTable (
+                    gSmst,
+                    &gPchSmiDispatchStatisticsGuid,
+                    &mSmiDispatchStatistics,
+                    sizeof (mSmiDispatchStatistics)
+                    );
+  ASSERT_EFI_ERROR (Status);
+
   //
   // Register EFI_SMM_READY_TO_LOCK_PROTOCOL_GUID notify function.
   //
@@ -762,7 +1015,6 @@ PchSmmCoreDispatcher (
   BOOLEAN             SxChildWasDispatched;
 
   DATABASE_RECORD     *RecordInDb;
-  LIST_ENTRY          *LinkInDb;
   DATABASE_RECORD     *RecordToExhaust;
   LIST_ENTRY          *LinkToExhaust;
 
@@ -778,6 +1030,11 @@ PchSmmCoreDispatcher (
   UINT8               Port76Save;
 
   PCH_SMM_SOURCE_DESC ActiveSource;
+  PCH_SMM_REGISTER_SNAPSHOT Snapshot;
+  UINT64              StartTicks;
+  UINT64              RootEntryTsc;
+  UINT64              EntryTsc;
+  UINT64              Handler;
 
   //
   // Initialize ActiveSource
@@ -790,6 +1047,9 @@ PchSmmCoreDispatcher (
   SxChildWasDispatched  = FALSE;
   Status                = EFI_SUCCESS;
 
+  RootEntryTsc = SmiLatencyProfileBegin ();
+  mSmiDispatchStatistics.RootHandlerCount++;
+
   //
   // Save IO index registers
   // @note: Save/Restore port 70h directly might break NMI_EN# setting,
@@ -806,156 +1066,147 @@ PchSmmCoreDispatcher (
     while ((!EosSet) && (EscapeCount > 0)) {
       EscapeCount--;
 
-      LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
-
       ///
       /// Cache SciEn, SmiEnValue and SmiStsValue to determine if source is active
       ///
       SciEn       = PchSmmGetSciEn ();
       SmiEnValue  = IoRead32 ((UINTN) (mAcpiBaseAddr + R_PCH_SMI_EN));
       SmiStsValue = IoRead32 ((UINTN) (mAcpiBaseAddr + R_PCH_SMI_STS));
+      PchSmmInitRegisterSnapshot (&Snapshot, SmiEnValue, SmiStsValue);
 
-      while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
-        RecordInDb = DATABASE_RECORD_FROM_LINK (LinkInDb);
+      ///
+      /// look for the first active source
+      ///
+      RecordInDb = FindFirstActiveRecord (SciEn, SmiStsValue, &Snapshot);
+      mSmiDispatchStatistics.RegisterReads += Snapshot.Reads;
+      if (RecordInDb == NULL) {
+        ///
+        /// No source is active, clear pending SMI status and try to clear EOS
+        ///
+        ClearPendingSmiStatus (SmiStsValue);
+        EosSet = PchSmmSetAndCheckEos ();
+        continue;
+      }
+
+      ///
+      /// We found a source. If this is a sleep type, we have to go to
+      /// appropriate sleep state anyway.No matter there is sleep child or not
+      ///
+      if (RecordInDb->ProtocolType == SxType) {
+        SxChildWasDispatched = TRUE;
+      }
+      ///
+      /// "cache" the source description and don't query I/O anymore
+      ///
+      CopyMem ((VOID *) &ActiveSource, (VOID *) &(RecordInDb->SrcDesc), sizeof (PCH_SMM_SOURCE_DESC));
+      LinkToExhaust = &RecordInDb->Link;
 
+      ///
+      /// exhaust the rest of the queue looking for the same source
+      ///
+      while (!IsNull (&mPrivateData.CallbackDataBase, LinkToExhaust)) {
+        RecordToExhaust = DATABASE_RECORD_FROM_LINK (LinkToExhaust);
         ///
-        /// look for the first active source
+        /// RecordToExhaust->Link might be removed (unregistered) by Callback function, and then the
+        /// system will hang in ASSERT() while calling GetNextNode().
+        /// To prevent the issue, we need to get next record in DB here (before Callback function).
         ///
-        if (!SourceIsActive (&RecordInDb->SrcDesc, SciEn, SmiEnValue, SmiStsValue)) {
-          ///
-          /// Didn't find the source yet, keep looking
-          ///
-          LinkInDb = GetNextNode (&mPrivateData.CallbackDataBase, &RecordInDb->Link);
+        LinkToExhaust = GetNextNode (&mPrivateData.CallbackDataBase, &RecordToExhaust->Link);
 
+        if (CompareSources (&RecordToExhaust->SrcDesc, &ActiveSource)) {
           ///
-          /// if it's the last one, try to clear EOS
-          ///
-          if (IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
-            //
-            // Clear pending SMI status before EOS
-            //
-            ClearPendingSmiStatus (SmiStsValue);
-            EosSet = PchSmmSetAndCheckEos ();
-          }
-        } else {
-          ///
-          /// We found a source. If this is a sleep type, we have to go to
-          /// appropriate sleep state anyway.No matter there is sleep child or not
-          ///
-          if (RecordInDb->ProtocolType == SxType) {
-            SxChildWasDispatched = TRUE;
-          }
-          ///
-          /// "cache" the source description and don't query I/O anymore
+          /// These source descriptions are equal, so this callback should be
+          /// dispatched.
           ///
-          CopyMem ((VOID *) &ActiveSource, (VOID *) &(RecordInDb->SrcDesc), sizeof (PCH_SMM_SOURCE_DESC));
-          LinkToExhaust = LinkInDb;
+          if (RecordToExhaust->ContextFunctions.GetContext != NULL) {
+            ///
+            /// This child requires that we get a calling context from
+            /// hardware and compare that context to the one supplied
+            /// by the child.
+            ///
+            ASSERT (RecordToExhaust->ContextFunctions.CmpContext != NULL);
 
-          ///
-          /// exhaust the rest of the queue looking for the same source
-          ///
-          while (!IsNull (&mPrivateData.CallbackDataBase, LinkToExhaust)) {
-            RecordToExhaust = DATABASE_RECORD_FROM_LINK (LinkToExhaust);
             ///
-            /// RecordToExhaust->Link might be removed (unregistered) by Callback function, and then the
-            /// system will hang in ASSERT() while calling GetNextNode().
-            /// To prevent the issue, we need to get next record in DB here (before Callback function).
+            /// Make sure contexts match before dispatching event to child
             ///
-            LinkToExhaust = GetNextNode (&mPrivateData.CallbackDataBase, &RecordToExhaust->Link);
-
-            if (CompareSources (&RecordToExhaust->SrcDesc, &ActiveSource)) {
-              ///
-              /// These source descriptions are equal, so this callback should be
-              /// dispatched.
-              ///
-              if (RecordToExhaust->ContextFunctions.GetContext != NULL) {
-                ///
-                /// This child requires that we get a calling context from
-                /// hardware and compare that context to the one supplied
-                /// by the child.
-                ///
-                ASSERT (RecordToExhaust->ContextFunctions.CmpContext != NULL);
-
-                ///
-                /// Make sure contexts match before dispatching event to child
-                ///
-                RecordToExhaust->ContextFunctions.GetContext (RecordToExhaust, &Context);
-                ContextsMatch = RecordToExhaust->ContextFunctions.CmpContext (&Context, &RecordToExhaust->ChildContext);
+            RecordToExhaust->ContextFunctions.GetContext (RecordToExhaust, &Context);
+            ContextsMatch = RecordToExhaust->ContextFunctions.CmpContext (&Context, &RecordToExhaust->ChildContext);
 
-              } else {
-                ///
-                /// This child doesn't require any more calling context beyond what
-                /// it supplied in registration.  Simply pass back what it gave us.
-                ///
-                Context       = RecordToExhaust->ChildContext;
-                ContextsMatch = TRUE;
-              }
+          } else {
+            ///
+            /// This child doesn't require any more calling context beyond what
+            /// it supplied in registration.  Simply pass back what it gave us.
+            ///
+            Context       = RecordToExhaust->ChildContext;
+            ContextsMatch = TRUE;
+          }
 
-              if (ContextsMatch) {
-                if (RecordToExhaust->ProtocolType == PchSmiDispatchType) {
-                  //
-                  // For PCH SMI dispatch protocols
-                  //
-                  PchSmiTypeCallbackDispatcher (RecordToExhaust);
+          if (ContextsMatch) {
+            if (RecordToExhaust->ProtocolType == PchSmiDispatchType) {
+              //
+              // For PCH SMI dispatch protocols
+              //
+              StartTicks = GetPerformanceCounter ();
+              PchSmiTypeCallbackDispatcher (RecordToExhaust);
+              UpdateDispatchStatistics (RecordToExhaust->ProtocolType, StartTicks);
+            } else {
+              //
+              // For EFI standard SMI dispatch protocols
+              //
+              if (RecordToExhaust->Callback != NULL) {
+                if (RecordToExhaust->ContextFunctions.GetCommBuffer != NULL) {
+                  ///
+                  /// This callback function needs CommBuffer and CommBufferSize.
+                  /// Get those from child and then pass to callback function.
+                  ///
+                  RecordToExhaust->ContextFunctions.GetCommBuffer (RecordToExhaust, &CommBuffer, &CommBufferSize);
                 } else {
-                  //
-                  // For EFI standard SMI dispatch protocols
-                  //
-                  if (RecordToExhaust->Callback != NULL) {
-                    if (RecordToExhaust->ContextFunctions.GetCommBuffer != NULL) {
-                      ///
-                      /// This callback function needs CommBuffer and CommBufferSize.
-                      /// Get those from child and then pass to callback function.
-                      ///
-                      RecordToExhaust->ContextFunctions.GetCommBuffer (RecordToExhaust, &CommBuffer, &CommBufferSize);
-                    } else {
-                      ///
-                      /// Child doesn't support the CommBuffer and CommBufferSize.
-                      /// Just pass NULL value to callback function.
-                      ///
-                      CommBuffer     = NULL;
-                      CommBufferSize = 0;
-                    }
-
-                    PERF_START_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
-                    RecordToExhaust->Callback ((EFI_HANDLE) & RecordToExhaust->Link, &Context, CommBuffer, &CommBufferSize);
-                    PERF_END_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
-                    if (RecordToExhaust->ProtocolType == SxType) {
-                      SxChildWasDispatched = TRUE;
-                    }
-                  } else {
-                    ASSERT (FALSE);
-                  }
+                  ///
+                  /// Child doesn't support the CommBuffer and CommBufferSize.
+                  /// Just pass NULL value to callback function.
+                  ///
+                  CommBuffer     = NULL;
+                  CommBufferSize = 0;
+                }
+
+                StartTicks = GetPerformanceCounter ();
+                PERF_START_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
+                Handler  = (UINT64) (UINTN) RecordToExhaust->Callback;
+                EntryTsc = SmiLatencyProfileBegin ();
+                RecordToExhaust->Callback ((EFI_HANDLE) & RecordToExhaust->Link, &Context, CommBuffer, &CommBufferSize);
+                SmiLatencyProfileEnd ((UINT32) RecordToExhaust->ProtocolType, Handler, EntryTsc);
+                PERF_END_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
+                UpdateDispatchStatistics (RecordToExhaust->ProtocolType, StartTicks);
+                if (RecordToExhaust->ProtocolType == SxType) {
+                  SxChildWasDispatched = TRUE;
                 }
+              } else {
+                ASSERT (FALSE);
               }
             }
           }
-
-          if (RecordInDb->ClearSource == NULL) {
-            ///
-            /// Clear the SMI associated w/ the source using the default function
-            ///
-            PchSmmClearSource (&ActiveSource);
-          } else {
-            ///
-            /// This source requires special handling to clear
-            ///
-            RecordInDb->ClearSource (&ActiveSource);
-          }
-          //
-          // Clear pending SMI status before EOS
-          //
-          ClearPendingSmiStatus (SmiStsValue);
-          ///
-          /// Also, try to clear EOS
-          ///
-          EosSet = PchSmmSetAndCheckEos ();
-          ///
-          /// Queue is empty, reset the search
-          ///
-          break;
         }
       }
+
+      if (RecordInDb->ClearSource == NULL) {
+        ///
+        /// Clear the SMI associated w/ the source using the default function
+        ///
+        PchSmmClearSource (&ActiveSource);
+      } else {
+        ///
+        /// This source requires special handling to clear
+        ///
+        RecordInDb->ClearSource (&ActiveSource);
+      }
+      //
+      // Clear pending SMI status before EOS
+      //
+      ClearPendingSmiStatus (SmiStsValue);
+      ///
+      /// Also, try to clear EOS
+      ///
+      EosSet = PchSmmSetAndCheckEos ();
     }
   }
   ///
@@ -992,5 +1243,7 @@ PchSmmCoreDispatcher (
   IoWrite8 (R_PCH_RTC_EXT_INDEX_ALT, Port76Save);
   IoWrite8 (R_PCH_RTC_INDEX_ALT, Port74Save);
 
+  SmiLatencyProfileEnd (SMI_LATENCY_PROFILE_SOURCE_ROOT, (UINT64) (UINTN) PchSmmCoreDispatcher, RootEntryTsc);
+
   return Status;
 }
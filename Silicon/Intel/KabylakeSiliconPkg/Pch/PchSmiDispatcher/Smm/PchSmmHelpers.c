@@ -139,23 +139,143 @@ CompareSources (
   return (BOOLEAN) (CompareEnables (Src1, Src2) && CompareStatuses (Src1, Src2));
 }
 
+/**
+  Start a new register snapshot, seeded with the SMI_EN and SMI_STS values the
+  dispatcher has already read for this pass.
+
+  @param[out] Snapshot            Pointer to the register snapshot
+  @param[in]  SmiEnValue          Value from R_PCH_SMI_EN
+  @param[in]  SmiStsValue         Value from R_PCH_SMI_STS
+**/
+VOID
+PchSmmInitRegisterSnapshot (
+  OUT PCH_SMM_REGISTER_SNAPSHOT *Snapshot,
+  IN  UINT32                    SmiEnValue,
+  IN  UINT32                    SmiStsValue
+  )
+{
+  Snapshot->Count = 2;
+  Snapshot->Reads = 0;
+
+  Snapshot->Entry[0].Type        = ACPI_ADDR_TYPE;
+  Snapshot->Entry[0].Offset      = R_PCH_SMI_EN;
+  Snapshot->Entry[0].SizeInBytes = 4;
+  Snapshot->Entry[0].Value       = SmiEnValue;
+
+  Snapshot->Entry[1].Type        = ACPI_ADDR_TYPE;
+  Snapshot->Entry[1].Offset      = R_PCH_SMI_STS;
+  Snapshot->Entry[1].SizeInBytes = 4;
+  Snapshot->Entry[1].Value       = SmiStsValue;
+}
+
+/**
+  Read a specifying bit through the register snapshot.
+  ACPI and TCO I/O registers are read from hardware the first time they are needed
+  in a pass and taken from the snapshot afterwards. Other register types are read directly.
+
+  @param[in] BitDesc              The struct that includes register address, size in byte and bit number
+  @param[in, out] Snapshot        Register snapshot of the current dispatch pass
+
+  @retval TRUE                    The bit is set
+  @retval FALSE                   The bit is clear
+**/
+STATIC
+BOOLEAN
+SnapshotReadBitDesc (
+  CONST PCH_SMM_BIT_DESC            *BitDesc,
+  IN OUT PCH_SMM_REGISTER_SNAPSHOT  *Snapshot
+  )
+{
+  UINTN   Index;
+  UINT16  BaseAddr;
+  UINT16  Offset;
+  UINT8   SizeInBytes;
+  UINT8   Bit;
+  UINT32  Value;
+
+  if ((BitDesc->Reg.Type != ACPI_ADDR_TYPE) && (BitDesc->Reg.Type != TCO_ADDR_TYPE)) {
+    Snapshot->Reads++;
+    return ReadBitDesc (BitDesc);
+  }
+
+  if (BitDesc->Reg.Type == ACPI_ADDR_TYPE) {
+    BaseAddr = mAcpiBaseAddr;
+    Offset   = BitDesc->Reg.Data.acpi;
+  } else {
+    BaseAddr = mTcoBaseAddr;
+    Offset   = BitDesc->Reg.Data.tco;
+  }
+  SizeInBytes = BitDesc->SizeInBytes;
+  Bit         = BitDesc->Bit;
+
+  //
+  // Same as ReadBitDesc, a 64-bit register is accessed as the 32-bit half holding the bit
+  //
+  if (SizeInBytes == 8) {
+    SizeInBytes = 4;
+    if (Bit >= 32) {
+      Offset += 4;
+      Bit    -= 32;
+    }
+  }
+
+  for (Index = 0; Index < Snapshot->Count; Index++) {
+    if ((Snapshot->Entry[Index].Type == BitDesc->Reg.Type) &&
+        (Snapshot->Entry[Index].Offset == Offset) &&
+        (Snapshot->Entry[Index].SizeInBytes == SizeInBytes)) {
+      return (BOOLEAN) ((Snapshot->Entry[Index].Value & (1u << Bit)) != 0);
+    }
+  }
+
+  switch (SizeInBytes) {
+    case 1:
+      Value = IoRead8 ((UINTN) (BaseAddr + Offset));
+      break;
+
+    case 2:
+      Value = IoRead16 ((UINTN) (BaseAddr + Offset));
+      break;
+
+    case 4:
+      Value = IoRead32 ((UINTN) (BaseAddr + Offset));
+      break;
+
+    default:
+      //
+      // Unsupported or invalid register size
+      //
+      ASSERT (FALSE);
+      Snapshot->Reads++;
+      return ReadBitDesc (BitDesc);
+  }
+  Snapshot->Reads++;
+
+  if (Snapshot->Count < PCH_SMM_REGISTER_SNAPSHOT_SIZE) {
+    Snapshot->Entry[Snapshot->Count].Type        = BitDesc->Reg.Type;
+    Snapshot->Entry[Snapshot->Count].Offset      = Offset;
+    Snapshot->Entry[Snapshot->Count].SizeInBytes = SizeInBytes;
+    Snapshot->Entry[Snapshot->Count].Value       = Value;
+    Snapshot->Count++;
+  }
+
+  return (BOOLEAN) ((Value & (1u << Bit)) != 0);
+}
+
 /**
   Check if an SMM source is active.
 
   @param[in] Src                  Pointer to the PCH SMI source description table
   @param[in] SciEn                Indicate if SCI is enabled or not
-  @param[in] SmiEnValue           Value from R_PCH_SMI_EN
-  @param[in] SmiStsValue          Value from R_PCH_SMI_STS
+  @param[in, out] Snapshot        Register snapshot of the current dispatch pass
 
   @retval TRUE                    It is active.
   @retval FALSE                   It is inactive.
 **/
 BOOLEAN
 SourceIsActive (
-  CONST IN PCH_SMM_SOURCE_DESC  *Src,
-  CONST IN BOOLEAN              SciEn,
-  CONST IN UINT32               SmiEnValue,
-  CONST IN UINT32               SmiStsValue
+  CONST IN PCH_SMM_SOURCE_DESC        *Src,
+  CONST IN BOOLEAN                    SciEn,
+  IN OUT   PCH_SMM_REGISTER_SNAPSHOT  *Snapshot
   )
 {
   UINTN   DescIndex;
@@ -174,36 +294,28 @@ SourceIsActive (
   if (!IS_BIT_DESC_NULL (Src->PmcSmiSts)) {
     if ((Src->PmcSmiSts.Reg.Type == ACPI_ADDR_TYPE) &&
         (Src->PmcSmiSts.Reg.Data.acpi == R_PCH_SMI_STS) &&
-        ((SmiStsValue & (1u << Src->PmcSmiSts.Bit)) == 0)) {
+        !SnapshotReadBitDesc (&Src->PmcSmiSts, Snapshot)) {
       return FALSE;
     }
   }
 
   ///
-  /// Read each bit desc from hardware and make sure it's a one
+  /// Read each bit desc, through the snapshot, and make sure it's a one
   ///
   for (DescIndex = 0; DescIndex < NUM_EN_BITS; DescIndex++) {
     if (!IS_BIT_DESC_NULL (Src->En[DescIndex])) {
-      if ((Src->En[DescIndex].Reg.Type == ACPI_ADDR_TYPE) &&
-          (Src->En[DescIndex].Reg.Data.acpi == R_PCH_SMI_EN) &&
-          ((SmiEnValue & (1u << Src->En[DescIndex].Bit)) == 0)) {
-        return FALSE;
-      } else if (ReadBitDesc (&Src->En[DescIndex]) == 0) {
+      if (!SnapshotReadBitDesc (&Src->En[DescIndex], Snapshot)) {
         return FALSE;
       }
     }
   }
 
   ///
-  /// Read each bit desc from hardware and make sure it's a one
+  /// Read each bit desc, through the snapshot, and make sure it's a one
   ///
   for (DescIndex = 0; DescIndex < NUM_STS_BITS; DescIndex++) {
     if (!IS_BIT_DESC_NULL (Src->Sts[DescIndex])) {
-      if ((Src->Sts[DescIndex].Reg.Type == ACPI_ADDR_TYPE) &&
-          (Src->Sts[DescIndex].Reg.Data.acpi == R_PCH_SMI_STS) &&
-          ((SmiStsValue & (1u << Src->Sts[DescIndex].Bit)) == 0)) {
-        return FALSE;
-      } else if (ReadBitDesc (&Src->Sts[DescIndex]) == 0) {
+      if (!SnapshotReadBitDesc (&Src->Sts[DescIndex], Snapshot)) {
         return FALSE;
       }
     }
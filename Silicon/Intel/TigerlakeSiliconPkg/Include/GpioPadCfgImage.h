@@ -0,0 +1,72 @@
+/** @file
+  Layout of a precompiled GPIO pad configuration image.
+
+  The image is produced at build time by Platform/Intel/Tools/GenGpioPadCfgImage
+  from a board GPIO_INIT_CONFIG table and consumed by GpioConfigurePadsFromImage().
+  All PADCFG and group DW register values are resolved ahead of time, so the
+  runtime only has to stream them out to the GPIO communities.
+
+  Image layout:
+    GPIO_PADCFG_IMAGE_HEADER
+    GPIO_PADCFG_IMAGE_COMMUNITY   (repeated CommunityCount times, sorted by Pid)
+      GPIO_PADCFG_IMAGE_GROUP_DW  GroupDw[GroupDwCount]
+      GPIO_PADCFG_IMAGE_REGISTER  Register[RegisterCount]
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#ifndef _GPIO_PADCFG_IMAGE_H_
+#define _GPIO_PADCFG_IMAGE_H_
+
+#include <Base.h>
+
+#define GPIO_PADCFG_IMAGE_SIGNATURE  SIGNATURE_32 ('G', 'P', 'C', 'I')
+#define GPIO_PADCFG_IMAGE_REVISION   1
+
+#pragma pack (push,1)
+
+typedef struct {
+  UINT32    Signature;        ///< GPIO_PADCFG_IMAGE_SIGNATURE
+  UINT16    Revision;         ///< GPIO_PADCFG_IMAGE_REVISION
+  UINT16    CommunityCount;   ///< Number of GPIO_PADCFG_IMAGE_COMMUNITY blocks
+  UINT32    ChipsetId;        ///< GPIO chipset ID the image was generated for
+  UINT32    ImageSize;        ///< Size of the whole image in bytes, header included
+} GPIO_PADCFG_IMAGE_HEADER;
+
+///
+/// One block per GPIO community, immediately followed by its group DW
+/// records and then its register records.
+///
+typedef struct {
+  UINT8     Pid;              ///< Sideband port ID of the GPIO community
+  UINT8     Reserved;
+  UINT16    GroupDwCount;     ///< Number of GPIO_PADCFG_IMAGE_GROUP_DW records
+  UINT32    RegisterCount;    ///< Number of GPIO_PADCFG_IMAGE_REGISTER records
+} GPIO_PADCFG_IMAGE_COMMUNITY;
+
+///
+/// Lock information for one DW of a GPIO group. Pads in PadMask are unlocked
+/// before the community is programmed, the unlock masks are handed over to
+/// GpioHelpersLib exactly as GpioConfigurePads() does.
+///
+typedef struct {
+  UINT32    Group;            ///< GPIO_GROUP
+  UINT32    DwNum;
+  UINT32    PadMask;          ///< Pads of this DW which are reconfigured
+  UINT32    ConfigUnlockMask; ///< Pads to be left with PADCFG unlocked
+  UINT32    OutputUnlockMask; ///< Pads to be left with output unlocked
+} GPIO_PADCFG_IMAGE_GROUP_DW;
+
+///
+/// Single register update, applied as (Current & ~Mask) | Value.
+/// PADCFG records come first in ascending offset order, followed by the
+/// HOSTSW_OWN/GPI_GPE_EN/GPI_NMI_EN/GPI_SMI_EN records in ascending offset order.
+///
+typedef struct {
+  UINT32    Offset;           ///< Register offset inside the community
+  UINT32    Mask;             ///< Bits to be modified
+  UINT32    Value;            ///< New value of the modified bits
+} GPIO_PADCFG_IMAGE_REGISTER;
+
+#pragma pack (pop)
+
+#endif // _GPIO_PADCFG_IMAGE_H_
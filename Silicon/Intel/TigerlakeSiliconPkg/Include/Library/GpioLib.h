@@ -44,6 +44,28 @@ GpioConfigurePads (
   IN GPIO_INIT_CONFIG          *GpioInitTableAddress
   );
 
+/**
+  This procedure will initialize multiple GPIO pins from a precompiled
+  PADCFG image generated at build time by GenGpioPadCfgImage.
+  Register values are already resolved in the image so they are only streamed
+  out to the GPIO communities. Registers which already hold the requested
+  value are not written.
+  Unlike GpioConfigurePads() no GPIO conflict HOB is created since the image
+  does not carry the original GPIO_INIT_CONFIG table.
+
+  @param[in] Image                      Pointer to GPIO_PADCFG_IMAGE_HEADER
+  @param[in] ImageSize                  Size of the image buffer in bytes
+
+  @retval EFI_SUCCESS                   The function completed successfully
+  @retval EFI_INVALID_PARAMETER         Image is malformed
+  @retval EFI_UNSUPPORTED               Image was generated for a different chipset
+**/
+EFI_STATUS
+GpioConfigurePadsFromImage (
+  IN CONST VOID                *Image,
+  IN UINTN                     ImageSize
+  );
+
 //
 // Functions for setting/getting multiple GpioPad settings
 //
@@ -7,6 +7,7 @@
 #include "GpioLibrary.h"
 #include <Register/PchPcrRegs.h>
 #include <Library/GpioCheckConflictLib.h>
+#include <GpioPadCfgImage.h>
 
 //
 // GPIO_GROUP_DW_DATA structure is used by GpioConfigurePch function
@@ -556,3 +557,143 @@ GpioConfigurePads (
   return Status;
 }
 
+
+/**
+  This internal procedure will program one GPIO community from a precompiled
+  PADCFG image. Pads are unlocked first, then register records are streamed out
+  in image order and lock information is stored for the end of boot.
+
+  @param[in] Community                  GPIO community block of the image
+**/
+STATIC
+VOID
+GpioConfigureCommunityFromImage (
+  IN CONST GPIO_PADCFG_IMAGE_COMMUNITY  *Community
+  )
+{
+  CONST GPIO_PADCFG_IMAGE_GROUP_DW  *GroupDw;
+  CONST GPIO_PADCFG_IMAGE_REGISTER  *Register;
+  UINTN                             Address;
+  UINT32                            CurrentValue;
+  UINT32                            NewValue;
+  UINT32                            GroupIndex;
+  UINT32                            Index;
+
+  GroupDw  = (CONST GPIO_PADCFG_IMAGE_GROUP_DW *) (Community + 1);
+  Register = (CONST GPIO_PADCFG_IMAGE_REGISTER *) (GroupDw + Community->GroupDwCount);
+
+  //
+  // Unlock pads which are going to be reconfigured, see GpioConfigurePch ()
+  //
+  for (Index = 0; Index < Community->GroupDwCount; Index++) {
+    if (GroupDw[Index].PadMask != 0) {
+      GpioUnlockPadCfgForGroupDw (GroupDw[Index].Group, GroupDw[Index].DwNum, GroupDw[Index].PadMask);
+      GpioUnlockPadCfgTxForGroupDw (GroupDw[Index].Group, GroupDw[Index].DwNum, GroupDw[Index].PadMask);
+    }
+  }
+
+  //
+  // Stream out register values. Registers already holding the requested
+  // value (e.g. on S3 resume or warm reset) are not written again.
+  //
+  for (Index = 0; Index < Community->RegisterCount; Index++) {
+    Address      = PCH_PCR_ADDRESS (Community->Pid, Register[Index].Offset);
+    CurrentValue = MmioRead32 (Address);
+    NewValue     = (CurrentValue & ~Register[Index].Mask) | Register[Index].Value;
+    if (NewValue != CurrentValue) {
+      MmioWrite32 (Address, NewValue);
+    }
+  }
+
+  for (Index = 0; Index < Community->GroupDwCount; Index++) {
+    GroupIndex = GpioGetGroupIndexFromGroup (GroupDw[Index].Group);
+    //
+    // Update Pad Configuration unlock data
+    //
+    if (GroupDw[Index].ConfigUnlockMask) {
+      GpioStoreGroupDwUnlockPadConfigData (GroupIndex, GroupDw[Index].DwNum, GroupDw[Index].ConfigUnlockMask);
+    }
+
+    //
+    // Update Pad Output unlock data
+    //
+    if (GroupDw[Index].OutputUnlockMask) {
+      GpioStoreGroupDwUnlockOutputData (GroupIndex, GroupDw[Index].DwNum, GroupDw[Index].OutputUnlockMask);
+    }
+  }
+}
+
+/**
+  This procedure will initialize multiple GPIO pins from a precompiled
+  PADCFG image generated at build time by GenGpioPadCfgImage.
+  Register values are already resolved in the image so they are only streamed
+  out to the GPIO communities. Registers which already hold the requested
+  value are not written.
+  Unlike GpioConfigurePads() no GPIO conflict HOB is created since the image
+  does not carry the original GPIO_INIT_CONFIG table.
+
+  @param[in] Image                      Pointer to GPIO_PADCFG_IMAGE_HEADER
+  @param[in] ImageSize                  Size of the image buffer in bytes
+
+  @retval EFI_SUCCESS                   The function completed successfully
+  @retval EFI_INVALID_PARAMETER         Image is malformed
+  @retval EFI_UNSUPPORTED               Image was generated for a different chipset
+**/
+EFI_STATUS
+GpioConfigurePadsFromImage (
+  IN CONST VOID                *Image,
+  IN UINTN                     ImageSize
+  )
+{
+  CONST GPIO_PADCFG_IMAGE_HEADER     *Header;
+  CONST GPIO_PADCFG_IMAGE_COMMUNITY  *Community;
+  UINTN                              Offset;
+  UINTN                              BlockSize;
+  UINT32                             Index;
+
+  Header = (CONST GPIO_PADCFG_IMAGE_HEADER *) Image;
+  if ((Header == NULL) ||
+      (ImageSize < sizeof (GPIO_PADCFG_IMAGE_HEADER)) ||
+      (Header->Signature != GPIO_PADCFG_IMAGE_SIGNATURE) ||
+      (Header->Revision != GPIO_PADCFG_IMAGE_REVISION) ||
+      (Header->ImageSize > ImageSize)) {
+    DEBUG ((DEBUG_ERROR, "GPIO ERROR: Invalid GPIO PADCFG image\n"));
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (Header->ChipsetId != GpioGetThisChipsetId ()) {
+    DEBUG ((DEBUG_ERROR, "GPIO ERROR: GPIO PADCFG image built for chipset 0x%x, running on 0x%x\n", Header->ChipsetId, GpioGetThisChipsetId ()));
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Validate the whole image before touching any register so that a truncated
+  // image does not leave the pads half configured.
+  //
+  Offset = sizeof (GPIO_PADCFG_IMAGE_HEADER);
+  for (Index = 0; Index < Header->CommunityCount; Index++) {
+    if (Offset + sizeof (GPIO_PADCFG_IMAGE_COMMUNITY) > Header->ImageSize) {
+      return EFI_INVALID_PARAMETER;
+    }
+    Community = (CONST GPIO_PADCFG_IMAGE_COMMUNITY *) ((CONST UINT8 *) Image + Offset);
+    BlockSize = sizeof (GPIO_PADCFG_IMAGE_COMMUNITY) +
+                Community->GroupDwCount * sizeof (GPIO_PADCFG_IMAGE_GROUP_DW) +
+                (UINTN) Community->RegisterCount * sizeof (GPIO_PADCFG_IMAGE_REGISTER);
+    if (BlockSize > Header->ImageSize - Offset) {
+      return EFI_INVALID_PARAMETER;
+    }
+    Offset += BlockSize;
+  }
+
+  Offset = sizeof (GPIO_PADCFG_IMAGE_HEADER);
+  for (Index = 0; Index < Header->CommunityCount; Index++) {
+    Community = (CONST GPIO_PADCFG_IMAGE_COMMUNITY *) ((CONST UINT8 *) Image + Offset);
+    GpioConfigureCommunityFromImage (Community);
+    Offset += sizeof (GPIO_PADCFG_IMAGE_COMMUNITY) +
+              Community->GroupDwCount * sizeof (GPIO_PADCFG_IMAGE_GROUP_DW) +
+              Community->RegisterCount * sizeof (GPIO_PADCFG_IMAGE_REGISTER);
+  }
+
+  GpioClearAllGpioInterrupts ();
+  return EFI_SUCCESS;
+}
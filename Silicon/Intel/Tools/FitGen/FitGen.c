@@ -346,6 +346,63 @@ typedef struct {
 
 FIT_TABLE_CONTEXT   gFitTableContext = {0};
 
+//
+// Index of the FVs and FFS files of a buffer, built once and used by every
+// GUID lookup on that buffer instead of rescanning it.
+//
+typedef struct {
+  EFI_GUID                    Name;
+  UINT32                      Ordinal;  // Scan order, keeps first match semantic for duplicate GUIDs
+  UINT32                      Size;     // File size without FFS header
+  UINT8                       *Data;    // File data after FFS header
+  EFI_FIRMWARE_VOLUME_HEADER  *FvHeader;
+} FFS_FILE_INDEX_ENTRY;
+
+typedef struct _FV_FILE_INDEX {
+  struct _FV_FILE_INDEX       *Next;
+  UINT8                       *Buffer;
+  UINT32                      BufferSize;
+  UINT32                      FvCount;
+  EFI_FIRMWARE_VOLUME_HEADER  **FvHeaders;
+  UINT32                      FileCount;
+  FFS_FILE_INDEX_ENTRY        *Files;   // Sorted by Name, then Ordinal
+} FV_FILE_INDEX;
+
+FV_FILE_INDEX       *gFvFileIndexList = NULL;
+
+//
+// Input files read by ReadInputFile() with a FileBufferRaw, either mapped or allocated.
+//
+typedef struct _INPUT_FILE_BUFFER {
+  struct _INPUT_FILE_BUFFER   *Next;
+  UINT8                       *Raw;
+  UINTN                       RawSize;
+  BOOLEAN                     Mapped;
+#if defined(__GNUC__) && !defined(_WIN32)
+  dev_t                       Device;
+  ino_t                       Inode;
+#endif
+} INPUT_FILE_BUFFER;
+
+INPUT_FILE_BUFFER   *gInputFileBufferList = NULL;
+
+//
+// Timing mode (-timing)
+//
+typedef enum {
+  FitTimeReadInput,
+  FitTimeCollectEntries,
+  FitTimeFillTable,
+  FitTimeWriteOutput,
+  FitTimeFvIndex,
+  FitTimeMax
+} FIT_TIME_PHASE;
+
+BOOLEAN             gTimingMode = FALSE;
+UINT64              gPhaseTime[FitTimeMax];
+UINT32              gFvIndexBuildCount = 0;
+UINT32              gGuidLookupCount = 0;
+
 unsigned int
 xtoi (
   char  *str
@@ -473,6 +530,7 @@ PrintUsage (
           "\t[-P RecordType <IndexPort DataPort Width Bit Index> [-V <RecordVersion>]] [-P ... [-V ...]]\n"
           "\t[-BP <BootPolicySize>[-V <BootPolicyVersion>]\n"
           "\t[-T <FixedFitLocation>]\n"
+          "\t[-TIMING]\n"
           , UTILITY_NAME);
   printf ("  Where:\n");
   printf ("\t-D                     - It is FD file instead of FV file. (The tool will search FV file)\n");
@@ -522,6 +580,7 @@ PrintUsage (
   printf ("\tBit                    - The Bit Number of the port.\n");
   printf ("\tIndex                  - The Index Number of the port.\n");
   printf ("\tFixedFitLocation       - Fixed FIT location in flash address. FIT table will be generated at this location and Option Modules will be directly put right before it.\n");
+  printf ("\t-TIMING                - Report the time spent in each phase of the tool.\n");
   printf ("\nUsage (view): %s [-view] InputFile -F <FitTablePointerOffset>\n", UTILITY_NAME);
   printf ("  Where:\n");
   printf ("\tInputFile              - Name of the input file.\n");
@@ -628,6 +687,209 @@ GetFixedFitLocation (
   return FitLocation;
 }
 
+/**
+  Get a timestamp for the timing mode.
+
+  @return Current time in microseconds.
+**/
+UINT64
+GetTimeInMicroseconds (
+  VOID
+  )
+{
+#if defined(__GNUC__) && !defined(_WIN32)
+  struct timespec             Time;
+
+  clock_gettime (CLOCK_MONOTONIC, &Time);
+  return (UINT64)Time.tv_sec * 1000000 + (UINT64)Time.tv_nsec / 1000;
+#else
+  return (UINT64)clock () * 1000000 / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+  Print where the tool spent its time. Only used in timing mode.
+
+  @param TotalTime        Time spent in FitGen().
+**/
+VOID
+PrintTiming (
+  IN UINT64  TotalTime
+  )
+{
+  printf ("\nTiming (ms):\n");
+  printf ("  Read input             %10.3f\n", gPhaseTime[FitTimeReadInput] / 1000.0);
+  printf ("  Collect FIT entries    %10.3f\n", gPhaseTime[FitTimeCollectEntries] / 1000.0);
+  printf ("  Fill FIT table         %10.3f\n", gPhaseTime[FitTimeFillTable] / 1000.0);
+  printf ("  Write output           %10.3f\n", gPhaseTime[FitTimeWriteOutput] / 1000.0);
+  printf ("  Total                  %10.3f\n", TotalTime / 1000.0);
+  printf ("  FV/FFS index builds    %10.3f (%u builds, included above)\n", gPhaseTime[FitTimeFvIndex] / 1000.0, gFvIndexBuildCount);
+  printf ("  GUID lookups           %10u\n", gGuidLookupCount);
+}
+
+/**
+  Record an input file buffer so that FreeInputFile() knows how to release it.
+
+  @param Raw              Start of the buffer returned as FileBufferRaw.
+  @param RawSize          Size of the buffer.
+  @param Mapped           TRUE if the buffer is a file mapping.
+  @param FileStat         File information of a mapped file, NULL otherwise.
+**/
+VOID
+AddInputFileBuffer (
+  IN UINT8    *Raw,
+  IN UINTN    RawSize,
+  IN BOOLEAN  Mapped,
+  IN VOID     *FileStat
+  )
+{
+  INPUT_FILE_BUFFER           *InputFile;
+
+  InputFile = (INPUT_FILE_BUFFER *) malloc (sizeof (INPUT_FILE_BUFFER));
+  if (InputFile == NULL) {
+    //
+    // Not tracked, FreeInputFile() falls back to free()
+    //
+    return;
+  }
+  SetMem (InputFile, sizeof (INPUT_FILE_BUFFER), 0);
+  InputFile->Raw     = Raw;
+  InputFile->RawSize = RawSize;
+  InputFile->Mapped  = Mapped;
+#if defined(__GNUC__) && !defined(_WIN32)
+  if (FileStat != NULL) {
+    InputFile->Device = ((struct stat *)FileStat)->st_dev;
+    InputFile->Inode  = ((struct stat *)FileStat)->st_ino;
+  }
+#endif
+  InputFile->Next = gInputFileBufferList;
+  gInputFileBufferList = InputFile;
+}
+
+/**
+  Map an input file copy-on-write at a 64KB aligned address.
+
+  @param FpIn             The opened input file.
+  @param FileSize         The input file size.
+  @param FileData         The mapped file data, 64KB aligned.
+  @param FileBufferRaw    The mapping, to be released with FreeInputFile().
+
+  @return TRUE            The file is mapped.
+  @return FALSE           Mapping is not supported, the caller reads the file.
+**/
+BOOLEAN
+MapInputFile (
+  IN  FILE    *FpIn,
+  IN  UINT32  FileSize,
+  OUT UINT8   **FileData,
+  OUT UINT8   **FileBufferRaw
+  )
+{
+#if defined(__GNUC__) && !defined(_WIN32)
+  struct stat                 FileStat;
+  UINT8                       *Reserved;
+  UINT8                       *Aligned;
+  VOID                        *Mapping;
+  UINTN                       ReservedSize;
+
+  if ((FileSize == 0) || (fstat (fileno (FpIn), &FileStat) != 0) || !S_ISREG (FileStat.st_mode)) {
+    return FALSE;
+  }
+
+  //
+  // Reserve address space with the same 64KB slack as the allocated buffer
+  // and map the file over its aligned part.
+  //
+  ReservedSize = (UINTN)FileSize + 0x10000;
+  Reserved = mmap (NULL, ReservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (Reserved == MAP_FAILED) {
+    return FALSE;
+  }
+  Aligned = (UINT8 *)(((UINTN)Reserved + 0xFFFF) & ~(UINTN)0xFFFF);
+  Mapping = mmap (Aligned, FileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fileno (FpIn), 0);
+  if (Mapping == MAP_FAILED) {
+    munmap (Reserved, ReservedSize);
+    return FALSE;
+  }
+
+  *FileBufferRaw = Reserved;
+  *FileData      = Aligned;
+  AddInputFileBuffer (Reserved, ReservedSize, TRUE, &FileStat);
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+/**
+  Release an input file buffer returned by ReadInputFile() in FileBufferRaw,
+  together with any FV/FFS index built over it.
+
+  @param FileBufferRaw    The buffer to release.
+**/
+VOID
+FreeInputFile (
+  IN UINT8  *FileBufferRaw
+  )
+{
+  INPUT_FILE_BUFFER           **Link;
+  INPUT_FILE_BUFFER           *InputFile;
+
+  for (Link = &gInputFileBufferList; *Link != NULL; Link = &(*Link)->Next) {
+    InputFile = *Link;
+    if (InputFile->Raw != FileBufferRaw) {
+      continue;
+    }
+    FreeFvFileIndex (InputFile->Raw, InputFile->RawSize);
+    *Link = InputFile->Next;
+#if defined(__GNUC__) && !defined(_WIN32)
+    if (InputFile->Mapped) {
+      munmap (InputFile->Raw, InputFile->RawSize);
+      free (InputFile);
+      return;
+    }
+#endif
+    free (InputFile);
+    break;
+  }
+
+  free ((VOID *)FileBufferRaw);
+}
+
+/**
+  Check whether a buffer is backed by a mapping of the given file. Writing to
+  that file truncates it and would invalidate the pages of the mapping.
+
+  @param FileName         The file name.
+  @param Buffer           The buffer.
+
+  @return TRUE            The buffer lies in a mapping of FileName.
+**/
+BOOLEAN
+IsMappedFromFile (
+  IN CHAR8  *FileName,
+  IN UINT8  *Buffer
+  )
+{
+#if defined(__GNUC__) && !defined(_WIN32)
+  struct stat                 FileStat;
+  INPUT_FILE_BUFFER           *InputFile;
+
+  if (stat (FileName, &FileStat) != 0) {
+    return FALSE;
+  }
+  for (InputFile = gInputFileBufferList; InputFile != NULL; InputFile = InputFile->Next) {
+    if (InputFile->Mapped &&
+        (InputFile->Device == FileStat.st_dev) &&
+        (InputFile->Inode == FileStat.st_ino) &&
+        (Buffer >= InputFile->Raw) && (Buffer < InputFile->Raw + InputFile->RawSize)) {
+      return TRUE;
+    }
+  }
+#endif
+  return FALSE;
+}
+
 /**
   Read input file.
 
@@ -679,6 +941,14 @@ ReadInputFile (
   // Read the contents of input file to memory buffer
   //
   if (FileBufferRaw != NULL) {
+    //
+    // Map the file copy-on-write when possible, the FIT table is only
+    // updated in memory and saved by WriteOutputFile().
+    //
+    if (MapInputFile (FpIn, *FileSize, FileData, FileBufferRaw)) {
+      fclose (FpIn);
+      return STATUS_SUCCESS;
+    }
     *FileBufferRaw = (UINT8 *) malloc (*FileSize + 0x10000);
     if (NULL == *FileBufferRaw) {
       Error (NULL, 0, 0, "No sufficient memory to allocate!", NULL);
@@ -687,6 +957,7 @@ ReadInputFile (
     }
     TempResult = 0x10000 - (UINT32) ((UINTN)*FileBufferRaw & 0x0FFFF);
     *FileData = (UINT8 *)((UINTN)*FileBufferRaw + TempResult);
+    AddInputFileBuffer (*FileBufferRaw, *FileSize + 0x10000, FALSE, NULL);
   } else {
     *FileData = (UINT8 *) malloc (*FileSize);
      if (NULL == *FileData) {
@@ -700,7 +971,7 @@ ReadInputFile (
   if (TempResult != *FileSize) {
     Error (NULL, 0, 0, "Read input file error!", NULL);
     if (FileBufferRaw != NULL) {
-      free ((VOID *)*FileBufferRaw);
+      FreeInputFile (*FileBufferRaw);
     } else {
       free ((VOID *)*FileData);
     }
@@ -780,101 +1051,277 @@ FindNextFvHeader (
 }
 
 /**
-  Find File with GUID in an FV.
+  Compare two FFS file index entries by GUID, then by scan order.
 
-  @param FvBuffer         FV binary buffer.
-  @param FvSize           FV size.
-  @param Guid             File GUID value to be searched.
-  @param FileSize         Guid File size.
+  @param Entry1           The first entry.
+  @param Entry2           The second entry.
 
-  @return FileLocation    Guid File location.
-  @return NULL            Guid File is not found.
+  @return <0, 0, >0       Entry1 sorts before, equal to or after Entry2.
 **/
-UINT8  *
-FindFileFromFvByGuid (
+int
+CompareFfsFileIndexEntry (
+  IN CONST VOID  *Entry1,
+  IN CONST VOID  *Entry2
+  )
+{
+  CONST FFS_FILE_INDEX_ENTRY  *File1;
+  CONST FFS_FILE_INDEX_ENTRY  *File2;
+  int                         Result;
+
+  File1 = (CONST FFS_FILE_INDEX_ENTRY *)Entry1;
+  File2 = (CONST FFS_FILE_INDEX_ENTRY *)Entry2;
+  Result = memcmp (&File1->Name, &File2->Name, sizeof (EFI_GUID));
+  if (Result != 0) {
+    return Result;
+  }
+  return (File1->Ordinal < File2->Ordinal) ? -1 : (File1->Ordinal > File2->Ordinal);
+}
+
+/**
+  Release the FV/FFS indexes built over a memory range.
+
+  @param Buffer           Start of the memory range, NULL to release all indexes.
+  @param BufferSize       Size of the memory range.
+**/
+VOID
+FreeFvFileIndex (
+  IN UINT8  *Buffer,
+  IN UINTN  BufferSize
+  )
+{
+  FV_FILE_INDEX               **Link;
+  FV_FILE_INDEX               *FvFileIndex;
+
+  Link = &gFvFileIndexList;
+  while (*Link != NULL) {
+    FvFileIndex = *Link;
+    if ((Buffer == NULL) ||
+        ((FvFileIndex->Buffer >= Buffer) && (FvFileIndex->Buffer < Buffer + BufferSize))) {
+      *Link = FvFileIndex->Next;
+      free (FvFileIndex->FvHeaders);
+      free (FvFileIndex->Files);
+      free (FvFileIndex);
+    } else {
+      Link = &FvFileIndex->Next;
+    }
+  }
+}
+
+/**
+  Get the index of all FVs and FFS files in a buffer. The index is built on
+  first use with a single pass over the buffer and reused afterwards.
+
+  @param FvBuffer         FV or FD binary buffer.
+  @param FvSize           Buffer size.
+
+  @return FvFileIndex     The index of the buffer.
+  @return NULL            No sufficient memory to build the index.
+**/
+FV_FILE_INDEX *
+GetFvFileIndex (
   IN UINT8     *FvBuffer,
-  IN UINT32    FvSize,
-  IN EFI_GUID  *Guid,
-  OUT UINT32   *FileSize
+  IN UINT32    FvSize
   )
 {
+  FV_FILE_INDEX               *FvFileIndex;
   EFI_FIRMWARE_VOLUME_HEADER  *FvHeader;
   EFI_FFS_FILE_HEADER         *FileHeader;
+  FFS_FILE_INDEX_ENTRY        *File;
+  VOID                        *NewBuffer;
   UINT64                      FvLength;
-  EFI_GUID                    *TempGuid;
-  UINT8                       *FixPoint;
   UINTN                       Offset;
   UINTN                       FileLength;
   UINTN                       FileOccupiedSize;
+  UINT32                      FvCapacity;
+  UINT32                      FileCapacity;
+  UINT64                      StartTime;
 
-  //
-  // Find the FFS file
-  //
-  FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader (FvBuffer, FvSize);
-  if (NULL == FvHeader) {
+  for (FvFileIndex = gFvFileIndexList; FvFileIndex != NULL; FvFileIndex = FvFileIndex->Next) {
+    if ((FvFileIndex->Buffer == FvBuffer) && (FvFileIndex->BufferSize == FvSize)) {
+      return FvFileIndex;
+    }
+  }
+
+  StartTime = GetTimeInMicroseconds ();
+  FvFileIndex = (FV_FILE_INDEX *) malloc (sizeof (FV_FILE_INDEX));
+  if (FvFileIndex == NULL) {
+    Error (NULL, 0, 0, "No sufficient memory to allocate!", NULL);
     return NULL;
   }
-  while (TRUE) {
-    FvLength         = FvHeader->FvLength;
+  SetMem (FvFileIndex, sizeof (FV_FILE_INDEX), 0);
+  FvFileIndex->Buffer     = FvBuffer;
+  FvFileIndex->BufferSize = FvSize;
+  FvCapacity   = 0;
+  FileCapacity = 0;
+
+  FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader (FvBuffer, FvSize);
+  while (FvHeader != NULL) {
+    FvLength = FvHeader->FvLength;
+
+    if (FvFileIndex->FvCount == FvCapacity) {
+      FvCapacity = (FvCapacity == 0) ? 16 : FvCapacity * 2;
+      NewBuffer = realloc (FvFileIndex->FvHeaders, FvCapacity * sizeof (EFI_FIRMWARE_VOLUME_HEADER *));
+      if (NewBuffer == NULL) {
+        goto OutOfResources;
+      }
+      FvFileIndex->FvHeaders = (EFI_FIRMWARE_VOLUME_HEADER **)NewBuffer;
+    }
+    FvFileIndex->FvHeaders[FvFileIndex->FvCount++] = FvHeader;
 
     //
-    // Prepare to walk the FV image
+    // Walk the FV image
     //
-    InitializeFvLib (FvHeader, (UINT32)FvLength);
-
-    FileHeader       = (EFI_FFS_FILE_HEADER *)((UINTN)FvHeader + FvHeader->HeaderLength);
-    Offset           = (UINTN) FileHeader - (UINTN) FvHeader;
+    FileHeader = (EFI_FFS_FILE_HEADER *)((UINTN)FvHeader + FvHeader->HeaderLength);
+    Offset     = (UINTN) FileHeader - (UINTN) FvHeader;
 
     while (Offset < FvLength) {
-      TempGuid = (EFI_GUID *)&(FileHeader->Name);
       FileLength = (*(UINT32 *)(FileHeader->Size)) & 0x00FFFFFF;
       FileOccupiedSize = GETOCCUPIEDSIZE(FileLength, 8);
-      if ((CompareGuid (TempGuid, Guid)) == 0) {
-        //
-        // Good! Find it.
-        //
-        FixPoint = ((UINT8 *)FileHeader + sizeof(EFI_FFS_FILE_HEADER));
+      if (FileOccupiedSize < sizeof (EFI_FFS_FILE_HEADER)) {
         //
-        // Find the position of file module, the offset
-        // between the position and the end of FvRecovery.fv file
-        // should not exceed 128kB to prevent reset vector from
-        // outside legacy E and F segment
+        // Corrupted file header, the rest of the FV can not be walked
         //
-        if ((UINTN)FvHeader + FvLength - (UINTN)FixPoint > 0x20000) {
-  //        printf ("WARNING: The position of file module is not in E and F segment!\n");
-  //        return NULL;
-        }
-        *FileSize = FileLength - sizeof(EFI_FFS_FILE_HEADER);
-  #if (PI_SPECIFICATION_VERSION < 0x00010000)
-        if (FileHeader->Attributes & FFS_ATTRIB_TAIL_PRESENT) {
-          *FileSize -= sizeof(EFI_FFS_FILE_TAIL);
+        break;
+      }
+
+      if (FvFileIndex->FileCount == FileCapacity) {
+        FileCapacity = (FileCapacity == 0) ? 256 : FileCapacity * 2;
+        NewBuffer = realloc (FvFileIndex->Files, FileCapacity * sizeof (FFS_FILE_INDEX_ENTRY));
+        if (NewBuffer == NULL) {
+          goto OutOfResources;
         }
-  #endif
-        return FixPoint;
+        FvFileIndex->Files = (FFS_FILE_INDEX_ENTRY *)NewBuffer;
       }
+      File = &FvFileIndex->Files[FvFileIndex->FileCount];
+      memcpy (&File->Name, &FileHeader->Name, sizeof (EFI_GUID));
+      File->Ordinal  = FvFileIndex->FileCount;
+      File->Size     = (UINT32)(FileLength - sizeof(EFI_FFS_FILE_HEADER));
+#if (PI_SPECIFICATION_VERSION < 0x00010000)
+      if (FileHeader->Attributes & FFS_ATTRIB_TAIL_PRESENT) {
+        File->Size -= sizeof(EFI_FFS_FILE_TAIL);
+      }
+#endif
+      File->Data     = (UINT8 *)FileHeader + sizeof(EFI_FFS_FILE_HEADER);
+      File->FvHeader = FvHeader;
+      FvFileIndex->FileCount++;
+
       FileHeader = (EFI_FFS_FILE_HEADER *)((UINTN)FileHeader + FileOccupiedSize);
       Offset = (UINTN) FileHeader - (UINTN) FvHeader;
     }
 
     //
-    // Not found, check next FV
+    // Next FV
     //
     if ((UINTN)FvBuffer + FvSize > (UINTN)FvHeader + FvLength) {
       FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader ((UINT8 *)FvHeader + (UINTN)FvLength, (UINTN)FvBuffer + FvSize - ((UINTN)FvHeader + (UINTN)FvLength));
-      if (FvHeader == NULL) {
-        break;
-      }
     } else {
-      break;
+      FvHeader = NULL;
     }
   }
 
+  if (FvFileIndex->FileCount > 1) {
+    qsort (FvFileIndex->Files, FvFileIndex->FileCount, sizeof (FFS_FILE_INDEX_ENTRY), CompareFfsFileIndexEntry);
+  }
+
+  FvFileIndex->Next = gFvFileIndexList;
+  gFvFileIndexList  = FvFileIndex;
+  gFvIndexBuildCount++;
+  gPhaseTime[FitTimeFvIndex] += GetTimeInMicroseconds () - StartTime;
+  return FvFileIndex;
+
+OutOfResources:
+  Error (NULL, 0, 0, "No sufficient memory to allocate!", NULL);
+  free (FvFileIndex->FvHeaders);
+  free (FvFileIndex->Files);
+  free (FvFileIndex);
+  return NULL;
+}
+
+/**
+  Find a file by GUID in an FV/FFS index.
+
+  @param FvFileIndex      The index to search.
+  @param Guid             File GUID value to be searched.
+  @param FvHeader         Only search the files of this FV, NULL to search all FVs.
+
+  @return File            The first matching file in scan order.
+  @return NULL            Guid File is not found.
+**/
+FFS_FILE_INDEX_ENTRY *
+FindFileInFvFileIndex (
+  IN FV_FILE_INDEX               *FvFileIndex,
+  IN EFI_GUID                    *Guid,
+  IN EFI_FIRMWARE_VOLUME_HEADER  *FvHeader OPTIONAL
+  )
+{
+  UINT32                      Low;
+  UINT32                      High;
+  UINT32                      Middle;
+
+  gGuidLookupCount++;
+
   //
-  // Not found
+  // Find the first entry with this GUID
   //
+  Low  = 0;
+  High = FvFileIndex->FileCount;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (memcmp (&FvFileIndex->Files[Middle].Name, Guid, sizeof (EFI_GUID)) < 0) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  for (; Low < FvFileIndex->FileCount; Low++) {
+    if (memcmp (&FvFileIndex->Files[Low].Name, Guid, sizeof (EFI_GUID)) != 0) {
+      break;
+    }
+    if ((FvHeader == NULL) || (FvFileIndex->Files[Low].FvHeader == FvHeader)) {
+      return &FvFileIndex->Files[Low];
+    }
+  }
+
   return NULL;
 }
 
+/**
+  Find File with GUID in an FV.
+
+  @param FvBuffer         FV binary buffer.
+  @param FvSize           FV size.
+  @param Guid             File GUID value to be searched.
+  @param FileSize         Guid File size.
+
+  @return FileLocation    Guid File location.
+  @return NULL            Guid File is not found.
+**/
+UINT8  *
+FindFileFromFvByGuid (
+  IN UINT8     *FvBuffer,
+  IN UINT32    FvSize,
+  IN EFI_GUID  *Guid,
+  OUT UINT32   *FileSize
+  )
+{
+  FV_FILE_INDEX               *FvFileIndex;
+  FFS_FILE_INDEX_ENTRY        *File;
+
+  FvFileIndex = GetFvFileIndex (FvBuffer, FvSize);
+  if (FvFileIndex == NULL) {
+    return NULL;
+  }
+
+  File = FindFileInFvFileIndex (FvFileIndex, Guid, NULL);
+  if (File == NULL) {
+    return NULL;
+  }
+
+  *FileSize = File->Size;
+  return File->Data;
+}
+
 /**
   Check whether a string is a GUID.
 
@@ -1873,7 +2320,7 @@ GetFitEntryNumber (
     }
 
     if (MicrocodeFileBufferRaw != NULL) {
-      free ((VOID *)MicrocodeFileBufferRaw);
+      FreeInputFile (MicrocodeFileBufferRaw);
       MicrocodeFileBufferRaw = NULL;
     }
   }
@@ -3378,6 +3825,8 @@ WriteOutputFile (
   )
 {
   FILE                        *FpOut;
+  UINT8                       *FileCopy;
+  STATUS                      Status;
 
   //
   //Check the File Path
@@ -3389,27 +3838,46 @@ WriteOutputFile (
   }
 
   //
-  // Open the output FvRecovery.fv file
+  // Output file is the mapped input file, opening it truncates the file
+  // under the mapping. Take a copy of the data first.
   //
-  if ((FpOut = fopen (FileName, "w+b")) == NULL) {
-    Error (NULL, 0, 0, "Unable to open file", "%s", FileName);
-    return STATUS_ERROR;
+  FileCopy = NULL;
+  if (IsMappedFromFile (FileName, FileData)) {
+    FileCopy = (UINT8 *) malloc (FileSize);
+    if (FileCopy == NULL) {
+      Error (NULL, 0, 0, "No sufficient memory to allocate!", NULL);
+      return STATUS_ERROR;
+    }
+    memcpy (FileCopy, FileData, FileSize);
+    FileData = FileCopy;
   }
+
+  Status = STATUS_SUCCESS;
   //
-  // Write the output FvRecovery.fv file
+  // Open the output FvRecovery.fv file
   //
-  if ((fwrite (FileData, 1, FileSize, FpOut)) != FileSize) {
-    Error (NULL, 0, 0, "Write output file error!", NULL);
+  if ((FpOut = fopen (FileName, "w+b")) == NULL) {
+    Error (NULL, 0, 0, "Unable to open file", "%s", FileName);
+    Status = STATUS_ERROR;
+  } else {
+    //
+    // Write the output FvRecovery.fv file
+    //
+    if ((fwrite (FileData, 1, FileSize, FpOut)) != FileSize) {
+      Error (NULL, 0, 0, "Write output file error!", NULL);
+      Status = STATUS_ERROR;
+    }
+
+    //
+    // Close the output FvRecovery.fv file
+    //
     fclose (FpOut);
-    return STATUS_ERROR;
   }
 
-  //
-  // Close the output FvRecovery.fv file
-  //
-  fclose (FpOut);
-
-  return STATUS_SUCCESS;
+  if (FileCopy != NULL) {
+    free (FileCopy);
+  }
+  return Status;
 }
 
 
@@ -3428,40 +3896,23 @@ GetFvAcmSizeFromFd(
 
 **/
 {
-  UINT8                         *FileBuffer = NULL;
+  FV_FILE_INDEX                 *FvFileIndex;
   UINT32                        FvAcmSize = 0;
   EFI_GUID                      ACMGuid = ACMFV_GUID;
-  UINT32                        FvLength;
-  UINT32                        FileLength;
+  UINT32                        FvIndex;
 
-  //*FvRecovery = NULL;
-  FileBuffer = FindNextFvHeader(FdBuffer, FdFileSize);
-  if (FileBuffer == NULL) {
+  FvFileIndex = GetFvFileIndex (FdBuffer, FdFileSize);
+  if (FvFileIndex == NULL) {
     return 0;
   }
 
-  while ((UINTN)FileBuffer < (UINTN)FdBuffer + FdFileSize) {
-    FvLength = (UINT32)((EFI_FIRMWARE_VOLUME_HEADER *)FileBuffer)->FvLength;
-
-    if (FindFileFromFvByGuid(FileBuffer, FvLength, &ACMGuid, &FileLength) != NULL) {
+  for (FvIndex = 0; FvIndex < FvFileIndex->FvCount; FvIndex++) {
+    if (FindFileInFvFileIndex (FvFileIndex, &ACMGuid, FvFileIndex->FvHeaders[FvIndex]) != NULL) {
       //
       // Found the ACM
       //
-      FvAcmSize = FvLength;
+      FvAcmSize = (UINT32)FvFileIndex->FvHeaders[FvIndex]->FvLength;
     }
-
-    //
-    // Next fv
-    //
-    FileBuffer = (UINT8 *)FileBuffer + FvLength;
-    if ((UINTN)FileBuffer >= (UINTN)FdBuffer + FdFileSize) {
-      break;
-    }
-    FileBuffer = FindNextFvHeader(FileBuffer, (UINTN)FdBuffer + FdFileSize - (UINTN)FileBuffer);
-    if (FileBuffer == NULL) {
-      break;
-    }
-
   }
 
   return FvAcmSize;
@@ -3485,41 +3936,25 @@ GetFvRecoveryInfoFromFd (
   OUT UINT8                      **FvRecovery
   )
 {
-  UINT8                         *FileBuffer = NULL;
+  FV_FILE_INDEX                 *FvFileIndex;
   UINT32                        FvRecoveryFileSize =0;
   EFI_GUID                      VTFGuid = EFI_FFS_VOLUME_TOP_FILE_GUID;
-  UINT32                        FvLength;
-  UINT32                        FileLength;
+  UINT32                        FvIndex;
 
   *FvRecovery = NULL;
-  FileBuffer = FindNextFvHeader (FdBuffer, FdFileSize);
-  if (FileBuffer == NULL) {
+  FvFileIndex = GetFvFileIndex (FdBuffer, FdFileSize);
+  if (FvFileIndex == NULL) {
     return 0;
   }
 
-  while ((UINTN)FileBuffer < (UINTN)FdBuffer + FdFileSize) {
-    FvLength         = (UINT32)((EFI_FIRMWARE_VOLUME_HEADER *)FileBuffer)->FvLength;
-
-    if (FindFileFromFvByGuid (FileBuffer, FvLength, &VTFGuid, &FileLength) != NULL) {
+  for (FvIndex = 0; FvIndex < FvFileIndex->FvCount; FvIndex++) {
+    if (FindFileInFvFileIndex (FvFileIndex, &VTFGuid, FvFileIndex->FvHeaders[FvIndex]) != NULL) {
       //
       // Found the VTF
       //
-      FvRecoveryFileSize = FvLength;
-      *FvRecovery = FileBuffer;
+      FvRecoveryFileSize = (UINT32)FvFileIndex->FvHeaders[FvIndex]->FvLength;
+      *FvRecovery = (UINT8 *)FvFileIndex->FvHeaders[FvIndex];
     }
-
-    //
-    // Next fv
-    //
-    FileBuffer = (UINT8 *)FileBuffer + FvLength;
-    if ((UINTN)FileBuffer >= (UINTN)FdBuffer + FdFileSize) {
-      break;
-    }
-    FileBuffer = FindNextFvHeader (FileBuffer, (UINTN)FdBuffer + FdFileSize - (UINTN)FileBuffer);
-    if (FileBuffer == NULL) {
-      break;
-    }
-
   }
 
   //
@@ -3728,8 +4163,12 @@ FitGen (
   UINT8                       *AcmBuffer;
   INTN                        Index = 0;
   UINT32                      FixedFitLocation;
+  UINT64                      StartTime;
+  UINT64                      PhaseTime;
 
   FileBufferRaw = NULL;
+  StartTime = GetTimeInMicroseconds ();
+  PhaseTime = StartTime;
   //
   // Step 0: Check FV or FD
   //
@@ -3768,11 +4207,14 @@ FitGen (
       goto exitFunc;
     }
   }
+  gPhaseTime[FitTimeReadInput] = GetTimeInMicroseconds () - PhaseTime;
 
   //
   // Step 2: Calculate FIT entry number.
   //
+  PhaseTime = GetTimeInMicroseconds ();
   FitEntryNumber = GetFitEntryNumber (argc, argv, FdFileBuffer, FdFileSize);
+  gPhaseTime[FitTimeCollectEntries] = GetTimeInMicroseconds () - PhaseTime;
   if (!gFitTableContext.Clear) {
     if (FitEntryNumber == 0) {
       Status = STATUS_ERROR;
@@ -3858,7 +4300,9 @@ FitGen (
     //
     // Step 4: Fill the FIT table one by one
     //
+    PhaseTime = GetTimeInMicroseconds ();
     FillFitTable (FdFileBuffer, FdFileSize, FitTableOffset);
+    gPhaseTime[FitTimeFillTable] = GetTimeInMicroseconds () - PhaseTime;
 
     //
     // For debug
@@ -3883,23 +4327,32 @@ FitGen (
     //
     // Step 4: Clear FIT table
     //
+    PhaseTime = GetTimeInMicroseconds ();
     ClearFitTable (FdFileBuffer, FdFileSize);
+    gPhaseTime[FitTimeFillTable] = GetTimeInMicroseconds () - PhaseTime;
     printf ("Clear FIT table Done!\n");
   }
 
   //
   // Step 5: Write OutputFvRecovery.fv data
   //
+  PhaseTime = GetTimeInMicroseconds ();
   if (IsFv) {
     Status = WriteOutputFile (argv[2], FileBuffer, FvRecoveryFileSize);
   } else {
     Status = WriteOutputFile (argv[3], FdFileBuffer, FdFileSize);
   }
+  gPhaseTime[FitTimeWriteOutput] = GetTimeInMicroseconds () - PhaseTime;
+
+  if (gTimingMode) {
+    PrintTiming (GetTimeInMicroseconds () - StartTime);
+  }
 
 exitFunc:
   if (FileBufferRaw != NULL) {
-    free ((VOID *)FileBufferRaw);
+    FreeInputFile (FileBufferRaw);
   }
+  FreeFvFileIndex (NULL, 0);
   return Status;
 }
 
@@ -4010,7 +4463,7 @@ FitView (
 
 exitFunc:
   if (FileBufferRaw != NULL) {
-    free ((VOID *)FileBufferRaw);
+    FreeInputFile (FileBufferRaw);
   }
   return Status;
 }
@@ -4030,8 +4483,22 @@ main (
   char  **argv
   )
 {
+  int   Index;
+
   SetUtilityName (UTILITY_NAME);
 
+  //
+  // -TIMING may appear anywhere, remove it before the positional parameters are parsed
+  //
+  for (Index = 1; Index < argc; Index++) {
+    if (stricmp (argv[Index], "-TIMING") == 0) {
+      gTimingMode = TRUE;
+      memmove (&argv[Index], &argv[Index + 1], (argc - Index) * sizeof (char *));
+      argc--;
+      Index--;
+    }
+  }
+
   //
   // Display utility information
   //
@@ -11,6 +11,14 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__GNUC__) && !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #define PI_SPECIFICATION_VERSION  0x00010000
 #define EFI_FVH_PI_REVISION       EFI_FVH_REVISION
 #include <Common/UefiBaseTypes.h>
@@ -31,7 +39,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 // Utility version information
 //
 #define UTILITY_MAJOR_VERSION 0
-#define UTILITY_MINOR_VERSION 67
+#define UTILITY_MINOR_VERSION 68
 #define UTILITY_DATE          __DATE__
 
 #define FIT_SPEC_VERSION_MAJOR 1
@@ -55,4 +63,10 @@ IN UINT8                       *FdBuffer,
 IN UINT32                      FdFileSize
 );
 
+VOID
+FreeFvFileIndex (
+IN UINT8                       *Buffer,
+IN UINTN                       BufferSize
+);
+
 #endif